@@ -30,15 +30,11 @@ namespace stan {
         }
       }
 
-      Eigen::Matrix<T, R, C> m_inv = inverse(m_val);
-      m_deriv = multiply(m_inv, m_deriv);
-
-      fvar<T> result;
-      result.val_ = m_val.determinant();
-      result.d_ = result.val_ * m_deriv.trace();
-
-      // FIXME:  I think this will overcopy compared to retur fvar<T>(...);
-      return result;
+      // one factorization gives the determinant and its tangent,
+      // det(m) * trace(m \ m')
+      Eigen::PartialPivLU<Eigen::Matrix<T, R, C> > lu(m_val);
+      T det = lu.determinant();
+      return fvar<T>(det, det * lu.solve(m_deriv).trace());
     }
 
   }
@@ -9,6 +9,7 @@
 #include <stan/math/fwd/scal/fun/log.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
 #include <boost/math/tools/promotion.hpp>
+#include <cmath>
 #include <vector>
 
 namespace stan {
@@ -20,7 +21,26 @@ namespace stan {
     log_determinant(const Eigen::Matrix<fvar<T>, R, C>& m) {
       check_square("log_determinant", "m", m);
 
-      return log(fabs(determinant(m)));
+      Eigen::Matrix<T, R, C> m_deriv(m.rows(), m.cols());
+      Eigen::Matrix<T, R, C> m_val(m.rows(), m.cols());
+
+      for (size_type i = 0; i < m.rows(); i++) {
+        for (size_type j = 0; j < m.cols(); j++) {
+          m_deriv(i, j) = m(i, j).d_;
+          m_val(i, j) = m(i, j).val_;
+        }
+      }
+
+      // the log absolute determinant is summed over the diagonal of
+      // the factorization, which does not overflow as the determinant
+      // can, and its tangent is trace(m \ m')
+      using std::fabs;
+      using std::log;
+      Eigen::PartialPivLU<Eigen::Matrix<T, R, C> > lu(m_val);
+      T val(0);
+      for (size_type i = 0; i < m.rows(); i++)
+        val += log(fabs(lu.matrixLU()(i, i)));
+      return fvar<T>(val, lu.solve(m_deriv).trace());
     }
 
   }
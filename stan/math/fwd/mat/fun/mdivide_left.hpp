@@ -26,9 +26,6 @@ namespace stan {
       check_square("mdivide_left", "A", A);
       check_multiplicable("mdivide_left", "A", A, "b", b);
 
-      Eigen::Matrix<T, R1, C2> inv_A_mult_b(A.rows(), b.cols());
-      Eigen::Matrix<T, R1, C2> inv_A_mult_deriv_b(A.rows(), b.cols());
-      Eigen::Matrix<T, R1, C1> inv_A_mult_deriv_A(A.rows(), A.cols());
       Eigen::Matrix<T, R1, C1> val_A(A.rows(), A.cols());
       Eigen::Matrix<T, R1, C1> deriv_A(A.rows(), A.cols());
       Eigen::Matrix<T, R2, C2> val_b(b.rows(), b.cols());
@@ -48,12 +45,11 @@ namespace stan {
         }
       }
 
-      inv_A_mult_b = mdivide_left(val_A, val_b);
-      inv_A_mult_deriv_b = mdivide_left(val_A, deriv_b);
-      inv_A_mult_deriv_A = mdivide_left(val_A, deriv_A);
-
-      Eigen::Matrix<T, R1, C2> deriv(A.rows(), b.cols());
-      deriv = inv_A_mult_deriv_b - multiply(inv_A_mult_deriv_A, inv_A_mult_b);
+      // the tangent of x = A \ b solves A x' = b' - A' x, so only the
+      // right-hand sides are solved for rather than A \ A'
+      Eigen::Matrix<T, R1, C2> inv_A_mult_b = mdivide_left(val_A, val_b);
+      deriv_b -= multiply(deriv_A, inv_A_mult_b);
+      Eigen::Matrix<T, R1, C2> deriv = mdivide_left(val_A, deriv_b);
 
       return to_fvar(inv_A_mult_b, deriv);
     }
@@ -88,9 +84,6 @@ namespace stan {
       check_square("mdivide_left", "A", A);
       check_multiplicable("mdivide_left", "A", A, "b", b);
 
-      Eigen::Matrix<T, R1, C2>
-        inv_A_mult_b(A.rows(), b.cols());
-      Eigen::Matrix<T, R1, C1> inv_A_mult_deriv_A(A.rows(), A.cols());
       Eigen::Matrix<T, R1, C1> val_A(A.rows(), A.cols());
       Eigen::Matrix<T, R1, C1> deriv_A(A.rows(), A.cols());
 
@@ -101,11 +94,9 @@ namespace stan {
         }
       }
 
-      inv_A_mult_b = mdivide_left(val_A, b);
-      inv_A_mult_deriv_A = mdivide_left(val_A, deriv_A);
-
-      Eigen::Matrix<T, R1, C2> deriv(A.rows(), b.cols());
-      deriv = -multiply(inv_A_mult_deriv_A, inv_A_mult_b);
+      Eigen::Matrix<T, R1, C2> inv_A_mult_b = mdivide_left(val_A, b);
+      Eigen::Matrix<T, R1, C2> deriv
+        = -mdivide_left(val_A, multiply(deriv_A, inv_A_mult_b));
 
       return to_fvar(inv_A_mult_b, deriv);
     }
@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/fun/multiply.hpp>
 #include <stan/math/prim/mat/err/check_multiplicable.hpp>
 #include <stan/math/fwd/core.hpp>
 #include <stan/math/fwd/mat/fun/typedefs.hpp>
@@ -71,57 +72,91 @@ namespace stan {
       return multiply(m, c);
     }
 
+    /**
+     * Return the product of the specified matrices.
+     *
+     * <p>The values and the tangents are split into matrices of
+     * <code>T</code> and the tangent follows the product rule,
+     * <code>(AB)' = A'B + AB'</code>, so for <code>fvar&lt;double&gt;</code>
+     * the product runs as three matrix products of doubles.
+     *
+     * @param m1 first matrix
+     * @param m2 second matrix
+     * @return product of the matrices
+     * @throw std::invalid_argument if the matrices are not
+     * multiplicable
+     */
     template<typename T, int R1, int C1, int R2, int C2>
     inline
     Eigen::Matrix<fvar<T>, R1, C2>
     multiply(const Eigen::Matrix<fvar<T>, R1, C1>& m1,
              const Eigen::Matrix<fvar<T>, R2, C2>& m2) {
       check_multiplicable("multiply", "m1", m1, "m2", m2);
-      Eigen::Matrix<fvar<T>, R1, C2> result(m1.rows(), m2.cols());
-      for (size_type i = 0; i < m1.rows(); i++) {
-        Eigen::Matrix<fvar<T>, 1, C1> crow = m1.row(i);
-        for (size_type j = 0; j < m2.cols(); j++) {
-          Eigen::Matrix<fvar<T>, R2, 1> ccol = m2.col(j);
-          result(i, j) = dot_product(crow, ccol);
-        }
+      Eigen::Matrix<T, R1, C1> val1(m1.rows(), m1.cols());
+      Eigen::Matrix<T, R1, C1> deriv1(m1.rows(), m1.cols());
+      for (size_type i = 0; i < m1.size(); i++) {
+        val1(i) = m1(i).val_;
+        deriv1(i) = m1(i).d_;
       }
-      return result;
+      Eigen::Matrix<T, R2, C2> val2(m2.rows(), m2.cols());
+      Eigen::Matrix<T, R2, C2> deriv2(m2.rows(), m2.cols());
+      for (size_type i = 0; i < m2.size(); i++) {
+        val2(i) = m2(i).val_;
+        deriv2(i) = m2(i).d_;
+      }
+      Eigen::Matrix<T, R1, C2> deriv = multiply(deriv1, val2);
+      deriv += multiply(val1, deriv2);
+      return to_fvar(multiply(val1, val2), deriv);
     }
 
+    /**
+     * Return the product of the specified matrices, splitting the
+     * first into matrices of values and tangents.
+     *
+     * @param m1 first matrix
+     * @param m2 second matrix
+     * @return product of the matrices
+     * @throw std::invalid_argument if the matrices are not
+     * multiplicable
+     */
     template<typename T, int R1, int C1, int R2, int C2>
     inline
     Eigen::Matrix<fvar<T>, R1, C2>
     multiply(const Eigen::Matrix<fvar<T>, R1, C1>& m1,
              const Eigen::Matrix<double, R2, C2>& m2) {
       check_multiplicable("multiply", "m1", m1, "m2", m2);
-      Eigen::Matrix<fvar<T>, R1, C2> result(m1.rows(), m2.cols());
-      for (size_type i = 0; i < m1.rows(); i++) {
-        Eigen::Matrix<fvar<T>, 1, C1> crow = m1.row(i);
-        for (size_type j = 0; j < m2.cols(); j++) {
-          Eigen::Matrix<double, R2, 1> ccol = m2.col(j);
-          result(i, j) = dot_product(crow, ccol);
-        }
+      Eigen::Matrix<T, R1, C1> val1(m1.rows(), m1.cols());
+      Eigen::Matrix<T, R1, C1> deriv1(m1.rows(), m1.cols());
+      for (size_type i = 0; i < m1.size(); i++) {
+        val1(i) = m1(i).val_;
+        deriv1(i) = m1(i).d_;
       }
-      return result;
+      return to_fvar(multiply(val1, m2), multiply(deriv1, m2));
     }
 
+    /**
+     * Return the product of the specified matrices, splitting the
+     * second into matrices of values and tangents.
+     *
+     * @param m1 first matrix
+     * @param m2 second matrix
+     * @return product of the matrices
+     * @throw std::invalid_argument if the matrices are not
+     * multiplicable
+     */
     template<typename T, int R1, int C1, int R2, int C2>
     inline
     Eigen::Matrix<fvar<T>, R1, C2>
     multiply(const Eigen::Matrix<double, R1, C1>& m1,
              const Eigen::Matrix<fvar<T>, R2, C2>& m2) {
-      check_multiplicable("multiply",
-                          "m1", m1,
-                          "m2", m2);
-      Eigen::Matrix<fvar<T>, R1, C2> result(m1.rows(), m2.cols());
-      for (size_type i = 0; i < m1.rows(); i++) {
-        Eigen::Matrix<double, 1, C1> crow = m1.row(i);
-        for (size_type j = 0; j < m2.cols(); j++) {
-          Eigen::Matrix<fvar<T>, R2, 1> ccol = m2.col(j);
-          result(i, j) = dot_product(crow, ccol);
-        }
+      check_multiplicable("multiply", "m1", m1, "m2", m2);
+      Eigen::Matrix<T, R2, C2> val2(m2.rows(), m2.cols());
+      Eigen::Matrix<T, R2, C2> deriv2(m2.rows(), m2.cols());
+      for (size_type i = 0; i < m2.size(); i++) {
+        val2(i) = m2(i).val_;
+        deriv2(i) = m2(i).d_;
       }
-      return result;
+      return to_fvar(multiply(m1, val2), multiply(m1, deriv2));
     }
 
     template <typename T, int C1, int R2>
@@ -7,9 +7,13 @@
 #include <stan/math/prim/scal/meta/likely.hpp>
 #include <cstdlib>
 #include <cstddef>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 namespace stan {
   namespace math {
@@ -32,6 +36,8 @@ namespace stan {
 
     namespace {
       const size_t DEFAULT_INITIAL_NBYTES = 1 << 16;  // 64KB
+      const size_t PAGE_NBYTES = 1 << 12;  // 4KB
+      const size_t HUGE_PAGE_NBYTES = 1 << 21;  // 2MB
 
       // FIXME: enforce alignment
       // big fun to inline, but only called twice
@@ -64,6 +70,15 @@ namespace stan {
      * recovered, with the blocks being reused, or all blocks may be
      * freed, resetting the stack of blocks to its original state.
      *
+     * When the memory is recovered after a sweep that needed more
+     * than one block, the blocks are replaced by a single block as
+     * large as all of them, so that a following sweep of about the
+     * same size, as in successive iterations of a sampler, runs in
+     * one contiguous block without further allocations.  The memory
+     * kept across recoveries can be capped, and large blocks can be
+     * backed by transparent huge pages and pre-faulted, which cuts
+     * TLB misses and page faults on large tapes.
+     *
      * Alignment up to 8 byte boundaries guaranteed for the first malloc,
      * and after that it's up to the caller.  On 64-bit architectures,
      * all struct values should be padded to 8-byte boundaries if they
@@ -82,6 +97,115 @@ namespace stan {
       std::vector<size_t> nested_cur_blocks_;
       std::vector<char*> nested_next_locs_;
       std::vector<char*> nested_cur_block_ends_;
+      // policy and bookkeeping for allocating and retaining blocks:
+      std::vector<bool> mapped_;   // whether each block is mmapped
+      size_t initial_nbytes_;
+      size_t max_retained_nbytes_;
+      bool huge_pages_;
+      bool prefault_;
+
+      /**
+       * Allocate a block of the specified size, backed by huge pages
+       * if they are enabled and the block is at least a huge page,
+       * and touching every page if pre-faulting is enabled.
+       *
+       * @param[in, out] size Number of bytes, rounded up to a whole
+       * number of huge pages if the block is mapped.
+       * @param[out] mapped Whether the block is mmapped.
+       * @return A pointer to the block, or 0 if allocation failed.
+       */
+      char* allocate_block(size_t& size, bool& mapped) {
+        char* ptr = 0;
+        mapped = false;
+#if defined(__linux__)
+        if (huge_pages_ && size >= HUGE_PAGE_NBYTES) {
+          size_t nbytes = (size + HUGE_PAGE_NBYTES - 1)
+            / HUGE_PAGE_NBYTES * HUGE_PAGE_NBYTES;
+          void* p = mmap(0, nbytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+          if (p != MAP_FAILED) {
+#if defined(MADV_HUGEPAGE)
+            madvise(p, nbytes, MADV_HUGEPAGE);
+#endif
+            ptr = static_cast<char*>(p);
+            size = nbytes;
+            mapped = true;
+          }
+        }
+#endif
+        if (!ptr)
+          ptr = eight_byte_aligned_malloc(size);
+        if (ptr && prefault_) {
+          for (size_t i = 0; i < size; i += PAGE_NBYTES)
+            ptr[i] = 0;
+        }
+        return ptr;
+      }
+
+      /**
+       * Return the specified block to the system.
+       *
+       * @param i Index of the block.
+       */
+      void free_block(size_t i) {
+        if (!blocks_[i])
+          return;
+#if defined(__linux__)
+        if (mapped_[i]) {
+          munmap(blocks_[i], sizes_[i]);
+          return;
+        }
+#endif
+        free(blocks_[i]);
+      }
+
+      /**
+       * Return the size of the largest block kept when the memory is
+       * recovered: the retained memory cap, but no smaller than the
+       * initial block, and rounded up as a mapped block would be.
+       *
+       * @return Largest number of bytes in a retained block.
+       */
+      size_t retained_limit() const {
+        size_t nbytes = max_retained_nbytes_;
+        if (nbytes < initial_nbytes_)
+          nbytes = initial_nbytes_;
+        if (huge_pages_ && nbytes >= HUGE_PAGE_NBYTES
+            && nbytes <= std::numeric_limits<size_t>::max()
+                         - HUGE_PAGE_NBYTES)
+          nbytes = (nbytes + HUGE_PAGE_NBYTES - 1)
+            / HUGE_PAGE_NBYTES * HUGE_PAGE_NBYTES;
+        return nbytes;
+      }
+
+      /**
+       * Replace the blocks by a single block as large as all of
+       * them, but no larger than the retained memory cap, and no
+       * smaller than the initial block.
+       */
+      void coalesce() {
+        size_t nbytes = 0;
+        for (size_t i = 0; i < blocks_.size(); ++i) {
+          nbytes += sizes_[i];
+          free_block(i);
+        }
+        if (nbytes > max_retained_nbytes_)
+          nbytes = max_retained_nbytes_;
+        if (nbytes < initial_nbytes_)
+          nbytes = initial_nbytes_;
+        bool mapped;
+        char* block = allocate_block(nbytes, mapped);
+        if (!block) {
+          // fall back to the initial size before giving up
+          nbytes = initial_nbytes_;
+          block = allocate_block(nbytes, mapped);
+        }
+        blocks_.assign(1, block);
+        sizes_.assign(1, nbytes);
+        mapped_.assign(1, mapped);
+        if (!block)
+          throw std::bad_alloc();
+      }
 
       /**
        * Moves us to the next block of memory, allocating that block
@@ -103,10 +227,13 @@ namespace stan {
           size_t newsize = sizes_.back() * 2;
           if (newsize < len)
             newsize = len;
-          blocks_.push_back(eight_byte_aligned_malloc(newsize));
-          if (!blocks_.back())
+          bool mapped;
+          char* block = allocate_block(newsize, mapped);
+          if (!block)
             throw std::bad_alloc();
+          blocks_.push_back(block);
           sizes_.push_back(newsize);
+          mapped_.push_back(mapped);
         }
         result = blocks_[cur_block_];
         // Get the object's state back in order.
@@ -130,7 +257,12 @@ namespace stan {
         sizes_(1, initial_nbytes),
         cur_block_(0),
         cur_block_end_(blocks_[0] + initial_nbytes),
-        next_loc_(blocks_[0]) {
+        next_loc_(blocks_[0]),
+        mapped_(1, false),
+        initial_nbytes_(initial_nbytes),
+        max_retained_nbytes_(std::numeric_limits<size_t>::max()),
+        huge_pages_(false),
+        prefault_(false) {
         if (!blocks_[0])
           throw std::bad_alloc();  // no msg allowed in bad_alloc ctor
       }
@@ -144,8 +276,7 @@ namespace stan {
       ~stack_alloc() {
         // free ALL blocks
         for (size_t i = 0; i < blocks_.size(); ++i)
-          if (blocks_[i])
-            free(blocks_[i]);
+          free_block(i);
       }
 
       /**
@@ -189,8 +320,16 @@ namespace stan {
        * of memory blocks allocated so far will be available for further
        * allocations.  To free memory back to the system, use the
        * function free_all().
+       *
+       * If there is more than one block, or the block is larger than
+       * the retained memory cap allows, the blocks are first replaced
+       * by a single block (see <code>set_max_retained_bytes()</code>).
+       * A block already coalesced to the cap is kept as it is.
        */
       inline void recover_all() {
+        if (unlikely(blocks_.size() > 1
+                     || sizes_[0] > retained_limit()))
+          coalesce();
         cur_block_ = 0;
         next_loc_ = blocks_[0];
         cur_block_end_ = next_loc_ + sizes_[0];
@@ -229,15 +368,83 @@ namespace stan {
        * destructor will free all memory.
        */
       inline void free_all() {
-        // frees all BUT the first (index 0) block
+        // frees all BUT the first (index 0) block, unless it has been
+        // replaced by a larger one
         for (size_t i = 1; i < blocks_.size(); ++i)
-          if (blocks_[i])
-            free(blocks_[i]);
+          free_block(i);
         sizes_.resize(1);
         blocks_.resize(1);
+        mapped_.resize(1);
+        if (sizes_[0] != initial_nbytes_) {
+          free_block(0);
+          bool mapped;
+          size_t nbytes = initial_nbytes_;
+          blocks_[0] = allocate_block(nbytes, mapped);
+          sizes_[0] = nbytes;
+          mapped_[0] = mapped;
+          if (!blocks_[0])
+            throw std::bad_alloc();
+        }
         recover_all();
       }
 
+      /**
+       * Set the largest number of bytes kept for reuse when the memory
+       * is recovered.  The default is no limit.  The cap does not
+       * limit the memory used during a sweep, and the initial block
+       * is always kept.
+       *
+       * @param nbytes Largest number of bytes to retain.
+       */
+      inline void set_max_retained_bytes(size_t nbytes) {
+        max_retained_nbytes_ = nbytes;
+      }
+
+      /**
+       * Set whether blocks of at least 2MB are allocated with
+       * <code>mmap</code> and advised to be backed by transparent huge
+       * pages.  This has no effect on systems other than Linux.  The
+       * default is false.
+       *
+       * @param huge_pages Whether to use huge pages.
+       */
+      inline void set_huge_pages(bool huge_pages) {
+        huge_pages_ = huge_pages;
+      }
+
+      /**
+       * Set whether new blocks are pre-faulted, touching every page
+       * when the block is allocated rather than on first use.  The
+       * default is false.
+       *
+       * @param prefault Whether to pre-fault blocks.
+       */
+      inline void set_prefault(bool prefault) {
+        prefault_ = prefault;
+      }
+
+      /**
+       * Return the number of bytes in all blocks held by this
+       * instance, whether or not they are in use.
+       *
+       * @return number of bytes retained by this instance
+       */
+      inline size_t bytes_retained() const {
+        size_t sum = 0;
+        for (size_t i = 0; i < sizes_.size(); ++i)
+          sum += sizes_[i];
+        return sum;
+      }
+
+      /**
+       * Return the number of blocks held by this instance.
+       *
+       * @return number of blocks
+       */
+      inline size_t num_blocks() const {
+        return blocks_.size();
+      }
+
       /**
        * Return number of bytes allocated to this instance by the heap.
        * This is not the same as the number of bytes allocated through
@@ -13,4 +13,6 @@
 #include <stan/math/fwd/arr.hpp>
 #include <stan/math/rev/arr.hpp>
 
+#include <stan/math/mix/arr/functor/integrate_ode_rk45_batch.hpp>
+
 #endif
@@ -0,0 +1,404 @@
+#ifndef STAN_MATH_MIX_ARR_FUNCTOR_INTEGRATE_ODE_RK45_BATCH_HPP
+#define STAN_MATH_MIX_ARR_FUNCTOR_INTEGRATE_ODE_RK45_BATCH_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/arr/fun/decouple_ode_states.hpp>
+#include <stan/math/rev/scal/meta/is_var.hpp>
+#include <stan/math/prim/arr/err/check_nonzero_size.hpp>
+#include <stan/math/prim/arr/err/check_ordered.hpp>
+#include <stan/math/prim/arr/functor/coupled_ode_observer.hpp>
+#include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_less.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/scal/err/invalid_argument.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION == 106400
+#  include <boost/serialization/array_wrapper.hpp>
+#endif
+#include <boost/numeric/odeint.hpp>
+#include <algorithm>
+#include <exception>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      /**
+       * The coupled ODE system of one subject of a batch, with the
+       * sensitivities computed in forward mode.
+       *
+       * <p>The coupled state has the layout used by
+       * <code>decouple_ode_states</code>: the N states followed by
+       * the N sensitivities of the states with respect to each of
+       * the S operands, which are the initial states, if they are
+       * autodiff variables, followed by the parameters, if they are.
+       * The derivative of the sensitivities with respect to operand
+       * s is the directional derivative of the system function along
+       * the current sensitivities and the unit vector of the
+       * operand, which is one evaluation of the system function on
+       * <code>fvar&lt;double&gt;</code>.
+       *
+       * <p>Forward mode does not touch the autodiff stack, so
+       * systems for different subjects can be integrated
+       * concurrently. The workspace is reused across calls and
+       * across subjects.
+       *
+       * @tparam F type of ODE system function
+       */
+      template <typename F>
+      struct ode_batch_system {
+        const F& f_;
+        size_t N_;
+        size_t S_;
+        size_t initial_size_;
+        const std::vector<double>* theta_;
+        const std::vector<double>* x_;
+        const std::vector<int>* x_int_;
+        std::ostream* msgs_;
+        std::vector<fvar<double> > y_fvar_;
+        std::vector<fvar<double> > theta_fvar_;
+
+        explicit ode_batch_system(const F& f)
+          : f_(f), N_(0), S_(0), initial_size_(0), theta_(0), x_(0),
+            x_int_(0), msgs_(0) { }
+
+        /**
+         * Point the system at the specified subject.
+         *
+         * @param[in] N number of states
+         * @param[in] initial_var true if the initial states are
+         * operands
+         * @param[in] param_var true if the parameters are operands
+         * @param[in] theta parameters
+         * @param[in] x real data
+         * @param[in] x_int integer data
+         * @param[in, out] msgs print stream
+         */
+        void reset(size_t N, bool initial_var, bool param_var,
+                   const std::vector<double>& theta,
+                   const std::vector<double>& x,
+                   const std::vector<int>& x_int, std::ostream* msgs) {
+          N_ = N;
+          initial_size_ = initial_var ? N : 0;
+          S_ = initial_size_ + (param_var ? theta.size() : 0);
+          theta_ = &theta;
+          x_ = &x;
+          x_int_ = &x_int;
+          msgs_ = msgs;
+          y_fvar_.resize(N);
+          theta_fvar_.resize(theta.size());
+        }
+
+        size_t size() const {
+          return N_ + N_ * S_;
+        }
+
+        void operator()(const std::vector<double>& z,
+                        std::vector<double>& dz_dt, double t) {
+          dz_dt.resize(z.size());
+          if (S_ == 0) {
+            std::vector<double> y(z.begin(), z.begin() + N_);
+            std::vector<double> dy_dt
+              = f_(t, y, *theta_, *x_, *x_int_, msgs_);
+            check_size_match("integrate_ode_rk45_batch",
+                             "dz_dt", dy_dt.size(), "states", N_);
+            std::copy(dy_dt.begin(), dy_dt.end(), dz_dt.begin());
+            return;
+          }
+          for (size_t s = 0; s < S_; ++s) {
+            const double* sens = &z[N_ + N_ * s];
+            for (size_t j = 0; j < N_; ++j)
+              y_fvar_[j] = fvar<double>(z[j], sens[j]);
+            for (size_t m = 0; m < theta_fvar_.size(); ++m)
+              theta_fvar_[m] = fvar<double>((*theta_)[m],
+                                            s == initial_size_ + m
+                                            ? 1.0 : 0.0);
+            std::vector<fvar<double> > dy_dt
+              = f_(t, y_fvar_, theta_fvar_, *x_, *x_int_, msgs_);
+            check_size_match("integrate_ode_rk45_batch",
+                             "dz_dt", dy_dt.size(), "states", N_);
+            for (size_t j = 0; j < N_; ++j)
+              dz_dt[N_ + N_ * s + j] = dy_dt[j].d_;
+            if (s == 0) {
+              for (size_t j = 0; j < N_; ++j)
+                dz_dt[j] = dy_dt[j].val_;
+            }
+          }
+        }
+      };
+
+      /**
+       * Integrates the subjects of a batch assigned to one worker,
+       * reusing the coupled system, the dense-output stepper, which
+       * is initialized again for each subject, and the coupled state
+       * for every subject. Exceptions and messages are kept per
+       * subject so they can be reported in subject order.
+       */
+      template <typename F>
+      struct ode_batch_worker {
+        const F& f_;
+        const std::vector<std::vector<double> >& y0_;
+        double t0_;
+        const std::vector<std::vector<double> >& ts_;
+        const std::vector<std::vector<double> >& theta_;
+        const std::vector<std::vector<double> >& x_;
+        const std::vector<std::vector<int> >& x_int_;
+        bool initial_var_;
+        bool param_var_;
+        bool keep_msgs_;
+        double relative_tolerance_;
+        double absolute_tolerance_;
+        int max_num_steps_;
+        size_t num_workers_;
+        std::vector<std::vector<std::vector<double> > >& y_coupled_;
+        std::vector<std::string>& msgs_;
+        std::vector<std::exception_ptr>& errors_;
+
+        ode_batch_worker(const F& f,
+                         const std::vector<std::vector<double> >& y0,
+                         double t0,
+                         const std::vector<std::vector<double> >& ts,
+                         const std::vector<std::vector<double> >& theta,
+                         const std::vector<std::vector<double> >& x,
+                         const std::vector<std::vector<int> >& x_int,
+                         bool initial_var, bool param_var, bool keep_msgs,
+                         double relative_tolerance,
+                         double absolute_tolerance, int max_num_steps,
+                         size_t num_workers,
+                         std::vector<std::vector<std::vector<double> > >&
+                         y_coupled,
+                         std::vector<std::string>& msgs,
+                         std::vector<std::exception_ptr>& errors)
+          : f_(f), y0_(y0), t0_(t0), ts_(ts), theta_(theta), x_(x),
+            x_int_(x_int), initial_var_(initial_var),
+            param_var_(param_var), keep_msgs_(keep_msgs),
+            relative_tolerance_(relative_tolerance),
+            absolute_tolerance_(absolute_tolerance),
+            max_num_steps_(max_num_steps), num_workers_(num_workers),
+            y_coupled_(y_coupled), msgs_(msgs), errors_(errors) { }
+
+        void operator()(size_t worker) const {
+          using boost::numeric::odeint::integrate_times;
+          using boost::numeric::odeint::make_dense_output;
+          using boost::numeric::odeint::runge_kutta_dopri5;
+          using boost::numeric::odeint::max_step_checker;
+          using boost::numeric::odeint::range_algebra;
+          using boost::numeric::odeint::default_operations;
+          using boost::numeric::odeint::always_resizer;
+
+          // subjects may differ in size, so the stepper checks the size
+          // of its buffers on every initialization
+          typedef runge_kutta_dopri5<std::vector<double>, double,
+                                     std::vector<double>, double,
+                                     range_algebra, default_operations,
+                                     always_resizer> dopri5;
+          typedef typename boost::numeric::odeint::result_of
+            ::make_dense_output<dopri5>::type dense_stepper;
+
+          ode_batch_system<F> system(f_);
+          dense_stepper stepper
+            = make_dense_output(absolute_tolerance_, relative_tolerance_,
+                                dopri5());
+          std::vector<double> state;
+          std::vector<double> ts_vec;
+          std::ostringstream subject_msgs;
+          const double step_size = 0.1;
+
+          for (size_t i = worker; i < y0_.size(); i += num_workers_) {
+            try {
+              const size_t N = y0_[i].size();
+              subject_msgs.str("");
+              system.reset(N, initial_var_, param_var_, theta_[i], x_[i],
+                           x_int_[i], keep_msgs_ ? &subject_msgs : 0);
+
+              // the initial sensitivities with respect to the initial
+              // states are the identity
+              state.assign(system.size(), 0.0);
+              std::copy(y0_[i].begin(), y0_[i].end(), state.begin());
+              if (initial_var_) {
+                for (size_t n = 0; n < N; ++n)
+                  state[N + N * n + n] = 1.0;
+              }
+
+              ts_vec.resize(ts_[i].size() + 1);
+              ts_vec[0] = t0_;
+              std::copy(ts_[i].begin(), ts_[i].end(), ts_vec.begin() + 1);
+
+              std::vector<std::vector<double> >& y = y_coupled_[i];
+              y.resize(ts_vec.size());
+              coupled_ode_observer observer(y);
+              integrate_times(boost::ref(stepper),
+                              boost::ref(system), state,
+                              ts_vec.begin(), ts_vec.end(), step_size,
+                              observer, max_step_checker(max_num_steps_));
+              y.erase(y.begin());
+            } catch (...) {
+              errors_[i] = std::current_exception();
+            }
+            if (keep_msgs_)
+              msgs_[i] = subject_msgs.str();
+          }
+        }
+      };
+
+    }
+
+    /**
+     * Return the solutions of a batch of independent ODE systems,
+     * one per subject, that share the system function and the
+     * initial time, integrating the subjects concurrently on up to
+     * the specified number of threads.
+     *
+     * <p>Subject i has initial state <code>y0[i]</code>, output
+     * times <code>ts[i]</code>, parameters <code>theta[i]</code> and
+     * data <code>x[i]</code> and <code>x_int[i]</code>; subjects may
+     * differ in all of their sizes. The arguments and results of
+     * each subject are as for <code>integrate_ode_rk45</code>, and
+     * the solution of each subject is a single node on the autodiff
+     * stack.
+     *
+     * <p>The sensitivities are computed with forward-mode autodiff,
+     * so the system function must also accept
+     * <code>fvar&lt;double&gt;</code> states and parameters. Forward
+     * mode does not use the autodiff stack, which is what allows the
+     * subjects to be solved concurrently. Each thread reuses one
+     * coupled system, stepper and state for all of its subjects.
+     * Messages written by the system function are collected per
+     * subject and written to the message stream in subject order.
+     *
+     * @tparam F type of ODE system function.
+     * @tparam T1 type of scalars for initial values.
+     * @tparam T2 type of scalars for parameters.
+     * @param[in] f functor for the base ordinary differential equation.
+     * @param[in] y0 initial state of each subject.
+     * @param[in] t0 initial time.
+     * @param[in] ts times of the desired solutions of each subject,
+     * in strictly increasing order, all greater than the initial time.
+     * @param[in] theta parameter vector of each subject.
+     * @param[in] x continuous data vector of each subject.
+     * @param[in] x_int integer data vector of each subject.
+     * @param[out] msgs the print stream for warning messages.
+     * @param[in] relative_tolerance relative tolerance parameter
+     *   for Boost's ode solver. Defaults to 1e-6.
+     * @param[in] absolute_tolerance absolute tolerance parameter
+     *   for Boost's ode solver. Defaults to 1e-6.
+     * @param[in] max_num_steps maximum number of steps to take within
+     *   the Boost ode solver for each subject.
+     * @param[in] num_threads maximum number of threads to use.
+     * @return for each subject, a vector of states, each state being
+     * a vector of the same size as the state variable, corresponding
+     * to a time in ts.
+     * @throw std::invalid_argument if the numbers of subjects do not
+     * match or a tolerance or the maximum number of steps is not
+     * positive
+     * @throw std::domain_error if the arguments of a subject are not
+     * valid for <code>integrate_ode_rk45</code> or num_threads is not
+     * positive
+     * @throw the first exception, in subject order, thrown while
+     * integrating a subject
+     */
+    template <typename F, typename T1, typename T2>
+    std::vector<std::vector<std::vector<typename stan::return_type<T1,
+                                                                   T2>
+                                        ::type> > >
+    integrate_ode_rk45_batch(const F& f,
+                             const std::vector<std::vector<T1> >& y0,
+                             double t0,
+                             const std::vector<std::vector<double> >& ts,
+                             const std::vector<std::vector<T2> >& theta,
+                             const std::vector<std::vector<double> >& x,
+                             const std::vector<std::vector<int> >& x_int,
+                             std::ostream* msgs = 0,
+                             double relative_tolerance = 1e-6,
+                             double absolute_tolerance = 1e-6,
+                             int max_num_steps = 1E6,
+                             int num_threads = 1) {
+      static const char* function = "integrate_ode_rk45_batch";
+      typedef typename stan::return_type<T1, T2>::type T_return;
+
+      const size_t K = y0.size();
+      check_size_match(function, "subjects in times", ts.size(),
+                       "subjects in initial state", K);
+      check_size_match(function, "subjects in parameters", theta.size(),
+                       "subjects in initial state", K);
+      check_size_match(function, "subjects in continuous data", x.size(),
+                       "subjects in initial state", K);
+      check_size_match(function, "subjects in integer data", x_int.size(),
+                       "subjects in initial state", K);
+      check_finite(function, "initial time", t0);
+      for (size_t i = 0; i < K; ++i) {
+        check_finite(function, "initial state", y0[i]);
+        check_finite(function, "times", ts[i]);
+        check_finite(function, "parameter vector", theta[i]);
+        check_finite(function, "continuous data", x[i]);
+        check_nonzero_size(function, "times", ts[i]);
+        check_nonzero_size(function, "initial state", y0[i]);
+        check_ordered(function, "times", ts[i]);
+        check_less(function, "initial time", t0, ts[i][0]);
+      }
+      if (relative_tolerance <= 0)
+        invalid_argument(function,
+                         "relative_tolerance,", relative_tolerance,
+                         "", ", must be greater than 0");
+      if (absolute_tolerance <= 0)
+        invalid_argument(function,
+                         "absolute_tolerance,", absolute_tolerance,
+                         "", ", must be greater than 0");
+      if (max_num_steps <= 0)
+        invalid_argument(function,
+                         "max_num_steps,", max_num_steps,
+                         "", ", must be greater than 0");
+      check_positive(function, "Number of threads", num_threads);
+
+      std::vector<std::vector<double> > y0_dbl(K);
+      std::vector<std::vector<double> > theta_dbl(K);
+      for (size_t i = 0; i < K; ++i) {
+        y0_dbl[i] = value_of(y0[i]);
+        theta_dbl[i] = value_of(theta[i]);
+      }
+
+      std::vector<std::vector<std::vector<double> > > y_coupled(K);
+      std::vector<std::string> subject_msgs(K);
+      std::vector<std::exception_ptr> errors(K);
+      size_t num_workers
+        = std::max<size_t>(1, std::min<size_t>(num_threads, K));
+      internal::ode_batch_worker<F>
+        worker(f, y0_dbl, t0, ts, theta_dbl, x, x_int,
+               is_var<T1>::value, is_var<T2>::value, msgs != 0,
+               relative_tolerance, absolute_tolerance, max_num_steps,
+               num_workers, y_coupled, subject_msgs, errors);
+
+      std::vector<std::thread> threads;
+      threads.reserve(num_workers - 1);
+      for (size_t t = 1; t < num_workers; ++t)
+        threads.push_back(std::thread(worker, t));
+      worker(0);
+      for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+      for (size_t i = 0; i < K; ++i) {
+        if (msgs)
+          *msgs << subject_msgs[i];
+        if (errors[i])
+          std::rethrow_exception(errors[i]);
+      }
+
+      std::vector<std::vector<std::vector<T_return> > > y_return(K);
+      for (size_t i = 0; i < K; ++i)
+        y_return[i] = decouple_ode_states(y_coupled[i], y0[i], theta[i]);
+      return y_return;
+    }
+
+  }
+}
+#endif
@@ -9,7 +9,10 @@
 
 #include <stan/math/prim/mat.hpp>
 
+#include <stan/math/mix/arr.hpp>
+
 #include <stan/math/mix/mat/functor/derivative.hpp>
+#include <stan/math/mix/mat/functor/edge_pushing_hessian.hpp>
 #include <stan/math/mix/mat/functor/finite_diff_grad_hessian.hpp>
 #include <stan/math/mix/mat/functor/grad_hessian.hpp>
 #include <stan/math/mix/mat/functor/grad_tr_mat_times_hessian.hpp>
@@ -17,5 +20,6 @@
 #include <stan/math/mix/mat/functor/hessian.hpp>
 #include <stan/math/mix/mat/functor/hessian_times_vector.hpp>
 #include <stan/math/mix/mat/functor/partial_derivative.hpp>
+#include <stan/math/mix/mat/functor/sparse_hessian.hpp>
 
 #endif
@@ -0,0 +1,59 @@
+#ifndef STAN_MATH_MIX_MAT_FUNCTOR_EDGE_PUSHING_HESSIAN_HPP
+#define STAN_MATH_MIX_MAT_FUNCTOR_EDGE_PUSHING_HESSIAN_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/functor/record_compact_program.hpp>
+#include <stan/math/mix/mat/functor/hessian.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Calculate the value, the gradient, and the Hessian of the
+     * specified function at the specified argument with one
+     * evaluation of the function and one second-order reverse sweep.
+     *
+     * <p>The function is evaluated with the compact tape enabled
+     * and the recorded <code>compact_program</code> supplies the
+     * first and second derivatives of each operation. The Hessian is
+     * then accumulated by edge pushing (see
+     * <code>compact_program::hessian()</code>), instead of the N
+     * forward-over-reverse passes of <code>hessian()</code>.
+     *
+     * <p>If the function uses an operation without a compact form
+     * (see <code>compact_op</code>), the result is calculated by
+     * <code>hessian()</code>, so the functor must be templated as
+     * for <code>hessian()</code> and be defined for
+     * <code>var</code> arguments.
+     *
+     * @tparam F Type of function
+     * @param[in] f Function
+     * @param[in] x Argument to function
+     * @param[out] fx Function applied to argument
+     * @param[out] grad gradient of function at argument
+     * @param[out] H Hessian of function at argument
+     */
+    template <typename F>
+    void edge_pushing_hessian(
+        const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+        double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& H) {
+      H.resize(x.size(), x.size());
+      grad.resize(x.size());
+      if (x.size() == 0) {
+        fx = f(x);
+        return;
+      }
+      compact_program program;
+      if (!record_compact_program(f, x, fx, grad, program)
+          || !program.forward(x.data())) {
+        hessian(f, x, fx, grad, H);
+        return;
+      }
+      program.hessian(0, grad.data(), H.data());
+    }
+
+  }
+}
+#endif
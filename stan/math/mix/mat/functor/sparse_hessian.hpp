@@ -0,0 +1,307 @@
+#ifndef STAN_MATH_MIX_MAT_FUNCTOR_SPARSE_HESSIAN_HPP
+#define STAN_MATH_MIX_MAT_FUNCTOR_SPARSE_HESSIAN_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/functor/record_compact_program.hpp>
+#include <stan/math/mix/mat/functor/hessian_times_vector.hpp>
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      /**
+       * Return true if the specified operation has two variable
+       * operands.
+       *
+       * @param op operation
+       * @return whether the operation is binary
+       */
+      inline bool is_binary(compact_op op) {
+        return op == COMPACT_ADD_VV || op == COMPACT_SUB_VV
+          || op == COMPACT_MUL_VV || op == COMPACT_DIV_VV;
+      }
+
+      /**
+       * Add the indexes in the first set to the pattern rows of each
+       * index in the second set. All sets are sorted.
+       *
+       * @param[in] a indexes interacting with those in b
+       * @param[in] b indexes interacting with those in a
+       * @param[in, out] rows pattern rows
+       */
+      inline void add_interactions(const std::vector<size_t>& a,
+                                   const std::vector<size_t>& b,
+                                   std::vector<std::set<size_t> >& rows) {
+        for (size_t k = 0; k < b.size(); ++k)
+          rows[b[k]].insert(a.begin(), a.end());
+      }
+
+      /**
+       * Detect the sparsity pattern of the Hessian of the first
+       * output of the specified program.
+       *
+       * <p>Each slot carries the set of inputs it depends on, and
+       * each nonlinear instruction marks the inputs of its operands
+       * as interacting: all pairs for a nonlinear unary function,
+       * pairs across operands for a product and, in addition, pairs
+       * within the divisor for a quotient. Sums, differences and
+       * products with constants only pass dependencies on. The result
+       * is a superset of the nonzero entries of the Hessian at any
+       * argument that takes the recorded path through the function.
+       *
+       * @param[in] program recorded program
+       * @param[out] pattern sorted row indexes of the nonzero entries
+       * of each column of the Hessian
+       */
+      inline void
+      hessian_sparsity(const compact_program& program,
+                       std::vector<std::vector<size_t> >& pattern) {
+        size_t N = program.num_inputs();
+        std::vector<std::set<size_t> > rows(N);
+        std::vector<std::vector<size_t> > deps(program.num_slots());
+        for (size_t n = 0; n < N; ++n)
+          deps[n].push_back(n);
+
+        // dependencies of a slot are released after its last use
+        std::vector<size_t> last_use(program.num_slots(), 0);
+        for (size_t i = 0; i < program.size(); ++i) {
+          last_use[program.operand_a(i)] = i;
+          if (is_binary(program.op(i)))
+            last_use[program.operand_b(i)] = i;
+        }
+
+        for (size_t i = 0; i < program.size(); ++i) {
+          size_t a = program.operand_a(i);
+          size_t b = program.operand_b(i);
+          std::vector<size_t>& y = deps[program.result(i)];
+          bool binary = is_binary(program.op(i));
+          switch (program.op(i)) {
+          case COMPACT_ADD_VV:
+          case COMPACT_SUB_VV:
+            break;
+          case COMPACT_MUL_VV:
+            add_interactions(deps[a], deps[b], rows);
+            add_interactions(deps[b], deps[a], rows);
+            break;
+          case COMPACT_DIV_VV:
+            add_interactions(deps[a], deps[b], rows);
+            add_interactions(deps[b], deps[a], rows);
+            add_interactions(deps[b], deps[b], rows);
+            break;
+          case COMPACT_ADD_V:
+          case COMPACT_NEG:
+          case COMPACT_SCALE:
+          case COMPACT_DIV_VD:
+            break;
+          default:
+            add_interactions(deps[a], deps[a], rows);
+            break;
+          }
+
+          if (last_use[a] == i)
+            y.swap(deps[a]);
+          else
+            y = deps[a];
+          if (binary && !deps[b].empty()) {
+            std::vector<size_t> merged;
+            merged.reserve(y.size() + deps[b].size());
+            std::set_union(y.begin(), y.end(),
+                           deps[b].begin(), deps[b].end(),
+                           std::back_inserter(merged));
+            y.swap(merged);
+            if (last_use[b] == i)
+              std::vector<size_t>().swap(deps[b]);
+          }
+        }
+
+        pattern.resize(N);
+        for (size_t n = 0; n < N; ++n)
+          pattern[n].assign(rows[n].begin(), rows[n].end());
+      }
+
+      /**
+       * Return true if a vertex adjacent to the specified vertex,
+       * other than the excluded one, has the specified color.
+       *
+       * @param[in] pattern adjacency of the vertexes
+       * @param[in] color colors of the vertexes, -1 if not colored
+       * @param[in] v vertex
+       * @param[in] excluded vertex not to consider
+       * @param[in] c color
+       * @return whether a neighbor has color c
+       */
+      inline bool has_neighbor_colored(
+          const std::vector<std::vector<size_t> >& pattern,
+          const std::vector<int>& color, size_t v, size_t excluded,
+          int c) {
+        for (size_t k = 0; k < pattern[v].size(); ++k) {
+          size_t u = pattern[v][k];
+          if (u != v && u != excluded && color[u] == c)
+            return true;
+        }
+        return false;
+      }
+
+      /**
+       * Greedily star color the adjacency graph of the specified
+       * symmetric sparsity pattern.
+       *
+       * <p>A star coloring is a coloring in which adjacent vertexes
+       * have different colors and every path on four vertexes uses
+       * at least three colors. Compressing the columns of a symmetric
+       * matrix by a star coloring of its pattern lets every nonzero
+       * entry be read directly off the compressed matrix.
+       *
+       * @param[in] pattern sorted row indexes of the nonzero entries
+       * of each column
+       * @param[out] color color of each column
+       * @return number of colors
+       */
+      inline int
+      star_coloring(const std::vector<std::vector<size_t> >& pattern,
+                    std::vector<int>& color) {
+        size_t N = pattern.size();
+        color.assign(N, -1);
+        std::vector<size_t> forbidden(N, N);
+        int num_colors = 0;
+        for (size_t v = 0; v < N; ++v) {
+          const std::vector<size_t>& adj = pattern[v];
+          for (size_t k = 0; k < adj.size(); ++k) {
+            if (adj[k] != v && color[adj[k]] >= 0)
+              forbidden[color[adj[k]]] = v;
+          }
+          // forbid colors that would give a path on four vertexes
+          // in two colors, with v at its end or inside it
+          for (size_t k = 0; k < adj.size(); ++k) {
+            size_t w = adj[k];
+            if (w == v || color[w] < 0)
+              continue;
+            for (size_t l = 0; l < pattern[w].size(); ++l) {
+              size_t x = pattern[w][l];
+              if (x == w || x == v || color[x] < 0
+                  || forbidden[color[x]] == v)
+                continue;
+              if (has_neighbor_colored(pattern, color, x, w, color[w])
+                  || has_neighbor_colored(pattern, color, v, w,
+                                          color[w]))
+                forbidden[color[x]] = v;
+            }
+          }
+          int c = 0;
+          while (forbidden[c] == v)
+            ++c;
+          color[v] = c;
+          num_colors = std::max(num_colors, c + 1);
+        }
+        return num_colors;
+      }
+
+    }
+
+    /**
+     * Calculate the value, the gradient, and the Hessian, as a
+     * sparse matrix, of the specified function at the specified
+     * argument.
+     *
+     * <p>The function is first evaluated with the compact tape
+     * enabled, which gives the value and the gradient, and the
+     * sparsity pattern of the Hessian is detected from the recorded
+     * tape. The columns of the Hessian are star colored and the
+     * Hessian is recovered from one call to
+     * <code>hessian_times_vector()</code> per color, with the vector
+     * the indicator of the columns of that color. For a banded or
+     * block diagonal Hessian the number of colors depends on the
+     * bandwidth or the block size rather than the number of inputs.
+     *
+     * <p>The pattern can only be detected if every operation on the
+     * tape has a compact form (see <code>compact_op</code>).
+     * Otherwise the Hessian is taken to be dense, and it is computed
+     * with one Hessian-vector product per input. The functor must
+     * be templated as for <code>hessian()</code>, and must also be
+     * defined for <code>var</code> arguments.
+     *
+     * @tparam F Type of function
+     * @param[in] f Function
+     * @param[in] x Argument to function
+     * @param[out] fx Function applied to argument
+     * @param[out] grad gradient of function at argument
+     * @param[out] H Hessian of function at argument
+     */
+    template <typename F>
+    void sparse_hessian(const F& f,
+                        const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                        double& fx,
+                        Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+                        Eigen::SparseMatrix<double>& H) {
+      size_t N = x.size();
+      H.resize(N, N);
+      H.setZero();
+      grad.resize(N);
+      if (N == 0) {
+        fx = f(x);
+        return;
+      }
+
+      compact_program program;
+      bool recorded = record_compact_program(f, x, fx, grad, program);
+
+      std::vector<std::vector<size_t> > pattern;
+      std::vector<int> color;
+      int num_colors;
+      if (recorded) {
+        internal::hessian_sparsity(program, pattern);
+        num_colors = internal::star_coloring(pattern, color);
+      } else {
+        pattern.resize(N);
+        color.resize(N);
+        for (size_t i = 0; i < N; ++i) {
+          for (size_t j = 0; j < N; ++j)
+            pattern[i].push_back(j);
+          color[i] = i;
+        }
+        num_colors = N;
+      }
+
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>
+        B(N, num_colors);
+      Eigen::Matrix<double, Eigen::Dynamic, 1> seed(N);
+      Eigen::Matrix<double, Eigen::Dynamic, 1> Hv;
+      double fx_v;
+      for (int c = 0; c < num_colors; ++c) {
+        for (size_t i = 0; i < N; ++i)
+          seed(i) = color[i] == c;
+        hessian_times_vector(f, x, seed, fx_v, Hv);
+        B.col(c) = Hv;
+      }
+
+      // H(i, j) is B(i, color j) if j is the only column of its
+      // color in row i, and otherwise B(j, color i) by symmetry
+      std::vector<Eigen::Triplet<double> > entries;
+      std::vector<int> count(num_colors, 0);
+      for (size_t i = 0; i < N; ++i) {
+        const std::vector<size_t>& row = pattern[i];
+        for (size_t k = 0; k < row.size(); ++k)
+          ++count[color[row[k]]];
+        for (size_t k = 0; k < row.size(); ++k) {
+          size_t j = row[k];
+          double h = count[color[j]] == 1 ? B(i, color[j])
+            : B(j, color[i]);
+          entries.push_back(Eigen::Triplet<double>(i, j, h));
+        }
+        for (size_t k = 0; k < row.size(); ++k)
+          count[color[row[k]]] = 0;
+      }
+      H.setFromTriplets(entries.begin(), entries.end());
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,101 @@
+#ifndef STAN_MATH_PRIM_ARR_FUNCTOR_PARALLEL_RNG_FILL_HPP
+#define STAN_MATH_PRIM_ARR_FUNCTOR_PARALLEL_RNG_FILL_HPP
+
+#include <stan/math/prim/scal/fun/philox_engine.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Number of draws generated from each chunk of a batched
+     * <code>_rng</code> call.
+     */
+    const size_t RNG_CHUNK_SIZE = 4096;
+
+    /**
+     * Number of engine outputs reserved for each chunk of a batched
+     * <code>_rng</code> call. This is far more than any sampler
+     * consumes for <code>RNG_CHUNK_SIZE</code> draws, so chunks never
+     * overlap.
+     */
+    const boost::uint64_t RNG_CHUNK_STRIDE
+      = static_cast<boost::uint64_t>(1) << 34;
+
+    namespace internal {
+
+      template <class F>
+      struct rng_chunk_worker {
+        const F& f_;
+        const philox_engine& rng_;
+        size_t N_;
+        size_t num_chunks_;
+        size_t num_workers_;
+
+        rng_chunk_worker(const F& f, const philox_engine& rng, size_t N,
+                         size_t num_chunks, size_t num_workers)
+          : f_(f), rng_(rng), N_(N), num_chunks_(num_chunks),
+            num_workers_(num_workers) { }
+
+        void operator()(size_t worker) const {
+          for (size_t c = worker; c < num_chunks_; c += num_workers_) {
+            philox_engine chunk_rng(rng_);
+            chunk_rng.discard(c * RNG_CHUNK_STRIDE);
+            size_t begin = c * RNG_CHUNK_SIZE;
+            size_t end = std::min(N_, begin + RNG_CHUNK_SIZE);
+            f_(begin, end, chunk_rng);
+          }
+        }
+      };
+
+    }
+
+    /**
+     * Generate N draws in chunks of <code>RNG_CHUNK_SIZE</code>,
+     * spreading the chunks over the specified number of threads.
+     *
+     * <p>Chunk c is generated from a copy of the engine advanced by
+     * c * <code>RNG_CHUNK_STRIDE</code> outputs, so every draw
+     * depends only on the engine state and its index and the result
+     * is the same for any number of threads. On return the engine is
+     * advanced past all of the chunks, so consecutive calls produce
+     * fresh draws.
+     *
+     * <p>The functor is called as <code>f(begin, end, rng)</code>
+     * and must write the draws with indexes in
+     * <code>[begin, end)</code> using only the supplied engine. It is
+     * called concurrently from several threads and must not throw.
+     *
+     * @tparam F type of functor
+     * @param N number of draws
+     * @param rng engine, advanced past the draws on return
+     * @param num_threads maximum number of threads to use
+     * @param f functor generating a chunk of draws
+     */
+    template <class F>
+    inline void parallel_rng_fill(size_t N, philox_engine& rng,
+                                  int num_threads, const F& f) {
+      size_t num_chunks = (N + RNG_CHUNK_SIZE - 1) / RNG_CHUNK_SIZE;
+      size_t num_workers
+        = std::max<size_t>(1, std::min<size_t>(num_threads, num_chunks));
+      internal::rng_chunk_worker<F> worker(f, rng, N, num_chunks,
+                                           num_workers);
+
+      std::vector<std::thread> threads;
+      threads.reserve(num_workers - 1);
+      for (size_t t = 1; t < num_workers; ++t)
+        threads.push_back(std::thread(worker, t));
+      worker(0);
+      for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+      rng.discard(num_chunks * RNG_CHUNK_STRIDE);
+    }
+
+  }
+}
+#endif
@@ -17,6 +17,8 @@
 #include <stan/math/prim/mat/meta/seq_view.hpp>
 #include <stan/math/prim/mat/meta/scalar_type.hpp>
 #include <stan/math/prim/mat/meta/value_type.hpp>
+#include <stan/math/prim/mat/meta/mapped_matrix.hpp>
+#include <stan/math/prim/mat/meta/validated_data.hpp>
 #include <stan/math/prim/mat/meta/vector_seq_view.hpp>
 
 #include <stan/math/prim/mat/err/check_cholesky_factor.hpp>
@@ -57,7 +59,9 @@
 #include <stan/math/prim/mat/fun/atan.hpp>
 #include <stan/math/prim/mat/fun/atanh.hpp>
 #include <stan/math/prim/mat/fun/autocorrelation.hpp>
+#include <stan/math/prim/mat/fun/autocorrelation_batch.hpp>
 #include <stan/math/prim/mat/fun/autocovariance.hpp>
+#include <stan/math/prim/mat/fun/autocovariance_batch.hpp>
 #include <stan/math/prim/mat/fun/block.hpp>
 #include <stan/math/prim/mat/fun/cbrt.hpp>
 #include <stan/math/prim/mat/fun/ceil.hpp>
@@ -71,6 +75,8 @@
 #include <stan/math/prim/mat/fun/cols.hpp>
 #include <stan/math/prim/mat/fun/columns_dot_product.hpp>
 #include <stan/math/prim/mat/fun/columns_dot_self.hpp>
+#include <stan/math/prim/mat/fun/columns_log_mix.hpp>
+#include <stan/math/prim/mat/fun/columns_log_sum_exp.hpp>
 #include <stan/math/prim/mat/fun/common_type.hpp>
 #include <stan/math/prim/mat/fun/corr_matrix_constrain.hpp>
 #include <stan/math/prim/mat/fun/corr_matrix_free.hpp>
@@ -143,6 +149,7 @@
 #include <stan/math/prim/mat/fun/log_determinant_spd.hpp>
 #include <stan/math/prim/mat/fun/log_inv_logit.hpp>
 #include <stan/math/prim/mat/fun/log_softmax.hpp>
+#include <stan/math/prim/mat/fun/mapped_matrix.hpp>
 #include <stan/math/prim/mat/fun/log_sum_exp.hpp>
 #include <stan/math/prim/mat/fun/logit.hpp>
 #include <stan/math/prim/mat/fun/make_nu.hpp>
@@ -194,6 +201,8 @@
 #include <stan/math/prim/mat/fun/rows.hpp>
 #include <stan/math/prim/mat/fun/rows_dot_product.hpp>
 #include <stan/math/prim/mat/fun/rows_dot_self.hpp>
+#include <stan/math/prim/mat/fun/rows_log_mix.hpp>
+#include <stan/math/prim/mat/fun/rows_log_sum_exp.hpp>
 #include <stan/math/prim/mat/fun/sd.hpp>
 #include <stan/math/prim/mat/fun/segment.hpp>
 #include <stan/math/prim/mat/fun/simplex_constrain.hpp>
@@ -215,6 +224,7 @@
 #include <stan/math/prim/mat/fun/subtract.hpp>
 #include <stan/math/prim/mat/fun/sub_col.hpp>
 #include <stan/math/prim/mat/fun/sub_row.hpp>
+#include <stan/math/prim/mat/fun/sufficient_stats.hpp>
 #include <stan/math/prim/mat/fun/sum.hpp>
 #include <stan/math/prim/mat/fun/tail.hpp>
 #include <stan/math/prim/mat/fun/tan.hpp>
@@ -237,19 +247,24 @@
 #include <stan/math/prim/mat/fun/typedefs.hpp>
 #include <stan/math/prim/mat/fun/unit_vector_constrain.hpp>
 #include <stan/math/prim/mat/fun/unit_vector_free.hpp>
+#include <stan/math/prim/mat/fun/validated_data.hpp>
 #include <stan/math/prim/mat/fun/value_of.hpp>
 #include <stan/math/prim/mat/fun/value_of_rec.hpp>
+#include <stan/math/prim/mat/fun/value_of_rows.hpp>
 #include <stan/math/prim/mat/fun/variance.hpp>
 #include <stan/math/prim/mat/fun/welford_covar_estimator.hpp>
 #include <stan/math/prim/mat/fun/welford_var_estimator.hpp>
 
 #include <stan/math/prim/mat/functor/finite_diff_gradient.hpp>
 #include <stan/math/prim/mat/functor/finite_diff_hessian.hpp>
+#include <stan/math/prim/mat/functor/glm_tile_sweep.hpp>
 
 #include <stan/math/prim/mat/prob/bernoulli_logit_glm_lpmf.hpp>
+#include <stan/math/prim/mat/prob/bernoulli_logit_sufficient_lpmf.hpp>
 #include <stan/math/prim/mat/prob/categorical_log.hpp>
 #include <stan/math/prim/mat/prob/categorical_lpmf.hpp>
 #include <stan/math/prim/mat/prob/categorical_logit_log.hpp>
+#include <stan/math/prim/mat/prob/categorical_logit_glm_lpmf.hpp>
 #include <stan/math/prim/mat/prob/categorical_logit_lpmf.hpp>
 #include <stan/math/prim/mat/prob/categorical_rng.hpp>
 #include <stan/math/prim/mat/prob/categorical_logit_rng.hpp>
@@ -258,6 +273,7 @@
 #include <stan/math/prim/mat/prob/dirichlet_rng.hpp>
 #include <stan/math/prim/mat/prob/gaussian_dlm_obs_log.hpp>
 #include <stan/math/prim/mat/prob/gaussian_dlm_obs_lpdf.hpp>
+#include <stan/math/prim/mat/prob/hmm_marginal.hpp>
 #include <stan/math/prim/mat/prob/inv_wishart_log.hpp>
 #include <stan/math/prim/mat/prob/inv_wishart_lpdf.hpp>
 #include <stan/math/prim/mat/prob/inv_wishart_rng.hpp>
@@ -291,10 +307,15 @@
 #include <stan/math/prim/mat/prob/multinomial_rng.hpp>
 #include <stan/math/prim/mat/prob/neg_binomial_2_log_glm_lpmf.hpp>
 #include <stan/math/prim/mat/prob/normal_id_glm_lpdf.hpp>
+#include <stan/math/prim/mat/prob/normal_rng.hpp>
+#include <stan/math/prim/mat/prob/normal_sufficient_lpdf.hpp>
 #include <stan/math/prim/mat/prob/ordered_logistic_log.hpp>
 #include <stan/math/prim/mat/prob/ordered_logistic_lpmf.hpp>
 #include <stan/math/prim/mat/prob/ordered_logistic_rng.hpp>
 #include <stan/math/prim/mat/prob/poisson_log_glm_lpmf.hpp>
+#include <stan/math/prim/mat/prob/poisson_log_sufficient_lpmf.hpp>
+#include <stan/math/prim/mat/prob/poisson_rng.hpp>
+#include <stan/math/prim/mat/prob/poisson_sufficient_lpmf.hpp>
 #include <stan/math/prim/mat/prob/ordered_probit_log.hpp>
 #include <stan/math/prim/mat/prob/ordered_probit_lpmf.hpp>
 #include <stan/math/prim/mat/prob/ordered_probit_rng.hpp>
@@ -0,0 +1,64 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_AUTOCORRELATION_BATCH_HPP
+#define STAN_MATH_PRIM_MAT_FUN_AUTOCORRELATION_BATCH_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/autocovariance_batch.hpp>
+#include <unsupported/Eigen/FFT>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Write autocorrelation estimates for every lag for each column
+     * of the specified matrix, holding one input sequence per column,
+     * into the columns of the specified result using the specified
+     * FFT engine. The result is resized to the size of the input,
+     * with lags given by row index.
+     *
+     * <p>The autocovariances are calculated as by
+     * <code>autocovariance_batch()</code>, which describes the reuse
+     * of the FFT engine, and normalized by the variance.
+     *
+     * @tparam T Scalar type.
+     * @tparam D Type of input matrix.
+     * @param y Input sequences, one per column.
+     * @param ac Autocorrelations, one column per input sequence.
+     * @param fft FFT engine instance.
+     */
+    template <typename T, typename D>
+    void autocorrelation_batch(const Eigen::MatrixBase<D>& y,
+                               Eigen::Matrix<T, Eigen::Dynamic,
+                                             Eigen::Dynamic>& ac,
+                               Eigen::FFT<T>& fft) {
+      autocovariance_batch(y, ac, fft);
+      for (int k = 0; k < ac.cols(); ++k) {
+        T var = ac(0, k);
+        ac.col(k) /= var;
+      }
+    }
+
+    /**
+     * Write autocorrelation estimates for every lag for each column
+     * of the specified matrix, holding one input sequence per column,
+     * into the columns of the specified result. The result is resized
+     * to the size of the input, with lags given by row index.
+     *
+     * <p>This method is just a light wrapper around the three-argument
+     * autocorrelation_batch function
+     *
+     * @tparam T Scalar type.
+     * @tparam D Type of input matrix.
+     * @param y Input sequences, one per column.
+     * @param ac Autocorrelations, one column per input sequence.
+     */
+    template <typename T, typename D>
+    void autocorrelation_batch(const Eigen::MatrixBase<D>& y,
+                               Eigen::Matrix<T, Eigen::Dynamic,
+                                             Eigen::Dynamic>& ac) {
+      Eigen::FFT<T> fft;
+      autocorrelation_batch(y, ac, fft);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,98 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_AUTOCOVARIANCE_BATCH_HPP
+#define STAN_MATH_PRIM_MAT_FUN_AUTOCOVARIANCE_BATCH_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/autocorrelation.hpp>
+#include <unsupported/Eigen/FFT>
+#include <complex>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Write autocovariance estimates for every lag for each column
+     * of the specified matrix, holding one input sequence per column,
+     * into the columns of the specified result using the specified
+     * FFT engine. The result is resized to the size of the input,
+     * with lags given by row index.
+     *
+     * <p>Each column is transformed as by
+     * <code>autocovariance()</code>, but with real-to-complex
+     * transforms of half the spectrum, and with the buffers and the
+     * FFT plan for the padded length shared by all columns. Reusing
+     * the engine across calls with sequences of the same length
+     * reuses its plan. An engine must not be used by more than one
+     * thread at a time.
+     *
+     * <p>The input may be any Eigen expression, such as an
+     * <code>Eigen::Map</code> of draws from a memory-mapped file, in
+     * which case the columns are read in place, one at a time.
+     *
+     * @tparam T Scalar type.
+     * @tparam D Type of input matrix.
+     * @param y Input sequences, one per column.
+     * @param acov Autocovariances, one column per input sequence.
+     * @param fft FFT engine instance.
+     */
+    template <typename T, typename D>
+    void autocovariance_batch(const Eigen::MatrixBase<D>& y,
+                              Eigen::Matrix<T, Eigen::Dynamic,
+                                            Eigen::Dynamic>& acov,
+                              Eigen::FFT<T>& fft) {
+      using std::complex;
+      using std::vector;
+
+      size_t N = y.rows();
+      acov.resize(y.rows(), y.cols());
+      if (N == 0)
+        return;
+      size_t Mt2 = 2 * fft_next_good_size(N);
+
+      bool half_spectrum = fft.HasFlag(Eigen::FFT<T>::HalfSpectrum);
+      fft.SetFlag(Eigen::FFT<T>::HalfSpectrum);
+      vector<T> centered_signal(Mt2, 0.0);
+      vector<complex<T> > freqvec(Mt2 / 2 + 1);
+      vector<T> ac(Mt2);
+      for (int k = 0; k < y.cols(); ++k) {
+        T mean = y.col(k).mean();
+        for (size_t i = 0; i < N; ++i)
+          centered_signal[i] = y(i, k) - mean;
+
+        fft.fwd(&freqvec[0], &centered_signal[0], Mt2);
+        for (size_t i = 0; i < freqvec.size(); ++i)
+          freqvec[i] = complex<T>(norm(freqvec[i]), 0.0);
+        fft.inv(&ac[0], &freqvec[0], Mt2);
+
+        for (size_t i = 0; i < N; ++i)
+          acov(i, k) = ac[i] / (N - i);
+      }
+      if (!half_spectrum)
+        fft.ClearFlag(Eigen::FFT<T>::HalfSpectrum);
+    }
+
+    /**
+     * Write autocovariance estimates for every lag for each column
+     * of the specified matrix, holding one input sequence per column,
+     * into the columns of the specified result. The result is resized
+     * to the size of the input, with lags given by row index.
+     *
+     * <p>This method is just a light wrapper around the three-argument
+     * autocovariance_batch function
+     *
+     * @tparam T Scalar type.
+     * @tparam D Type of input matrix.
+     * @param y Input sequences, one per column.
+     * @param acov Autocovariances, one column per input sequence.
+     */
+    template <typename T, typename D>
+    void autocovariance_batch(const Eigen::MatrixBase<D>& y,
+                              Eigen::Matrix<T, Eigen::Dynamic,
+                                            Eigen::Dynamic>& acov) {
+      Eigen::FFT<T> fft;
+      autocovariance_batch(y, acov, fft);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,33 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_COLUMNS_LOG_SUM_EXP_HPP
+#define STAN_MATH_PRIM_MAT_FUN_COLUMNS_LOG_SUM_EXP_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/log_sum_exp.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Return the log of the sum of the exponentiated values of each
+     * column of the specified matrix.
+     *
+     * @tparam T scalar type
+     * @param[in] x Matrix.
+     * @return Row vector of the log sums of exponentials of the
+     * columns.
+     */
+    template <typename T, int R, int C>
+    inline Eigen::Matrix<T, 1, C>
+    columns_log_sum_exp(const Eigen::Matrix<T, R, C>& x) {
+      Eigen::Matrix<T, 1, C> ret(x.cols());
+      Eigen::Matrix<T, R, 1> col(x.rows());
+      for (int j = 0; j < x.cols(); ++j) {
+        col = x.col(j);
+        ret(j) = log_sum_exp(col);
+      }
+      return ret;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,440 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_MAPPED_MATRIX_HPP
+#define STAN_MATH_PRIM_MAT_FUN_MAPPED_MATRIX_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/meta/broadcast_array.hpp>
+#include <stan/math/prim/mat/meta/mapped_matrix.hpp>
+#include <stan/math/prim/scal/err/domain_error.hpp>
+#include <stan/math/prim/scal/err/invalid_argument.hpp>
+#include <stan/math/prim/scal/meta/error_index.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Size in bytes of the header of a file read by
+     * <code>mapped_matrix</code>. The header holds the null
+     * terminated string <code>"STANMAT"</code>, a 32-bit format
+     * version, 32-bit flags whose lowest bit is set if the values are
+     * stored in row-major order, and the 64-bit numbers of rows and
+     * columns, all in native byte order. The values follow as
+     * doubles.
+     */
+    const size_t MAPPED_MATRIX_HEADER_NBYTES = 32;
+
+    /**
+     * Version of the format of the files read by
+     * <code>mapped_matrix</code>.
+     */
+    const boost::uint32_t MAPPED_MATRIX_VERSION = 1;
+
+    /**
+     * A read-only matrix of doubles backed by a memory-mapped binary
+     * file (see <code>MAPPED_MATRIX_HEADER_NBYTES</code> and
+     * <code>write_mapped_matrix()</code> for the format), for design
+     * matrices that are larger than memory.
+     *
+     * <p>The GLM densities accept it as their design matrix. They
+     * read it in tiles of rows through <code>value_of_rows()</code>,
+     * which copies a tile out of the mapping, asks the system to read
+     * the following rows ahead and releases the pages of the tile, so
+     * a gradient streams the file once. Besides the tiles and the
+     * read-ahead, at most one page per column stays resident in
+     * column-major order, and one page in row-major order, whatever
+     * the number of rows.
+     *
+     * <p>The values are scanned once when the file is opened, so
+     * <code>check_finite()</code> is a constant-time test on every
+     * later call. On systems without <code>mmap</code> the values are
+     * read into memory instead.
+     */
+    class mapped_matrix {
+    public:
+      typedef Eigen::Map<const Eigen::MatrixXd, 0,
+                         Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic> >
+        map_t;
+
+      /**
+       * Open the specified matrix file and scan its values.
+       *
+       * @param path path of the file
+       * @throw std::invalid_argument if the file is not a matrix file,
+       * its size does not match its dimensions or it has more than
+       * <code>INT_MAX</code> rows or columns
+       * @throw std::runtime_error if the file cannot be read or
+       * mapped
+       */
+      explicit mapped_matrix(const std::string& path)
+        : base_(0), nbytes_(0), data_(0), rows_(0), cols_(0),
+          row_major_(false), finite_(true), page_nbytes_(4096) {
+        static const char* function = "mapped_matrix";
+        std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+        if (!in)
+          throw std::runtime_error(std::string(function)
+                                   + ": could not open file " + path);
+        size_t file_nbytes = in.tellg();
+        char header[MAPPED_MATRIX_HEADER_NBYTES];
+        in.seekg(0);
+        if (file_nbytes < MAPPED_MATRIX_HEADER_NBYTES
+            || !in.read(header, MAPPED_MATRIX_HEADER_NBYTES)
+            || std::strncmp(header, "STANMAT", 8) != 0)
+          invalid_argument(function, "file", path, "",
+                           " is not a matrix file");
+        boost::uint32_t version;
+        boost::uint32_t flags;
+        boost::uint64_t rows;
+        boost::uint64_t cols;
+        std::memcpy(&version, header + 8, sizeof(version));
+        std::memcpy(&flags, header + 12, sizeof(flags));
+        std::memcpy(&rows, header + 16, sizeof(rows));
+        std::memcpy(&cols, header + 24, sizeof(cols));
+        if (version != MAPPED_MATRIX_VERSION)
+          invalid_argument(function, "version of file", version, "",
+                           " is not supported");
+        const boost::uint64_t max_dim = std::numeric_limits<int>::max();
+        if (rows > max_dim || cols > max_dim)
+          invalid_argument(function, "dimensions of file", path, "",
+                           " are too large");
+        if ((rows > 0
+             && cols > (std::numeric_limits<size_t>::max()
+                        - MAPPED_MATRIX_HEADER_NBYTES)
+                       / sizeof(double) / rows)
+            || file_nbytes != MAPPED_MATRIX_HEADER_NBYTES
+                              + rows * cols * sizeof(double))
+          invalid_argument(function, "file", path, "",
+                           " does not match its dimensions");
+        rows_ = rows;
+        cols_ = cols;
+        row_major_ = flags & 1;
+        nbytes_ = file_nbytes;
+
+#if defined(__linux__) || defined(__APPLE__)
+        page_nbytes_ = sysconf(_SC_PAGESIZE);
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+          throw std::runtime_error(std::string(function)
+                                   + ": could not open file " + path);
+        void* p = mmap(0, nbytes_, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED)
+          throw std::runtime_error(std::string(function)
+                                   + ": could not map file " + path);
+        base_ = static_cast<char*>(p);
+        madvise(base_, nbytes_, MADV_SEQUENTIAL);
+        data_ = reinterpret_cast<const double*>(
+            base_ + MAPPED_MATRIX_HEADER_NBYTES);
+#else
+        values_.resize(rows_ * cols_);
+        if (!in.read(reinterpret_cast<char*>(values_.data()),
+                     values_.size() * sizeof(double)))
+          throw std::runtime_error(std::string(function)
+                                   + ": could not read file " + path);
+        data_ = values_.data();
+#endif
+
+        // the scan releases the pages it has read, like the tiles
+        const size_t chunk = 1 << 17;
+        for (size_t k = 0; k < size(); k += chunk) {
+          size_t n = std::min(chunk, size() - k);
+          for (size_t i = 0; i < n; ++i)
+            if (!(boost::math::isfinite)(data_[k + i]))
+              finite_ = false;
+          release(data_ + k, n);
+        }
+      }
+
+      ~mapped_matrix() {
+#if defined(__linux__) || defined(__APPLE__)
+        if (base_)
+          munmap(base_, nbytes_);
+#endif
+      }
+
+      /**
+       * Return the number of rows.
+       *
+       * @return number of rows
+       */
+      Eigen::Index rows() const { return rows_; }
+
+      /**
+       * Return the number of columns.
+       *
+       * @return number of columns
+       */
+      Eigen::Index cols() const { return cols_; }
+
+      /**
+       * Return the number of values.
+       *
+       * @return number of values
+       */
+      size_t size() const { return rows_ * cols_; }
+
+      /**
+       * Return <code>true</code> if the values are stored in
+       * row-major order.
+       *
+       * @return whether the storage is row-major
+       */
+      bool row_major() const { return row_major_; }
+
+      /**
+       * Return <code>true</code> if every value is finite.
+       *
+       * @return <code>true</code> if all values are finite
+       */
+      bool finite() const { return finite_; }
+
+      /**
+       * Return a map of the values, without copying them.
+       *
+       * @return map of the values
+       */
+      map_t values() const {
+        typedef Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic> stride_t;
+        return map_t(data_, rows_, cols_,
+                     row_major_ ? stride_t(1, cols_) : stride_t(rows_, 1));
+      }
+
+      /**
+       * Return the specified value.
+       *
+       * @param i row index
+       * @param j column index
+       * @return value
+       */
+      double operator()(size_t i, size_t j) const {
+        return row_major_ ? data_[i * cols_ + j] : data_[i + j * rows_];
+      }
+
+      /**
+       * Return the specified column.
+       *
+       * @param j column index
+       * @return column expression
+       */
+      map_t::ColXpr col(Eigen::Index j) const { return values().col(j); }
+
+      /**
+       * Return the specified row.
+       *
+       * @param i row index
+       * @return row expression
+       */
+      map_t::RowXpr row(Eigen::Index i) const { return values().row(i); }
+
+      /**
+       * Copy a block of consecutive rows into the specified buffer.
+       * The system is advised to read the following rows ahead, and
+       * the pages of the copied rows are released, except those they
+       * share with the following rows.
+       *
+       * @param[in] begin first row
+       * @param[in] rows number of rows
+       * @param[out] buffer values of the rows
+       */
+      void read_rows(size_t begin, size_t rows,
+                     Eigen::MatrixXd& buffer) const {
+        buffer.resize(rows, cols_);
+        if (rows == 0 || cols_ == 0)
+          return;
+        size_t ahead = std::min(rows, rows_ - begin - rows);
+        if (row_major_) {
+          const double* p = data_ + begin * cols_;
+          will_need(p + rows * cols_, ahead * cols_);
+          buffer = Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic,
+                                                  Eigen::Dynamic,
+                                                  Eigen::RowMajor> >(
+              p, rows, cols_);
+          release(p, rows * cols_);
+        } else {
+          for (size_t j = 0; j < cols_; ++j) {
+            const double* p = data_ + j * rows_ + begin;
+            will_need(p + rows, ahead);
+            buffer.col(j) = Eigen::Map<const Eigen::VectorXd>(p, rows);
+            release(p, rows);
+          }
+        }
+      }
+
+    private:
+      char* base_;
+      size_t nbytes_;
+      const double* data_;
+      size_t rows_;
+      size_t cols_;
+      bool row_major_;
+      bool finite_;
+      size_t page_nbytes_;
+      std::vector<double> values_;
+
+      mapped_matrix(const mapped_matrix&);
+      mapped_matrix& operator=(const mapped_matrix&);
+
+      /**
+       * Advise the system that the specified values will be read
+       * soon.
+       *
+       * @param p first value
+       * @param n number of values
+       */
+      void will_need(const double* p, size_t n) const {
+#if defined(__linux__) || defined(__APPLE__)
+        if (!base_ || n == 0)
+          return;
+        size_t begin = reinterpret_cast<const char*>(p) - base_;
+        size_t end = begin + n * sizeof(double);
+        begin -= begin % page_nbytes_;
+        madvise(base_ + begin, end - begin, MADV_WILLNEED);
+#endif
+      }
+
+      /**
+       * Release the pages from the one holding the first of the
+       * specified values up to the last one ending within them. The
+       * page holding the end of the values is kept for the following
+       * rows, and is released when they have been read, so segments
+       * shorter than a page, as in the columns of a tile of a wide
+       * column-major matrix, are released as the sweep goes past
+       * them. Released pages are read from the file again if they are
+       * used later.
+       *
+       * @param p first value
+       * @param n number of values
+       */
+      void release(const double* p, size_t n) const {
+#if defined(__linux__) || defined(__APPLE__)
+        if (!base_)
+          return;
+        size_t begin = reinterpret_cast<const char*>(p) - base_;
+        size_t end = begin + n * sizeof(double);
+        begin -= begin % page_nbytes_;
+        end -= end % page_nbytes_;
+        if (begin < end)
+          madvise(base_ + begin, end - begin, MADV_DONTNEED);
+#endif
+      }
+    };
+
+    /**
+     * Write the specified matrix to a file that can be opened as a
+     * <code>mapped_matrix</code>.
+     *
+     * @param path path of the file
+     * @param x matrix
+     * @param row_major whether to store the values in row-major order
+     * @throw std::runtime_error if the file cannot be written
+     */
+    inline void write_mapped_matrix(const std::string& path,
+                                    const Eigen::MatrixXd& x,
+                                    bool row_major = false) {
+      std::ofstream out(path.c_str(), std::ios::binary);
+      char header[MAPPED_MATRIX_HEADER_NBYTES] = { 0 };
+      boost::uint32_t version = MAPPED_MATRIX_VERSION;
+      boost::uint32_t flags = row_major ? 1 : 0;
+      boost::uint64_t rows = x.rows();
+      boost::uint64_t cols = x.cols();
+      std::memcpy(header, "STANMAT", 8);
+      std::memcpy(header + 8, &version, sizeof(version));
+      std::memcpy(header + 12, &flags, sizeof(flags));
+      std::memcpy(header + 16, &rows, sizeof(rows));
+      std::memcpy(header + 24, &cols, sizeof(cols));
+      out.write(header, MAPPED_MATRIX_HEADER_NBYTES);
+      if (row_major) {
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+          x_row_major = x;
+        out.write(reinterpret_cast<const char*>(x_row_major.data()),
+                  x.size() * sizeof(double));
+      } else {
+        out.write(reinterpret_cast<const char*>(x.data()),
+                  x.size() * sizeof(double));
+      }
+      if (!out)
+        throw std::runtime_error("write_mapped_matrix: could not write file "
+                                 + path);
+    }
+
+    /**
+     * Return the values of a block of consecutive rows of a mapped
+     * matrix, copied into the specified buffer as they are streamed
+     * from the file.
+     *
+     * @param[in] x mapped matrix
+     * @param[in] begin first row
+     * @param[in] rows number of rows
+     * @param[in, out] buffer storage for the values
+     * @return values of the rows
+     */
+    inline Eigen::Map<const Eigen::MatrixXd, 0, Eigen::OuterStride<> >
+    value_of_rows(const mapped_matrix& x, size_t begin, size_t rows,
+                  Eigen::MatrixXd& buffer) {
+      x.read_rows(begin, rows, buffer);
+      return Eigen::Map<const Eigen::MatrixXd, 0, Eigen::OuterStride<> >(
+          buffer.data(), rows, x.cols(), Eigen::OuterStride<>(rows));
+    }
+
+    /**
+     * Check that a mapped matrix is finite. The values were scanned
+     * when the file was opened, so they are only read again to report
+     * a value that is not finite.
+     *
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Mapped matrix to check
+     * @throw <code>domain_error</code> if any value is infinite or NaN
+     */
+    inline void check_finite(const char* function, const char* name,
+                             const mapped_matrix& y) {
+      if (y.finite())
+        return;
+      for (Eigen::Index j = 0; j < y.cols(); ++j) {
+        for (Eigen::Index i = 0; i < y.rows(); ++i) {
+          if (!(boost::math::isfinite)(y(i, j))) {
+            std::ostringstream entry_name;
+            entry_name << name << "[" << stan::error_index::value + i
+                       << ", " << stan::error_index::value + j << "]";
+            domain_error(function, entry_name.str().c_str(), y(i, j),
+                         "is ", ", but must be finite!");
+          }
+        }
+      }
+    }
+
+    namespace internal {
+      /**
+       * A mapped matrix is never differentiated, so its partials are
+       * the empty partials of a matrix of doubles.
+       */
+      template <typename ViewElt>
+      class empty_broadcast_array<ViewElt, mapped_matrix>
+        : public empty_broadcast_array<ViewElt, Eigen::MatrixXd> {
+      public:
+        using empty_broadcast_array<ViewElt, Eigen::MatrixXd>::operator=;
+      };
+    }
+
+  }
+
+  inline size_t length(const math::mapped_matrix& x) {
+    return x.size();
+  }
+
+}
+#endif
@@ -0,0 +1,68 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_ROWS_LOG_MIX_HPP
+#define STAN_MATH_PRIM_MAT_FUN_ROWS_LOG_MIX_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/log_sum_exp.hpp>
+#include <stan/math/prim/mat/meta/is_vector_like.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/scal/err/check_bounded.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <boost/math/tools/promotion.hpp>
+#include <cmath>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Return the log mixture density of each row of the specified
+     * matrix of log densities, with the specified mixing proportions.
+     *
+     * <p>Row <code>n</code> of <code>lambda</code> holds the log
+     * densities of the components for the <code>n</code>-th
+     * observation, and the result is
+     *
+     * \f[
+     * \log \sum_{k=1}^K \theta_k \exp(\lambda_{n,k}).
+     * \f]
+     *
+     * @tparam T_theta type of mixing proportions
+     * @tparam T_lambda type of log densities
+     * @param[in] theta mixing proportions in [0, 1].
+     * @param[in] lambda log densities, one row per observation and
+     * one column per component.
+     * @return Vector of the log mixture densities of the rows.
+     * @throw std::domain_error if a mixing proportion is not in
+     * [0, 1] or a log density is NaN.
+     * @throw std::invalid_argument if the number of mixing
+     * proportions is not the number of columns of lambda.
+     */
+    template <typename T_theta, typename T_lambda, int R, int C>
+    inline Eigen::Matrix<typename boost::math::tools::promote_args
+                         <T_theta, T_lambda>::type, R, 1>
+    rows_log_mix(const Eigen::Matrix<T_theta, Eigen::Dynamic, 1>& theta,
+                 const Eigen::Matrix<T_lambda, R, C>& lambda) {
+      using std::log;
+      typedef typename boost::math::tools::promote_args<T_theta, T_lambda>
+        ::type T_return;
+      check_bounded("rows_log_mix", "theta", theta, 0, 1);
+      check_not_nan("rows_log_mix", "lambda", lambda);
+      check_size_match("rows_log_mix", "size of theta", theta.size(),
+                       "columns of lambda", lambda.cols());
+
+      Eigen::Matrix<T_theta, 1, Eigen::Dynamic> log_theta(theta.size());
+      for (int k = 0; k < theta.size(); ++k)
+        log_theta(k) = log(theta(k));
+      Eigen::Matrix<T_return, R, 1> ret(lambda.rows());
+      Eigen::Matrix<T_return, 1, C> row(lambda.cols());
+      for (int i = 0; i < lambda.rows(); ++i) {
+        for (int k = 0; k < lambda.cols(); ++k)
+          row(k) = log_theta(k) + lambda(i, k);
+        ret(i) = log_sum_exp(row);
+      }
+      return ret;
+    }
+
+  }
+}
+#endif
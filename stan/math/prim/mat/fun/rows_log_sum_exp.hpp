@@ -0,0 +1,32 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_ROWS_LOG_SUM_EXP_HPP
+#define STAN_MATH_PRIM_MAT_FUN_ROWS_LOG_SUM_EXP_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/log_sum_exp.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Return the log of the sum of the exponentiated values of each
+     * row of the specified matrix.
+     *
+     * @tparam T scalar type
+     * @param[in] x Matrix.
+     * @return Vector of the log sums of exponentials of the rows.
+     */
+    template <typename T, int R, int C>
+    inline Eigen::Matrix<T, R, 1>
+    rows_log_sum_exp(const Eigen::Matrix<T, R, C>& x) {
+      Eigen::Matrix<T, R, 1> ret(x.rows());
+      Eigen::Matrix<T, 1, C> row(x.cols());
+      for (int i = 0; i < x.rows(); ++i) {
+        row = x.row(i);
+        ret(i) = log_sum_exp(row);
+      }
+      return ret;
+    }
+
+  }
+}
+#endif
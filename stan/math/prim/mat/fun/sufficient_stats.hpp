@@ -0,0 +1,223 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_SUFFICIENT_STATS_HPP
+#define STAN_MATH_PRIM_MAT_FUN_SUFFICIENT_STATS_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/arr/meta/length.hpp>
+#include <stan/math/prim/scal/err/check_bounded.hpp>
+#include <stan/math/prim/scal/err/check_consistent_size.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/fun/is_nan.hpp>
+#include <stan/math/prim/scal/fun/lgamma.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Data-only summaries of a (possibly grouped) sequence of
+     * observations, computed once so that likelihoods with one
+     * parameter per group can be evaluated in time proportional to
+     * the number of groups rather than the number of observations.
+     *
+     * <p>For each group this stores the number of observations, the
+     * sum and mean of the observations, the sum of squared
+     * deviations from the group mean and the sum of
+     * <code>lgamma(y + 1)</code>. These are the sufficient
+     * statistics of the normal, Poisson and Bernoulli likelihoods,
+     * plus the data-only normalizing term of the Poisson likelihood.
+     * The minimum and maximum observation and the first observation
+     * that is not an integer are also kept so that likelihoods can
+     * check the support of the data in constant time.
+     *
+     * <p>See <code>normal_sufficient_lpdf</code>,
+     * <code>poisson_sufficient_lpmf</code>,
+     * <code>poisson_log_sufficient_lpmf</code> and
+     * <code>bernoulli_logit_sufficient_lpmf</code>.
+     */
+    class sufficient_stats {
+    public:
+      /**
+       * Construct the summaries of a single group of observations.
+       *
+       * @tparam T_y type of observations; a standard vector or an
+       * Eigen vector of integers or doubles
+       * @param y observations
+       * @throw std::domain_error if any observation is not finite
+       */
+      template <typename T_y>
+      explicit sufficient_stats(const T_y& y) {
+        std::vector<int> group(length(y), 1);
+        init(y, group, 1);
+      }
+
+      /**
+       * Construct the summaries of observations partitioned into
+       * groups. Group indexes start at 1.
+       *
+       * @tparam T_y type of observations; a standard vector or an
+       * Eigen vector of integers or doubles
+       * @param y observations
+       * @param group group index of each observation
+       * @param num_groups number of groups
+       * @throw std::domain_error if any observation is not finite,
+       * if the number of groups is not positive, or if a group index
+       * is out of range
+       * @throw std::invalid_argument if the sizes of y and group do
+       * not match
+       */
+      template <typename T_y>
+      sufficient_stats(const T_y& y, const std::vector<int>& group,
+                       int num_groups) {
+        init(y, group, num_groups);
+      }
+
+      /**
+       * Return the number of groups.
+       *
+       * @return number of groups
+       */
+      int num_groups() const { return count_.size(); }
+
+      /**
+       * Return the total number of observations.
+       *
+       * @return number of observations
+       */
+      int num_obs() const { return num_obs_; }
+
+      /**
+       * Return the number of observations in each group.
+       *
+       * @return observation counts
+       */
+      const Eigen::VectorXd& count() const { return count_; }
+
+      /**
+       * Return the sum of the observations in each group.
+       *
+       * @return sums
+       */
+      const Eigen::VectorXd& sum() const { return sum_; }
+
+      /**
+       * Return the mean of the observations in each group. The mean
+       * of an empty group is zero.
+       *
+       * @return means
+       */
+      const Eigen::VectorXd& mean() const { return mean_; }
+
+      /**
+       * Return the sum of squared deviations from the group mean of
+       * the observations in each group.
+       *
+       * @return sums of squared deviations
+       */
+      const Eigen::VectorXd& sum_sq_dev() const { return sum_sq_dev_; }
+
+      /**
+       * Return the sum of <code>lgamma(y + 1)</code> over the
+       * observations in each group.
+       *
+       * @return sums of log factorials
+       */
+      const Eigen::VectorXd& sum_lgamma_p1() const {
+        return sum_lgamma_p1_;
+      }
+
+      /**
+       * Return the smallest observation, or positive infinity if
+       * there are none.
+       *
+       * @return minimum observation
+       */
+      double min() const { return min_; }
+
+      /**
+       * Return the largest observation, or negative infinity if there
+       * are none.
+       *
+       * @return maximum observation
+       */
+      double max() const { return max_; }
+
+      /**
+       * Return true if every observation is an integer.
+       *
+       * @return whether the observations are integers
+       */
+      bool integer_valued() const { return is_nan(non_integer_); }
+
+      /**
+       * Return the first observation that is not an integer, or NaN
+       * if every observation is an integer.
+       *
+       * @return first non-integer observation
+       */
+      double non_integer() const { return non_integer_; }
+
+    private:
+      int num_obs_;
+      Eigen::VectorXd count_;
+      Eigen::VectorXd sum_;
+      Eigen::VectorXd mean_;
+      Eigen::VectorXd sum_sq_dev_;
+      Eigen::VectorXd sum_lgamma_p1_;
+      double min_;
+      double max_;
+      double non_integer_;
+
+      template <typename T_y>
+      void init(const T_y& y, const std::vector<int>& group,
+                int num_groups) {
+        static const char* function = "sufficient_stats";
+        check_finite(function, "Observations", y);
+        check_positive(function, "Number of groups", num_groups);
+        check_consistent_size(function, "Group indexes", group, length(y));
+        check_bounded(function, "Group indexes", group, 1, num_groups);
+
+        scalar_seq_view<T_y> y_vec(y);
+        num_obs_ = length(y);
+        count_ = Eigen::VectorXd::Zero(num_groups);
+        sum_ = Eigen::VectorXd::Zero(num_groups);
+        sum_sq_dev_ = Eigen::VectorXd::Zero(num_groups);
+        sum_lgamma_p1_ = Eigen::VectorXd::Zero(num_groups);
+        min_ = std::numeric_limits<double>::infinity();
+        max_ = -std::numeric_limits<double>::infinity();
+        non_integer_ = std::numeric_limits<double>::quiet_NaN();
+
+        for (int n = 0; n < num_obs_; ++n) {
+          const double y_n = y_vec[n];
+          const int g = group[n] - 1;
+          count_[g] += 1;
+          sum_[g] += y_n;
+          sum_lgamma_p1_[g] += lgamma(y_n + 1.0);
+          if (y_n < min_)
+            min_ = y_n;
+          if (y_n > max_)
+            max_ = y_n;
+          if (y_n != std::floor(y_n) && is_nan(non_integer_))
+            non_integer_ = y_n;
+        }
+
+        mean_ = Eigen::VectorXd::Zero(num_groups);
+        for (int g = 0; g < num_groups; ++g)
+          if (count_[g] > 0)
+            mean_[g] = sum_[g] / count_[g];
+
+        for (int n = 0; n < num_obs_; ++n) {
+          const int g = group[n] - 1;
+          const double dev = y_vec[n] - mean_[g];
+          sum_sq_dev_[g] += dev * dev;
+        }
+      }
+    };
+
+  }
+}
+#endif
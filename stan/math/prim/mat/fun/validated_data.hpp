@@ -0,0 +1,449 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_VALIDATED_DATA_HPP
+#define STAN_MATH_PRIM_MAT_FUN_VALIDATED_DATA_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of_rows.hpp>
+#include <stan/math/prim/mat/meta/broadcast_array.hpp>
+#include <stan/math/prim/mat/meta/get.hpp>
+#include <stan/math/prim/mat/meta/is_vector_like.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/mat/meta/validated_data.hpp>
+#include <stan/math/prim/arr/meta/get.hpp>
+#include <stan/math/prim/arr/meta/length.hpp>
+#include <stan/math/prim/scal/meta/length.hpp>
+#include <stan/math/prim/scal/err/check_bounded.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_greater.hpp>
+#include <stan/math/prim/scal/err/check_greater_or_equal.hpp>
+#include <stan/math/prim/scal/err/check_less.hpp>
+#include <stan/math/prim/scal/err/check_less_or_equal.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/err/check_positive_finite.hpp>
+#include <stan/math/prim/scal/fun/value_of_rec.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <limits>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Wrapper for a data argument (a scalar, standard vector or Eigen
+     * matrix of <code>int</code> or <code>double</code>) that has
+     * been scanned once on construction.
+     *
+     * <p>The scan records whether the values contain NaN, whether
+     * they are all finite, and their minimum and maximum. The
+     * argument checks in <code>prim/scal/err</code> are overloaded
+     * for this type so that a density called with a
+     * <code>validated_data</code> argument replaces its
+     * <code>O(N)</code> checks on that argument with constant-time
+     * comparisons against the cached summary. The full check (and
+     * its error message) is only run when the summary indicates the
+     * check would fail, or when it compares against a container of
+     * bounds.
+     *
+     * <p>The wrapper holds its own copy of the data, so it can be
+     * constructed once (for instance when data is read) and passed
+     * to a density on every log density evaluation. Only data
+     * (constant) types may be wrapped; the summary would be stale
+     * for autodiff variables.
+     *
+     * @tparam T type of data being wrapped
+     */
+    template <typename T>
+    class validated_data {
+    public:
+      /**
+       * Construct a wrapper holding a copy of the specified data and
+       * summarize its values.
+       *
+       * @param x data to wrap
+       */
+      explicit validated_data(const T& x)
+        : x_(x), not_nan_(true), finite_(true),
+          min_(std::numeric_limits<double>::infinity()),
+          max_(-std::numeric_limits<double>::infinity()) {
+        using stan::get;
+        using stan::length;
+        for (size_t n = 0; n < length(x_); ++n) {
+          double x_n = value_of_rec(get(x_, n));
+          if ((boost::math::isnan)(x_n)) {
+            not_nan_ = false;
+            finite_ = false;
+            continue;
+          }
+          if (!(boost::math::isfinite)(x_n))
+            finite_ = false;
+          if (x_n < min_)
+            min_ = x_n;
+          if (x_n > max_)
+            max_ = x_n;
+        }
+      }
+
+      /**
+       * Return the wrapped data.
+       *
+       * @return wrapped data
+       */
+      const T& data() const { return x_; }
+
+      /**
+       * Return <code>true</code> if none of the values is NaN.
+       *
+       * @return <code>true</code> if no value is NaN
+       */
+      bool not_nan() const { return not_nan_; }
+
+      /**
+       * Return <code>true</code> if every value is finite.
+       *
+       * @return <code>true</code> if all values are finite
+       */
+      bool finite() const { return finite_; }
+
+      /**
+       * Return the smallest non-NaN value, or positive infinity if
+       * there are none.
+       *
+       * @return minimum value
+       */
+      double min() const { return min_; }
+
+      /**
+       * Return the largest non-NaN value, or negative infinity if
+       * there are none.
+       *
+       * @return maximum value
+       */
+      double max() const { return max_; }
+
+      /**
+       * Return the number of elements in the wrapped data.
+       *
+       * @return number of elements
+       */
+      size_t size() const {
+        using stan::length;
+        return length(x_);
+      }
+
+      /**
+       * Return the number of rows of a wrapped Eigen matrix.
+       *
+       * @return number of rows
+       */
+      int rows() const { return x_.rows(); }
+
+      /**
+       * Return the number of columns of a wrapped Eigen matrix.
+       *
+       * @return number of columns
+       */
+      int cols() const { return x_.cols(); }
+
+      /**
+       * Return the specified column of a wrapped Eigen matrix.
+       *
+       * @param j column index
+       * @return column expression
+       */
+      auto col(int j) const { return x_.col(j); }
+
+      /**
+       * Return the specified row of a wrapped Eigen matrix.
+       *
+       * @param i row index
+       * @return row expression
+       */
+      auto row(int i) const { return x_.row(i); }
+
+      /**
+       * Return the specified element of a wrapped vector.
+       *
+       * @param i index
+       * @return element
+       */
+      auto operator[](int i) const { return x_[i]; }
+
+    private:
+      T x_;
+      bool not_nan_;
+      bool finite_;
+      double min_;
+      double max_;
+    };
+
+    /**
+     * Return a wrapper for the specified data whose values have been
+     * summarized for constant-time argument checks.
+     *
+     * @tparam T type of data
+     * @param x data
+     * @return validated data wrapper
+     */
+    template <typename T>
+    inline validated_data<T> validate_data(const T& x) {
+      return validated_data<T>(x);
+    }
+
+    /**
+     * Return the wrapped data.
+     *
+     * @tparam T type of data
+     * @param x validated data wrapper
+     * @return wrapped data
+     */
+    template <typename T>
+    inline const T& value_of(const validated_data<T>& x) {
+      return x.data();
+    }
+
+    /**
+     * Return the values of a block of consecutive rows of a wrapped
+     * Eigen matrix.
+     *
+     * @tparam T type of data
+     * @tparam T_buffer type of values
+     * @param[in] x validated data wrapper
+     * @param[in] begin first row
+     * @param[in] rows number of rows
+     * @param[in, out] buffer storage for the values, if they are
+     * copied
+     * @return values of the rows
+     */
+    template <typename T, typename T_buffer>
+    inline Eigen::Map<const Eigen::Matrix<T_buffer, Eigen::Dynamic,
+                                          Eigen::Dynamic>,
+                      0, Eigen::OuterStride<> >
+    value_of_rows(const validated_data<T>& x, size_t begin, size_t rows,
+                  Eigen::Matrix<T_buffer, Eigen::Dynamic, Eigen::Dynamic>&
+                  buffer) {
+      return value_of_rows(x.data(), begin, rows, buffer);
+    }
+
+    /**
+     * Check that validated data contains no NaN, running the full
+     * check only if the cached summary reports a NaN.
+     *
+     * @tparam T type of data
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @throw <code>domain_error</code> if any value is NaN
+     */
+    template <typename T>
+    inline void check_not_nan(const char* function, const char* name,
+                              const validated_data<T>& y) {
+      if (!y.not_nan())
+        check_not_nan(function, name, y.data());
+    }
+
+    /**
+     * Check that validated data is finite, running the full check
+     * only if the cached summary reports a non-finite value.
+     *
+     * @tparam T type of data
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @throw <code>domain_error</code> if any value is infinite or NaN
+     */
+    template <typename T>
+    inline void check_finite(const char* function, const char* name,
+                             const validated_data<T>& y) {
+      if (!y.finite())
+        check_finite(function, name, y.data());
+    }
+
+    /**
+     * Check that validated data is positive, running the full check
+     * only if the cached summary cannot establish it.
+     *
+     * @tparam T type of data
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @throw <code>domain_error</code> if any value is not positive
+     */
+    template <typename T>
+    inline void check_positive(const char* function, const char* name,
+                               const validated_data<T>& y) {
+      if (!(y.not_nan() && y.min() > 0))
+        check_positive(function, name, y.data());
+    }
+
+    /**
+     * Check that validated data is positive and finite, running the
+     * full check only if the cached summary cannot establish it.
+     *
+     * @tparam T type of data
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @throw <code>domain_error</code> if any value is not positive
+     *   or not finite
+     */
+    template <typename T>
+    inline void check_positive_finite(const char* function,
+                                      const char* name,
+                                      const validated_data<T>& y) {
+      if (!(y.finite() && y.min() > 0))
+        check_positive_finite(function, name, y.data());
+    }
+
+    /**
+     * Check that validated data is non-negative, running the full
+     * check only if the cached summary cannot establish it.
+     *
+     * @tparam T type of data
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @throw <code>domain_error</code> if any value is negative or NaN
+     */
+    template <typename T>
+    inline void check_nonnegative(const char* function, const char* name,
+                                  const validated_data<T>& y) {
+      if (!(y.not_nan() && y.min() >= 0))
+        check_nonnegative(function, name, y.data());
+    }
+
+    /**
+     * Check that validated data is greater than a bound. A scalar
+     * bound is compared against the cached minimum; container bounds
+     * fall back to the full check.
+     *
+     * @tparam T type of data
+     * @tparam T_low type of lower bound
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @param low Lower bound
+     * @throw <code>domain_error</code> if any value is not greater
+     *   than the bound
+     */
+    template <typename T, typename T_low>
+    inline void check_greater(const char* function, const char* name,
+                              const validated_data<T>& y,
+                              const T_low& low) {
+      if (is_vector_like<T_low>::value
+          || !(y.not_nan() && y.min() > value_of_rec(get(low, 0))))
+        check_greater(function, name, y.data(), low);
+    }
+
+    /**
+     * Check that validated data is greater than or equal to a
+     * bound. A scalar bound is compared against the cached minimum;
+     * container bounds fall back to the full check.
+     *
+     * @tparam T type of data
+     * @tparam T_low type of lower bound
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @param low Lower bound
+     * @throw <code>domain_error</code> if any value is less than
+     *   the bound
+     */
+    template <typename T, typename T_low>
+    inline void check_greater_or_equal(const char* function,
+                                       const char* name,
+                                       const validated_data<T>& y,
+                                       const T_low& low) {
+      if (is_vector_like<T_low>::value
+          || !(y.not_nan() && y.min() >= value_of_rec(get(low, 0))))
+        check_greater_or_equal(function, name, y.data(), low);
+    }
+
+    /**
+     * Check that validated data is less than a bound. A scalar bound
+     * is compared against the cached maximum; container bounds fall
+     * back to the full check.
+     *
+     * @tparam T type of data
+     * @tparam T_high type of upper bound
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @param high Upper bound
+     * @throw <code>domain_error</code> if any value is not less than
+     *   the bound
+     */
+    template <typename T, typename T_high>
+    inline void check_less(const char* function, const char* name,
+                           const validated_data<T>& y,
+                           const T_high& high) {
+      if (is_vector_like<T_high>::value
+          || !(y.not_nan() && y.max() < value_of_rec(get(high, 0))))
+        check_less(function, name, y.data(), high);
+    }
+
+    /**
+     * Check that validated data is less than or equal to a bound. A
+     * scalar bound is compared against the cached maximum; container
+     * bounds fall back to the full check.
+     *
+     * @tparam T type of data
+     * @tparam T_high type of upper bound
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @param high Upper bound
+     * @throw <code>domain_error</code> if any value is greater than
+     *   the bound
+     */
+    template <typename T, typename T_high>
+    inline void check_less_or_equal(const char* function, const char* name,
+                                    const validated_data<T>& y,
+                                    const T_high& high) {
+      if (is_vector_like<T_high>::value
+          || !(y.not_nan() && y.max() <= value_of_rec(get(high, 0))))
+        check_less_or_equal(function, name, y.data(), high);
+    }
+
+    /**
+     * Check that validated data lies in a closed interval. Scalar
+     * bounds are compared against the cached minimum and maximum;
+     * container bounds fall back to the full check.
+     *
+     * @tparam T type of data
+     * @tparam T_low type of lower bound
+     * @tparam T_high type of upper bound
+     * @param function Function name (for error messages)
+     * @param name Variable name (for error messages)
+     * @param y Validated data to check
+     * @param low Lower bound
+     * @param high Upper bound
+     * @throw <code>domain_error</code> if any value is outside of
+     *   the interval
+     */
+    template <typename T, typename T_low, typename T_high>
+    inline void check_bounded(const char* function, const char* name,
+                              const validated_data<T>& y,
+                              const T_low& low, const T_high& high) {
+      if (is_vector_like<T_low>::value || is_vector_like<T_high>::value
+          || !(y.not_nan() && y.min() >= value_of_rec(get(low, 0))
+               && y.max() <= value_of_rec(get(high, 0))))
+        check_bounded(function, name, y.data(), low, high);
+    }
+
+    namespace internal {
+      /**
+       * Validated data is never differentiated, so its partials are
+       * the empty partials of the wrapped type.
+       */
+      template <typename ViewElt, typename T>
+      class empty_broadcast_array<ViewElt, validated_data<T> >
+        : public empty_broadcast_array<ViewElt, T> {
+      public:
+        using empty_broadcast_array<ViewElt, T>::operator=;
+      };
+    }
+
+  }
+
+}
+#endif
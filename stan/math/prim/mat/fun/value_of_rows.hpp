@@ -0,0 +1,61 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_VALUE_OF_ROWS_HPP
+#define STAN_MATH_PRIM_MAT_FUN_VALUE_OF_ROWS_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <cstddef>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Return the values of a block of consecutive rows of the
+     * specified matrix, copied into the specified buffer.
+     *
+     * <p>The result is a map of the buffer, so it is only valid until
+     * the buffer is modified or destroyed.
+     *
+     * @tparam T_x type of matrix
+     * @tparam T type of values
+     * @param[in] x matrix
+     * @param[in] begin first row
+     * @param[in] rows number of rows
+     * @param[in, out] buffer storage for the values
+     * @return values of the rows
+     */
+    template <typename T_x, typename T>
+    inline Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>,
+                      0, Eigen::OuterStride<> >
+    value_of_rows(const T_x& x, size_t begin, size_t rows,
+                  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& buffer) {
+      buffer.resize(rows, x.cols());
+      for (int j = 0; j < x.cols(); ++j)
+        for (size_t i = 0; i < rows; ++i)
+          buffer(i, j) = value_of(x(begin + i, j));
+      return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic,
+                                            Eigen::Dynamic>,
+                        0, Eigen::OuterStride<> >(
+          buffer.data(), rows, x.cols(), Eigen::OuterStride<>(rows));
+    }
+
+    /**
+     * Return the values of a block of consecutive rows of the
+     * specified matrix of doubles. The rows are mapped in place
+     * rather than copied.
+     *
+     * @param[in] x matrix
+     * @param[in] begin first row
+     * @param[in] rows number of rows
+     * @param[in, out] buffer not used
+     * @return values of the rows
+     */
+    inline Eigen::Map<const Eigen::MatrixXd, 0, Eigen::OuterStride<> >
+    value_of_rows(const Eigen::MatrixXd& x, size_t begin, size_t rows,
+                  Eigen::MatrixXd& buffer) {
+      return Eigen::Map<const Eigen::MatrixXd, 0, Eigen::OuterStride<> >(
+          x.data() + begin, rows, x.cols(), Eigen::OuterStride<>(x.rows()));
+    }
+
+  }
+}
+#endif
@@ -29,6 +29,21 @@ namespace stan {
         m2_ += (q - m_) * delta.transpose();
       }
 
+      void add_samples(const Eigen::MatrixXd& q) {
+        if (q.cols() == 0)
+          return;
+        Eigen::VectorXd mean = q.rowwise().mean();
+        Eigen::MatrixXd centered = q.colwise() - mean;
+        Eigen::MatrixXd m2 = Eigen::MatrixXd::Zero(q.rows(), q.rows());
+        m2.selfadjointView<Eigen::Lower>().rankUpdate(centered);
+        m2.triangularView<Eigen::StrictlyUpper>() = m2.transpose();
+        combine(q.cols(), mean, m2);
+      }
+
+      void merge(const welford_covar_estimator& other) {
+        combine(other.num_samples_, other.m_, other.m2_);
+      }
+
       int num_samples() { return num_samples_; }
 
       void sample_mean(Eigen::VectorXd& mean) { mean = m_; }
@@ -39,6 +54,20 @@ namespace stan {
       }
 
     protected:
+      // pairwise combination of Chan, Golub and LeVeque
+      void combine(double n, const Eigen::VectorXd& mean,
+                   const Eigen::MatrixXd& m2) {
+        if (n == 0)
+          return;
+        double total = num_samples_ + n;
+        Eigen::VectorXd delta(mean - m_);
+        m2_ += m2;
+        m2_.noalias() += (num_samples_ * n / total) * delta
+          * delta.transpose();
+        m_ += delta * (n / total);
+        num_samples_ = total;
+      }
+
       double num_samples_;
       Eigen::VectorXd m_;
       Eigen::MatrixXd m2_;
@@ -29,6 +29,19 @@ namespace stan {
         m2_ += delta.cwiseProduct(q - m_);
       }
 
+      void add_samples(const Eigen::MatrixXd& q) {
+        if (q.cols() == 0)
+          return;
+        Eigen::VectorXd mean = q.rowwise().mean();
+        Eigen::VectorXd m2
+          = (q.colwise() - mean).array().square().rowwise().sum();
+        combine(q.cols(), mean, m2);
+      }
+
+      void merge(const welford_var_estimator& other) {
+        combine(other.num_samples_, other.m_, other.m2_);
+      }
+
       int num_samples() { return num_samples_; }
 
       void sample_mean(Eigen::VectorXd& mean) { mean = m_; }
@@ -39,6 +52,18 @@ namespace stan {
       }
 
     protected:
+      // pairwise combination of Chan, Golub and LeVeque
+      void combine(double n, const Eigen::VectorXd& mean,
+                   const Eigen::VectorXd& m2) {
+        if (n == 0)
+          return;
+        double total = num_samples_ + n;
+        Eigen::VectorXd delta(mean - m_);
+        m2_ += m2 + delta.cwiseProduct(delta) * (num_samples_ * n / total);
+        m_ += delta * (n / total);
+        num_samples_ = total;
+      }
+
       double num_samples_;
       Eigen::VectorXd m_;
       Eigen::VectorXd m2_;
@@ -0,0 +1,190 @@
+#ifndef STAN_MATH_PRIM_MAT_FUNCTOR_GLM_TILE_SWEEP_HPP
+#define STAN_MATH_PRIM_MAT_FUNCTOR_GLM_TILE_SWEEP_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of_rows.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Target size in bytes of the tiles of rows of a design matrix
+     * swept by the GLM densities. A tile is read once to compute its
+     * linear predictors and once more, while it is still in cache, to
+     * accumulate the gradient of the weights.
+     */
+    const size_t GLM_TILE_NBYTES = 256 * 1024;
+
+    namespace internal {
+
+      template <typename T, typename T_x, class F>
+      struct glm_tile_worker {
+        typedef Eigen::Matrix<T, Eigen::Dynamic, 1> vector_t;
+        typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> matrix_t;
+
+        const T_x& x_;
+        const vector_t& beta_;
+        const T& alpha_;
+        const F& f_;
+        size_t N_;
+        size_t tile_rows_;
+        size_t num_tiles_;
+        size_t num_workers_;
+        bool x_derivative_;
+        vector_t* theta_derivative_;
+        std::vector<T>& logp_;
+        std::vector<T>& sum_derivative_;
+        std::vector<vector_t>& x_derivative_sums_;
+
+        glm_tile_worker(const T_x& x, const vector_t& beta, const T& alpha,
+                        const F& f, size_t N, size_t tile_rows,
+                        size_t num_tiles, size_t num_workers,
+                        bool x_derivative, vector_t* theta_derivative,
+                        std::vector<T>& logp,
+                        std::vector<T>& sum_derivative,
+                        std::vector<vector_t>& x_derivative_sums)
+          : x_(x), beta_(beta), alpha_(alpha), f_(f), N_(N),
+            tile_rows_(tile_rows), num_tiles_(num_tiles),
+            num_workers_(num_workers), x_derivative_(x_derivative),
+            theta_derivative_(theta_derivative), logp_(logp),
+            sum_derivative_(sum_derivative),
+            x_derivative_sums_(x_derivative_sums) { }
+
+        void operator()(size_t worker) const {
+          matrix_t buffer;
+          Eigen::Array<T, Eigen::Dynamic, 1> theta;
+          Eigen::Array<T, Eigen::Dynamic, 1> derivative;
+          T logp(0.0);
+          T sum_derivative(0.0);
+          vector_t x_derivative_sum
+            = vector_t::Zero(x_derivative_ ? beta_.size() : 0);
+          for (size_t t = worker; t < num_tiles_; t += num_workers_) {
+            size_t begin = t * tile_rows_;
+            size_t rows = std::min(N_, begin + tile_rows_) - begin;
+            Eigen::Map<const matrix_t, 0, Eigen::OuterStride<> > x_tile
+              = value_of_rows(x_, begin, rows, buffer);
+            theta = (x_tile * beta_).array() + alpha_;
+            derivative.resize(rows);
+            logp += f_(begin, theta, derivative);
+            sum_derivative += derivative.sum();
+            if (x_derivative_)
+              x_derivative_sum.noalias()
+                += x_tile.transpose() * derivative.matrix();
+            if (theta_derivative_)
+              theta_derivative_->segment(begin, rows) = derivative.matrix();
+          }
+          logp_[worker] = logp;
+          sum_derivative_[worker] = sum_derivative;
+          x_derivative_sums_[worker].swap(x_derivative_sum);
+        }
+      };
+
+    }
+
+    /**
+     * Sweep the rows of the design matrix of a GLM in tiles of about
+     * <code>GLM_TILE_NBYTES</code>, spreading the tiles over the
+     * specified number of threads, and return the log density.
+     *
+     * <p>For each tile the linear predictors <code>theta = x * beta +
+     * alpha</code> of its rows are computed and passed to the
+     * functor, which is called as <code>f(begin, theta,
+     * derivative)</code>. It must write the derivatives of the log
+     * density with respect to the linear predictors of the rows
+     * <code>[begin, begin + theta.size())</code> into
+     * <code>derivative</code> and return the log density of those
+     * rows. It is called concurrently from several threads and must
+     * not throw, so the arguments must be checked beforehand.
+     *
+     * <p>Only <code>O(M)</code> memory per thread is used besides the
+     * tiles, unless the derivatives with respect to the linear
+     * predictors of all of the rows are requested. Tile t is swept by
+     * thread <code>t % num_threads</code> and the sums of the threads
+     * are added in order, so the result is the same for a given
+     * number of threads.
+     *
+     * <p>The tiles are only spread over several threads if the values
+     * are arithmetic. Otherwise, as for the <code>var</code> values
+     * of <code>fvar<var></code> arguments, the functor and the
+     * products of the tiles create varis on the autodiff stack, which
+     * is not safe to share between threads, so a single thread is
+     * used.
+     *
+     * @tparam T type of values
+     * @tparam T_x type of design matrix
+     * @tparam F type of functor
+     * @param[in] x N by M design matrix
+     * @param[in] beta values of the M weights
+     * @param[in] alpha value of the intercept
+     * @param[in] num_threads maximum number of threads to use; ignored
+     * unless T is arithmetic
+     * @param[in] f functor for the log density of a tile of rows
+     * @param[out] x_derivative if not null, the product of the
+     * transpose of x and the derivatives with respect to the linear
+     * predictors
+     * @param[out] sum_derivative if not null, the sum of the
+     * derivatives with respect to the linear predictors
+     * @param[out] theta_derivative if not null, the derivatives with
+     * respect to the linear predictors of all of the rows
+     * @return log density
+     */
+    template <typename T, typename T_x, class F>
+    T glm_tile_sweep(const T_x& x,
+                     const Eigen::Matrix<T, Eigen::Dynamic, 1>& beta,
+                     const T& alpha, int num_threads, const F& f,
+                     Eigen::Matrix<T, Eigen::Dynamic, 1>* x_derivative,
+                     T* sum_derivative,
+                     Eigen::Matrix<T, Eigen::Dynamic, 1>* theta_derivative) {
+      typedef Eigen::Matrix<T, Eigen::Dynamic, 1> vector_t;
+      size_t N = x.rows();
+      size_t M = beta.size();
+      size_t tile_rows
+        = std::max<size_t>(1, GLM_TILE_NBYTES
+                              / (sizeof(T) * std::max<size_t>(1, M)));
+      size_t num_tiles = (N + tile_rows - 1) / tile_rows;
+      size_t num_workers
+        = boost::is_arithmetic<T>::value
+          ? std::max<size_t>(1, std::min<size_t>(num_threads, num_tiles))
+          : 1;
+      if (theta_derivative)
+        theta_derivative->resize(N);
+
+      std::vector<T> logp(num_workers, 0.0);
+      std::vector<T> sums(num_workers, 0.0);
+      std::vector<vector_t> x_sums(num_workers);
+      internal::glm_tile_worker<T, T_x, F>
+        worker(x, beta, alpha, f, N, tile_rows, num_tiles, num_workers,
+               x_derivative != 0, theta_derivative, logp, sums, x_sums);
+
+      std::vector<std::thread> threads;
+      threads.reserve(num_workers - 1);
+      for (size_t t = 1; t < num_workers; ++t)
+        threads.push_back(std::thread(worker, t));
+      worker(0);
+      for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+      T result = logp[0];
+      for (size_t t = 1; t < num_workers; ++t)
+        result += logp[t];
+      if (sum_derivative) {
+        *sum_derivative = sums[0];
+        for (size_t t = 1; t < num_workers; ++t)
+          *sum_derivative += sums[t];
+      }
+      if (x_derivative) {
+        x_derivative->swap(x_sums[0]);
+        for (size_t t = 1; t < num_workers; ++t)
+          *x_derivative += x_sums[t];
+      }
+      return result;
+    }
+
+  }
+}
+#endif
@@ -28,6 +28,10 @@ namespace stan {
         * Not implemented so cannot be called.
         */
         Eigen::Matrix<ViewElt, R, 1>& col(int /*i*/);
+       /**
+        * Not implemented so cannot be called.
+        */
+        ViewElt& operator()(int /*i*/, int /*j*/);
       };
     }
   }
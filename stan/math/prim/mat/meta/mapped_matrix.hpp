@@ -0,0 +1,33 @@
+#ifndef STAN_MATH_PRIM_MAT_META_MAPPED_MATRIX_HPP
+#define STAN_MATH_PRIM_MAT_META_MAPPED_MATRIX_HPP
+
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/scalar_type.hpp>
+#include <stan/math/prim/scal/meta/value_type.hpp>
+#include <cstddef>
+
+namespace stan {
+  namespace math {
+    class mapped_matrix;
+  }
+
+  template <>
+  struct scalar_type<math::mapped_matrix> {
+    typedef double type;
+  };
+
+  template <>
+  struct is_constant_struct<math::mapped_matrix> {
+    enum { value = true };
+  };
+
+  inline size_t length(const math::mapped_matrix& x);
+
+  namespace math {
+    template <>
+    struct value_type<mapped_matrix> {
+      typedef double type;
+    };
+  }
+}
+#endif
@@ -0,0 +1,73 @@
+#ifndef STAN_MATH_PRIM_MAT_META_VALIDATED_DATA_HPP
+#define STAN_MATH_PRIM_MAT_META_VALIDATED_DATA_HPP
+
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/is_vector.hpp>
+#include <stan/math/prim/scal/meta/is_vector_like.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+#include <stan/math/prim/scal/meta/scalar_type.hpp>
+#include <stan/math/prim/scal/meta/value_type.hpp>
+#include <cstddef>
+
+namespace stan {
+  namespace math {
+    template <typename T>
+    class validated_data;
+  }
+
+  template <typename T>
+  struct scalar_type<math::validated_data<T> > {
+    typedef typename scalar_type<T>::type type;
+  };
+
+  template <typename T>
+  struct is_vector<math::validated_data<T> > {
+    enum { value = is_vector<T>::value };
+    typedef typename is_vector<T>::type type;
+  };
+
+  template <typename T>
+  struct is_vector_like<math::validated_data<T> > {
+    enum { value = is_vector_like<T>::value };
+  };
+
+  template <typename T>
+  struct is_constant_struct<math::validated_data<T> > {
+    enum { value = is_constant_struct<T>::value };
+  };
+
+  template <typename T>
+  size_t length(const math::validated_data<T>& x) {
+    return x.size();
+  }
+
+  /**
+   * Specialization of scalar_seq_view for validated data, which
+   * views the wrapped data.
+   *
+   * @tparam C type of wrapped data
+   * @tparam T scalar type of wrapped data
+   */
+  template <typename C, typename T>
+  class scalar_seq_view<math::validated_data<C>, T> {
+  public:
+    explicit scalar_seq_view(const math::validated_data<C>& c)
+      : view_(c.data()) {}
+    const T& operator[](int i) const {
+      return view_[i];
+    }
+    int size() const {
+      return view_.size();
+    }
+  private:
+    scalar_seq_view<C> view_;
+  };
+
+  namespace math {
+    template <typename T>
+    struct value_type<validated_data<T> > {
+      typedef typename value_type<T>::type type;
+    };
+  }
+}
+#endif
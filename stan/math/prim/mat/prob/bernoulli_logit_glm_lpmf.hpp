@@ -8,9 +8,11 @@
 #include <stan/math/prim/scal/err/check_consistent_sizes.hpp>
 #include <stan/math/prim/scal/err/check_bounded.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
 #include <stan/math/prim/scal/fun/value_of.hpp>
 #include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/functor/glm_tile_sweep.hpp>
 #include <stan/math/prim/scal/meta/include_summand.hpp>
 #include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
 #include <stan/math/prim/scal/fun/size_zero.hpp>
@@ -24,11 +26,14 @@ namespace stan {
      * Returns the log PMF of the Generalized Linear Model (GLM)
      * with Bernoulli distribution and logit link function.
      * If containers are supplied, returns the log sum of the probabilities.
+     * The rows of x are swept in tiles, which may be spread over several
+     * threads (see <code>glm_tile_sweep()</code>).
      * @tparam T_n type of binary vector of dependent variables (labels);
      * this can also be a single binary value;
      * @tparam T_x type of the matrix of independent variables (features); this
      * should be an Eigen::Matrix type whose number of rows should match the 
-     * length of n and whose number of columns should match the length of beta
+     * length of n and whose number of columns should match the length of beta;
+     * it can also be a mapped_matrix streamed from a file
      * @tparam T_beta type of the weight vector;
      * this can also be a single value;
      * @tparam T_alpha type of the intercept;
@@ -37,16 +42,20 @@ namespace stan {
      * @param x design matrix
      * @param beta weight vector
      * @param alpha intercept (in log odds)
+     * @param num_threads maximum number of threads to use; a single
+     * thread is used for arguments of nested autodiff types such as
+     * fvar<var>
      * @return log probability or log sum of probabilities
      * @throw std::domain_error if x, beta or alpha is infinite.
      * @throw std::domain_error if n is not binary.
+     * @throw std::domain_error if num_threads is not positive.
      * @throw std::invalid_argument if container sizes mismatch.
      */
     template <bool propto, typename T_n, typename T_x, typename T_beta,
               typename T_alpha>
     typename return_type<T_x, T_beta, T_alpha>::type
     bernoulli_logit_glm_lpmf(const T_n &n, const T_x &x, const T_beta &beta,
-                             const T_alpha &alpha) {
+                             const T_alpha &alpha, int num_threads = 1) {
       static const char* function = "bernoulli_logit_glm_lpmf";
       typedef typename stan::partials_return_type<T_n, T_x, T_beta,
                                                   T_alpha>::type
@@ -55,6 +64,7 @@ namespace stan {
       using std::exp;
       using Eigen::Dynamic;
       using Eigen::Matrix;
+      using Eigen::Array;
 
       if (size_zero(n, x, beta))
         return 0.0;
@@ -71,20 +81,13 @@ namespace stan {
       check_consistent_sizes(function,
                              "Columns in matrix of independent variables",
                              x.row(0), "Weight vector",  beta);
+      check_positive(function, "Number of threads", num_threads);
 
       if (!include_summand<propto, T_x, T_beta, T_alpha>::value)
         return 0.0;
 
-      const size_t N = x.col(0).size();
       const size_t M = x.row(0).size();
 
-      Matrix<T_partials_return, Dynamic, 1> signs(N, 1);
-      {
-        scalar_seq_view<T_n> n_vec(n);
-        for (size_t n = 0; n < N; ++n) {
-          signs[n] = 2 * n_vec[n] - 1;
-        }
-      }
       Matrix<T_partials_return, Dynamic, 1> beta_dbl(M, 1);
       {
         scalar_seq_view<T_beta> beta_vec(beta);
@@ -92,50 +95,53 @@ namespace stan {
           beta_dbl[m] = value_of(beta_vec[m]);
         }
       }
-      Matrix<T_partials_return, Dynamic, Dynamic> x_dbl = value_of(x);
-
-      Eigen::Array<T_partials_return, Dynamic, 1> ntheta = signs.array()
-        * (x_dbl * beta_dbl + Matrix<double, Dynamic, 1>::Ones(N, 1)
-        * value_of(alpha)).array();
-      Eigen::Array<T_partials_return, Dynamic, 1> exp_m_ntheta =
-        (-ntheta).exp();
+      scalar_seq_view<T_n> n_vec(n);
 
+      // Compute the log-density and its derivatives with respect to the
+      // linear predictors, handling extreme values gracefully using
+      // Taylor approximations.
       static const double cutoff = 20.0;
-      for (size_t n = 0; n < N; ++n) {
-        // Compute the log-density and handle extreme values gracefully
-        // using Taylor approximations.
-        if (ntheta[n] > cutoff)
-          logp -= exp_m_ntheta[n];
-        else if (ntheta[n] < -cutoff)
-          logp += ntheta[n];
-        else
-          logp -= log1p(exp_m_ntheta[n]);
-      }
+      Matrix<T_partials_return, Dynamic, 1> beta_derivative;
+      T_partials_return alpha_derivative(0.0);
+      Matrix<T_partials_return, Dynamic, 1> theta_derivative;
+      logp = glm_tile_sweep(
+          x, beta_dbl, T_partials_return(value_of(alpha)), num_threads,
+          [&n_vec](size_t begin,
+                   const Array<T_partials_return, Dynamic, 1>& theta,
+                   Array<T_partials_return, Dynamic, 1>& derivative) {
+            T_partials_return logp(0.0);
+            for (int i = 0; i < theta.size(); ++i) {
+              T_partials_return sign = 2 * n_vec[begin + i] - 1;
+              T_partials_return ntheta = sign * theta[i];
+              T_partials_return exp_m_ntheta = exp(-ntheta);
+              if (ntheta > cutoff) {
+                logp -= exp_m_ntheta;
+                derivative[i] = sign * exp_m_ntheta;
+              } else if (ntheta < -cutoff) {
+                logp += ntheta;
+                derivative[i] = sign;
+              } else {
+                logp -= log1p(exp_m_ntheta);
+                derivative[i] = sign * exp_m_ntheta / (exp_m_ntheta + 1);
+              }
+            }
+            return logp;
+          },
+          is_constant_struct<T_beta>::value ? 0 : &beta_derivative,
+          is_constant_struct<T_alpha>::value ? 0 : &alpha_derivative,
+          is_constant_struct<T_x>::value ? 0 : &theta_derivative);
 
       // Compute the necessary derivatives.
       operands_and_partials<T_x, T_beta, T_alpha> ops_partials(x, beta, alpha);
-      if (!(is_constant_struct<T_x>::value && is_constant_struct<T_beta>::value
-            && is_constant_struct<T_alpha>::value)) {
-        Matrix<T_partials_return, Dynamic, 1> theta_derivative(N, 1);
-        for (size_t n = 0; n < N; ++n) {
-          if (ntheta[n] > cutoff)
-            theta_derivative[n] = -exp_m_ntheta[n];
-          else if (ntheta[n] < -cutoff)
-            theta_derivative[n] = signs[n];
-          else
-            theta_derivative[n] = signs[n] * exp_m_ntheta[n]
-              / (exp_m_ntheta[n] + 1);
-        }
-        if (!is_constant_struct<T_beta>::value) {
-          ops_partials.edge2_.partials_ = x_dbl.transpose() * theta_derivative;
-        }
-        if (!is_constant_struct<T_x>::value) {
-          ops_partials.edge1_.partials_ = theta_derivative
-            * beta_dbl.transpose();
-        }
-        if (!is_constant_struct<T_alpha>::value) {
-          ops_partials.edge3_.partials_[0] = theta_derivative.trace();
-        }
+      if (!is_constant_struct<T_beta>::value) {
+        ops_partials.edge2_.partials_ = beta_derivative;
+      }
+      if (!is_constant_struct<T_x>::value) {
+        ops_partials.edge1_.partials_ = theta_derivative
+          * beta_dbl.transpose();
+      }
+      if (!is_constant_struct<T_alpha>::value) {
+        ops_partials.edge3_.partials_[0] = alpha_derivative;
       }
 
       return ops_partials.build(logp);
@@ -145,8 +151,8 @@ namespace stan {
     inline
         typename return_type<T_x, T_beta, T_alpha>::type
         bernoulli_logit_glm_lpmf(const T_n &n, const T_x &x, const T_beta &beta,
-                                 const T_alpha &alpha) {
-      return bernoulli_logit_glm_lpmf<false>(n, x, beta, alpha);
+                                 const T_alpha &alpha, int num_threads = 1) {
+      return bernoulli_logit_glm_lpmf<false>(n, x, beta, alpha, num_threads);
     }
   }  // namespace math
 }  // namespace stan
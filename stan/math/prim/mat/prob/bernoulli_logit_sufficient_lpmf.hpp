@@ -0,0 +1,101 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_BERNOULLI_LOGIT_SUFFICIENT_LPMF_HPP
+#define STAN_MATH_PRIM_MAT_PROB_BERNOULLI_LOGIT_SUFFICIENT_LPMF_HPP
+
+#include <stan/math/prim/mat/fun/sufficient_stats.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/err/check_bounded.hpp>
+#include <stan/math/prim/scal/err/check_consistent_size.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/domain_error.hpp>
+#include <stan/math/prim/scal/fun/size_zero.hpp>
+#include <stan/math/prim/scal/fun/inv_logit.hpp>
+#include <stan/math/prim/scal/fun/log_inv_logit.hpp>
+#include <stan/math/prim/scal/fun/log1m_inv_logit.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * The log of the Bernoulli probability mass of (grouped) binary
+     * outcomes given their precomputed sufficient statistics and the
+     * log odds of success of each group. theta can be either a
+     * scalar, shared by all groups, or a vector with one entry per
+     * group.
+     *
+     * <p>The cost is proportional to the number of groups rather than
+     * the number of observations.
+     *
+     * @tparam T_prob Type of log odds parameter.
+     * @param n Sufficient statistics of the binary outcomes.
+     * @param theta (Sequence of) log odds parameter(s).
+     * @return The log of the product of the probability masses.
+     * @throw std::domain_error if an outcome is not 0 or 1, or if a
+     * log odds parameter is NaN.
+     * @throw std::invalid_argument if the length of theta does not
+     * match the number of groups.
+     */
+    template <bool propto, typename T_prob>
+    typename return_type<T_prob>::type
+    bernoulli_logit_sufficient_lpmf(const sufficient_stats& n,
+                                    const T_prob& theta) {
+      typedef typename stan::partials_return_type<T_prob>::type
+        T_partials_return;
+
+      static const char* function = "bernoulli_logit_sufficient_lpmf";
+
+      if (n.num_obs() == 0 || size_zero(theta))
+        return 0.0;
+
+      T_partials_return logp(0.0);
+
+      check_bounded(function, "n", n.min(), 0, 1);
+      check_bounded(function, "n", n.max(), 0, 1);
+      if (!n.integer_valued())
+        domain_error(function, "n", n.non_integer(),
+                     "is ", ", but must be an integer!");
+      check_not_nan(function, "Logit transformed probability parameter",
+                    theta);
+      check_consistent_size(function,
+                            "Logit transformed probability parameter",
+                            theta, n.num_groups());
+
+      if (!include_summand<propto, T_prob>::value)
+        return 0.0;
+
+      const Eigen::VectorXd& count = n.count();
+      const Eigen::VectorXd& sum = n.sum();
+      scalar_seq_view<T_prob> theta_vec(theta);
+      const int G = n.num_groups();
+
+      operands_and_partials<T_prob> ops_partials(theta);
+
+      for (int g = 0; g < G; g++) {
+        const T_partials_return theta_dbl = value_of(theta_vec[g]);
+        if (sum[g] > 0)
+          logp += sum[g] * log_inv_logit(theta_dbl);
+        if (count[g] > sum[g])
+          logp += (count[g] - sum[g]) * log1m_inv_logit(theta_dbl);
+
+        if (!is_constant_struct<T_prob>::value)
+          ops_partials.edge1_.partials_[g]
+            += sum[g] - count[g] * inv_logit(theta_dbl);
+      }
+      return ops_partials.build(logp);
+    }
+
+    template <typename T_prob>
+    inline
+    typename return_type<T_prob>::type
+    bernoulli_logit_sufficient_lpmf(const sufficient_stats& n,
+                                    const T_prob& theta) {
+      return bernoulli_logit_sufficient_lpmf<false>(n, theta);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,144 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_CATEGORICAL_LOGIT_GLM_LPMF_HPP
+#define STAN_MATH_PRIM_MAT_PROB_CATEGORICAL_LOGIT_GLM_LPMF_HPP
+
+#include <stan/math/prim/arr/meta/is_vector.hpp>
+#include <stan/math/prim/arr/meta/length.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/is_vector.hpp>
+#include <stan/math/prim/scal/meta/length.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/scal/err/check_bounded.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+#include <cmath>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns the log PMF of the Generalized Linear Model (GLM)
+     * with categorical distribution and logit (softmax) link function.
+     * If containers are supplied, returns the log sum of the probabilities.
+     *
+     * <p>The log odds of all of the observations are computed with one
+     * matrix product on doubles and normalized with a log softmax that
+     * subtracts the maximum of each row. The partials of the weights
+     * come from one more matrix product, so the log odds never go on
+     * the expression graph and the result is a single node.
+     *
+     * @tparam T_y type of the outcomes, integers between 1 and the
+     * number of categories; this can also be a single integer, which
+     * is the outcome of every row
+     * @tparam T_x type of the entries of the N by M matrix of covariates
+     * @tparam T_beta type of the entries of the M by K weight matrix
+     * @tparam T_alpha type of the entries of the vector of K intercepts
+     * @param y outcomes
+     * @param x design matrix
+     * @param beta weight matrix, with one column per category
+     * @param alpha intercepts, one per category (in log odds)
+     * @return log probability or log sum of probabilities
+     * @throw std::domain_error if x, beta or alpha is infinite.
+     * @throw std::domain_error if an outcome is out of support.
+     * @throw std::invalid_argument if container sizes mismatch.
+     */
+    template <bool propto, typename T_y, typename T_x, typename T_beta,
+              typename T_alpha>
+    typename return_type<T_x, T_beta, T_alpha>::type
+    categorical_logit_glm_lpmf(
+        const T_y& y,
+        const Eigen::Matrix<T_x, Eigen::Dynamic, Eigen::Dynamic>& x,
+        const Eigen::Matrix<T_beta, Eigen::Dynamic, Eigen::Dynamic>& beta,
+        const Eigen::Matrix<T_alpha, Eigen::Dynamic, 1>& alpha) {
+      static const char* function = "categorical_logit_glm_lpmf";
+      typedef typename stan::partials_return_type<T_x, T_beta,
+                                                  T_alpha>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1> vector_d;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic,
+                            Eigen::Dynamic>
+        matrix_d;
+      typedef Eigen::Matrix<T_x, Eigen::Dynamic, Eigen::Dynamic> T_xs;
+      typedef Eigen::Matrix<T_beta, Eigen::Dynamic, Eigen::Dynamic> T_betas;
+      typedef Eigen::Matrix<T_alpha, Eigen::Dynamic, 1> T_alphas;
+
+      using std::log;
+
+      const size_t N = x.rows();
+
+      check_size_match(function, "Columns of matrix of independent variables",
+                       x.cols(), "rows of weight matrix", beta.rows());
+      check_size_match(function, "Columns of weight matrix", beta.cols(),
+                       "size of intercept vector", alpha.size());
+      if (is_vector<T_y>::value)
+        check_size_match(function, "Rows of matrix of independent variables",
+                         N, "size of vector of dependent variables",
+                         length(y));
+      scalar_seq_view<T_y> y_seq(y);
+      for (size_t i = 0; i < length(y); ++i)
+        check_bounded(function, "categorical outcome out of support",
+                      y_seq[i], 1, beta.cols());
+      check_finite(function, "Matrix of independent variables", x);
+      check_finite(function, "Weight matrix", beta);
+      check_finite(function, "Intercept vector", alpha);
+
+      if (N == 0 || !include_summand<propto, T_x, T_beta, T_alpha>::value)
+        return 0.0;
+
+      matrix_d x_dbl = value_of(x);
+      matrix_d beta_dbl = value_of(beta);
+
+      // lin(i, k) is the log odds of category k in row i, which are
+      // replaced by the unnormalized probabilities once the log density
+      // is accumulated
+      matrix_d lin = x_dbl * beta_dbl;
+      lin.rowwise() += value_of(alpha).transpose();
+      vector_d max_lin = lin.rowwise().maxCoeff();
+      T_partials_return logp(0.0);
+      for (size_t i = 0; i < N; ++i)
+        logp += lin(i, y_seq[i] - 1) - max_lin(i);
+      lin = (lin.colwise() - max_lin).array().exp().matrix();
+      vector_d sum_lin = lin.rowwise().sum();
+      for (size_t i = 0; i < N; ++i)
+        logp -= log(sum_lin(i));
+
+      operands_and_partials<T_xs, T_betas, T_alphas>
+        ops_partials(x, beta, alpha);
+      if (!(is_constant_struct<T_xs>::value
+            && is_constant_struct<T_betas>::value
+            && is_constant_struct<T_alphas>::value)) {
+        // the derivative with respect to the log odds is the indicator
+        // of the outcome minus the probabilities
+        lin.array().colwise() /= -sum_lin.array();
+        for (size_t i = 0; i < N; ++i)
+          lin(i, y_seq[i] - 1) += 1;
+        if (!is_constant_struct<T_xs>::value)
+          ops_partials.edge1_.partials_ = lin * beta_dbl.transpose();
+        if (!is_constant_struct<T_betas>::value)
+          ops_partials.edge2_.partials_ = x_dbl.transpose() * lin;
+        if (!is_constant_struct<T_alphas>::value)
+          ops_partials.edge3_.partials_ = lin.colwise().sum().transpose();
+      }
+      return ops_partials.build(logp);
+    }
+
+    template <typename T_y, typename T_x, typename T_beta, typename T_alpha>
+    inline
+    typename return_type<T_x, T_beta, T_alpha>::type
+    categorical_logit_glm_lpmf(
+        const T_y& y,
+        const Eigen::Matrix<T_x, Eigen::Dynamic, Eigen::Dynamic>& x,
+        const Eigen::Matrix<T_beta, Eigen::Dynamic, Eigen::Dynamic>& beta,
+        const Eigen::Matrix<T_alpha, Eigen::Dynamic, 1>& alpha) {
+      return categorical_logit_glm_lpmf<false>(y, x, beta, alpha);
+    }
+
+  }
+}
+#endif
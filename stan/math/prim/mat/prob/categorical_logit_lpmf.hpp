@@ -3,12 +3,18 @@
 
 #include <stan/math/prim/scal/err/check_bounded.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/arr/fun/log_sum_exp.hpp>
-#include <stan/math/prim/mat/fun/log_softmax.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/fun/log_sum_exp.hpp>
-#include <stan/math/prim/mat/fun/sum.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
 #include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
 #include <boost/math/tools/promotion.hpp>
+#include <cmath>
 #include <vector>
 
 namespace stan {
@@ -43,6 +49,24 @@ namespace stan {
       return categorical_logit_lpmf<false>(n, beta);
     }
 
+    /**
+     * Returns the log probability of the specified outcomes, all
+     * drawn from the categorical distribution with the specified log
+     * odds.
+     *
+     * <p>The log probability only depends on the number of times each
+     * outcome occurs, so it is computed on doubles from the counts of
+     * the outcomes and one normalizer, and the result is a single node
+     * in the expression graph.
+     *
+     * @tparam propto True if calculating up to a proportion.
+     * @tparam T_prob Type of log odds.
+     * @param ns Outcomes, each between 1 and the size of beta.
+     * @param beta Log odds.
+     * @return Log probability of the outcomes.
+     * @throw std::domain_error if an outcome is out of support or a
+     * log odds is not finite.
+     */
     template <bool propto,
               typename T_prob>
     typename boost::math::tools::promote_args<T_prob>::type
@@ -50,6 +74,13 @@ namespace stan {
                           const Eigen::Matrix<T_prob, Eigen::Dynamic, 1>&
                           beta) {
       static const char* function = "categorical_logit_lpmf";
+      typedef typename stan::partials_return_type<T_prob>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1> vector_d;
+      typedef Eigen::Matrix<T_prob, Eigen::Dynamic, 1> T_beta;
+
+      using std::exp;
+      using std::log;
 
       for (size_t k = 0; k < ns.size(); ++k)
         check_bounded(function, "categorical outcome out of support",
@@ -62,15 +93,23 @@ namespace stan {
       if (ns.size() == 0)
         return 0.0;
 
-      Eigen::Matrix<T_prob, Eigen::Dynamic, 1> log_softmax_beta
-        = log_softmax(beta);
-
-      // FIXME:  replace with more efficient sum()
-      Eigen::Matrix<typename boost::math::tools::promote_args<T_prob>::type,
-                    Eigen::Dynamic, 1> results(ns.size());
+      vector_d counts = vector_d::Zero(beta.size());
       for (size_t i = 0; i < ns.size(); ++i)
-        results[i] = log_softmax_beta(ns[i] - 1);
-      return sum(results);
+        counts(ns[i] - 1) += 1;
+
+      vector_d beta_dbl = value_of(beta);
+      T_partials_return max_beta = beta_dbl.maxCoeff();
+      vector_d probs = (beta_dbl.array() - max_beta).exp().matrix();
+      T_partials_return sum_probs = probs.sum();
+      probs /= sum_probs;
+      T_partials_return N = ns.size();
+      T_partials_return logp = counts.dot(beta_dbl)
+        - N * (max_beta + log(sum_probs));
+
+      operands_and_partials<T_beta> ops_partials(beta);
+      if (!is_constant_struct<T_beta>::value)
+        ops_partials.edge1_.partials_ = counts - N * probs;
+      return ops_partials.build(logp);
     }
 
     template <typename T_prob>
@@ -82,6 +121,87 @@ namespace stan {
       return categorical_logit_lpmf<false>(ns, beta);
     }
 
+    /**
+     * Returns the log probability of the specified outcomes, each
+     * drawn from the categorical distribution with the log odds in
+     * its row of the specified matrix, as with a linear predictor
+     * for each observation.
+     *
+     * <p>The normalizers and the partials are computed on doubles in
+     * sweeps over the matrix, and the result is a single node in the
+     * expression graph.
+     *
+     * @tparam propto True if calculating up to a proportion.
+     * @tparam T_prob Type of log odds.
+     * @param ns Outcomes, each between 1 and the number of columns of
+     * beta.
+     * @param beta Log odds, with one row per outcome.
+     * @return Log probability of the outcomes.
+     * @throw std::invalid_argument if the number of outcomes does not
+     * match the number of rows of beta.
+     * @throw std::domain_error if an outcome is out of support or a
+     * log odds is not finite.
+     */
+    template <bool propto,
+              typename T_prob>
+    typename boost::math::tools::promote_args<T_prob>::type
+    categorical_logit_lpmf(const std::vector<int>& ns,
+                          const Eigen::Matrix<T_prob, Eigen::Dynamic,
+                                              Eigen::Dynamic>& beta) {
+      static const char* function = "categorical_logit_lpmf";
+      typedef typename stan::partials_return_type<T_prob>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1> vector_d;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic,
+                            Eigen::Dynamic>
+        matrix_d;
+      typedef Eigen::Matrix<T_prob, Eigen::Dynamic, Eigen::Dynamic> T_beta;
+
+      using std::log;
+
+      check_size_match(function, "Number of outcomes", ns.size(),
+                       "rows of log odds parameter", beta.rows());
+      for (size_t k = 0; k < ns.size(); ++k)
+        check_bounded(function, "categorical outcome out of support",
+                      ns[k], 1, beta.cols());
+      check_finite(function, "log odds parameter", beta);
+
+      if (!include_summand<propto, T_prob>::value)
+        return 0.0;
+
+      if (ns.size() == 0)
+        return 0.0;
+
+      // the sweeps follow the storage order of the matrix
+      matrix_d probs = value_of(beta);
+      vector_d max_beta = probs.rowwise().maxCoeff();
+      T_partials_return logp(0.0);
+      for (size_t i = 0; i < ns.size(); ++i)
+        logp += probs(i, ns[i] - 1) - max_beta(i);
+      probs = (probs.colwise() - max_beta).array().exp().matrix();
+      vector_d sum_probs = probs.rowwise().sum();
+      for (int i = 0; i < sum_probs.size(); ++i)
+        logp -= log(sum_probs(i));
+
+      operands_and_partials<T_beta> ops_partials(beta);
+      if (!is_constant_struct<T_beta>::value) {
+        probs.array().colwise() /= sum_probs.array();
+        for (size_t i = 0; i < ns.size(); ++i)
+          probs(i, ns[i] - 1) -= 1;
+        ops_partials.edge1_.partials_ = -probs;
+      }
+      return ops_partials.build(logp);
+    }
+
+    template <typename T_prob>
+    inline
+    typename boost::math::tools::promote_args<T_prob>::type
+    categorical_logit_lpmf(const std::vector<int>& ns,
+                          const Eigen::Matrix<T_prob, Eigen::Dynamic,
+                                              Eigen::Dynamic>& beta) {
+      return categorical_logit_lpmf<false>(ns, beta);
+    }
+
   }
 }
 #endif
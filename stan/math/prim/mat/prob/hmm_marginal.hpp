@@ -0,0 +1,155 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_HMM_MARGINAL_HPP
+#define STAN_MATH_PRIM_MAT_PROB_HMM_MARGINAL_HPP
+
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/mat/err/check_simplex.hpp>
+#include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/meta/broadcast_array.hpp>
+#include <stan/math/prim/mat/meta/is_vector_like.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <cmath>
+#include <limits>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns the log density of the observations of a hidden Markov
+     * model, marginalizing over the hidden states.
+     *
+     * <p>The model has <code>K</code> states and <code>T</code> time
+     * steps. The density is computed with the forward algorithm on
+     * doubles, with the forward probabilities scaled to sum to one
+     * at every step. The gradients come from one backward pass, which
+     * gives the posterior probabilities of the states, so all of the
+     * partials are stored in <code>O(T K)</code> memory and the
+     * result is a single node in the expression graph.
+     *
+     * @tparam T_omega type of the log emission densities
+     * @tparam T_Gamma type of the transition matrix
+     * @tparam T_rho type of the initial distribution
+     * @param log_omegas log density of the observation at each time
+     * step under each state, with one row per state and one column
+     * per time step
+     * @param Gamma transition matrix, whose entry
+     * <code>(i, j)</code> is the probability of a transition from
+     * state <code>i</code> to state <code>j</code>
+     * @param rho distribution of the initial state
+     * @return log marginal density of the observations
+     * @throw std::invalid_argument if Gamma is not square or the
+     * sizes of the arguments do not match.
+     * @throw std::domain_error if a row of Gamma or rho is not a
+     * simplex, or a log emission density is NaN.
+     */
+    template <typename T_omega, typename T_Gamma, typename T_rho>
+    typename return_type<T_omega, T_Gamma, T_rho>::type
+    hmm_marginal(
+        const Eigen::Matrix<T_omega, Eigen::Dynamic, Eigen::Dynamic>&
+        log_omegas,
+        const Eigen::Matrix<T_Gamma, Eigen::Dynamic, Eigen::Dynamic>& Gamma,
+        const Eigen::Matrix<T_rho, Eigen::Dynamic, 1>& rho) {
+      static const char* function = "hmm_marginal";
+      typedef typename stan::partials_return_type<T_omega, T_Gamma,
+                                                  T_rho>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1>
+        vector_d;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic,
+                            Eigen::Dynamic>
+        matrix_d;
+      typedef Eigen::Matrix<T_omega, Eigen::Dynamic, Eigen::Dynamic>
+        T_omegas;
+      typedef Eigen::Matrix<T_Gamma, Eigen::Dynamic, Eigen::Dynamic>
+        T_Gammas;
+      typedef Eigen::Matrix<T_rho, Eigen::Dynamic, 1> T_rhos;
+
+      using std::exp;
+      using std::log;
+
+      check_square(function, "Gamma", Gamma);
+      check_size_match(function, "rows of log_omegas", log_omegas.rows(),
+                       "rows of Gamma", Gamma.rows());
+      check_size_match(function, "rows of log_omegas", log_omegas.rows(),
+                       "size of rho", rho.size());
+      check_not_nan(function, "log_omegas", log_omegas);
+      matrix_d Gamma_dbl = value_of(Gamma);
+      for (int i = 0; i < Gamma_dbl.rows(); ++i) {
+        vector_d row = Gamma_dbl.row(i).transpose();
+        check_simplex(function, "Gamma[i]", row);
+      }
+      vector_d rho_dbl = value_of(rho);
+      check_simplex(function, "rho", rho_dbl);
+
+      const int K = log_omegas.rows();
+      const int T = log_omegas.cols();
+      operands_and_partials<T_omegas, T_Gammas, T_rhos>
+        ops_partials(log_omegas, Gamma, rho);
+      if (T == 0)
+        return ops_partials.build(0.0);
+
+      // the emission densities of each step are scaled by their
+      // maximum, which is added back to the log density
+      matrix_d omegas = value_of(log_omegas);
+      T_partials_return logp(0.0);
+      for (int t = 0; t < T; ++t) {
+        T_partials_return max_omega = omegas.col(t).maxCoeff();
+        if (max_omega == -std::numeric_limits<double>::infinity())
+          return ops_partials.build(max_omega);
+        logp += max_omega;
+        omegas.col(t) = (omegas.col(t).array() - max_omega).exp().matrix();
+      }
+
+      // alphas(k, t) is the probability of state k at step t given the
+      // observations up to step t
+      matrix_d alphas(K, T);
+      vector_d norms(T);
+      alphas.col(0) = omegas.col(0).cwiseProduct(rho_dbl);
+      for (int t = 0; t < T; ++t) {
+        if (t > 0) {
+          alphas.col(t).noalias() = Gamma_dbl.transpose() * alphas.col(t - 1);
+          alphas.col(t) = alphas.col(t).cwiseProduct(omegas.col(t));
+        }
+        norms(t) = alphas.col(t).sum();
+        if (norms(t) == 0)
+          return ops_partials.build(-std::numeric_limits<double>::infinity());
+        alphas.col(t) /= norms(t);
+        logp += log(norms(t));
+      }
+
+      if (!(is_constant_struct<T_omegas>::value
+            && is_constant_struct<T_Gammas>::value
+            && is_constant_struct<T_rhos>::value)) {
+        // beta(k) is the scaled probability of the observations after
+        // step t given state k at step t, and the posterior
+        // probability of state k at step t is alphas(k, t) * beta(k)
+        vector_d beta = vector_d::Ones(K);
+        matrix_d weighted_betas(K, T);
+        for (int t = T - 1; t >= 0; --t) {
+          if (!is_constant_struct<T_omegas>::value)
+            ops_partials.edge1_.partials_.col(t)
+              = alphas.col(t).cwiseProduct(beta);
+          weighted_betas.col(t)
+            = omegas.col(t).cwiseProduct(beta) / norms(t);
+          beta.noalias() = Gamma_dbl * weighted_betas.col(t);
+        }
+        if (!is_constant_struct<T_Gammas>::value && T > 1)
+          ops_partials.edge2_.partials_
+            = alphas.leftCols(T - 1)
+            * weighted_betas.rightCols(T - 1).transpose();
+        if (!is_constant_struct<T_rhos>::value)
+          ops_partials.edge3_.partials_ = weighted_betas.col(0);
+      }
+      return ops_partials.build(logp);
+    }
+
+  }
+}
+#endif
@@ -6,12 +6,19 @@
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
 #include <stan/math/prim/mat/meta/index_type.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/LDLT_factor.hpp>
 #include <stan/math/prim/mat/fun/log_determinant_ldlt.hpp>
 #include <stan/math/prim/mat/fun/mdivide_left_ldlt.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/prob/wishart_lpdf.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
-#include <stan/math/prim/scal/meta/include_summand.hpp>
 #include <stan/math/prim/scal/fun/lmgamma.hpp>
-#include <stan/math/prim/mat/fun/trace.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
 
 namespace stan {
   namespace math {
@@ -31,6 +38,12 @@ namespace stan {
      +\frac{\nu}{2} \log(\det(S)) - \frac{\nu+k+1}{2}\log (\det(W)) - \frac{1}{2} \mbox{tr}(S W^{-1})
      \f}
      *
+     * The density is computed on doubles from one LDLT factorization
+     * of each of W and S, and the partials are pushed through
+     * <code>operands_and_partials</code>, as for
+     * <code>wishart_lpdf()</code>.  The partials with respect to the
+     * entries of W and S above the diagonal are zero.
+     *
      * @param W A scalar matrix
      * @param nu Degrees of freedom
      * @param S The scale matrix
@@ -51,14 +64,19 @@ namespace stan {
                      const Eigen::Matrix
                      <T_scale, Eigen::Dynamic, Eigen::Dynamic>& S) {
       static const char* function = "inv_wishart_lpdf";
+      typedef typename stan::partials_return_type<T_y, T_dof,
+                                                  T_scale>::type
+        T_partials_return;
 
-      using boost::math::tools::promote_args;
       using Eigen::Dynamic;
       using Eigen::Matrix;
 
+      typedef Matrix<T_partials_return, Dynamic, Dynamic> matrix_d;
+      typedef Matrix<T_y, Dynamic, Dynamic> T_W;
+      typedef Matrix<T_scale, Dynamic, Dynamic> T_S;
+
       typename index_type<Matrix<T_scale, Dynamic, Dynamic> >::type k
         = S.rows();
-      typename promote_args<T_y, T_dof, T_scale>::type lp(0.0);
 
       check_greater(function, "Degrees of freedom parameter", nu, k-1);
       check_square(function, "random variable", W);
@@ -67,40 +85,62 @@ namespace stan {
                        "Rows of random variable", W.rows(),
                        "columns of scale parameter", S.rows());
 
-      LDLT_factor<T_y, Eigen::Dynamic, Eigen::Dynamic> ldlt_W(W);
+      matrix_d W_dbl = value_of(W);
+      LDLT_factor<T_partials_return, Dynamic, Dynamic> ldlt_W(W_dbl);
       check_ldlt_factor(function, "LDLT_Factor of random variable", ldlt_W);
-      LDLT_factor<T_scale, Eigen::Dynamic, Eigen::Dynamic> ldlt_S(S);
+      matrix_d S_dbl = value_of(S);
+      LDLT_factor<T_partials_return, Dynamic, Dynamic> ldlt_S(S_dbl);
       check_ldlt_factor(function, "LDLT_Factor of scale parameter", ldlt_S);
 
-      if (include_summand<propto, T_dof>::value)
-        lp -= lmgamma(k, 0.5 * nu);
-      if (include_summand<propto, T_dof, T_scale>::value) {
-        lp += 0.5 * nu * log_determinant_ldlt(ldlt_S);
+      operands_and_partials<T_W, T_dof, T_S> ops_partials(W, nu, S);
+      if (!include_summand<propto, T_y, T_dof, T_scale>::value)
+        return ops_partials.build(0.0);
+
+      const T_partials_return nu_dbl = value_of(nu);
+      const Eigen::MatrixXd id = Eigen::MatrixXd::Identity(k, k);
+      T_partials_return lp(0.0);
+      // gradients of the density as a function of symmetric W and S
+      matrix_d W_grad = matrix_d::Zero(k, k);
+      matrix_d S_grad = matrix_d::Zero(k, k);
+
+      if (include_summand<propto, T_dof>::value) {
+        lp -= lmgamma(k, 0.5 * nu_dbl);
+        if (!is_constant_struct<T_dof>::value)
+          ops_partials.edge2_.partials_[0]
+            -= 0.5 * internal::lmgamma_derivative(k, 0.5 * nu_dbl);
       }
-      if (include_summand<propto, T_y, T_dof, T_scale>::value) {
-        lp -= 0.5 * (nu + k + 1.0) * log_determinant_ldlt(ldlt_W);
+      if (include_summand<propto, T_dof, T_scale>::value) {
+        T_partials_return log_det_S = log_determinant_ldlt(ldlt_S);
+        lp += 0.5 * nu_dbl * log_det_S + nu_dbl * k * NEG_LOG_TWO_OVER_TWO;
+        if (!is_constant_struct<T_dof>::value)
+          ops_partials.edge2_.partials_[0]
+            += 0.5 * log_det_S + k * NEG_LOG_TWO_OVER_TWO;
+        if (!is_constant_struct<T_S>::value)
+          S_grad += 0.5 * nu_dbl * mdivide_left_ldlt(ldlt_S, id);
       }
+
+      matrix_d W_inv = mdivide_left_ldlt(ldlt_W, id);
+      T_partials_return log_det_W = log_determinant_ldlt(ldlt_W);
+      lp -= 0.5 * (nu_dbl + k + 1.0) * log_det_W;
+      if (!is_constant_struct<T_dof>::value)
+        ops_partials.edge2_.partials_[0] -= 0.5 * log_det_W;
+      if (!is_constant_struct<T_W>::value)
+        W_grad -= 0.5 * (nu_dbl + k + 1.0) * W_inv;
+
       if (include_summand<propto, T_y, T_scale>::value) {
-        //    L = crossprod(mdivide_left_tri_low(L));
-        //    Eigen::Matrix<T_y, Eigen::Dynamic, 1> W_inv_vec = Eigen::Map<
-        //      const Eigen::Matrix<T_y, Eigen::Dynamic, Eigen::Dynamic> >(
-        //      &L(0), L.size(), 1);
-        //    Eigen::Matrix<T_scale, Eigen::Dynamic, 1> S_vec = Eigen::Map<
-        //      const Eigen::Matrix<T_scale, Eigen::Dynamic, Eigen::Dynamic> >(
-        //      &S(0), S.size(), 1);
-        //    lp -= 0.5 * dot_product(S_vec, W_inv_vec); // trace(S * W^-1)
-        Eigen::Matrix<typename promote_args<T_y, T_scale>::type,
-                      Eigen::Dynamic, Eigen::Dynamic>
-          Winv_S(mdivide_left_ldlt
-                 (ldlt_W,
-                  static_cast<Eigen::Matrix
-                  <T_scale, Eigen::Dynamic, Eigen::Dynamic> >
-                  (S.template selfadjointView<Eigen::Lower>())));
-        lp -= 0.5*trace(Winv_S);
+        matrix_d S_sym = S_dbl.template selfadjointView<Eigen::Lower>();
+        lp -= 0.5 * W_inv.cwiseProduct(S_sym).sum();
+        if (!is_constant_struct<T_W>::value)
+          W_grad += 0.5 * W_inv * S_sym * W_inv;
+        if (!is_constant_struct<T_S>::value)
+          S_grad -= 0.5 * W_inv;
       }
-      if (include_summand<propto, T_dof, T_scale>::value)
-        lp += nu * k * NEG_LOG_TWO_OVER_TWO;
-      return lp;
+
+      if (!is_constant_struct<T_W>::value)
+        internal::lower_partials(W_grad, ops_partials.edge1_.partials_);
+      if (!is_constant_struct<T_S>::value)
+        internal::lower_partials(S_grad, ops_partials.edge3_.partials_);
+      return ops_partials.build(lp);
     }
 
     template <typename T_y, typename T_dof, typename T_scale>
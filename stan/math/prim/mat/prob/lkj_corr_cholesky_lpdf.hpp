@@ -4,7 +4,13 @@
 #include <stan/math/prim/scal/err/check_finite.hpp>
 #include <stan/math/prim/scal/err/check_positive.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/fun/digamma.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
 #include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
+#include <stan/math/prim/mat/err/check_lower_triangular.hpp>
 #include <stan/math/prim/mat/fun/factor_cov_matrix.hpp>
 #include <stan/math/prim/mat/fun/factor_U.hpp>
 #include <stan/math/prim/mat/fun/read_corr_L.hpp>
@@ -50,6 +56,8 @@ namespace stan {
 
     // LKJ_Corr(L|eta) [ L Cholesky factor of correlation matrix
     //                  eta > 0; eta == 1 <-> uniform]
+    // The density only depends on the diagonal of L, which is the only
+    // operand, and the partials are computed on doubles in one pass.
     template <bool propto,
               typename T_covar, typename T_shape>
     typename boost::math::tools::promote_args<T_covar, T_shape>::type
@@ -57,37 +65,50 @@ namespace stan {
                           <T_covar, Eigen::Dynamic, Eigen::Dynamic>& L,
                           const T_shape& eta) {
       static const char* function = "lkj_corr_cholesky_lpdf";
+      typedef typename stan::partials_return_type<T_covar, T_shape>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_covar, Eigen::Dynamic, 1> T_L_diag;
 
-      using boost::math::tools::promote_args;
+      using std::log;
 
-      typedef typename promote_args<T_covar, T_shape>::type lp_ret;
-      lp_ret lp(0.0);
       check_positive(function, "Shape parameter", eta);
       check_lower_triangular(function, "Random variable", L);
 
-      const unsigned int K = L.rows();
+      const int K = L.rows();
       if (K == 0)
         return 0.0;
 
-      if (include_summand<propto, T_shape>::value)
-        lp += do_lkj_constant(eta, K);
+      // only the diagonal of L is an operand
+      T_L_diag L_diag = L.diagonal();
+      operands_and_partials<T_L_diag, T_shape> ops_partials(L_diag, eta);
+      const T_partials_return eta_dbl = value_of(eta);
+      const int Km1 = K - 1;
+      T_partials_return lp(0.0);
+
+      if (include_summand<propto, T_shape>::value) {
+        lp += do_lkj_constant(eta_dbl, K);
+        if (!is_constant_struct<T_shape>::value) {
+          T_partials_return d_eta = Km1 * digamma(eta_dbl + 0.5 * Km1);
+          for (int k = 1; k <= Km1; k++)
+            d_eta -= digamma(eta_dbl + 0.5 * (Km1 - k));
+          ops_partials.edge2_.partials_[0] += d_eta;
+        }
+      }
+
       if (include_summand<propto, T_covar, T_shape>::value) {
-        const int Km1 = K - 1;
-        Eigen::Matrix<T_covar, Eigen::Dynamic, 1> log_diagonals =
-          L.diagonal().tail(Km1).array().log();
-        Eigen::Matrix<lp_ret, Eigen::Dynamic, 1> values(Km1);
-        for (int k = 0; k < Km1; k++)
-          values(k) = (Km1 - k - 1) * log_diagonals(k);
-        if ((eta == 1.0) &&
-            stan::is_constant<typename stan::scalar_type<T_shape> >::value) {
-          lp += sum(values);
-          return(lp);
+        for (int k = 1; k < K; k++) {
+          const T_partials_return L_kk = value_of(L_diag(k));
+          const T_partials_return log_L_kk = log(L_kk);
+          const T_partials_return c = Km1 - k + 2.0 * eta_dbl - 2.0;
+          lp += c * log_L_kk;
+          if (!is_constant_struct<T_L_diag>::value)
+            ops_partials.edge1_.partials_[k] = c / L_kk;
+          if (!is_constant_struct<T_shape>::value)
+            ops_partials.edge2_.partials_[0] += 2.0 * log_L_kk;
         }
-        values += multiply(2.0 * eta - 2.0, log_diagonals);
-        lp += sum(values);
       }
 
-      return lp;
+      return ops_partials.build(lp);
     }
 
     template <typename T_covar, typename T_shape>
@@ -6,6 +6,10 @@
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
 #include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/fun/philox_engine.hpp>
+#include <stan/math/prim/arr/functor/parallel_rng_fill.hpp>
 #include <stan/math/prim/mat/fun/columns_dot_product.hpp>
 #include <stan/math/prim/mat/fun/columns_dot_self.hpp>
 #include <stan/math/prim/mat/fun/dot_product.hpp>
@@ -17,6 +21,7 @@
 #include <stan/math/prim/mat/fun/multiply.hpp>
 #include <stan/math/prim/mat/fun/subtract.hpp>
 #include <stan/math/prim/mat/fun/sum.hpp>
+#include <stan/math/prim/mat/prob/normal_rng.hpp>
 
 #include <stan/math/prim/scal/fun/constants.hpp>
 #include <stan/math/prim/scal/meta/include_summand.hpp>
@@ -44,6 +49,43 @@ namespace stan {
 
       return mu + S * z;
     }
+
+    /**
+     * Return N pseudo-random vectors with a multi-variate normal
+     * distribution given the specified location parameter and
+     * Cholesky factor of the covariance matrix, generated in chunks
+     * from the specified counter-based engine on up to the specified
+     * number of threads. The draws are the columns of the result and
+     * do not depend on the number of threads; the engine is advanced
+     * past the draws on return.
+     *
+     * @tparam T_loc Type of location parameter, a vector of doubles.
+     * @param mu Location parameter.
+     * @param L Cholesky factor of the covariance matrix.
+     * @param N Number of draws.
+     * @param rng Counter-based pseudo-random number generator.
+     * @param num_threads Maximum number of threads to use.
+     * @return Matrix with one draw per column.
+     */
+    template <typename T_loc>
+    inline Eigen::MatrixXd
+    multi_normal_cholesky_rng(const T_loc& mu,
+                              const Eigen::MatrixXd& L, int N,
+                              philox_engine& rng, int num_threads = 1) {
+      static const char* function = "multi_normal_cholesky_rng";
+      check_finite(function, "Location parameter", mu);
+      check_size_match(function, "Size of location parameter", mu.size(),
+                       "rows of covariance parameter", L.rows());
+      check_nonnegative(function, "Number of draws", N);
+      check_positive(function, "Number of threads", num_threads);
+
+      Eigen::MatrixXd z(L.cols(), N);
+      parallel_rng_fill(z.size(), rng, num_threads,
+                        internal::std_normal_rng_chunk(z.data()));
+      Eigen::MatrixXd y = L * z;
+      y.colwise() += mu;
+      return y;
+    }
   }
 }
 #endif
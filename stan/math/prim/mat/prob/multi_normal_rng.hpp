@@ -9,6 +9,8 @@
 #include <stan/math/prim/mat/err/check_symmetric.hpp>
 #include <stan/math/prim/mat/fun/trace_inv_quad_form_ldlt.hpp>
 #include <stan/math/prim/mat/fun/log_determinant_ldlt.hpp>
+#include <stan/math/prim/mat/prob/multi_normal_cholesky_rng.hpp>
+#include <stan/math/prim/scal/fun/philox_engine.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 
@@ -57,6 +59,42 @@ namespace stan {
       return mu + llt_of_S.matrixL() * z;
     }
 
+    /**
+     * Return N pseudo-random vectors with a multi-variate normal
+     * distribution given the specified location parameter and
+     * covariance matrix, generated in chunks from the specified
+     * counter-based engine on up to the specified number of threads.
+     * The covariance matrix is factored once for all of the draws.
+     * The draws are the columns of the result and do not depend on
+     * the number of threads; the engine is advanced past the draws on
+     * return.
+     *
+     * @tparam T_loc Type of location parameter, a vector of doubles.
+     * @param mu Location parameter.
+     * @param S Covariance parameter.
+     * @param N Number of draws.
+     * @param rng Counter-based pseudo-random number generator.
+     * @param num_threads Maximum number of threads to use.
+     * @return Matrix with one draw per column.
+     */
+    template <typename T_loc>
+    inline Eigen::MatrixXd
+    multi_normal_rng(const T_loc& mu, const Eigen::MatrixXd& S, int N,
+                     philox_engine& rng, int num_threads = 1) {
+      static const char* function = "multi_normal_rng";
+
+      check_positive(function, "Covariance matrix rows", S.rows());
+      check_symmetric(function, "Covariance matrix", S);
+      check_finite(function, "Location parameter", mu);
+
+      Eigen::LLT<Eigen::MatrixXd> llt_of_S = S.llt();
+      check_pos_definite("multi_normal_rng", "covariance matrix argument",
+                         llt_of_S);
+
+      return multi_normal_cholesky_rng(mu, llt_of_S.matrixL(), N, rng,
+                                       num_threads);
+    }
+
   }
 }
 #endif
@@ -5,6 +5,7 @@
 #include <stan/math/prim/scal/meta/partials_return_type.hpp>
 #include <stan/math/prim/scal/meta/operands_and_partials.hpp>
 #include <stan/math/prim/scal/err/check_consistent_sizes.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
 #include <stan/math/prim/scal/err/check_positive_finite.hpp>
 #include <stan/math/prim/scal/err/check_nonnegative.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
@@ -15,6 +16,7 @@
 #include <stan/math/prim/scal/fun/log_sum_exp.hpp>
 #include <stan/math/prim/scal/fun/value_of.hpp>
 #include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/functor/glm_tile_sweep.hpp>
 #include <stan/math/prim/scal/meta/include_summand.hpp>
 #include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
 #include <cmath>
@@ -26,11 +28,14 @@ namespace stan {
      * Returns the log PMF of the Generalized Linear Model (GLM)
      * with Negative-Binomial-2 distribution and log link function.
      * If containers are supplied, returns the log sum of the probabilities.
+     * The rows of x are swept in tiles, which may be spread over several
+     * threads (see <code>glm_tile_sweep()</code>).
      * @tparam T_n type of positive int vector of variates (labels);
      * this can also be a single positive integer value;
      * @tparam T_x type of the matrix of covariates (features); this
      * should be an Eigen::Matrix type whose number of rows should match the 
-     * length of n and whose number of columns should match the length of beta
+     * length of n and whose number of columns should match the length of beta;
+     * it can also be a mapped_matrix streamed from a file
      * @tparam T_beta type of the weight vector;
      * this can also be a scalar;
      * @tparam T_alpha type of the intercept;
@@ -42,23 +47,29 @@ namespace stan {
      * @param beta weight vector
      * @param alpha intercept (in log odds)
      * @param phi (vector of) precision parameters
+     * @param num_threads maximum number of threads to use; a single
+     * thread is used for arguments of nested autodiff types such as
+     * fvar<var>
      * @return log probability or log sum of probabilities
      * @throw std::invalid_argument if container sizes mismatch.
      * @throw std::domain_error if x, beta or alpha is infinite.
      * @throw std::domain_error if phi is infinite or non-positive.
      * @throw std::domain_error if n is negative.
+     * @throw std::domain_error if num_threads is not positive.
      */
     template <bool propto, typename T_n, typename T_x, typename T_beta,
               typename T_alpha, typename T_precision>
     typename return_type<T_x, T_beta, T_alpha, T_precision>::type
     neg_binomial_2_log_glm_lpmf(const T_n &n, const T_x &x, const T_beta &beta,
-                             const T_alpha &alpha, const T_precision &phi) {
+                             const T_alpha &alpha, const T_precision &phi,
+                             int num_threads = 1) {
       static const char* function = "neg_binomial_2_log_glm_lpmf";
       typedef typename stan::partials_return_type<T_n, T_x, T_beta,
                                                   T_alpha, T_precision>::type
         T_partials_return;
 
       using std::exp;
+      using std::log;
       using Eigen::Dynamic;
       using Eigen::Matrix;
       using Eigen::Array;
@@ -83,6 +94,7 @@ namespace stan {
       check_consistent_sizes(function,
                              "Columns in matrix of independent variables",
                              x.row(0), "Weight vector",  beta);
+      check_positive(function, "Number of threads", num_threads);
 
       if (!include_summand<propto, T_x, T_beta, T_alpha, T_precision>::value)
         return 0.0;
@@ -90,17 +102,6 @@ namespace stan {
       const size_t N = x.col(0).size();
       const size_t M = x.row(0).size();
 
-      Array<T_partials_return, Dynamic, 1> n_arr(N, 1);
-      Array<T_partials_return, Dynamic, 1> phi_arr(N, 1);
-      {
-        scalar_seq_view<T_n> n_vec(n);
-        scalar_seq_view<T_precision> phi_vec(phi);
-        for (size_t n = 0; n < N; ++n) {
-          n_arr[n] = n_vec[n];
-          phi_arr[n] = value_of(phi_vec[n]);
-        }
-      }
-
       Matrix<T_partials_return, Dynamic, 1> beta_dbl(M, 1);
       {
         scalar_seq_view<T_beta> beta_vec(beta);
@@ -108,76 +109,69 @@ namespace stan {
           beta_dbl[m] = value_of(beta_vec[m]);
         }
       }
-      Matrix<T_partials_return, Dynamic, Dynamic> x_dbl = value_of(x);
-
-      Array<T_partials_return, Dynamic, 1> theta_dbl = (x_dbl * beta_dbl
-      + Matrix<double, Dynamic, 1>::Ones(N, 1) * value_of(alpha)).array();
-      Array<T_partials_return, Dynamic, 1> log_phi = phi_arr.log();
-      Array<T_partials_return, Dynamic, 1> logsumexp_eta_logphi =
-        theta_dbl.binaryExpr(log_phi,
-                             [](const T_partials_return& xx,
-                                const T_partials_return& yy) {
-                               return log_sum_exp(xx, yy);
-                             });
-      Array<T_partials_return, Dynamic, 1> n_plus_phi = n_arr + phi_arr;
-
-      // Compute the log-density.
-      if (include_summand<propto>::value) {
-        logp -= (n_arr
-          + Array<double, Dynamic, 1>::Ones(N, 1))
-          .unaryExpr([](const T_partials_return& xx) {
-                       return lgamma(xx);
-                     }).sum();
-      }
-      if (include_summand<propto, T_precision>::value) {
-        logp += (phi_arr.binaryExpr(phi_arr, [](const T_partials_return& xx,
-                                                const T_partials_return& yy) {
-                                                  return multiply_log(xx, yy);
-                                              })
-                - phi_arr.unaryExpr([](const T_partials_return& xx) {
-                                      return lgamma(xx);
-                                    })).sum();
-      }
-      if (include_summand<propto, T_x, T_beta, T_alpha, T_precision>::value)
-        logp -= (n_plus_phi * logsumexp_eta_logphi).sum();
-      if (include_summand<propto, T_x, T_beta, T_alpha>::value)
-        logp += (n_arr * theta_dbl).sum();
-      if (include_summand<propto, T_precision>::value) {
-        logp += n_plus_phi.unaryExpr([](const T_partials_return& xx) {
-          return lgamma(xx);
-        }).sum();
-      }
+      scalar_seq_view<T_n> n_vec(n);
+      scalar_seq_view<T_precision> phi_vec(phi);
+
+      // Compute the log-density and its derivatives with respect to the
+      // linear predictors and the precisions.
+      Matrix<T_partials_return, Dynamic, 1> beta_derivative;
+      T_partials_return alpha_derivative(0.0);
+      Matrix<T_partials_return, Dynamic, 1> theta_derivative;
+      Matrix<T_partials_return, Dynamic, 1> phi_derivative;
+      if (!is_constant_struct<T_precision>::value)
+        phi_derivative.resize(N);
+      logp = glm_tile_sweep(
+          x, beta_dbl, T_partials_return(value_of(alpha)), num_threads,
+          [&n_vec, &phi_vec, &phi_derivative](
+              size_t begin, const Array<T_partials_return, Dynamic, 1>& theta,
+              Array<T_partials_return, Dynamic, 1>& derivative) {
+            T_partials_return logp(0.0);
+            for (int i = 0; i < theta.size(); ++i) {
+              T_partials_return n_i = n_vec[begin + i];
+              T_partials_return phi_i = value_of(phi_vec[begin + i]);
+              T_partials_return exp_theta = exp(theta[i]);
+              T_partials_return log_phi = log(phi_i);
+              T_partials_return logsumexp_eta_logphi
+                = log_sum_exp(theta[i], log_phi);
+              T_partials_return n_plus_phi = n_i + phi_i;
+              if (include_summand<propto>::value)
+                logp -= lgamma(n_i + 1);
+              if (include_summand<propto, T_precision>::value)
+                logp += multiply_log(phi_i, phi_i) - lgamma(phi_i)
+                  + lgamma(n_plus_phi);
+              if (include_summand<propto, T_x, T_beta, T_alpha,
+                                  T_precision>::value)
+                logp -= n_plus_phi * logsumexp_eta_logphi;
+              if (include_summand<propto, T_x, T_beta, T_alpha>::value)
+                logp += n_i * theta[i];
+              derivative[i] = n_i - n_plus_phi / (phi_i / exp_theta + 1);
+              if (!is_constant_struct<T_precision>::value)
+                phi_derivative[begin + i]
+                  = 1 - n_plus_phi / (exp_theta + phi_i) + log_phi
+                  - logsumexp_eta_logphi - digamma(phi_i)
+                  + digamma(n_plus_phi);
+            }
+            return logp;
+          },
+          is_constant_struct<T_beta>::value ? 0 : &beta_derivative,
+          is_constant_struct<T_alpha>::value ? 0 : &alpha_derivative,
+          is_constant_struct<T_x>::value ? 0 : &theta_derivative);
 
       // Compute the necessary derivatives.
       operands_and_partials<T_x, T_beta, T_alpha,
                             T_precision> ops_partials(x, beta, alpha, phi);
-
-      if (!(is_constant_struct<T_x>::value && is_constant_struct<T_beta>::value
-            && is_constant_struct<T_alpha>::value)) {
-        Matrix<T_partials_return, Dynamic, 1> theta_derivative(N, 1);
-        theta_derivative = (n_arr - (n_plus_phi / (phi_arr / (theta_dbl.exp())
-          + Array<double, Dynamic, 1>::Ones(N, 1)))).matrix();
-        if (!is_constant_struct<T_beta>::value) {
-          ops_partials.edge2_.partials_ = x_dbl.transpose() * theta_derivative;
-        }
-        if (!is_constant_struct<T_x>::value) {
-          ops_partials.edge1_.partials_ = theta_derivative
-            * beta_dbl.transpose();
-        }
-        if (!is_constant_struct<T_alpha>::value) {
-          ops_partials.edge3_.partials_[0] = theta_derivative.trace();
-        }
+      if (!is_constant_struct<T_beta>::value) {
+        ops_partials.edge2_.partials_ = beta_derivative;
+      }
+      if (!is_constant_struct<T_x>::value) {
+        ops_partials.edge1_.partials_ = theta_derivative
+          * beta_dbl.transpose();
+      }
+      if (!is_constant_struct<T_alpha>::value) {
+        ops_partials.edge3_.partials_[0] = alpha_derivative;
       }
       if (!is_constant_struct<T_precision>::value) {
-        ops_partials.edge4_.partials_ = (Array<double, Dynamic, 1>::Ones(N, 1)
-          - n_plus_phi / (theta_dbl.exp() + phi_arr) + log_phi
-          - logsumexp_eta_logphi
-          - phi_arr.unaryExpr([](const T_partials_return& xx) {
-                                return digamma(xx);
-                              })
-          + n_plus_phi.unaryExpr([](const T_partials_return& xx) {
-                                   return digamma(xx);
-                                 })).matrix();
+        ops_partials.edge4_.partials_ = phi_derivative;
       }
       return ops_partials.build(logp);
     }
@@ -188,8 +182,10 @@ namespace stan {
         typename return_type<T_x, T_beta, T_alpha, T_precision>::type
         neg_binomial_2_log_glm_lpmf(const T_n &n, const T_x &x,
                                     const T_beta &beta, const T_alpha &alpha,
-                                    const T_precision& phi) {
-      return neg_binomial_2_log_glm_lpmf<false>(n, x, beta, alpha, phi);
+                                    const T_precision& phi,
+                                    int num_threads = 1) {
+      return neg_binomial_2_log_glm_lpmf<false>(n, x, beta, alpha, phi,
+                                                num_threads);
     }
   }  // namespace math
 }  // namespace stan
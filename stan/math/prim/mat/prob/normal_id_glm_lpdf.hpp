@@ -6,9 +6,11 @@
 #include <stan/math/prim/scal/meta/operands_and_partials.hpp>
 #include <stan/math/prim/scal/err/check_consistent_sizes.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
 #include <stan/math/prim/scal/fun/value_of.hpp>
 #include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/functor/glm_tile_sweep.hpp>
 #include <stan/math/prim/scal/meta/include_summand.hpp>
 #include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
 #include <cmath>
@@ -20,11 +22,14 @@ namespace stan {
      * Returns the log PDF of the Generalized Linear Model (GLM)
      * with Normal distribution and id link function.
      * If containers are supplied, returns the log sum of the probabilities.
+     * The rows of x are swept in tiles, which may be spread over several
+     * threads (see <code>glm_tile_sweep()</code>).
      * @tparam T_n type of vector of dependent variables (labels);
      * this can also be a single value;
      * @tparam T_x type of the matrix of independent variables (features); this
      * should be an Eigen::Matrix type whose number of rows should match the
-     * length of n and whose number of columns should match the length of beta
+     * length of n and whose number of columns should match the length of beta;
+     * it can also be a mapped_matrix streamed from a file
      * @tparam T_beta type of the weight vector;
      * this can also be a single value;
      * @tparam T_alpha type of the intercept;
@@ -36,22 +41,28 @@ namespace stan {
      * @param alpha intercept (in log odds)
      * @param sigma (Sequence of) scale parameters for the normal
      * distribution.
+     * @param num_threads maximum number of threads to use; a single
+     * thread is used for arguments of nested autodiff types such as
+     * fvar<var>
      * @return log probability or log sum of probabilities
      * @throw std::domain_error if x, beta or alpha is infinite.
      * @throw std::domain_error if the scale is not positive.
+     * @throw std::domain_error if num_threads is not positive.
      * @throw std::invalid_argument if container sizes mismatch.
      */
     template <bool propto, typename T_n, typename T_x, typename T_beta,
               typename T_alpha, typename T_scale>
     typename return_type<T_n, T_x, T_beta, T_alpha, T_scale>::type
     normal_id_glm_lpdf(const T_n &n, const T_x &x, const T_beta &beta,
-                             const T_alpha &alpha, const T_scale& sigma) {
+                             const T_alpha &alpha, const T_scale& sigma,
+                             int num_threads = 1) {
       static const char* function = "normal_id_glm_lpdf";
       typedef typename stan::partials_return_type<T_n, T_x, T_beta,
                                                   T_alpha, T_scale>::type
         T_partials_return;
 
       using std::exp;
+      using std::log;
       using Eigen::Dynamic;
       using Eigen::Matrix;
       using Eigen::Array;
@@ -76,6 +87,7 @@ namespace stan {
       check_consistent_sizes(function,
                              "Columns in matrix of independent variables",
                              x.row(0), "Weight vector",  beta);
+      check_positive(function, "Number of threads", num_threads);
 
       if (!include_summand<propto, T_n, T_x, T_beta, T_alpha, T_scale>::value)
         return 0.0;
@@ -83,17 +95,6 @@ namespace stan {
       const size_t N = x.col(0).size();
       const size_t M = x.row(0).size();
 
-      Array<T_partials_return, Dynamic, 1> sigma_dbl(N, 1);
-      Array<T_partials_return, Dynamic, 1> n_dbl(N, 1);
-      {
-        scalar_seq_view<T_n> n_vec(n);
-        scalar_seq_view<T_scale> sigma_vec(sigma);
-        for (size_t n = 0; n < N; ++n) {
-          sigma_dbl[n] = value_of(sigma_vec[n]);
-          n_dbl[n] = value_of(n_vec[n]);
-        }
-      }
-      Array<T_partials_return, Dynamic, 1> inv_sigma = 1/sigma_dbl;
       Matrix<T_partials_return, Dynamic, 1> beta_dbl(M, 1);
       {
         scalar_seq_view<T_beta> beta_vec(beta);
@@ -101,48 +102,68 @@ namespace stan {
           beta_dbl[m] = value_of(beta_vec[m]);
         }
       }
-      Matrix<T_partials_return, Dynamic, Dynamic> x_dbl = value_of(x);
-
-      Array<T_partials_return, Dynamic, 1> mu_dbl = (x_dbl * beta_dbl
-        + Matrix<double, Dynamic, 1>::Ones(N, 1)
-        * value_of(alpha)).array();
-      Array<T_partials_return, Dynamic, 1> n_minus_mu_over_sigma =
-        (n_dbl - mu_dbl) * inv_sigma;
-      Array<T_partials_return, Dynamic, 1> n_minus_mu_over_sigma_squared
-        = n_minus_mu_over_sigma.square();
+      scalar_seq_view<T_n> n_vec(n);
+      scalar_seq_view<T_scale> sigma_vec(sigma);
 
       if (include_summand<propto>::value)
         logp += NEG_LOG_SQRT_TWO_PI * N;
-      if (include_summand<propto, T_scale>::value)
-        logp -= sigma_dbl.log().sum();
-      if (include_summand<propto, T_n, T_x, T_beta, T_alpha, T_scale>::value)
-        logp -= 0.5 * n_minus_mu_over_sigma_squared.sum();
+
+      // Compute the log-density and its derivatives with respect to the
+      // means and the scales.
+      Matrix<T_partials_return, Dynamic, 1> beta_derivative;
+      T_partials_return alpha_derivative(0.0);
+      Matrix<T_partials_return, Dynamic, 1> mu_derivative;
+      Matrix<T_partials_return, Dynamic, 1> sigma_derivative;
+      if (!is_constant_struct<T_scale>::value)
+        sigma_derivative.resize(N);
+      logp += glm_tile_sweep(
+          x, beta_dbl, T_partials_return(value_of(alpha)), num_threads,
+          [&n_vec, &sigma_vec, &sigma_derivative](
+              size_t begin, const Array<T_partials_return, Dynamic, 1>& mu,
+              Array<T_partials_return, Dynamic, 1>& derivative) {
+            T_partials_return logp(0.0);
+            for (int i = 0; i < mu.size(); ++i) {
+              T_partials_return sigma_dbl = value_of(sigma_vec[begin + i]);
+              T_partials_return inv_sigma = 1 / sigma_dbl;
+              T_partials_return n_minus_mu_over_sigma
+                = (value_of(n_vec[begin + i]) - mu[i]) * inv_sigma;
+              T_partials_return n_minus_mu_over_sigma_squared
+                = n_minus_mu_over_sigma * n_minus_mu_over_sigma;
+              if (include_summand<propto, T_scale>::value)
+                logp -= log(sigma_dbl);
+              if (include_summand<propto, T_n, T_x, T_beta, T_alpha,
+                                  T_scale>::value)
+                logp -= 0.5 * n_minus_mu_over_sigma_squared;
+              derivative[i] = inv_sigma * n_minus_mu_over_sigma;
+              if (!is_constant_struct<T_scale>::value)
+                sigma_derivative[begin + i]
+                  = inv_sigma * (n_minus_mu_over_sigma_squared - 1);
+            }
+            return logp;
+          },
+          is_constant_struct<T_beta>::value ? 0 : &beta_derivative,
+          is_constant_struct<T_alpha>::value ? 0 : &alpha_derivative,
+          is_constant_struct<T_n>::value && is_constant_struct<T_x>::value
+          ? 0 : &mu_derivative);
 
       // Compute the necessary derivatives.
       operands_and_partials<T_n, T_x, T_beta, T_alpha, T_scale> ops_partials(n,
       x, beta, alpha, sigma);
-      if (!(is_constant_struct<T_n>::value && is_constant_struct<T_x>::value
-            && is_constant_struct<T_beta>::value
-            && is_constant_struct<T_alpha>::value)) {
-        Matrix<T_partials_return, Dynamic, 1> mu_derivative = (inv_sigma
-          * n_minus_mu_over_sigma).matrix();
-        if (!is_constant_struct<T_n>::value) {
-          ops_partials.edge1_.partials_ = - mu_derivative;
-        }
-        if (!is_constant_struct<T_x>::value) {
-          ops_partials.edge2_.partials_ = mu_derivative
-            * beta_dbl.transpose();
-        }
-        if (!is_constant_struct<T_beta>::value) {
-          ops_partials.edge3_.partials_ = x_dbl.transpose() * mu_derivative;
-        }
-        if (!is_constant_struct<T_alpha>::value) {
-          ops_partials.edge4_.partials_[0] = mu_derivative.trace();
-        }
-        if (!is_constant_struct<T_scale>::value) {
-          ops_partials.edge5_.partials_ = ((inv_sigma - Array<double,
-            Dynamic, 1>::Ones(N, 1)) * n_minus_mu_over_sigma_squared).matrix();
-        }
+      if (!is_constant_struct<T_n>::value) {
+        ops_partials.edge1_.partials_ = - mu_derivative;
+      }
+      if (!is_constant_struct<T_x>::value) {
+        ops_partials.edge2_.partials_ = mu_derivative
+          * beta_dbl.transpose();
+      }
+      if (!is_constant_struct<T_beta>::value) {
+        ops_partials.edge3_.partials_ = beta_derivative;
+      }
+      if (!is_constant_struct<T_alpha>::value) {
+        ops_partials.edge4_.partials_[0] = alpha_derivative;
+      }
+      if (!is_constant_struct<T_scale>::value) {
+        ops_partials.edge5_.partials_ = sigma_derivative;
       }
 
       return ops_partials.build(logp);
@@ -153,8 +174,10 @@ namespace stan {
     inline
         typename return_type<T_n, T_x, T_beta, T_alpha, T_scale>::type
         normal_id_glm_lpdf(const T_n &n, const T_x &x, const T_beta &beta,
-                                 const T_alpha &alpha, const T_scale& sigma) {
-      return normal_id_glm_lpdf<false>(n, x, beta, alpha, sigma);
+                                 const T_alpha &alpha, const T_scale& sigma,
+                                 int num_threads = 1) {
+      return normal_id_glm_lpdf<false>(n, x, beta, alpha, sigma,
+                                       num_threads);
     }
   }  // namespace math
 }  // namespace stan
@@ -0,0 +1,117 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_NORMAL_RNG_HPP
+#define STAN_MATH_PRIM_MAT_PROB_NORMAL_RNG_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/arr/functor/parallel_rng_fill.hpp>
+#include <stan/math/prim/scal/err/check_consistent_size.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/err/check_positive_finite.hpp>
+#include <stan/math/prim/scal/fun/philox_engine.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+#include <stan/math/prim/scal/prob/normal_rng.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <cstddef>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      /**
+       * Write n standard normal variates to out, constructing the
+       * distribution once for the whole chunk.
+       *
+       * @param out destination of length n
+       * @param n number of variates
+       * @param rng engine
+       */
+      inline void std_normal_fill(double* out, size_t n,
+                                  philox_engine& rng) {
+        boost::random::normal_distribution<> std_normal(0, 1);
+        for (size_t i = 0; i < n; ++i)
+          out[i] = std_normal(rng);
+      }
+
+      struct std_normal_rng_chunk {
+        double* out_;
+
+        explicit std_normal_rng_chunk(double* out) : out_(out) { }
+
+        void operator()(size_t begin, size_t end,
+                        philox_engine& rng) const {
+          std_normal_fill(out_ + begin, end - begin, rng);
+        }
+      };
+
+      template <typename T_loc, typename T_scale>
+      struct normal_rng_chunk {
+        const scalar_seq_view<T_loc>& mu_vec_;
+        const scalar_seq_view<T_scale>& sigma_vec_;
+        double* out_;
+
+        normal_rng_chunk(const scalar_seq_view<T_loc>& mu_vec,
+                         const scalar_seq_view<T_scale>& sigma_vec,
+                         double* out)
+          : mu_vec_(mu_vec), sigma_vec_(sigma_vec), out_(out) { }
+
+        void operator()(size_t begin, size_t end,
+                        philox_engine& rng) const {
+          std_normal_fill(out_ + begin, end - begin, rng);
+          for (size_t n = begin; n < end; ++n)
+            out_[n] = mu_vec_[n] + sigma_vec_[n] * out_[n];
+        }
+      };
+
+    }
+
+    /**
+     * Return a vector of N pseudorandom Normal variates for the given
+     * location and scale, generated in chunks from the specified
+     * counter-based engine on up to the specified number of threads.
+     *
+     * <p>mu and sigma can each be a scalar, a std::vector, an
+     * Eigen::Vector, or an Eigen::RowVector. Non-scalar inputs must
+     * have length N. The draws depend only on the state of the engine
+     * and not on the number of threads; the engine is advanced past
+     * the draws on return.
+     *
+     * @tparam T_loc Type of location parameter
+     * @tparam T_scale Type of scale parameter
+     * @param mu (Sequence of) location parameter(s)
+     * @param sigma (Sequence of) positive scale parameter(s)
+     * @param N number of draws
+     * @param rng counter-based random number generator
+     * @param num_threads maximum number of threads to use
+     * @return Normal random variates
+     * @throw std::domain_error if mu is infinite, sigma is nonpositive,
+     * N is negative or num_threads is not positive
+     * @throw std::invalid_argument if non-scalar arguments are not of
+     * length N
+     */
+    template <typename T_loc, typename T_scale>
+    inline Eigen::VectorXd
+    normal_rng(const T_loc& mu, const T_scale& sigma, int N,
+               philox_engine& rng, int num_threads = 1) {
+      static const char* function = "normal_rng";
+
+      check_finite(function, "Location parameter", mu);
+      check_positive_finite(function, "Scale parameter", sigma);
+      check_nonnegative(function, "Number of draws", N);
+      check_positive(function, "Number of threads", num_threads);
+      check_consistent_size(function, "Location parameter", mu, N);
+      check_consistent_size(function, "Scale parameter", sigma, N);
+
+      scalar_seq_view<T_loc> mu_vec(mu);
+      scalar_seq_view<T_scale> sigma_vec(sigma);
+      Eigen::VectorXd output(N);
+      parallel_rng_fill(N, rng, num_threads,
+                        internal::normal_rng_chunk<T_loc, T_scale>
+                        (mu_vec, sigma_vec, output.data()));
+      return output;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,54 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_NORMAL_SUFFICIENT_LPDF_HPP
+#define STAN_MATH_PRIM_MAT_PROB_NORMAL_SUFFICIENT_LPDF_HPP
+
+#include <stan/math/prim/mat/fun/sufficient_stats.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/scal/prob/normal_sufficient_lpdf.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * The log of the normal density of (grouped) observations given
+     * their precomputed sufficient statistics and the mean(s) and
+     * deviation(s) of each group. mu and sigma can each be either a
+     * scalar, shared by all groups, or a vector with one entry per
+     * group.
+     *
+     * <p>The cost is proportional to the number of groups rather than
+     * the number of observations. Every group must contain at least
+     * one observation.
+     *
+     * @tparam T_loc Type of location parameter.
+     * @tparam T_scale Type of scale parameter.
+     * @param y Sufficient statistics of the observations.
+     * @param mu (Sequence of) location parameter(s)
+     * for the normal distribution.
+     * @param sigma (Sequence of) scale parameters for the normal
+     * distribution.
+     * @return The log of the product of the densities.
+     * @throw std::domain_error if a group is empty, if sigma is not
+     * positive or if any parameter is not finite.
+     * @throw std::invalid_argument if the length of a vector
+     * parameter does not match the number of groups.
+     */
+    template <bool propto, typename T_loc, typename T_scale>
+    inline
+    typename return_type<T_loc, T_scale>::type
+    normal_sufficient_lpdf(const sufficient_stats& y, const T_loc& mu,
+                           const T_scale& sigma) {
+      return normal_sufficient_lpdf<propto>(y.mean(), y.sum_sq_dev(),
+                                            y.count(), mu, sigma);
+    }
+
+    template <typename T_loc, typename T_scale>
+    inline
+    typename return_type<T_loc, T_scale>::type
+    normal_sufficient_lpdf(const sufficient_stats& y, const T_loc& mu,
+                           const T_scale& sigma) {
+      return normal_sufficient_lpdf<false>(y, mu, sigma);
+    }
+
+  }
+}
+#endif
@@ -3,6 +3,7 @@
 
 #include <boost/random/uniform_01.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <stan/math/prim/scal/fun/expm1.hpp>
 #include <stan/math/prim/scal/fun/inv_logit.hpp>
 #include <stan/math/prim/scal/fun/log1m.hpp>
 #include <stan/math/prim/scal/fun/log1m_exp.hpp>
@@ -18,7 +19,12 @@
 #include <stan/math/prim/mat/err/check_ordered.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
 #include <stan/math/prim/mat/prob/categorical_rng.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
 #include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
 #include <stan/math/prim/scal/meta/return_type.hpp>
 #include <Eigen/StdVector>
 #include <vector>
@@ -102,6 +108,10 @@ namespace stan {
      * will be the dot product of a vector of regression coefficients
      * and a vector of predictors for the outcome.
      *
+     * <p>The partials are computed on doubles in one pass over the
+     * outcomes, and the result is a single node in the expression
+     * graph.
+     *
      * @tparam propto True if calculating up to a proportion.
      * @tparam T_loc Location type.
      * @tparam T_cut Cut-point type.
@@ -123,9 +133,14 @@ namespace stan {
     ordered_logistic_lpmf(const std::vector<int>& y,
                           const Eigen::Matrix<T_loc, Eigen::Dynamic, 1>& lambda,
                           const Eigen::Matrix<T_cut, Eigen::Dynamic, 1>& c) {
-      typename return_type<T_loc, T_cut>::type logp_n(0.0);
+      typedef typename stan::partials_return_type<T_loc, T_cut>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1> vector_d;
+      typedef Eigen::Matrix<T_loc, Eigen::Dynamic, 1> T_lambda;
+      typedef Eigen::Matrix<T_cut, Eigen::Dynamic, 1> T_c;
 
       using std::exp;
+      using std::expm1;
       using std::log;
 
       static const char* function = "ordered_logistic";
@@ -141,17 +156,47 @@ namespace stan {
       check_finite(function, "Final cut-point", c(c.size()-1));
       check_finite(function, "First cut-point", c(0));
 
+      // the log probabilities and their partials are computed on
+      // doubles, and the partials of the cut-points are accumulated
+      // over the observations
+      vector_d lambda_dbl = value_of(lambda);
+      vector_d c_dbl = value_of(c);
+      operands_and_partials<T_lambda, T_c> ops_partials(lambda, c);
+      T_partials_return logp_n(0.0);
+
       for (int i = 0; i < N; ++i) {
+        T_partials_return d_lambda;
         if (y[i] == 1) {
-          logp_n -= log1p_exp(lambda[i] - c[0]);
+          T_partials_return x = lambda_dbl(i) - c_dbl(0);
+          logp_n -= log1p_exp(x);
+          d_lambda = -inv_logit(x);
+          if (!is_constant_struct<T_c>::value)
+            ops_partials.edge2_.partials_[0] -= d_lambda;
         } else if (y[i] == K) {
-          logp_n -= log1p_exp(c[K-2] - lambda[i]);
+          T_partials_return x = c_dbl(K-2) - lambda_dbl(i);
+          logp_n -= log1p_exp(x);
+          d_lambda = inv_logit(x);
+          if (!is_constant_struct<T_c>::value)
+            ops_partials.edge2_.partials_[K-2] -= d_lambda;
         } else {
-          logp_n += log_inv_logit_diff(c[y[i]-2] - lambda[i],
-                                    c[y[i]-1] - lambda[i]);
+          T_partials_return a = c_dbl(y[i]-2) - lambda_dbl(i);
+          T_partials_return b = c_dbl(y[i]-1) - lambda_dbl(i);
+          logp_n += log_inv_logit_diff(a, b);
+          if (is_constant_struct<T_lambda>::value
+              && is_constant_struct<T_c>::value)
+            continue;
+          T_partials_return d_a = -1 / expm1(b - a) - inv_logit(a);
+          T_partials_return d_b = -1 / expm1(a - b) - inv_logit(b);
+          d_lambda = -d_a - d_b;
+          if (!is_constant_struct<T_c>::value) {
+            ops_partials.edge2_.partials_[y[i]-2] += d_a;
+            ops_partials.edge2_.partials_[y[i]-1] += d_b;
+          }
         }
+        if (!is_constant_struct<T_lambda>::value)
+          ops_partials.edge1_.partials_[i] = d_lambda;
       }
-      return logp_n;
+      return ops_partials.build(logp_n);
     }
 
     template <typename T_loc, typename T_cut>
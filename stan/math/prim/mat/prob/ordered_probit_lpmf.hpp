@@ -8,6 +8,12 @@
 #include <stan/math/prim/scal/err/check_greater.hpp>
 #include <stan/math/prim/scal/err/check_consistent_sizes.hpp>
 #include <stan/math/prim/arr/err/check_ordered.hpp>
+#include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
 #include <stan/math/prim/scal/meta/return_type.hpp>
 #include <Eigen/Dense>
 #include <vector>
@@ -80,6 +86,10 @@ namespace stan {
      * will be the dot product of a vector of regression coefficients
      * and a vector of predictors for the outcome.
      *
+     * <p>The partials are computed on doubles in one pass over the
+     * outcomes, and the result is a single node in the expression
+     * graph.
+     *
      * @tparam propto True if calculating up to a proportion.
      * @tparam T_loc Location type.
      * @tparam T_cut Cut-point type.
@@ -101,6 +111,12 @@ namespace stan {
     ordered_probit_lpmf(const std::vector<int>& y,
                         const Eigen::Matrix<T_loc, Eigen::Dynamic, 1>& lambda,
                         const Eigen::Matrix<T_cut, Eigen::Dynamic, 1>& c) {
+      typedef typename stan::partials_return_type<T_loc, T_cut>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1> vector_d;
+      typedef Eigen::Matrix<T_loc, Eigen::Dynamic, 1> T_lambda;
+      typedef Eigen::Matrix<T_cut, Eigen::Dynamic, 1> T_c;
+
       using std::exp;
       using std::log;
 
@@ -116,19 +132,49 @@ namespace stan {
       check_greater(function, "Size of cut points parameter", c.size(), 0);
       check_finite(function, "Cut-points", c);
 
-      typename return_type<T_loc, T_cut>::type logp_n(0.0);
+      // the log probabilities and their partials are computed on
+      // doubles, and the partials of the cut-points are accumulated
+      // over the observations
+      vector_d lambda_dbl = value_of(lambda);
+      vector_d c_dbl = value_of(c);
+      operands_and_partials<T_lambda, T_c> ops_partials(lambda, c);
+      T_partials_return logp_n(0.0);
 
       for (int i = 0; i < N; ++i) {
+        T_partials_return d_lambda;
         if (y[i] == 1) {
-          logp_n += log1m(Phi(lambda[i] - c[0]));
+          T_partials_return x = lambda_dbl(i) - c_dbl(0);
+          T_partials_return p = 1 - Phi(x);
+          logp_n += log(p);
+          d_lambda = -INV_SQRT_TWO_PI * exp(-0.5 * x * x) / p;
+          if (!is_constant_struct<T_c>::value)
+            ops_partials.edge2_.partials_[0] -= d_lambda;
         } else if (y[i] == K) {
-          logp_n += log(Phi(lambda[i] - c[K-2]));
+          T_partials_return x = lambda_dbl(i) - c_dbl(K-2);
+          T_partials_return p = Phi(x);
+          logp_n += log(p);
+          d_lambda = INV_SQRT_TWO_PI * exp(-0.5 * x * x) / p;
+          if (!is_constant_struct<T_c>::value)
+            ops_partials.edge2_.partials_[K-2] -= d_lambda;
         } else {
-          logp_n += log(Phi(lambda[i] - c[y[i]-2])
-                          - Phi(lambda[i] - c[y[i]-1]));
+          T_partials_return x_lo = lambda_dbl(i) - c_dbl(y[i]-2);
+          T_partials_return x_hi = lambda_dbl(i) - c_dbl(y[i]-1);
+          T_partials_return p = Phi(x_lo) - Phi(x_hi);
+          logp_n += log(p);
+          T_partials_return d_lo = INV_SQRT_TWO_PI
+            * exp(-0.5 * x_lo * x_lo) / p;
+          T_partials_return d_hi = -INV_SQRT_TWO_PI
+            * exp(-0.5 * x_hi * x_hi) / p;
+          d_lambda = d_lo + d_hi;
+          if (!is_constant_struct<T_c>::value) {
+            ops_partials.edge2_.partials_[y[i]-2] -= d_lo;
+            ops_partials.edge2_.partials_[y[i]-1] -= d_hi;
+          }
         }
+        if (!is_constant_struct<T_lambda>::value)
+          ops_partials.edge1_.partials_[i] = d_lambda;
       }
-      return logp_n;
+      return ops_partials.build(logp_n);
     }
 
     template <typename T_loc, typename T_cut>
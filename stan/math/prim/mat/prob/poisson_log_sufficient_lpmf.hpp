@@ -0,0 +1,113 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_POISSON_LOG_SUFFICIENT_LPMF_HPP
+#define STAN_MATH_PRIM_MAT_PROB_POISSON_LOG_SUFFICIENT_LPMF_HPP
+
+#include <stan/math/prim/mat/fun/sufficient_stats.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/err/check_consistent_size.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/domain_error.hpp>
+#include <stan/math/prim/scal/fun/size_zero.hpp>
+#include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+#include <cmath>
+#include <limits>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * The log of the Poisson probability mass of (grouped) counts
+     * given their precomputed sufficient statistics and the log
+     * rate(s) of each group. alpha can be either a scalar, shared by
+     * all groups, or a vector with one entry per group.
+     *
+     * <p>The cost is proportional to the number of groups rather than
+     * the number of observations. The data-only term
+     * <code>-lgamma(n + 1)</code> is read from the precomputed
+     * statistics and dropped entirely when <code>propto</code> is
+     * <code>true</code>.
+     *
+     * @tparam T_log_rate Type of log rate parameter.
+     * @param n Sufficient statistics of the counts.
+     * @param alpha (Sequence of) log rate parameter(s).
+     * @return The log of the product of the probability masses.
+     * @throw std::domain_error if a count is negative or not an
+     * integer, or if a log rate is NaN.
+     * @throw std::invalid_argument if the length of alpha does not
+     * match the number of groups.
+     */
+    template <bool propto, typename T_log_rate>
+    typename return_type<T_log_rate>::type
+    poisson_log_sufficient_lpmf(const sufficient_stats& n,
+                                const T_log_rate& alpha) {
+      typedef typename stan::partials_return_type<T_log_rate>::type
+        T_partials_return;
+
+      static const char* function = "poisson_log_sufficient_lpmf";
+
+      using std::exp;
+
+      if (n.num_obs() == 0 || size_zero(alpha))
+        return 0.0;
+
+      T_partials_return logp(0.0);
+
+      check_nonnegative(function, "Random variable", n.min());
+      if (!n.integer_valued())
+        domain_error(function, "Random variable", n.non_integer(),
+                     "is ", ", but must be an integer!");
+      check_not_nan(function, "Log rate parameter", alpha);
+      check_consistent_size(function, "Log rate parameter", alpha,
+                            n.num_groups());
+
+      if (!include_summand<propto, T_log_rate>::value)
+        return 0.0;
+
+      const Eigen::VectorXd& count = n.count();
+      const Eigen::VectorXd& sum = n.sum();
+      scalar_seq_view<T_log_rate> alpha_vec(alpha);
+      const int G = n.num_groups();
+
+      for (int g = 0; g < G; g++)
+        if (std::numeric_limits<double>::infinity() == alpha_vec[g]
+            && count[g] > 0)
+          return LOG_ZERO;
+      for (int g = 0; g < G; g++)
+        if (-std::numeric_limits<double>::infinity() == alpha_vec[g]
+            && sum[g] != 0)
+          return LOG_ZERO;
+
+      operands_and_partials<T_log_rate> ops_partials(alpha);
+
+      if (include_summand<propto>::value)
+        logp -= n.sum_lgamma_p1().sum();
+
+      for (int g = 0; g < G; g++) {
+        const T_partials_return alpha_dbl = value_of(alpha_vec[g]);
+        const T_partials_return exp_alpha = exp(alpha_dbl);
+        if (!(alpha_dbl == -std::numeric_limits<double>::infinity()
+              && sum[g] == 0))
+          logp += sum[g] * alpha_dbl - count[g] * exp_alpha;
+
+        if (!is_constant_struct<T_log_rate>::value)
+          ops_partials.edge1_.partials_[g] += sum[g] - count[g] * exp_alpha;
+      }
+      return ops_partials.build(logp);
+    }
+
+    template <typename T_log_rate>
+    inline
+    typename return_type<T_log_rate>::type
+    poisson_log_sufficient_lpmf(const sufficient_stats& n,
+                                const T_log_rate& alpha) {
+      return poisson_log_sufficient_lpmf<false>(n, alpha);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,93 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_POISSON_RNG_HPP
+#define STAN_MATH_PRIM_MAT_PROB_POISSON_RNG_HPP
+
+#include <stan/math/prim/arr/functor/parallel_rng_fill.hpp>
+#include <stan/math/prim/scal/err/check_consistent_size.hpp>
+#include <stan/math/prim/scal/err/check_less.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/fun/philox_engine.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+#include <stan/math/prim/scal/prob/poisson_rng.hpp>
+#include <boost/random/poisson_distribution.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      template <typename T_rate>
+      struct poisson_rng_chunk {
+        const scalar_seq_view<T_rate>& lambda_vec_;
+        int* out_;
+
+        poisson_rng_chunk(const scalar_seq_view<T_rate>& lambda_vec,
+                          int* out)
+          : lambda_vec_(lambda_vec), out_(out) { }
+
+        void operator()(size_t begin, size_t end,
+                        philox_engine& rng) const {
+          // the distribution precomputes constants for its rate, so
+          // it is only rebuilt when the rate changes
+          boost::random::poisson_distribution<> dist(lambda_vec_[begin]);
+          for (size_t n = begin; n < end; ++n) {
+            if (lambda_vec_[n] != dist.mean())
+              dist = boost::random::poisson_distribution<>(lambda_vec_[n]);
+            out_[n] = dist(rng);
+          }
+        }
+      };
+
+    }
+
+    /**
+     * Return N pseudorandom Poisson variates for the given rate,
+     * generated in chunks from the specified counter-based engine on
+     * up to the specified number of threads.
+     *
+     * <p>lambda can be a scalar, a std::vector, an Eigen::Vector, or
+     * an Eigen::RowVector; a non-scalar must have length N. The draws
+     * depend only on the state of the engine and not on the number of
+     * threads; the engine is advanced past the draws on return.
+     *
+     * @tparam T_rate Type of rate parameter
+     * @param lambda (Sequence of) nonnegative rate parameter(s)
+     * @param N number of draws
+     * @param rng counter-based random number generator
+     * @param num_threads maximum number of threads to use
+     * @return Poisson random variates
+     * @throw std::domain_error if lambda is nan, negative or too
+     * large, N is negative or num_threads is not positive
+     * @throw std::invalid_argument if a non-scalar lambda is not of
+     * length N
+     */
+    template <typename T_rate>
+    inline std::vector<int>
+    poisson_rng(const T_rate& lambda, int N, philox_engine& rng,
+                int num_threads = 1) {
+      static const char* function = "poisson_rng";
+
+      check_not_nan(function, "Rate parameter", lambda);
+      check_nonnegative(function, "Rate parameter", lambda);
+      check_less(function, "Rate parameter", lambda, POISSON_MAX_RATE);
+      check_nonnegative(function, "Number of draws", N);
+      check_positive(function, "Number of threads", num_threads);
+      check_consistent_size(function, "Rate parameter", lambda, N);
+
+      scalar_seq_view<T_rate> lambda_vec(lambda);
+      std::vector<int> output(N);
+      if (N == 0)
+        return output;
+      parallel_rng_fill(N, rng, num_threads,
+                        internal::poisson_rng_chunk<T_rate>
+                        (lambda_vec, &output[0]));
+      return output;
+    }
+
+  }
+}
+#endif
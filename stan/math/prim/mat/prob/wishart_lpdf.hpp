@@ -5,22 +5,70 @@
 #include <stan/math/prim/mat/err/check_ldlt_factor.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
 #include <stan/math/prim/scal/err/check_greater.hpp>
+#include <stan/math/prim/scal/fun/digamma.hpp>
 #include <stan/math/prim/scal/fun/lmgamma.hpp>
-#include <stan/math/prim/mat/fun/crossprod.hpp>
-#include <stan/math/prim/mat/fun/columns_dot_product.hpp>
-#include <stan/math/prim/mat/fun/trace.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/LDLT_factor.hpp>
 #include <stan/math/prim/mat/fun/log_determinant_ldlt.hpp>
 #include <stan/math/prim/mat/fun/mdivide_left_ldlt.hpp>
-#include <stan/math/prim/mat/fun/dot_product.hpp>
-#include <stan/math/prim/mat/fun/mdivide_left_tri_low.hpp>
-#include <stan/math/prim/mat/fun/multiply_lower_tri_self_transpose.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
 #include <stan/math/prim/mat/meta/index_type.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
 #include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
 
 namespace stan {
   namespace math {
 
+    namespace internal {
+
+      /**
+       * Return the derivative of the log multivariate gamma function
+       * with respect to its second argument.
+       *
+       * @tparam T type of argument
+       * @param k number of dimensions
+       * @param x argument
+       * @return derivative of <code>lmgamma(k, x)</code> with respect
+       * to x
+       */
+      template <typename T>
+      inline T lmgamma_derivative(int k, const T& x) {
+        T result(0.0);
+        for (int j = 1; j <= k; ++j)
+          result += digamma(x + (1.0 - j) / 2.0);
+        return result;
+      }
+
+      /**
+       * Set the partials with respect to the entries of a symmetric
+       * matrix of which only the lower triangle is read, given the
+       * gradient with respect to the symmetric matrix.  An entry
+       * below the diagonal stands for both itself and its transpose.
+       *
+       * @tparam T type of gradient
+       * @tparam T_partials type of partials
+       * @param[in] grad gradient with respect to the symmetric matrix
+       * @param[out] partials partials with respect to the entries
+       */
+      template <typename T, typename T_partials>
+      inline void lower_partials(
+          const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& grad,
+          T_partials& partials) {
+        for (int j = 0; j < grad.cols(); ++j) {
+          for (int i = 0; i < j; ++i)
+            partials(i, j) = 0;
+          partials(j, j) = grad(j, j);
+          for (int i = j + 1; i < grad.rows(); ++i)
+            partials(i, j) = grad(i, j) + grad(j, i);
+        }
+      }
+
+    }
+
     /**
      * The log of the Wishart density for the given W, degrees of freedom,
      * and scale matrix.
@@ -38,6 +86,13 @@ namespace stan {
      -\frac{\nu}{2} \log(\det(S)) + \frac{\nu-k-1}{2}\log (\det(W)) - \frac{1}{2} \mbox{tr} (S^{-1}W)
      \f}
      *
+     * The density is computed on doubles from one LDLT factorization
+     * of each of W and S, and the partials are pushed through
+     * <code>operands_and_partials</code>, so the result is a single
+     * node in the expression graph.  The density only reads the lower
+     * triangles of W and S, and the partials with respect to the
+     * entries above the diagonal are zero.
+     *
      * @param W A scalar matrix
      * @param nu Degrees of freedom
      * @param S The scale matrix
@@ -56,15 +111,20 @@ namespace stan {
                 const Eigen::Matrix<T_scale, Eigen::Dynamic, Eigen::Dynamic>&
                 S) {
       static const char* function = "wishart_lpdf";
+      typedef typename stan::partials_return_type<T_y, T_dof,
+                                                  T_scale>::type
+        T_partials_return;
 
-      using boost::math::tools::promote_args;
       using Eigen::Dynamic;
       using Eigen::Lower;
       using Eigen::Matrix;
 
+      typedef Matrix<T_partials_return, Dynamic, Dynamic> matrix_d;
+      typedef Matrix<T_y, Dynamic, Dynamic> T_W;
+      typedef Matrix<T_scale, Dynamic, Dynamic> T_S;
+
       typename index_type<Matrix<T_scale, Dynamic, Dynamic> >::type k
         = W.rows();
-      typename promote_args<T_y, T_dof, T_scale>::type lp(0.0);
       check_greater(function, "Degrees of freedom parameter", nu, k - 1);
       check_square(function, "random variable", W);
       check_square(function, "scale parameter", S);
@@ -72,35 +132,68 @@ namespace stan {
                        "Rows of random variable", W.rows(),
                        "columns of scale parameter", S.rows());
 
-      LDLT_factor<T_y, Eigen::Dynamic, Eigen::Dynamic> ldlt_W(W);
+      matrix_d W_dbl = value_of(W);
+      LDLT_factor<T_partials_return, Dynamic, Dynamic> ldlt_W(W_dbl);
       check_ldlt_factor(function, "LDLT_Factor of random variable",
                         ldlt_W);
 
-      LDLT_factor<T_scale, Eigen::Dynamic, Eigen::Dynamic> ldlt_S(S);
+      matrix_d S_dbl = value_of(S);
+      LDLT_factor<T_partials_return, Dynamic, Dynamic> ldlt_S(S_dbl);
       check_ldlt_factor(function, "LDLT_Factor of scale parameter",
                         ldlt_S);
 
-      if (include_summand<propto, T_dof>::value)
-        lp += nu * k * NEG_LOG_TWO_OVER_TWO;
+      operands_and_partials<T_W, T_dof, T_S> ops_partials(W, nu, S);
+      if (!include_summand<propto, T_y, T_dof, T_scale>::value)
+        return ops_partials.build(0.0);
 
-      if (include_summand<propto, T_dof>::value)
-        lp -= lmgamma(k, 0.5 * nu);
+      const T_partials_return nu_dbl = value_of(nu);
+      const Eigen::MatrixXd id = Eigen::MatrixXd::Identity(k, k);
+      T_partials_return lp(0.0);
+      // gradients of the density as a function of symmetric W and S
+      matrix_d W_grad = matrix_d::Zero(k, k);
+      matrix_d S_grad = matrix_d::Zero(k, k);
 
-      if (include_summand<propto, T_dof, T_scale>::value)
-        lp -= 0.5 * nu * log_determinant_ldlt(ldlt_S);
+      if (include_summand<propto, T_dof>::value) {
+        lp += nu_dbl * k * NEG_LOG_TWO_OVER_TWO - lmgamma(k, 0.5 * nu_dbl);
+        if (!is_constant_struct<T_dof>::value)
+          ops_partials.edge2_.partials_[0]
+            += k * NEG_LOG_TWO_OVER_TWO
+            - 0.5 * internal::lmgamma_derivative(k, 0.5 * nu_dbl);
+      }
+
+      matrix_d S_inv = mdivide_left_ldlt(ldlt_S, id);
+      if (include_summand<propto, T_dof, T_scale>::value) {
+        T_partials_return log_det_S = log_determinant_ldlt(ldlt_S);
+        lp -= 0.5 * nu_dbl * log_det_S;
+        if (!is_constant_struct<T_dof>::value)
+          ops_partials.edge2_.partials_[0] -= 0.5 * log_det_S;
+        if (!is_constant_struct<T_S>::value)
+          S_grad -= 0.5 * nu_dbl * S_inv;
+      }
 
       if (include_summand<propto, T_scale, T_y>::value) {
-        Matrix<typename promote_args<T_y, T_scale>::type, Dynamic, Dynamic>
-          Sinv_W(mdivide_left_ldlt
-                 (ldlt_S,
-                  static_cast<Matrix<T_y, Dynamic, Dynamic> >
-                  (W.template selfadjointView<Lower>())));
-        lp -= 0.5 * trace(Sinv_W);
+        matrix_d W_sym = W_dbl.template selfadjointView<Lower>();
+        lp -= 0.5 * S_inv.cwiseProduct(W_sym).sum();
+        if (!is_constant_struct<T_W>::value)
+          W_grad -= 0.5 * S_inv;
+        if (!is_constant_struct<T_S>::value)
+          S_grad += 0.5 * S_inv * W_sym * S_inv;
+      }
+
+      if (include_summand<propto, T_y, T_dof>::value) {
+        T_partials_return log_det_W = log_determinant_ldlt(ldlt_W);
+        lp += 0.5 * (nu_dbl - k - 1.0) * log_det_W;
+        if (!is_constant_struct<T_dof>::value)
+          ops_partials.edge2_.partials_[0] += 0.5 * log_det_W;
+        if (!is_constant_struct<T_W>::value)
+          W_grad += 0.5 * (nu_dbl - k - 1.0) * mdivide_left_ldlt(ldlt_W, id);
       }
 
-      if (include_summand<propto, T_y, T_dof>::value && nu != (k + 1))
-        lp += 0.5 * (nu - k - 1.0) * log_determinant_ldlt(ldlt_W);
-      return lp;
+      if (!is_constant_struct<T_W>::value)
+        internal::lower_partials(W_grad, ops_partials.edge1_.partials_);
+      if (!is_constant_struct<T_S>::value)
+        internal::lower_partials(S_grad, ops_partials.edge3_.partials_);
+      return ops_partials.build(lp);
     }
 
     template <typename T_y, typename T_dof, typename T_scale>
@@ -0,0 +1,207 @@
+#ifndef STAN_MATH_PRIM_SCAL_FUN_PHILOX_ENGINE_HPP
+#define STAN_MATH_PRIM_SCAL_FUN_PHILOX_ENGINE_HPP
+
+#include <boost/cstdint.hpp>
+#include <limits>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Counter-based pseudo-random number generator implementing the
+     * Philox4x32-10 function of Salmon et al. (2011), "Parallel
+     * random numbers: as easy as 1, 2, 3".
+     *
+     * <p>The state is a 64-bit key, taken from the seed, and a
+     * 128-bit counter. The upper half of the counter holds a stream
+     * identifier and the lower half counts blocks within the stream;
+     * each block is encrypted to four 32-bit outputs. Because the
+     * output for any position is a pure function of the seed, the
+     * stream and the position, engines can be split into independent
+     * streams and advanced by arbitrary amounts in constant time.
+     * This lets several threads draw from disjoint parts of one
+     * sequence and reproduce exactly the values a single thread
+     * would have drawn.
+     *
+     * <p>The class models the Boost and standard uniform random
+     * number generator concepts, so it can be used with all of the
+     * <code>_rng</code> functions.
+     */
+    class philox_engine {
+    public:
+      typedef boost::uint32_t result_type;
+      static const bool has_fixed_range = false;
+
+      /**
+       * Construct an engine for the specified seed and stream,
+       * positioned at the start of the stream.
+       *
+       * @param seed seed, used as the key
+       * @param stream stream identifier
+       */
+      explicit philox_engine(boost::uint64_t seed = 0,
+                             boost::uint64_t stream = 0) {
+        this->seed(seed, stream);
+      }
+
+      /**
+       * Reset the engine to the start of the specified stream for the
+       * specified seed.
+       *
+       * @param seed seed, used as the key
+       * @param stream stream identifier
+       */
+      void seed(boost::uint64_t seed, boost::uint64_t stream = 0) {
+        key_[0] = static_cast<boost::uint32_t>(seed);
+        key_[1] = static_cast<boost::uint32_t>(seed >> 32);
+        stream_ = stream;
+        block_ = 0;
+        idx_ = 4;
+      }
+
+      /**
+       * Return the smallest value the engine can produce.
+       *
+       * @return zero
+       */
+      static result_type min() { return 0; }
+
+      /**
+       * Return the largest value the engine can produce.
+       *
+       * @return largest 32-bit unsigned integer
+       */
+      static result_type max() {
+        return std::numeric_limits<result_type>::max();
+      }
+
+      /**
+       * Return the next value in the stream.
+       *
+       * @return next 32-bit output
+       */
+      result_type operator()() {
+        if (idx_ == 4) {
+          generate_block(block_++, out_);
+          idx_ = 0;
+        }
+        return out_[idx_++];
+      }
+
+      /**
+       * Advance the engine by the specified number of outputs in
+       * constant time.
+       *
+       * @param z number of outputs to skip
+       */
+      void discard(boost::uint64_t z) {
+        // position of the next output, counted from block_ - 1 when
+        // a block is buffered and from block_ otherwise
+        boost::uint64_t pos = (idx_ == 4) ? 0 : idx_;
+        boost::uint64_t base = (idx_ == 4) ? block_ : block_ - 1;
+        pos += z;
+        block_ = base + pos / 4;
+        idx_ = pos % 4;
+        if (idx_ == 0) {
+          idx_ = 4;
+        } else {
+          generate_block(block_++, out_);
+        }
+      }
+
+      /**
+       * Return an engine with the same seed positioned at the start of
+       * the specified stream. Engines with different streams produce
+       * statistically independent sequences.
+       *
+       * @param stream stream identifier
+       * @return engine for the stream
+       */
+      philox_engine split(boost::uint64_t stream) const {
+        philox_engine rng;
+        rng.key_[0] = key_[0];
+        rng.key_[1] = key_[1];
+        rng.stream_ = stream;
+        return rng;
+      }
+
+      /**
+       * Return the stream identifier of this engine.
+       *
+       * @return stream identifier
+       */
+      boost::uint64_t stream() const { return stream_; }
+
+      /**
+       * Return true if both engines will produce the same sequence.
+       *
+       * @param a first engine
+       * @param b second engine
+       * @return true if the engines are in the same state
+       */
+      friend bool operator==(const philox_engine& a,
+                             const philox_engine& b) {
+        if (a.key_[0] != b.key_[0] || a.key_[1] != b.key_[1]
+            || a.stream_ != b.stream_)
+          return false;
+        boost::uint64_t a_next = (a.idx_ == 4) ? a.block_ * 4
+          : (a.block_ - 1) * 4 + a.idx_;
+        boost::uint64_t b_next = (b.idx_ == 4) ? b.block_ * 4
+          : (b.block_ - 1) * 4 + b.idx_;
+        return a_next == b_next;
+      }
+
+      friend bool operator!=(const philox_engine& a,
+                             const philox_engine& b) {
+        return !(a == b);
+      }
+
+      /**
+       * Apply the Philox4x32-10 bijection to the specified counter
+       * under the specified key.
+       *
+       * @param ctr counter, overwritten with the output
+       * @param key key
+       */
+      static void philox4x32_10(boost::uint32_t ctr[4],
+                                const boost::uint32_t key[2]) {
+        boost::uint32_t k0 = key[0];
+        boost::uint32_t k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+          boost::uint64_t p0
+            = static_cast<boost::uint64_t>(0xD2511F53U) * ctr[0];
+          boost::uint64_t p1
+            = static_cast<boost::uint64_t>(0xCD9E8D57U) * ctr[2];
+          boost::uint32_t hi0 = static_cast<boost::uint32_t>(p0 >> 32);
+          boost::uint32_t lo0 = static_cast<boost::uint32_t>(p0);
+          boost::uint32_t hi1 = static_cast<boost::uint32_t>(p1 >> 32);
+          boost::uint32_t lo1 = static_cast<boost::uint32_t>(p1);
+          ctr[0] = hi1 ^ ctr[1] ^ k0;
+          ctr[1] = lo1;
+          ctr[2] = hi0 ^ ctr[3] ^ k1;
+          ctr[3] = lo0;
+          k0 += 0x9E3779B9U;
+          k1 += 0xBB67AE85U;
+        }
+      }
+
+    private:
+      boost::uint32_t key_[2];
+      boost::uint64_t stream_;
+      boost::uint64_t block_;
+      boost::uint32_t out_[4];
+      int idx_;
+
+      void generate_block(boost::uint64_t block,
+                          boost::uint32_t out[4]) const {
+        out[0] = static_cast<boost::uint32_t>(block);
+        out[1] = static_cast<boost::uint32_t>(block >> 32);
+        out[2] = static_cast<boost::uint32_t>(stream_);
+        out[3] = static_cast<boost::uint32_t>(stream_ >> 32);
+        philox4x32_10(out, key_);
+      }
+    };
+
+  }
+}
+#endif
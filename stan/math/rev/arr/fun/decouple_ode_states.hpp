@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_ARR_FUN_DECOUPLE_ODE_STATES_HPP
 
 #include <stan/math/rev/core.hpp>
+#include <stan/math/rev/arr/fun/ode_solution_vari.hpp>
 #include <stan/math/prim/scal/meta/return_type.hpp>
 #include <stan/math/rev/scal/meta/is_var.hpp>
 #include <vector>
@@ -11,7 +12,7 @@ namespace stan {
 
     /**
      * Takes sensitivity output from integrators and returns results
-     * in precomputed_gradients format.
+     * as vars sharing a single <code>ode_solution_vari</code>.
      *
      * Solution input vector size depends on requested sensitivities,
      * which can be enabled for initials and parameters. For each
@@ -37,9 +38,7 @@ namespace stan {
     decouple_ode_states(const std::vector<std::vector<double> >& y,
                         const std::vector<T_initial>& y0,
                         const std::vector<T_param>& theta) {
-      using std::vector;
-
-      vector<typename stan::return_type<T_initial, T_param>::type> vars;
+      std::vector<var> vars;
       typedef stan::is_var<T_initial> initial_var;
       typedef stan::is_var<T_param> param_var;
 
@@ -54,21 +53,7 @@ namespace stan {
       if (param_var::value)
         vars.insert(vars.end(), theta.begin(), theta.end());
 
-      vector<var> temp_vars(N);
-      vector<double> temp_gradients(S);
-      vector<vector<var> > y_return(y.size());
-
-      for (size_t i = 0; i < y.size(); ++i) {
-        for (size_t j = 0; j < N; ++j) {
-          for (size_t k = 0; k < S; ++k) {
-            temp_gradients[k] = y[i][N + N * k + j];
-          }
-          temp_vars[j] = precomputed_gradients(y[i][j],
-                                               vars, temp_gradients);
-        }
-        y_return[i] = temp_vars;
-      }
-      return y_return;
+      return ode_solution(y, N, vars, false);
     }
 
     /**
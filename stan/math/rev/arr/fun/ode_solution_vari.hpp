@@ -0,0 +1,141 @@
+#ifndef STAN_MATH_REV_ARR_FUN_ODE_SOLUTION_VARI_HPP
+#define STAN_MATH_REV_ARR_FUN_ODE_SOLUTION_VARI_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * The vari for the solution of an ODE at all output times. It
+     * owns one operand array shared by all outputs and one
+     * contiguous block holding the sensitivities of every output
+     * with respect to every operand, instead of one
+     * precomputed_gradients_vari with its own copies per output.
+     *
+     * <p>The first output is this vari and the rest are allocated
+     * without being put on the chain stack, as in
+     * <code>algebra_solver_vari</code>. The chain() method gathers
+     * the adjoints of the outputs and applies the transposed
+     * sensitivity matrix to them in a single matrix-vector product.
+     */
+    class ode_solution_vari : public vari {
+    public:
+      /** number of outputs (output times times states) */
+      size_t y_size_;
+      /** outputs, stored time by time */
+      vari** y_;
+      /** number of operands */
+      size_t operands_size_;
+      /** operands (initial states and/or parameters) */
+      vari** operands_;
+      /**
+       * sensitivities in column-major order, with one row per output
+       * and one column per operand
+       */
+      double* sensitivities_;
+      /** scratch space for the adjoints of the outputs */
+      double* y_adj_;
+
+      /**
+       * Construct the solution from the coupled states returned by
+       * an integrator.
+       *
+       * <p>Each coupled state holds the N states followed by the N
+       * sensitivities of the states with respect to each operand in
+       * turn. If the integrator solved for the offset of the states
+       * from an unknown initial state, the first N operands must be
+       * the initial state; their values are added back to the states
+       * and the identity to their sensitivities.
+       *
+       * @param[in] y coupled states at each output time
+       * @param[in] N number of states
+       * @param[in] operands operands of the solution
+       * @param[in] add_initial true if the integrator solved for the
+       * offset from the initial state
+       */
+      ode_solution_vari(const std::vector<std::vector<double> >& y,
+                        size_t N, const std::vector<var>& operands,
+                        bool add_initial)
+        : vari(y[0][0] + (add_initial ? operands[0].val() : 0.0)),
+          y_size_(y.size() * N),
+          y_(ChainableStack::memalloc_.alloc_array<vari*>(y_size_)),
+          operands_size_(operands.size()),
+          operands_(ChainableStack::memalloc_
+                    .alloc_array<vari*>(operands_size_)),
+          sensitivities_(ChainableStack::memalloc_
+                         .alloc_array<double>(y_size_ * operands_size_)),
+          y_adj_(ChainableStack::memalloc_.alloc_array<double>(y_size_)) {
+        for (size_t k = 0; k < operands_size_; ++k)
+          operands_[k] = operands[k].vi_;
+
+        for (size_t i = 0; i < y.size(); ++i) {
+          const double* state = &y[i][0];
+          for (size_t k = 0; k < operands_size_; ++k) {
+            const double* sens = state + N + N * k;
+            double* col = sensitivities_ + y_size_ * k + N * i;
+            for (size_t j = 0; j < N; ++j)
+              col[j] = sens[j];
+          }
+          if (add_initial) {
+            for (size_t j = 0; j < N; ++j)
+              sensitivities_[y_size_ * j + N * i + j] += 1.0;
+          }
+        }
+
+        y_[0] = this;
+        for (size_t r = 1; r < y_size_; ++r) {
+          size_t j = r % N;
+          double val = y[r / N][j];
+          if (add_initial)
+            val += operands_[j]->val_;
+          y_[r] = new vari(val, false);
+        }
+      }
+
+      void chain() {
+        for (size_t r = 0; r < y_size_; ++r)
+          y_adj_[r] = y_[r]->adj_;
+        for (size_t k = 0; k < operands_size_; ++k) {
+          const double* col = sensitivities_ + y_size_ * k;
+          double sum = 0;
+          for (size_t r = 0; r < y_size_; ++r)
+            sum += col[r] * y_adj_[r];
+          operands_[k]->adj_ += sum;
+        }
+      }
+    };
+
+    /**
+     * Return the solution of an ODE at each output time as vars
+     * sharing a single <code>ode_solution_vari</code>.
+     *
+     * @param[in] y coupled states at each output time
+     * @param[in] N number of states
+     * @param[in] operands operands of the solution
+     * @param[in] add_initial true if the integrator solved for the
+     * offset from the initial state, which must then be the first N
+     * operands
+     * @return states at each output time
+     */
+    inline std::vector<std::vector<var> >
+    ode_solution(const std::vector<std::vector<double> >& y, size_t N,
+                 const std::vector<var>& operands, bool add_initial) {
+      std::vector<std::vector<var> > y_return(y.size(),
+                                              std::vector<var>(N));
+      if (y.empty() || N == 0)
+        return y_return;
+
+      ode_solution_vari* vi
+        = new ode_solution_vari(y, N, operands, add_initial);
+      for (size_t i = 0; i < y.size(); ++i)
+        for (size_t j = 0; j < N; ++j)
+          y_return[i][j] = var(vi->y_[N * i + j]);
+      return y_return;
+    }
+
+  }
+}
+#endif
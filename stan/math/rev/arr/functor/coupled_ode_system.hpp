@@ -7,6 +7,7 @@
 #include <stan/math/prim/arr/fun/value_of.hpp>
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/rev/scal/fun/value_of_rec.hpp>
+#include <stan/math/rev/arr/fun/ode_solution_vari.hpp>
 #include <stan/math/rev/core.hpp>
 #include <ostream>
 #include <stdexcept>
@@ -19,24 +20,6 @@ namespace stan {
     // It is in namespace stan::math so that the partial template
     // specializations are treated as such.
 
-    /**
-     * Increment the state derived from the coupled system in the with
-     * the original initial state.  This is necessary because the
-     * coupled system subtracts out the initial state in its
-     * representation when the initial state is unknown.
-     *
-     * @param[in] y0 original initial values to add back into the
-     * coupled system.
-     * @param[in, out] y state of the coupled system on input,
-     * incremented with initial values on output.
-     */
-    inline void add_initial_values(const std::vector<var>& y0,
-                                   std::vector<std::vector<var> >& y) {
-      for (size_t n = 0; n < y.size(); n++)
-        for (size_t m = 0; m < y0.size(); m++)
-          y[n][m] += y0[m];
-    }
-
     /**
      * The coupled ODE system for known initial values and unknown
      * parameters.
@@ -201,24 +184,7 @@ namespace stan {
        */
       std::vector<std::vector<var> >
       decouple_states(const std::vector<std::vector<double> >& y) const {
-        std::vector<var> temp_vars(N_);
-        std::vector<double> temp_gradients(M_);
-        std::vector<std::vector<var> > y_return(y.size());
-
-        for (size_t i = 0; i < y.size(); i++) {
-          // iterate over number of equations
-          for (size_t j = 0; j < N_; j++) {
-            // iterate over parameters for each equation
-            for (size_t k = 0; k < M_; k++)
-              temp_gradients[k] = y[i][y0_dbl_.size() + y0_dbl_.size() * k + j];
-
-            temp_vars[j] = precomputed_gradients(y[i][j],
-                                                 theta_,
-                                                 temp_gradients);
-          }
-          y_return[i] = temp_vars;
-        }
-        return y_return;
+        return ode_solution(y, N_, theta_, false);
       }
     };
 
@@ -391,28 +357,8 @@ namespace stan {
        */
       std::vector<std::vector<var> >
       decouple_states(const std::vector<std::vector<double> >& y) const {
-        using std::vector;
-
-        vector<var> temp_vars(N_);
-        vector<double> temp_gradients(N_);
-        vector<vector<var> > y_return(y.size());
-
-        for (size_t i = 0; i < y.size(); i++) {
-          // iterate over number of equations
-          for (size_t j = 0; j < N_; j++) {
-            // iterate over parameters for each equation
-            for (size_t k = 0; k < N_; k++)
-              temp_gradients[k] = y[i][y0_.size() + y0_.size() * k + j];
-
-            temp_vars[j] = precomputed_gradients(y[i][j],
-                                                 y0_, temp_gradients);
-          }
-          y_return[i] = temp_vars;
-        }
-
-        add_initial_values(y0_, y_return);
-
-        return y_return;
+        // the initial values are added back inside the solution vari
+        return ode_solution(y, N_, y0_, true);
       }
     };
 
@@ -596,29 +542,11 @@ namespace stan {
        */
       std::vector<std::vector<var> >
       decouple_states(const std::vector<std::vector<double> >& y) const {
-        using std::vector;
-
-        vector<var> vars = y0_;
+        std::vector<var> vars = y0_;
         vars.insert(vars.end(), theta_.begin(), theta_.end());
 
-        vector<var> temp_vars(N_);
-        vector<double> temp_gradients(N_ + M_);
-        vector<vector<var> > y_return(y.size());
-
-        for (size_t i = 0; i < y.size(); i++) {
-          // iterate over number of equations
-          for (size_t j = 0; j < N_; j++) {
-            // iterate over parameters for each equation
-            for (size_t k = 0; k < N_ + M_; k++)
-              temp_gradients[k] = y[i][N_ + N_ * k + j];
-
-            temp_vars[j] = precomputed_gradients(y[i][j],
-                                                 vars, temp_gradients);
-          }
-          y_return[i] = temp_vars;
-        }
-        add_initial_values(y0_, y_return);
-        return y_return;
+        // the initial values are added back inside the solution vari
+        return ode_solution(y, N_, vars, true);
       }
     };
 
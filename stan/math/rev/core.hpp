@@ -4,11 +4,15 @@
 #include <stan/math/rev/core/autodiffstackstorage.hpp>
 #include <stan/math/rev/core/chainable_alloc.hpp>
 #include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/compact_program.hpp>
+#include <stan/math/rev/core/compact_tape.hpp>
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/ddv_vari.hpp>
 #include <stan/math/rev/core/dv_vari.hpp>
 #include <stan/math/rev/core/dvd_vari.hpp>
 #include <stan/math/rev/core/dvv_vari.hpp>
 #include <stan/math/rev/core/empty_nested.hpp>
+#include <stan/math/rev/core/gemm_vvv_vari.hpp>
 #include <stan/math/rev/core/gevv_vvv_vari.hpp>
 #include <stan/math/rev/core/grad.hpp>
 #include <stan/math/rev/core/matrix_vari.hpp>
@@ -50,7 +54,9 @@
 #include <stan/math/rev/core/stored_gradient_vari.hpp>
 #include <stan/math/rev/core/v_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/var_matrix.hpp>
 #include <stan/math/rev/core/vari.hpp>
+#include <stan/math/rev/core/vari_matrix.hpp>
 #include <stan/math/rev/core/vd_vari.hpp>
 #include <stan/math/rev/core/vdd_vari.hpp>
 #include <stan/math/rev/core/vdv_vari.hpp>
@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_AUTODIFFSTACKSTORAGE_HPP
 
 #include <stan/math/memory/stack_alloc.hpp>
+#include <stan/math/rev/core/compact_tape.hpp>
 #include <vector>
 
 namespace stan {
@@ -14,6 +15,7 @@ namespace stan {
       static std::vector<ChainableT*> var_nochain_stack_;
       static std::vector<ChainableAllocT*> var_alloc_stack_;
       static stack_alloc memalloc_;
+      static compact_tape<ChainableT> compact_tape_;
 
       // nested positions
       static std::vector<size_t> nested_var_stack_sizes_;
@@ -37,6 +39,10 @@ namespace stan {
     stack_alloc
     AutodiffStackStorage<ChainableT, ChainableAllocT>::memalloc_;
 
+    template<typename ChainableT, typename ChainableAllocT>
+    compact_tape<ChainableT>
+    AutodiffStackStorage<ChainableT, ChainableAllocT>::compact_tape_;
+
     template<typename ChainableT, typename ChainableAllocT>
     std::vector<size_t>
     AutodiffStackStorage<ChainableT, ChainableAllocT>::nested_var_stack_sizes_;
@@ -0,0 +1,809 @@
+#ifndef STAN_MATH_REV_CORE_COMPACT_PROGRAM_HPP
+#define STAN_MATH_REV_CORE_COMPACT_PROGRAM_HPP
+
+#include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/fun/inv_logit.hpp>
+#include <stan/math/prim/scal/fun/log1p.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/compact_tape.hpp>
+#include <stan/math/rev/core/compact_tape_vari.hpp>
+#include <stan/math/rev/core/nested_size.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <typeinfo>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * A straight-line program recorded from the compact tape, with
+     * the operands of each instruction given by their position
+     * rather than by pointer, so that it can be evaluated again on
+     * new inputs without building an expression graph.
+     *
+     * <p>Slots <code>0, ..., N - 1</code> hold the inputs, the next K
+     * slots the constants created by the function and slot
+     * <code>N + K + i</code> the result of instruction i. Evaluation runs
+     * the instructions forward, computing the values and the stored
+     * partials of <code>compact_op</code>, and the gradient of an
+     * output is a reverse sweep over the same instructions. Both can
+     * run on several points at once, with each slot holding one lane
+     * per point.
+     *
+     * <p>The outcomes of the comparisons made during the recording
+     * are kept as guards. An evaluation that changes the outcome of a
+     * guard, or that produces a NaN, took or may have taken a
+     * different path through the recorded function, and is reported
+     * as failed so that the caller can record again.
+     */
+    class compact_program {
+    private:
+      size_t num_inputs_;
+      std::vector<double> constants_;
+      size_t results_begin_;
+      std::vector<unsigned char> op_;
+      std::vector<size_t> a_;
+      std::vector<size_t> b_;
+      std::vector<double> c_;
+      std::vector<compact_cmp> guard_cmp_;
+      std::vector<size_t> guard_a_;
+      std::vector<size_t> guard_b_;
+      std::vector<bool> guard_has_b_;
+      std::vector<double> guard_c_;
+      std::vector<bool> guard_result_;
+      std::vector<size_t> outputs_;
+      std::vector<double> val_;
+      std::vector<double> da_;
+      std::vector<double> adj_;
+      size_t num_lanes_;
+
+      static bool compare(compact_cmp cmp, double a, double b) {
+        switch (cmp) {
+        case COMPACT_LT: return a < b;
+        case COMPACT_LE: return a <= b;
+        case COMPACT_GT: return a > b;
+        case COMPACT_GE: return a >= b;
+        case COMPACT_EQ: return a == b;
+        case COMPACT_NE: return a != b;
+        }
+        return false;
+      }
+
+      bool add_constant(vari* vi, std::map<vari*, size_t>& slot) {
+        if (typeid(*vi) != typeid(vari))
+          return false;
+        slot[vi] = num_inputs_ + constants_.size();
+        constants_.push_back(vi->val_);
+        return true;
+      }
+
+      static void add_symmetric(std::vector<std::map<size_t, double> >& w,
+                                size_t p, size_t q, double e) {
+        w[p][q] += e;
+        if (p != q)
+          w[q][p] += e;
+      }
+
+      // writes the distinct variable operands of instruction i with
+      // the first and second derivatives of its result with respect
+      // to them, returning their number
+      size_t local_derivatives(size_t i, const double* val, size_t* x,
+                               double* d, double h[2][2]) const {
+        const double a = val[a_[i]];
+        const double y = val[results_begin_ + i];
+        const double c = c_[i];
+        x[0] = a_[i];
+        x[1] = b_[i];
+        h[0][0] = 0;
+        h[0][1] = 0;
+        h[1][1] = 0;
+        size_t n = 1;
+        switch (op_[i]) {
+        case COMPACT_ADD_VV: n = 2; d[0] = 1; d[1] = 1; break;
+        case COMPACT_SUB_VV: n = 2; d[0] = 1; d[1] = -1; break;
+        case COMPACT_MUL_VV:
+          n = 2;
+          d[0] = val[b_[i]];
+          d[1] = a;
+          h[0][1] = 1;
+          break;
+        case COMPACT_DIV_VV: {
+          const double b = val[b_[i]];
+          n = 2;
+          d[0] = 1 / b;
+          d[1] = -a / (b * b);
+          h[0][1] = -1 / (b * b);
+          h[1][1] = 2 * a / (b * b * b);
+          break;
+        }
+        case COMPACT_ADD_V: d[0] = 1; break;
+        case COMPACT_NEG: d[0] = -1; break;
+        case COMPACT_SCALE: d[0] = c; break;
+        case COMPACT_DIV_VD: d[0] = 1 / c; break;
+        case COMPACT_DIV_DV:
+          d[0] = -c / (a * a);
+          h[0][0] = 2 * c / (a * a * a);
+          break;
+        case COMPACT_EXP: d[0] = y; h[0][0] = y; break;
+        case COMPACT_LOG: d[0] = 1 / a; h[0][0] = -1 / (a * a); break;
+        case COMPACT_SQRT:
+          d[0] = 0.5 / y;
+          h[0][0] = -0.25 / (y * y * y);
+          break;
+        case COMPACT_TANH:
+          d[0] = 1 - y * y;
+          h[0][0] = -2 * y * d[0];
+          break;
+        case COMPACT_LOG1P:
+          d[0] = 1 / (1 + a);
+          h[0][0] = -d[0] * d[0];
+          break;
+        case COMPACT_SQUARE: d[0] = 2 * a; h[0][0] = 2; break;
+        case COMPACT_SIN:
+        case COMPACT_COS:
+          d[0] = da_[i];
+          h[0][0] = -y;
+          break;
+        case COMPACT_INV_LOGIT:
+          d[0] = y * (1 - y);
+          h[0][0] = d[0] * (1 - 2 * y);
+          break;
+        }
+        if (n == 2) {
+          if (x[0] == x[1]) {
+            // the same operand twice, as in a * a
+            d[0] += d[1];
+            h[0][0] += 2 * h[0][1] + h[1][1];
+            n = 1;
+          } else {
+            h[1][0] = h[0][1];
+          }
+        }
+        // constants have no adjoints
+        size_t m = 0;
+        for (size_t k = 0; k < n; ++k) {
+          if (x[k] < num_inputs_ || x[k] >= results_begin_) {
+            x[m] = x[k];
+            d[m] = d[k];
+            h[m][m] = h[k][k];
+            ++m;
+          }
+        }
+        if (m < n)
+          h[0][1] = 0;
+        return m;
+      }
+
+    public:
+      compact_program()
+        : num_inputs_(0), results_begin_(0), num_lanes_(0) { }
+
+      /**
+       * Return the number of instructions.
+       *
+       * @return number of instructions
+       */
+      size_t size() const { return op_.size(); }
+
+      /**
+       * Return the number of inputs.
+       *
+       * @return number of inputs
+       */
+      size_t num_inputs() const { return num_inputs_; }
+
+      /**
+       * Return the number of outputs.
+       *
+       * @return number of outputs
+       */
+      size_t num_outputs() const { return outputs_.size(); }
+
+      /**
+       * Return the number of slots, which is the number of inputs,
+       * constants and instructions.
+       *
+       * @return number of slots
+       */
+      size_t num_slots() const { return results_begin_ + op_.size(); }
+
+      /**
+       * Return the operation of the specified instruction.
+       *
+       * @param i instruction index
+       * @return operation code
+       */
+      compact_op op(size_t i) const {
+        return static_cast<compact_op>(op_[i]);
+      }
+
+      /**
+       * Return the slot of the first operand of the specified
+       * instruction.
+       *
+       * @param i instruction index
+       * @return slot of operand a
+       */
+      size_t operand_a(size_t i) const { return a_[i]; }
+
+      /**
+       * Return the slot of the second operand of the specified
+       * instruction, which is only meaningful for the operations
+       * with two variable operands.
+       *
+       * @param i instruction index
+       * @return slot of operand b
+       */
+      size_t operand_b(size_t i) const { return b_[i]; }
+
+      /**
+       * Return the slot of the result of the specified instruction.
+       *
+       * @param i instruction index
+       * @return slot of the result
+       */
+      size_t result(size_t i) const { return results_begin_ + i; }
+
+      /**
+       * Return the slot of the specified output.
+       *
+       * @param j output index
+       * @return slot of the output
+       */
+      size_t output(size_t j) const { return outputs_[j]; }
+
+      /**
+       * Record the program computing the specified outputs from the
+       * specified inputs from the top nested region of the stack.
+       *
+       * <p>The region must have been recorded with the compact tape
+       * enabled and with guards recorded. It can only be replayed if
+       * every operation in it went onto the compact tape, which is
+       * not the case if it contains any other vari (a function
+       * without a compact form or an output of a multi-output
+       * operation) or an operation that saw a NaN. Plain varis
+       * created in the region, such as the result of
+       * <code>var y = 0</code>, are taken to be constants. Functions
+       * that create one with a value depending on their argument,
+       * such as <code>step()</code>, record the comparison it
+       * depends on as a guard.
+       *
+       * @param inputs varis of the inputs, created at the start of
+       * the region
+       * @param outputs varis of the outputs
+       * @return true if the region can be replayed; if false, the
+       * program is empty
+       */
+      bool record(const std::vector<vari*>& inputs,
+                  const std::vector<vari*>& outputs) {
+        compact_tape<vari>& tape = ChainableStack::compact_tape_;
+        *this = compact_program();
+        if (outputs.empty())
+          return false;
+        num_inputs_ = inputs.size();
+
+        std::map<vari*, size_t> slot;
+        for (size_t n = 0; n < inputs.size(); ++n)
+          slot[inputs[n]] = n;
+
+        size_t stack_end = ChainableStack::var_stack_.size();
+        for (size_t i = stack_end - nested_size(); i < stack_end; ++i) {
+          vari* vi = ChainableStack::var_stack_[i];
+          if (slot.count(vi) != 0
+              || dynamic_cast<compact_segment_vari*>(vi) != 0)
+            continue;
+          if (!add_constant(vi, slot)) {
+            *this = compact_program();
+            return false;
+          }
+        }
+        size_t nochain_begin
+          = ChainableStack::nested_var_nochain_stack_sizes_.back();
+        size_t nochain_end = ChainableStack::var_nochain_stack_.size();
+        for (size_t i = nochain_begin; i < nochain_end; ++i) {
+          if (!add_constant(ChainableStack::var_nochain_stack_[i], slot)) {
+            *this = compact_program();
+            return false;
+          }
+        }
+        results_begin_ = num_inputs_ + constants_.size();
+
+        size_t begin = tape.nested_sizes_.back();
+        size_t end = tape.size();
+        for (size_t i = begin; i < end; ++i) {
+          compact_op op = static_cast<compact_op>(tape.op_[i]);
+          std::map<vari*, size_t>::const_iterator a = slot.find(tape.a_[i]);
+          std::map<vari*, size_t>::const_iterator b = slot.find(tape.b_[i]);
+          bool binary = op == COMPACT_ADD_VV || op == COMPACT_SUB_VV
+            || op == COMPACT_MUL_VV || op == COMPACT_DIV_VV;
+          if (op == COMPACT_NAN_V || op == COMPACT_NAN_VV
+              || a == slot.end() || (binary && b == slot.end())) {
+            *this = compact_program();
+            return false;
+          }
+          op_.push_back(tape.op_[i]);
+          a_.push_back(a->second);
+          b_.push_back(binary ? b->second : 0);
+          c_.push_back(tape.da_[i]);
+          slot[tape.res_[i]] = results_begin_ + op_.size() - 1;
+        }
+
+        for (size_t k = 0; k < tape.guards_.size(); ++k) {
+          const compact_guard<vari>& guard = tape.guards_[k];
+          std::map<vari*, size_t>::const_iterator a = slot.find(guard.a_);
+          std::map<vari*, size_t>::const_iterator b = slot.find(guard.b_);
+          if (a == slot.end() || (guard.b_ != 0 && b == slot.end())) {
+            *this = compact_program();
+            return false;
+          }
+          guard_cmp_.push_back(guard.cmp_);
+          guard_a_.push_back(a->second);
+          guard_b_.push_back(guard.b_ != 0 ? b->second : 0);
+          guard_has_b_.push_back(guard.b_ != 0);
+          guard_c_.push_back(guard.c_);
+          guard_result_.push_back(guard.result_);
+        }
+
+        for (size_t j = 0; j < outputs.size(); ++j) {
+          std::map<vari*, size_t>::const_iterator y = slot.find(outputs[j]);
+          if (y == slot.end()) {
+            *this = compact_program();
+            return false;
+          }
+          outputs_.push_back(y->second);
+        }
+
+        return true;
+      }
+
+      /**
+       * Evaluate the program on the specified inputs.
+       *
+       * @param x inputs, of the size the program was recorded with
+       * @return false if a guard changed outcome or a value is NaN,
+       * in which case the values and gradients must not be used
+       */
+      bool forward(const double* x) {
+        char ok;
+        forward_lanes<1>(x, 1, &ok);
+        return ok;
+      }
+
+      /**
+       * Evaluate the program on K points at once.
+       *
+       * <p>Each slot holds K lanes, one per point, and each
+       * instruction runs over all lanes before the next, so that the
+       * program is dispatched once for all points and the arithmetic
+       * is over contiguous lanes.
+       *
+       * @param x inputs, column major with one column per point
+       * @param K number of points
+       * @param[out] ok for each point, false if a guard changed
+       * outcome or a value is NaN, in which case its values and
+       * gradients must not be used
+       */
+      void forward(const double* x, size_t K, char* ok) {
+        forward_lanes<0>(x, K, ok);
+      }
+
+      /**
+       * Return the value of the specified output from the last
+       * evaluation.
+       *
+       * @param j output index
+       * @return value of the output
+       */
+      double value(size_t j) const {
+        return val_[outputs_[j] * num_lanes_];
+      }
+
+      /**
+       * Return the value of the specified output at the specified
+       * point from the last evaluation.
+       *
+       * @param j output index
+       * @param k point index
+       * @return value of the output
+       */
+      double value(size_t j, size_t k) const {
+        return val_[outputs_[j] * num_lanes_ + k];
+      }
+
+      /**
+       * Write the gradient of the specified output with respect to the
+       * inputs at each point of the last evaluation, in one reverse
+       * sweep over all points.
+       *
+       * @param j output index
+       * @param[out] grad gradients, column major with one column per
+       * point
+       */
+      void gradient(size_t j, double* grad) {
+        if (num_lanes_ == 1)
+          gradient_lanes<1>(j, grad);
+        else
+          gradient_lanes<0>(j, grad);
+      }
+
+      /**
+       * Write the gradients of K consecutive outputs with respect to
+       * the inputs from the last evaluation, which must be of a single
+       * point, in one reverse sweep.
+       *
+       * <p>Each slot holds K adjoint lanes, lane k seeded at output
+       * <code>j + k</code>, so the program is dispatched and its
+       * values are read once for all K outputs rather than once per
+       * output. Blocks of rows of a Jacobian come from one sweep
+       * each.
+       *
+       * @param j first output index
+       * @param K number of outputs
+       * @param[out] grad gradients, column major with one column per
+       * output
+       */
+      void output_gradients(size_t j, size_t K, double* grad) {
+        if (K == 8)
+          output_gradients_lanes<8>(j, K, grad);
+        else
+          output_gradients_lanes<0>(j, K, grad);
+      }
+
+      /**
+       * Write the gradient and the Hessian of the specified output
+       * from the last evaluation, which must be of a single point,
+       * with respect to the inputs, in one second-order reverse
+       * sweep.
+       *
+       * <p>The sweep is edge pushing: along with the adjoints it
+       * keeps the symmetric matrix W of second-order adjoints
+       * between live slots. Each instruction, taken in reverse,
+       * pushes the entries of W on its result onto its operands
+       * using its first derivatives, and creates entries between its
+       * operands from its second derivatives scaled by the adjoint of
+       * its result. Only nonzero entries are stored, so the cost
+       * follows the nonlinear interactions in the program rather
+       * than the square of the number of inputs.
+       *
+       * @param j output index
+       * @param[out] grad gradient, of the size of the inputs
+       * @param[out] H Hessian, column major, with as many rows and
+       * columns as inputs
+       */
+      void hessian(size_t j, double* grad, double* H) {
+        const double* val = &val_[0];
+        adj_.assign(num_slots(), 0);
+        double* adj = &adj_[0];
+        adj[outputs_[j]] = 1;
+        std::vector<std::map<size_t, double> > w(adj_.size());
+
+        size_t x[2];
+        double d[2];
+        double h[2][2];
+        for (size_t i = op_.size(); i-- > 0; ) {
+          size_t r = results_begin_ + i;
+          size_t n = local_derivatives(i, val, x, d, h);
+
+          // push the second-order adjoints of the result
+          std::map<size_t, double>& w_r = w[r];
+          double w_rr = 0;
+          for (std::map<size_t, double>::const_iterator it = w_r.begin();
+               it != w_r.end(); ++it) {
+            size_t p = it->first;
+            if (p == r) {
+              w_rr = it->second;
+              continue;
+            }
+            w[p].erase(r);
+            for (size_t k = 0; k < n; ++k) {
+              if (x[k] == p)
+                w[p][p] += 2 * d[k] * it->second;
+              else
+                add_symmetric(w, x[k], p, d[k] * it->second);
+            }
+          }
+          std::map<size_t, double>().swap(w_r);
+
+          // create the interactions of the operands
+          const double v = adj[r];
+          for (size_t k = 0; k < n; ++k) {
+            for (size_t l = k; l < n; ++l) {
+              double e = d[k] * d[l] * w_rr + v * h[k][l];
+              if (e != 0)
+                add_symmetric(w, x[k], x[l], e);
+            }
+            adj[x[k]] += v * d[k];
+          }
+        }
+
+        for (size_t n = 0; n < num_inputs_; ++n) {
+          grad[n] = adj[n];
+          for (size_t m = 0; m < num_inputs_; ++m)
+            H[n + m * num_inputs_] = 0;
+          for (std::map<size_t, double>::const_iterator it = w[n].begin();
+               it != w[n].end() && it->first < num_inputs_; ++it)
+            H[n + it->first * num_inputs_] = it->second;
+        }
+      }
+
+    private:
+      // L is the number of lanes if known at compile time, or zero
+      template <size_t L>
+      void forward_lanes(const double* x, size_t num_lanes, char* ok) {
+        const size_t K = L != 0 ? L : num_lanes;
+        num_lanes_ = K;
+        val_.resize(num_slots() * K);
+        da_.resize(op_.size() * K);
+        if (K == 0)
+          return;
+        double* val = &val_[0];
+        for (size_t n = 0; n < num_inputs_; ++n)
+          for (size_t k = 0; k < K; ++k)
+            val[n * K + k] = x[n + k * num_inputs_];
+        for (size_t m = 0; m < constants_.size(); ++m)
+          for (size_t k = 0; k < K; ++k)
+            val[(num_inputs_ + m) * K + k] = constants_[m];
+        for (size_t k = 0; k < K; ++k)
+          ok[k] = 1;
+
+        for (size_t i = 0; i < op_.size(); ++i) {
+          const double* a = val + a_[i] * K;
+          const double* b = val + b_[i] * K;
+          double* y = val + (results_begin_ + i) * K;
+          double* da = &da_[i * K];
+          const double c = c_[i];
+          switch (op_[i]) {
+          case COMPACT_ADD_VV:
+            for (size_t k = 0; k < K; ++k)
+              y[k] = a[k] + b[k];
+            break;
+          case COMPACT_ADD_V:
+            for (size_t k = 0; k < K; ++k)
+              y[k] = a[k] + c;
+            break;
+          case COMPACT_SUB_VV:
+            for (size_t k = 0; k < K; ++k)
+              y[k] = a[k] - b[k];
+            break;
+          case COMPACT_NEG:
+            for (size_t k = 0; k < K; ++k)
+              y[k] = c - a[k];
+            break;
+          case COMPACT_MUL_VV:
+            for (size_t k = 0; k < K; ++k)
+              y[k] = a[k] * b[k];
+            break;
+          case COMPACT_SCALE:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = a[k] * c;
+              da[k] = c;
+            }
+            break;
+          case COMPACT_DIV_VV:
+            for (size_t k = 0; k < K; ++k)
+              y[k] = a[k] / b[k];
+            break;
+          case COMPACT_DIV_VD:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = a[k] / c;
+              da[k] = c;
+            }
+            break;
+          case COMPACT_DIV_DV:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = c / a[k];
+              da[k] = c;
+            }
+            break;
+          case COMPACT_EXP:
+            for (size_t k = 0; k < K; ++k)
+              y[k] = std::exp(a[k]);
+            break;
+          case COMPACT_LOG:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = std::log(a[k]);
+              da[k] = a[k];
+            }
+            break;
+          case COMPACT_SQRT:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = std::sqrt(a[k]);
+              da[k] = 2.0 * y[k];
+            }
+            break;
+          case COMPACT_TANH:
+            for (size_t k = 0; k < K; ++k) {
+              double cosh = std::cosh(a[k]);
+              y[k] = std::tanh(a[k]);
+              da[k] = cosh * cosh;
+            }
+            break;
+          case COMPACT_LOG1P:
+            for (size_t k = 0; k < K; ++k) {
+              // log1p(double) throws outside its domain
+              y[k] = a[k] >= -1.0 ? log1p(a[k]) : NOT_A_NUMBER;
+              da[k] = 1 + a[k];
+            }
+            break;
+          case COMPACT_SQUARE:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = a[k] * a[k];
+              da[k] = 2.0 * a[k];
+            }
+            break;
+          case COMPACT_SIN:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = std::sin(a[k]);
+              da[k] = std::cos(a[k]);
+            }
+            break;
+          case COMPACT_COS:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = std::cos(a[k]);
+              da[k] = -std::sin(a[k]);
+            }
+            break;
+          case COMPACT_INV_LOGIT:
+            for (size_t k = 0; k < K; ++k) {
+              y[k] = inv_logit(a[k]);
+              da[k] = y[k] * (1.0 - y[k]);
+            }
+            break;
+          }
+        }
+        // checked after the sweep, as ok may alias the values
+        for (size_t i = 0; i < op_.size(); ++i) {
+          const double* y = val + (results_begin_ + i) * K;
+          for (size_t k = 0; k < K; ++k)
+            ok[k] &= y[k] == y[k];
+        }
+
+        for (size_t m = 0; m < guard_cmp_.size(); ++m) {
+          const double* a = val + guard_a_[m] * K;
+          const double* b = val + guard_b_[m] * K;
+          for (size_t k = 0; k < K; ++k) {
+            double bk = guard_has_b_[m] ? b[k] : guard_c_[m];
+            ok[k] &= compare(guard_cmp_[m], a[k], bk) == guard_result_[m];
+          }
+        }
+      }
+
+      template <size_t L>
+      void gradient_lanes(size_t j, double* grad) {
+        const size_t K = L != 0 ? L : num_lanes_;
+        adj_.assign(num_slots() * K, 0);
+        if (K == 0)
+          return;
+        for (size_t k = 0; k < K; ++k)
+          adj_[outputs_[j] * K + k] = 1;
+        reverse_lanes<L, 1>(K, grad);
+      }
+
+      template <size_t L>
+      void output_gradients_lanes(size_t j, size_t num_lanes, double* grad) {
+        const size_t K = L != 0 ? L : num_lanes;
+        adj_.assign(num_slots() * K, 0);
+        if (K == 0)
+          return;
+        for (size_t k = 0; k < K; ++k)
+          adj_[outputs_[j + k] * K + k] = 1;
+        reverse_lanes<L, 0>(K, grad);
+      }
+
+      // S is 1 if the lanes are points, with K lanes of values per
+      // slot, or 0 if they are outputs sharing one lane of values
+      template <size_t L, size_t S>
+      void reverse_lanes(size_t num_lanes, double* grad) {
+        const size_t K = L != 0 ? L : num_lanes;
+        const size_t V = S != 0 ? K : 1;
+        const double* val = &val_[0];
+        double* adj = &adj_[0];
+        for (size_t i = op_.size(); i-- > 0; ) {
+          const double* g = adj + (results_begin_ + i) * K;
+          const double* a = val + a_[i] * V;
+          const double* b = val + b_[i] * V;
+          const double* y = val + (results_begin_ + i) * V;
+          const double* da = &da_[i * V];
+          double* a_adj = adj + a_[i] * K;
+          double* b_adj = adj + b_[i] * K;
+          switch (op_[i]) {
+          case COMPACT_ADD_VV:
+            for (size_t k = 0; k < K; ++k) {
+              a_adj[k] += g[k];
+              b_adj[k] += g[k];
+            }
+            break;
+          case COMPACT_ADD_V:
+            for (size_t k = 0; k < K; ++k)
+              a_adj[k] += g[k];
+            break;
+          case COMPACT_SUB_VV:
+            for (size_t k = 0; k < K; ++k) {
+              a_adj[k] += g[k];
+              b_adj[k] -= g[k];
+            }
+            break;
+          case COMPACT_NEG:
+            for (size_t k = 0; k < K; ++k)
+              a_adj[k] -= g[k];
+            break;
+          case COMPACT_MUL_VV:
+            for (size_t k = 0; k < K; ++k) {
+              a_adj[k] += g[k] * b[k * S];
+              b_adj[k] += g[k] * a[k * S];
+            }
+            break;
+          case COMPACT_SCALE:
+          case COMPACT_SQUARE:
+          case COMPACT_SIN:
+          case COMPACT_COS:
+          case COMPACT_INV_LOGIT:
+            for (size_t k = 0; k < K; ++k)
+              a_adj[k] += g[k] * da[k * S];
+            break;
+          case COMPACT_DIV_VV:
+            for (size_t k = 0; k < K; ++k) {
+              a_adj[k] += g[k] / b[k * S];
+              b_adj[k] -= g[k] * a[k * S] / (b[k * S] * b[k * S]);
+            }
+            break;
+          case COMPACT_DIV_VD:
+          case COMPACT_LOG:
+          case COMPACT_SQRT:
+          case COMPACT_TANH:
+          case COMPACT_LOG1P:
+            for (size_t k = 0; k < K; ++k)
+              a_adj[k] += g[k] / da[k * S];
+            break;
+          case COMPACT_DIV_DV:
+            for (size_t k = 0; k < K; ++k)
+              a_adj[k] -= g[k] * da[k * S] / (a[k * S] * a[k * S]);
+            break;
+          case COMPACT_EXP:
+            for (size_t k = 0; k < K; ++k)
+              a_adj[k] += g[k] * y[k * S];
+            break;
+          }
+        }
+        for (size_t n = 0; n < num_inputs_; ++n)
+          for (size_t k = 0; k < K; ++k)
+            grad[n + k * num_inputs_] = adj[n * K + k];
+      }
+    };
+
+    /**
+     * Start recording onto the compact tape with guards, for a later
+     * call to <code>compact_program::record()</code>.
+     *
+     * @return whether the compact tape was enabled before, to be
+     * passed to <code>stop_compact_recording()</code>
+     */
+    static inline bool start_compact_recording() {
+      compact_tape<vari>& tape = ChainableStack::compact_tape_;
+      bool enabled = tape.enabled_;
+      tape.enabled_ = true;
+      tape.record_guards_ = true;
+      tape.guards_.clear();
+      return enabled;
+    }
+
+    /**
+     * Stop recording guards and restore the previous compact tape
+     * mode. The recorded guards are kept until the next call to
+     * <code>start_compact_recording()</code>.
+     *
+     * @param enabled whether the compact tape was enabled before
+     * recording started
+     */
+    static inline void stop_compact_recording(bool enabled) {
+      compact_tape<vari>& tape = ChainableStack::compact_tape_;
+      tape.enabled_ = enabled;
+      tape.record_guards_ = false;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,230 @@
+#ifndef STAN_MATH_REV_CORE_COMPACT_TAPE_HPP
+#define STAN_MATH_REV_CORE_COMPACT_TAPE_HPP
+
+#include <stan/math/prim/scal/meta/likely.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Operation codes for entries of the compact tape. Each entry has
+     * a result, up to two operands, a and b, and a stored double, da,
+     * holding a partial or a constant. With g the adjoint of the
+     * result, replaying an entry applies:
+     *
+     * <ul>
+     * <li><code>COMPACT_ADD_VV</code>: a += g, b += g</li>
+     * <li><code>COMPACT_ADD_V</code>: a += g (da is the constant
+     * added to a)</li>
+     * <li><code>COMPACT_SUB_VV</code>: a += g, b -= g</li>
+     * <li><code>COMPACT_NEG</code>: a -= g (da is the constant
+     * a is subtracted from)</li>
+     * <li><code>COMPACT_MUL_VV</code>: a += g * val(b),
+     * b += g * val(a)</li>
+     * <li><code>COMPACT_SCALE</code>: a += g * da</li>
+     * <li><code>COMPACT_DIV_VV</code>: a += g / val(b),
+     * b -= g * val(a) / val(b)^2</li>
+     * <li><code>COMPACT_DIV_VD</code>: a += g / da</li>
+     * <li><code>COMPACT_DIV_DV</code>: a -= g * da / val(a)^2</li>
+     * <li><code>COMPACT_EXP</code>: a += g * val(result)</li>
+     * <li><code>COMPACT_LOG</code>, <code>COMPACT_SQRT</code>,
+     * <code>COMPACT_TANH</code>, <code>COMPACT_LOG1P</code>:
+     * a += g / da</li>
+     * <li><code>COMPACT_SQUARE</code>, <code>COMPACT_SIN</code>,
+     * <code>COMPACT_COS</code>, <code>COMPACT_INV_LOGIT</code>:
+     * a += g * da</li>
+     * <li><code>COMPACT_NAN_V</code>: a = NaN</li>
+     * <li><code>COMPACT_NAN_VV</code>: a = NaN, b = NaN</li>
+     * </ul>
+     *
+     * <p>The unary functions have codes of their own, rather than
+     * sharing <code>COMPACT_SCALE</code> and
+     * <code>COMPACT_DIV_VD</code>, so that a recorded tape can be
+     * re-evaluated on new values (see <code>compact_program</code>).
+     */
+    enum compact_op {
+      COMPACT_ADD_VV,
+      COMPACT_ADD_V,
+      COMPACT_SUB_VV,
+      COMPACT_NEG,
+      COMPACT_MUL_VV,
+      COMPACT_SCALE,
+      COMPACT_DIV_VV,
+      COMPACT_DIV_VD,
+      COMPACT_DIV_DV,
+      COMPACT_EXP,
+      COMPACT_LOG,
+      COMPACT_SQRT,
+      COMPACT_TANH,
+      COMPACT_LOG1P,
+      COMPACT_SQUARE,
+      COMPACT_SIN,
+      COMPACT_COS,
+      COMPACT_INV_LOGIT,
+      COMPACT_NAN_V,
+      COMPACT_NAN_VV
+    };
+
+    /**
+     * Comparison codes for the guards recorded on the compact tape.
+     */
+    enum compact_cmp {
+      COMPACT_LT,
+      COMPACT_LE,
+      COMPACT_GT,
+      COMPACT_GE,
+      COMPACT_EQ,
+      COMPACT_NE
+    };
+
+    /**
+     * The outcome of a comparison of a variable with a variable, or
+     * with a constant if <code>b_</code> is null, recorded so that a
+     * replay of the tape can tell whether control flow changed.
+     *
+     * @tparam ChainableT type of chainable variable implementation
+     */
+    template <typename ChainableT>
+    struct compact_guard {
+      compact_cmp cmp_;
+      ChainableT* a_;
+      ChainableT* b_;
+      double c_;
+      bool result_;
+    };
+
+    /**
+     * Struct-of-arrays storage for the compact tape, on which the
+     * built-in scalar operations record (operation, result, operands,
+     * partials) entries instead of allocating a vari subclass each.
+     *
+     * <p>Entries are replayed by segment varis (see
+     * <code>compact_segment_vari</code>) that sit on the ordinary
+     * var stack, so compact entries and custom varis are chained in
+     * the order they were created.
+     *
+     * @tparam ChainableT type of chainable variable implementation
+     */
+    template <typename ChainableT>
+    class compact_tape {
+    public:
+      /** Whether scalar operations record onto the compact tape. */
+      bool enabled_;
+      /** Segment currently being appended to, or null. */
+      ChainableT* segment_;
+      /** Whether comparisons of variables record guards. */
+      bool record_guards_;
+      /** Guards recorded while <code>record_guards_</code> is set. */
+      std::vector<compact_guard<ChainableT> > guards_;
+
+      // parallel arrays sharing size_ and capacity_, so that an
+      // append costs a single capacity check
+      unsigned char* op_;
+      ChainableT** res_;
+      ChainableT** a_;
+      ChainableT** b_;
+      double* da_;
+
+      std::vector<size_t> nested_sizes_;
+
+      compact_tape()
+        : enabled_(false), segment_(0), record_guards_(false), op_(0),
+          res_(0), a_(0), b_(0), da_(0), size_(0), capacity_(0) { }
+
+      ~compact_tape() {
+        std::free(op_);
+        std::free(res_);
+        std::free(a_);
+        std::free(b_);
+        std::free(da_);
+      }
+
+      /**
+       * Return the number of entries on the tape.
+       *
+       * @return number of entries
+       */
+      size_t size() const { return size_; }
+
+      /**
+       * Append an entry to the tape.
+       */
+      void push_back(compact_op op, ChainableT* res, ChainableT* a,
+                     ChainableT* b, double da) {
+        if (unlikely(size_ == capacity_))
+          grow();
+        // read the members before any store, since the store through
+        // op_ may alias them
+        const size_t n = size_;
+        unsigned char* op_n = op_ + n;
+        ChainableT** res_n = res_ + n;
+        ChainableT** a_n = a_ + n;
+        ChainableT** b_n = b_ + n;
+        double* da_n = da_ + n;
+        size_ = n + 1;
+        *res_n = res;
+        *a_n = a;
+        *b_n = b;
+        *da_n = da;
+        *op_n = static_cast<unsigned char>(op);
+      }
+
+      /**
+       * Remove all entries, keeping the capacity of the arrays.
+       */
+      void clear() {
+        size_ = 0;
+        segment_ = 0;
+        nested_sizes_.clear();
+        guards_.clear();
+      }
+
+      /**
+       * Mark the start of a nested region. Later entries go into a
+       * new segment.
+       */
+      void start_nested() {
+        nested_sizes_.push_back(size_);
+        segment_ = 0;
+      }
+
+      /**
+       * Remove the entries recorded since the matching call to
+       * <code>start_nested()</code>.
+       */
+      void recover_nested() {
+        size_ = nested_sizes_.back();
+        nested_sizes_.pop_back();
+        segment_ = 0;
+      }
+
+    private:
+      size_t size_;
+      size_t capacity_;
+
+      template <typename T>
+      static void grow_array(T*& x, size_t n) {
+        T* y = static_cast<T*>(std::realloc(x, n * sizeof(T)));
+        if (y == 0)
+          throw std::bad_alloc();
+        x = y;
+      }
+
+      void grow() {
+        size_t n = capacity_ == 0 ? 1024 : 2 * capacity_;
+        grow_array(op_, n);
+        grow_array(res_, n);
+        grow_array(a_, n);
+        grow_array(b_, n);
+        grow_array(da_, n);
+        capacity_ = n;
+      }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,167 @@
+#ifndef STAN_MATH_REV_CORE_COMPACT_TAPE_VARI_HPP
+#define STAN_MATH_REV_CORE_COMPACT_TAPE_VARI_HPP
+
+#include <stan/math/prim/scal/meta/likely.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/compact_tape.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <limits>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * A vari standing for a contiguous run of compact tape entries.
+     * Its chain() method replays the entries in reverse order in a
+     * single loop, dispatching on the operation code with a switch
+     * instead of a virtual call per operation.
+     */
+    class compact_segment_vari : public vari {
+    public:
+      size_t begin_;
+      size_t end_;
+
+      explicit compact_segment_vari(size_t begin)
+        : vari(0.0), begin_(begin), end_(begin) { }
+
+      void chain() {
+        compact_tape<vari>& tape = ChainableStack::compact_tape_;
+        const unsigned char* op = tape.op_;
+        vari* const* res = tape.res_;
+        vari* const* a = tape.a_;
+        vari* const* b = tape.b_;
+        const double* da = tape.da_;
+        for (size_t i = end_; i-- > begin_; ) {
+          const double g = res[i]->adj_;
+          switch (op[i]) {
+          case COMPACT_ADD_VV:
+            a[i]->adj_ += g;
+            b[i]->adj_ += g;
+            break;
+          case COMPACT_ADD_V:
+            a[i]->adj_ += g;
+            break;
+          case COMPACT_SUB_VV:
+            a[i]->adj_ += g;
+            b[i]->adj_ -= g;
+            break;
+          case COMPACT_NEG:
+            a[i]->adj_ -= g;
+            break;
+          case COMPACT_MUL_VV:
+            a[i]->adj_ += b[i]->val_ * g;
+            b[i]->adj_ += a[i]->val_ * g;
+            break;
+          case COMPACT_SCALE:
+          case COMPACT_SQUARE:
+          case COMPACT_SIN:
+          case COMPACT_COS:
+          case COMPACT_INV_LOGIT:
+            a[i]->adj_ += g * da[i];
+            break;
+          case COMPACT_DIV_VV:
+            a[i]->adj_ += g / b[i]->val_;
+            b[i]->adj_ -= g * a[i]->val_ / (b[i]->val_ * b[i]->val_);
+            break;
+          case COMPACT_DIV_VD:
+          case COMPACT_LOG:
+          case COMPACT_SQRT:
+          case COMPACT_TANH:
+          case COMPACT_LOG1P:
+            a[i]->adj_ += g / da[i];
+            break;
+          case COMPACT_DIV_DV:
+            a[i]->adj_ -= g * da[i] / (a[i]->val_ * a[i]->val_);
+            break;
+          case COMPACT_EXP:
+            a[i]->adj_ += g * res[i]->val_;
+            break;
+          case COMPACT_NAN_V:
+            a[i]->adj_ = std::numeric_limits<double>::quiet_NaN();
+            break;
+          case COMPACT_NAN_VV:
+            a[i]->adj_ = std::numeric_limits<double>::quiet_NaN();
+            b[i]->adj_ = std::numeric_limits<double>::quiet_NaN();
+            break;
+          }
+        }
+      }
+    };
+
+    /**
+     * Return true if the built-in scalar operations record onto the
+     * compact tape.
+     *
+     * @return true if the compact tape is enabled
+     */
+    static inline bool compact_tape_enabled() {
+      return ChainableStack::compact_tape_.enabled_;
+    }
+
+    /**
+     * Turn recording onto the compact tape on or off. The mode can
+     * be changed at any time; entries already recorded in either
+     * mode are chained correctly.
+     *
+     * @param enabled true to record the built-in scalar operations
+     * onto the compact tape
+     */
+    static inline void set_compact_tape(bool enabled) {
+      ChainableStack::compact_tape_.enabled_ = enabled;
+    }
+
+    /**
+     * Record an operation on the compact tape and return the vari
+     * holding its result. The result vari is put on neither stack;
+     * the tape keeps track of it for chaining and for zeroing its
+     * adjoint.
+     *
+     * <p>Entries are appended to the current segment if it is still
+     * on top of the var stack, and otherwise to a new segment pushed
+     * onto the var stack, so that the reverse pass visits compact
+     * entries and other varis in creation order.
+     *
+     * @param op operation code
+     * @param val value of the result
+     * @param a first operand
+     * @param b second operand, or null
+     * @param da stored partial or constant
+     * @return result vari
+     */
+    inline vari* record_compact_op(compact_op op, double val, vari* a,
+                                   vari* b = 0, double da = 0) {
+      compact_tape<vari>& tape = ChainableStack::compact_tape_;
+      if (tape.segment_ == 0
+          || ChainableStack::var_stack_.back() != tape.segment_)
+        tape.segment_ = new compact_segment_vari(tape.size());
+      vari* res = new vari(val, vari::unstacked());
+      tape.push_back(op, res, a, b, da);
+      static_cast<compact_segment_vari*>(tape.segment_)->end_
+        = tape.size();
+      return res;
+    }
+
+    /**
+     * Return the outcome of a comparison, recording it as a guard if
+     * guards are being recorded.
+     *
+     * @param cmp comparison code
+     * @param result outcome of the comparison
+     * @param a first variable
+     * @param b second variable, or null to compare with c
+     * @param c constant compared with if b is null
+     * @return result
+     */
+    inline bool record_compact_guard(compact_cmp cmp, bool result, vari* a,
+                                     vari* b, double c = 0) {
+      compact_tape<vari>& tape = ChainableStack::compact_tape_;
+      if (unlikely(tape.record_guards_)) {
+        compact_guard<vari> guard = { cmp, a, b, c, result };
+        tape.guards_.push_back(guard);
+      }
+      return result;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,164 @@
+#ifndef STAN_MATH_REV_CORE_GEMM_VVV_VARI_HPP
+#define STAN_MATH_REV_CORE_GEMM_VVV_VARI_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <cstddef>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * The vari for a general matrix product of variables,
+     * <code>C + alpha * A * B</code>, as used by Eigen's matrix-matrix
+     * and matrix-vector product kernels.
+     *
+     * <p>The values of <code>A</code> and <code>B</code> are kept in
+     * column-major matrices of doubles, so the product and the two
+     * products of the reverse pass run as double matrix products. The
+     * first entry of the result is this vari and the others are varis
+     * that are not chained, so the whole product is a single vari on
+     * the stack.
+     */
+    class gemm_vvv_vari : public vari {
+    protected:
+      size_t rows_;
+      size_t cols_;
+      size_t depth_;
+      vari* alpha_;
+      double* A_;
+      vari** A_vis_;
+      double* B_;
+      vari** B_vis_;
+      vari** C_vis_;
+      vari** res_;
+
+    public:
+      /**
+       * Construct the vari for the specified operands and result
+       * values. The matrices are in column-major order.
+       *
+       * @param[in] rows number of rows of the result
+       * @param[in] cols number of columns of the result
+       * @param[in] depth number of columns of A and rows of B
+       * @param[in] alpha scale of the product
+       * @param[in] A values of the left-hand side
+       * @param[in] A_vis varis of the left-hand side
+       * @param[in] B values of the right-hand side
+       * @param[in] B_vis varis of the right-hand side
+       * @param[in] C_vis varis of the matrix added to the product
+       * @param[in] res values of the result
+       */
+      gemm_vvv_vari(size_t rows, size_t cols, size_t depth, vari* alpha,
+                    double* A, vari** A_vis, double* B, vari** B_vis,
+                    vari** C_vis, const double* res)
+        : vari(res[0]), rows_(rows), cols_(cols), depth_(depth),
+          alpha_(alpha), A_(A), A_vis_(A_vis), B_(B), B_vis_(B_vis),
+          C_vis_(C_vis),
+          res_(ChainableStack::memalloc_.alloc_array<vari*>(rows * cols)) {
+        res_[0] = this;
+        for (size_t i = 1; i < rows * cols; ++i)
+          res_[i] = new vari(res[i], false);
+      }
+
+      void chain() {
+        Eigen::MatrixXd adj(rows_, cols_);
+        for (size_t i = 0; i < rows_ * cols_; ++i) {
+          adj(i) = res_[i]->adj_;
+          C_vis_[i]->adj_ += adj(i);
+        }
+        Eigen::Map<Eigen::MatrixXd> A(A_, rows_, depth_);
+        Eigen::Map<Eigen::MatrixXd> B(B_, depth_, cols_);
+        Eigen::MatrixXd adj_A = adj * B.transpose();
+        alpha_->adj_ += A.cwiseProduct(adj_A).sum();
+        double alpha = alpha_->val_;
+        for (size_t i = 0; i < rows_ * depth_; ++i)
+          A_vis_[i]->adj_ += alpha * adj_A(i);
+        Eigen::MatrixXd adj_B = A.transpose() * adj;
+        for (size_t i = 0; i < depth_ * cols_; ++i)
+          B_vis_[i]->adj_ += alpha * adj_B(i);
+      }
+
+      /**
+       * Add the scaled product of the specified matrices of variables
+       * to the specified matrix of variables, using a single vari.
+       *
+       * <p>Entry <code>(i, j)</code> of a matrix is at
+       * <code>i * row_incr + j * col_incr</code> from its first
+       * entry.
+       *
+       * @param[in] rows number of rows of the result
+       * @param[in] cols number of columns of the result
+       * @param[in] depth number of columns of lhs and rows of rhs
+       * @param[in] lhs left-hand side
+       * @param[in] lhs_row_incr row increment of lhs
+       * @param[in] lhs_col_incr column increment of lhs
+       * @param[in] rhs right-hand side
+       * @param[in] rhs_row_incr row increment of rhs
+       * @param[in] rhs_col_incr column increment of rhs
+       * @param[in, out] res result
+       * @param[in] res_row_incr row increment of res
+       * @param[in] res_col_incr column increment of res
+       * @param[in] alpha scale of the product
+       */
+      static void run(size_t rows, size_t cols, size_t depth,
+                      const var* lhs, size_t lhs_row_incr,
+                      size_t lhs_col_incr,
+                      const var* rhs, size_t rhs_row_incr,
+                      size_t rhs_col_incr,
+                      var* res, size_t res_row_incr, size_t res_col_incr,
+                      const var& alpha) {
+        if (rows == 0 || cols == 0 || depth == 0)
+          return;
+        double* A = ChainableStack::memalloc_
+          .alloc_array<double>(rows * depth);
+        vari** A_vis = ChainableStack::memalloc_
+          .alloc_array<vari*>(rows * depth);
+        for (size_t k = 0; k < depth; ++k) {
+          for (size_t i = 0; i < rows; ++i) {
+            vari* vi = lhs[i * lhs_row_incr + k * lhs_col_incr].vi_;
+            A_vis[i + k * rows] = vi;
+            A[i + k * rows] = vi->val_;
+          }
+        }
+        double* B = ChainableStack::memalloc_
+          .alloc_array<double>(depth * cols);
+        vari** B_vis = ChainableStack::memalloc_
+          .alloc_array<vari*>(depth * cols);
+        for (size_t j = 0; j < cols; ++j) {
+          for (size_t k = 0; k < depth; ++k) {
+            vari* vi = rhs[k * rhs_row_incr + j * rhs_col_incr].vi_;
+            B_vis[k + j * depth] = vi;
+            B[k + j * depth] = vi->val_;
+          }
+        }
+
+        Eigen::MatrixXd values
+          = alpha.vi_->val_
+          * (Eigen::Map<Eigen::MatrixXd>(A, rows, depth)
+             * Eigen::Map<Eigen::MatrixXd>(B, depth, cols));
+        vari** C_vis = ChainableStack::memalloc_
+          .alloc_array<vari*>(rows * cols);
+        for (size_t j = 0; j < cols; ++j) {
+          for (size_t i = 0; i < rows; ++i) {
+            vari* vi = res[i * res_row_incr + j * res_col_incr].vi_;
+            C_vis[i + j * rows] = vi;
+            values(i, j) += vi->val_;
+          }
+        }
+
+        gemm_vvv_vari* vi
+          = new gemm_vvv_vari(rows, cols, depth, alpha.vi_, A, A_vis, B,
+                              B_vis, C_vis, values.data());
+        for (size_t j = 0; j < cols; ++j)
+          for (size_t i = 0; i < rows; ++i)
+            res[i * res_row_incr + j * res_col_incr].vi_
+              = vi->res_[i + j * rows];
+      }
+    };
+
+  }
+}
+#endif
@@ -28,21 +28,14 @@ namespace stan {
      * derivative propagation.
      */
     static void grad(vari* vi) {
-      // simple reference implementation (intended as doc):
-      //   vi->init_dependent();
-      //   size_t end = var_stack_.size();
-      //   size_t begin = empty_nested() ? 0 : end - nested_size();
-      //   for (size_t i = end; --i > begin; )
-      //     var_stack_[i]->chain();
-
-      typedef std::vector<vari*>::reverse_iterator it_t;
+      // indexes rather than iterators, because a chain() method may
+      // push and then pop a nested stack (see checkpoint()), which
+      // can reallocate var_stack_
       vi->init_dependent();
-      it_t begin = ChainableStack::var_stack_.rbegin();
-      it_t end = empty_nested()
-        ? ChainableStack::var_stack_.rend() : begin + nested_size();
-      for (it_t it = begin; it < end; ++it) {
-        (*it)->chain();
-      }
+      size_t end = ChainableStack::var_stack_.size();
+      size_t begin = empty_nested() ? 0 : end - nested_size();
+      for (size_t i = end; i-- > begin; )
+        ChainableStack::var_stack_[i]->chain();
     }
 
   }
@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_ADDITION_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_ADDITION_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/vv_vari.hpp>
 #include <stan/math/rev/core/vd_vari.hpp>
@@ -82,6 +83,12 @@ namespace stan {
      * @return Variable result of adding two variables.
      */
     inline var operator+(const var& a, const var& b) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_)
+                                     || is_nan(b.vi_->val_)
+                                     ? COMPACT_NAN_VV : COMPACT_ADD_VV,
+                                     a.vi_->val_ + b.vi_->val_,
+                                     a.vi_, b.vi_));
       return var(new add_vv_vari(a.vi_, b.vi_));
     }
 
@@ -99,6 +106,10 @@ namespace stan {
     inline var operator+(const var& a, double b) {
       if (b == 0.0)
         return a;
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_) || is_nan(b)
+                                     ? COMPACT_NAN_V : COMPACT_ADD_V,
+                                     a.vi_->val_ + b, a.vi_, 0, b));
       return var(new add_vd_vari(a.vi_, b));
     }
 
@@ -116,6 +127,10 @@ namespace stan {
     inline var operator+(double a, const var& b) {
       if (a == 0.0)
         return b;
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a) || is_nan(b.vi_->val_)
+                                     ? COMPACT_NAN_V : COMPACT_ADD_V,
+                                     a + b.vi_->val_, b.vi_, 0, a));
       return var(new add_vd_vari(b.vi_, a));  // by symmetry
     }
 
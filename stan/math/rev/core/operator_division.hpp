@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_DIVISION_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_DIVISION_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/vv_vari.hpp>
 #include <stan/math/rev/core/vd_vari.hpp>
@@ -94,6 +95,12 @@ namespace stan {
      * second.
      */
     inline var operator/(const var& a, const var& b) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_)
+                                     || is_nan(b.vi_->val_)
+                                     ? COMPACT_NAN_VV : COMPACT_DIV_VV,
+                                     a.vi_->val_ / b.vi_->val_,
+                                     a.vi_, b.vi_));
       return var(new divide_vv_vari(a.vi_, b.vi_));
     }
 
@@ -111,6 +118,10 @@ namespace stan {
     inline var operator/(const var& a, double b) {
       if (b == 1.0)
         return a;
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_) || is_nan(b)
+                                     ? COMPACT_NAN_V : COMPACT_DIV_VD,
+                                     a.vi_->val_ / b, a.vi_, 0, b));
       return var(new divide_vd_vari(a.vi_, b));
     }
 
@@ -126,6 +137,9 @@ namespace stan {
      * @return Variable result of dividing the scalar by the variable.
      */
     inline var operator/(double a, const var& b) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(COMPACT_DIV_DV, a / b.vi_->val_,
+                                     b.vi_, 0, a));
       return var(new divide_dv_vari(a, b.vi_));
     }
 
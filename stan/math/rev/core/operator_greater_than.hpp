@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 
 namespace stan {
@@ -23,7 +24,8 @@ namespace stan {
      * @return True if first variable's value is greater than second's.
      */
     inline bool operator>(const var& a, const var& b) {
-      return a.val() > b.val();
+      return record_compact_guard(COMPACT_GT, a.val() > b.val(), a.vi_,
+                                  b.vi_);
     }
 
     /**
@@ -35,7 +37,7 @@ namespace stan {
      * @return True if first variable's value is greater than second value.
      */
     inline bool operator>(const var& a, double b) {
-      return a.val() > b;
+      return record_compact_guard(COMPACT_GT, a.val() > b, a.vi_, 0, b);
     }
 
     /**
@@ -47,7 +49,7 @@ namespace stan {
      * @return True if first value is greater than second variable's value.
      */
     inline bool operator>(double a, const var& b) {
-      return a > b.val();
+      return record_compact_guard(COMPACT_LT, a > b.val(), b.vi_, 0, a);
     }
 
   }
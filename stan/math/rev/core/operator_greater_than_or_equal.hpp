@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_OR_EQUAL_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_OR_EQUAL_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 
 namespace stan {
@@ -25,7 +26,8 @@ namespace stan {
      * to the second's.
      */
     inline bool operator>=(const var& a, const var& b) {
-      return a.val() >= b.val();
+      return record_compact_guard(COMPACT_GE, a.val() >= b.val(), a.vi_,
+                                  b.vi_);
     }
 
     /**
@@ -38,7 +40,7 @@ namespace stan {
      * to second value.
      */
     inline bool operator>=(const var& a, double b) {
-      return a.val() >= b;
+      return record_compact_guard(COMPACT_GE, a.val() >= b, a.vi_, 0, b);
     }
 
     /**
@@ -51,7 +53,7 @@ namespace stan {
      * second variable's value.
      */
     inline bool operator>=(double a, const var& b) {
-      return a >= b.val();
+      return record_compact_guard(COMPACT_LE, a >= b.val(), b.vi_, 0, a);
     }
 
   }
@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_LESS_THAN_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_LESS_THAN_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 
 namespace stan {
@@ -22,7 +23,8 @@ namespace stan {
      * @return True if first variable's value is less than second's.
      */
     inline bool operator<(const var& a, const var& b) {
-      return a.val() < b.val();
+      return record_compact_guard(COMPACT_LT, a.val() < b.val(), a.vi_,
+                                  b.vi_);
     }
 
     /**
@@ -34,7 +36,7 @@ namespace stan {
      * @return True if first variable's value is less than second value.
      */
     inline bool operator<(const var& a, double b) {
-      return a.val() < b;
+      return record_compact_guard(COMPACT_LT, a.val() < b, a.vi_, 0, b);
     }
 
     /**
@@ -46,7 +48,7 @@ namespace stan {
      * @return True if first value is less than second variable's value.
      */
     inline bool operator<(double a, const var& b) {
-      return a < b.val();
+      return record_compact_guard(COMPACT_GT, a < b.val(), b.vi_, 0, a);
     }
 
   }
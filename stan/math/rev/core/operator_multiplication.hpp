@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_MULTIPLICATION_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_MULTIPLICATION_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/vv_vari.hpp>
 #include <stan/math/rev/core/vd_vari.hpp>
@@ -81,6 +82,12 @@ namespace stan {
      * @return Variable result of multiplying operands.
      */
     inline var operator*(const var& a, const var& b) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_)
+                                     || is_nan(b.vi_->val_)
+                                     ? COMPACT_NAN_VV : COMPACT_MUL_VV,
+                                     a.vi_->val_ * b.vi_->val_,
+                                     a.vi_, b.vi_));
       return var(new multiply_vv_vari(a.vi_, b.vi_));
     }
 
@@ -98,6 +105,10 @@ namespace stan {
     inline var operator*(const var& a, double b) {
       if (b == 1.0)
         return a;
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_) || is_nan(b)
+                                     ? COMPACT_NAN_V : COMPACT_SCALE,
+                                     a.vi_->val_ * b, a.vi_, 0, b));
       return var(new multiply_vd_vari(a.vi_, b));
     }
 
@@ -115,6 +126,10 @@ namespace stan {
     inline var operator*(double a, const var& b) {
       if (a == 1.0)
         return b;
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a) || is_nan(b.vi_->val_)
+                                     ? COMPACT_NAN_V : COMPACT_SCALE,
+                                     a * b.vi_->val_, b.vi_, 0, a));
       return var(new multiply_vd_vari(b.vi_, a));  // by symmetry
     }
 
@@ -8,14 +8,12 @@ namespace stan {
   namespace math {
 
     inline var& var::operator*=(const var& b) {
-      vi_ = new multiply_vv_vari(vi_, b.vi_);
+      vi_ = (*this * b).vi_;
       return *this;
     }
 
     inline var& var::operator*=(double b) {
-      if (b == 1.0)
-        return *this;
-      vi_ = new multiply_vd_vari(vi_, b);
+      vi_ = (*this * b).vi_;
       return *this;
     }
 
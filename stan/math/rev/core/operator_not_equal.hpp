@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_NOT_EQUAL_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_NOT_EQUAL_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 
 namespace stan {
@@ -24,7 +25,8 @@ namespace stan {
      * second's.
      */
     inline bool operator!=(const var& a, const var& b) {
-      return a.val() != b.val();
+      return record_compact_guard(COMPACT_NE, a.val() != b.val(), a.vi_,
+                                  b.vi_);
     }
 
     /**
@@ -37,7 +39,7 @@ namespace stan {
      * second value.
      */
     inline bool operator!=(const var& a, double b) {
-      return a.val() != b;
+      return record_compact_guard(COMPACT_NE, a.val() != b, a.vi_, 0, b);
     }
 
     /**
@@ -50,7 +52,7 @@ namespace stan {
      * second variable's value.
      */
     inline bool operator!=(double a, const var& b) {
-      return a != b.val();
+      return record_compact_guard(COMPACT_NE, a != b.val(), b.vi_, 0, a);
     }
 
   }
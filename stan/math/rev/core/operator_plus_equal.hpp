@@ -8,14 +8,12 @@ namespace stan {
   namespace math {
 
     inline var& var::operator+=(const var& b) {
-      vi_ = new add_vv_vari(vi_, b.vi_);
+      vi_ = (*this + b).vi_;
       return *this;
     }
 
     inline var& var::operator+=(double b) {
-      if (b == 0.0)
-        return *this;
-      vi_ = new add_vd_vari(vi_, b);
+      vi_ = (*this + b).vi_;
       return *this;
     }
 
@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_SUBTRACTION_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_SUBTRACTION_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/vv_vari.hpp>
 #include <stan/math/rev/core/vd_vari.hpp>
@@ -97,6 +98,12 @@ namespace stan {
      * the first.
      */
     inline var operator-(const var& a, const var& b) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_)
+                                     || is_nan(b.vi_->val_)
+                                     ? COMPACT_NAN_VV : COMPACT_SUB_VV,
+                                     a.vi_->val_ - b.vi_->val_,
+                                     a.vi_, b.vi_));
       return var(new subtract_vv_vari(a.vi_, b.vi_));
     }
 
@@ -114,6 +121,10 @@ namespace stan {
     inline var operator-(const var& a, double b) {
       if (b == 0.0)
         return a;
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_) || is_nan(b)
+                                     ? COMPACT_NAN_V : COMPACT_ADD_V,
+                                     a.vi_->val_ - b, a.vi_, 0, -b));
       return var(new subtract_vd_vari(a.vi_, b));
     }
 
@@ -129,6 +140,10 @@ namespace stan {
      * @return Result of sutracting a variable from a scalar.
      */
     inline var operator-(double a, const var& b) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a) || is_nan(b.vi_->val_)
+                                     ? COMPACT_NAN_V : COMPACT_NEG,
+                                     a - b.vi_->val_, b.vi_, 0, a));
       return var(new subtract_dv_vari(a, b.vi_));
     }
 
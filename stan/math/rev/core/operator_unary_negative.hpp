@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_UNARY_NEGATIVE_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_UNARY_NEGATIVE_HPP
 
+#include <stan/math/rev/core/compact_tape_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/v_vari.hpp>
 #include <stan/math/prim/scal/fun/is_nan.hpp>
@@ -49,6 +50,10 @@ namespace stan {
      * @return Negation of variable.
      */
     inline var operator-(const var& a) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(is_nan(a.vi_->val_)
+                                     ? COMPACT_NAN_V : COMPACT_NEG,
+                                     -a.vi_->val_, a.vi_));
       return var(new neg_vari(a.vi_));
     }
 
@@ -26,6 +26,7 @@ namespace stan {
       }
       ChainableStack::var_alloc_stack_.clear();
       ChainableStack::memalloc_.recover_all();
+      ChainableStack::compact_tape_.clear();
     }
 
   }
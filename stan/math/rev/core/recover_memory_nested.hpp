@@ -40,6 +40,7 @@ namespace stan {
       ChainableStack::nested_var_alloc_stack_starts_.pop_back();
 
       ChainableStack::memalloc_.recover_nested();
+      ChainableStack::compact_tape_.recover_nested();
     }
 
   }
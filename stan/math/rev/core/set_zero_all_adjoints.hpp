@@ -16,6 +16,8 @@ namespace stan {
         ChainableStack::var_stack_[i]->set_zero_adjoint();
       for (size_t i = 0; i < ChainableStack::var_nochain_stack_.size(); ++i)
         ChainableStack::var_nochain_stack_[i]->set_zero_adjoint();
+      for (size_t i = 0; i < ChainableStack::compact_tape_.size(); ++i)
+        ChainableStack::compact_tape_.res_[i]->set_zero_adjoint();
     }
 
   }
@@ -29,6 +29,10 @@ namespace stan {
            i < ChainableStack::var_nochain_stack_.size(); ++i) {
         ChainableStack::var_nochain_stack_[i]->set_zero_adjoint();
       }
+
+      size_t start3 = ChainableStack::compact_tape_.nested_sizes_.back();
+      for (size_t i = start3; i < ChainableStack::compact_tape_.size(); ++i)
+        ChainableStack::compact_tape_.res_[i]->set_zero_adjoint();
     }
 
   }
@@ -18,6 +18,7 @@ namespace stan {
       ChainableStack::nested_var_alloc_stack_starts_
         .push_back(ChainableStack::var_alloc_stack_.size());
       ChainableStack::memalloc_.start_nested();
+      ChainableStack::compact_tape_.start_nested();
     }
 
   }
@@ -0,0 +1,102 @@
+#ifndef STAN_MATH_REV_CORE_VAR_MATRIX_HPP
+#define STAN_MATH_REV_CORE_VAR_MATRIX_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core/vari_matrix.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * A matrix of independent or dependent variables whose values
+     * and adjoints are stored contiguously.
+     *
+     * <p>Like <code>var</code>, this is a pointer to its
+     * implementation, a <code>vari_matrix</code> in the arena, and is
+     * cheap to copy. It is converted from and to
+     * <code>Eigen::Matrix&lt;var, R, C&gt;</code> with
+     * <code>to_var_matrix()</code> and <code>to_var()</code>, and
+     * operations on it, such as <code>multiply()</code> and
+     * <code>cholesky_decompose()</code>, take their operands' values
+     * and adjoints as <code>Eigen::Map</code>s.
+     */
+    class var_matrix {
+    public:
+      /**
+       * Pointer to the implementation of this matrix.
+       */
+      vari_matrix* vi_;
+
+      /**
+       * Construct a matrix variable with a null implementation.
+       */
+      var_matrix() : vi_(0) { }
+
+      /**
+       * Construct a matrix variable from the specified
+       * implementation.
+       *
+       * @param vi implementation
+       */
+      explicit var_matrix(vari_matrix* vi) : vi_(vi) { }
+
+      /**
+       * Construct an independent matrix variable with the specified
+       * values.
+       *
+       * @param x values
+       */
+      template <int R, int C>
+      explicit var_matrix(const Eigen::Matrix<double, R, C>& x)
+        : vi_(new vari_matrix(x)) { }
+
+      /**
+       * Return the number of rows.
+       *
+       * @return number of rows
+       */
+      int rows() const {
+        return vi_->rows_;
+      }
+
+      /**
+       * Return the number of columns.
+       *
+       * @return number of columns
+       */
+      int cols() const {
+        return vi_->cols_;
+      }
+
+      /**
+       * Return the number of entries.
+       *
+       * @return number of entries
+       */
+      int size() const {
+        return vi_->rows_ * vi_->cols_;
+      }
+
+      /**
+       * Return the values of the matrix.
+       *
+       * @return map of the values
+       */
+      Eigen::Map<Eigen::MatrixXd> val() const {
+        return vi_->val();
+      }
+
+      /**
+       * Return the adjoints of the matrix, which are the partial
+       * derivatives of the last gradient with respect to its entries.
+       *
+       * @return map of the adjoints
+       */
+      Eigen::Map<Eigen::MatrixXd> adj() const {
+        return vi_->adj();
+      }
+    };
+
+  }
+}
+#endif
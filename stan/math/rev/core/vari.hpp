@@ -70,6 +70,24 @@ namespace stan {
           ChainableStack::var_nochain_stack_.push_back(this);
       }
 
+      /**
+       * Tag type for constructing a variable that is put on neither
+       * stack.
+       */
+      struct unstacked {};
+
+      /**
+       * Construct a variable implementation from a value without
+       * adding it to either stack.  This is only for variables whose
+       * adjoints are reset and propagated by some other owner, such
+       * as the results of compact tape entries.
+       *
+       * @param x Value of the constructed variable.
+       */
+      vari(double x, unstacked):
+        val_(x),
+        adj_(0.0) { }
+
       /**
        * Throw an illegal argument exception.
        *
@@ -102,9 +120,11 @@ namespace stan {
       /**
        * Set the adjoint value of this variable to 0.  This is used to
        * reset adjoints before propagating derivatives again (for
-       * example in a Jacobian calculation).
+       * example in a Jacobian calculation).  Variables that hold
+       * further adjoints, such as matrix variables, override this to
+       * reset them as well.
        */
-      void set_zero_adjoint() {
+      virtual void set_zero_adjoint() {
         adj_ = 0.0;
       }
 
@@ -0,0 +1,103 @@
+#ifndef STAN_MATH_REV_CORE_VARI_MATRIX_HPP
+#define STAN_MATH_REV_CORE_VARI_MATRIX_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * The variable implementation base class for matrices whose
+     * values and adjoints are stored as two contiguous column-major
+     * arrays in the arena.
+     *
+     * <p>The matrix is a single vari. Operations on matrices of this
+     * type read the values of their operands and add to the adjoints
+     * of their operands through <code>Eigen::Map</code>s of these
+     * arrays, so they need not gather values from or scatter
+     * adjoints to one vari per entry. The base class is used for
+     * independent matrices, whose <code>chain()</code> is a no-op.
+     */
+    class vari_matrix : public vari {
+    public:
+      /**
+       * Number of rows of the matrix.
+       */
+      const int rows_;
+
+      /**
+       * Number of columns of the matrix.
+       */
+      const int cols_;
+
+      /**
+       * Values of the matrix in column-major order.
+       */
+      double* vals_;
+
+      /**
+       * Adjoints of the matrix in column-major order.
+       */
+      double* adjs_;
+
+      /**
+       * Construct a matrix variable of the specified size, with
+       * values to be set by the caller and zero adjoints.
+       *
+       * @param rows number of rows
+       * @param cols number of columns
+       * @param stacked whether chain() should be called in the
+       * reverse pass
+       */
+      vari_matrix(int rows, int cols, bool stacked = true)
+        : vari(0.0, stacked), rows_(rows), cols_(cols),
+          vals_(ChainableStack::memalloc_.alloc_array<double>(rows * cols)),
+          adjs_(ChainableStack::memalloc_
+                .alloc_array<double>(rows * cols)) {
+        adj().setZero();
+      }
+
+      /**
+       * Construct an independent matrix variable with the specified
+       * values.
+       *
+       * @param x values
+       */
+      template <int R, int C>
+      explicit vari_matrix(const Eigen::Matrix<double, R, C>& x)
+        : vari(0.0, false), rows_(x.rows()), cols_(x.cols()),
+          vals_(ChainableStack::memalloc_.alloc_array<double>(x.size())),
+          adjs_(ChainableStack::memalloc_.alloc_array<double>(x.size())) {
+        val() = x;
+        adj().setZero();
+      }
+
+      /**
+       * Return the values of the matrix.
+       *
+       * @return map of the values
+       */
+      Eigen::Map<Eigen::MatrixXd> val() const {
+        return Eigen::Map<Eigen::MatrixXd>(vals_, rows_, cols_);
+      }
+
+      /**
+       * Return the adjoints of the matrix.
+       *
+       * @return map of the adjoints
+       */
+      Eigen::Map<Eigen::MatrixXd> adj() const {
+        return Eigen::Map<Eigen::MatrixXd>(adjs_, rows_, cols_);
+      }
+
+      void set_zero_adjoint() {
+        adj_ = 0.0;
+        adj().setZero();
+      }
+    };
+
+  }
+}
+#endif
@@ -15,6 +15,8 @@
 #include <stan/math/rev/mat/fun/cholesky_decompose.hpp>
 #include <stan/math/rev/mat/fun/columns_dot_product.hpp>
 #include <stan/math/rev/mat/fun/columns_dot_self.hpp>
+#include <stan/math/rev/mat/fun/columns_log_mix.hpp>
+#include <stan/math/rev/mat/fun/columns_log_sum_exp.hpp>
 #include <stan/math/rev/mat/fun/cov_exp_quad.hpp>
 #include <stan/math/rev/mat/fun/crossprod.hpp>
 #include <stan/math/rev/mat/fun/determinant.hpp>
@@ -28,6 +30,7 @@
 #include <stan/math/rev/mat/fun/log_determinant.hpp>
 #include <stan/math/rev/mat/fun/log_determinant_ldlt.hpp>
 #include <stan/math/rev/mat/fun/log_determinant_spd.hpp>
+#include <stan/math/rev/mat/fun/log_mix_slices.hpp>
 #include <stan/math/rev/mat/fun/log_softmax.hpp>
 #include <stan/math/rev/mat/fun/log_sum_exp.hpp>
 #include <stan/math/rev/mat/fun/mdivide_left.hpp>
@@ -39,6 +42,8 @@
 #include <stan/math/rev/mat/fun/quad_form.hpp>
 #include <stan/math/rev/mat/fun/quad_form_sym.hpp>
 #include <stan/math/rev/mat/fun/rows_dot_product.hpp>
+#include <stan/math/rev/mat/fun/rows_log_mix.hpp>
+#include <stan/math/rev/mat/fun/rows_log_sum_exp.hpp>
 #include <stan/math/rev/mat/fun/sd.hpp>
 #include <stan/math/rev/mat/fun/softmax.hpp>
 #include <stan/math/rev/mat/fun/squared_distance.hpp>
@@ -46,6 +51,7 @@
 #include <stan/math/rev/mat/fun/sum.hpp>
 #include <stan/math/rev/mat/fun/tcrossprod.hpp>
 #include <stan/math/rev/mat/fun/to_var.hpp>
+#include <stan/math/rev/mat/fun/to_var_matrix.hpp>
 #include <stan/math/rev/mat/fun/trace_gen_inv_quad_form_ldlt.hpp>
 #include <stan/math/rev/mat/fun/trace_gen_quad_form.hpp>
 #include <stan/math/rev/mat/fun/trace_inv_quad_form_ldlt.hpp>
@@ -53,9 +59,14 @@
 #include <stan/math/rev/mat/fun/typedefs.hpp>
 #include <stan/math/rev/mat/fun/variance.hpp>
 #include <stan/math/rev/mat/functor/algebra_solver.hpp>
+#include <stan/math/rev/mat/functor/checkpoint.hpp>
 #include <stan/math/rev/mat/functor/gradient.hpp>
+#include <stan/math/rev/mat/functor/gradient_batch.hpp>
 #include <stan/math/rev/mat/functor/jacobian.hpp>
 #include <stan/math/rev/mat/functor/ode_system.hpp>
+#include <stan/math/rev/mat/functor/record_compact_program.hpp>
+#include <stan/math/rev/mat/functor/taped_gradient.hpp>
+#include <stan/math/rev/mat/functor/taped_jacobian.hpp>
 #include <stan/math/rev/mat/functor/cvodes_utils.hpp>
 #include <stan/math/rev/mat/functor/cvodes_ode_data.hpp>
 #include <stan/math/rev/mat/functor/integrate_ode_bdf.hpp>
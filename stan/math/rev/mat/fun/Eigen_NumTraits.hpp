@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/rev/core.hpp>
+#include <stan/math/rev/core/gemm_vvv_vari.hpp>
 #include <stan/math/rev/core/std_numeric_limits.hpp>
 #include <limits>
 
@@ -108,8 +109,8 @@ namespace Eigen {
      *
      * @tparam Index index type
      * @tparam LhsMapper left-hand side data and stride
-     * @tparam CongjuageLhs left-hand side conjugacy flag
-     * @tparam CongjuageRhs right-hand side conjugacy flag
+     * @tparam ConjugateLhs left-hand side conjugacy flag
+     * @tparam ConjugateRhs right-hand side conjugacy flag
      * @tparam RhsMapper right-hand side data and stride
      * @tparam Version integer version number
      */
@@ -143,13 +144,10 @@ namespace Eigen {
           const RhsScalar* rhs, Index rhsIncr,
           ResScalar* res, Index resIncr,
           const ResScalar &alpha) {
-        using stan::math::var;
-        using stan::math::gevv_vvv_vari;
-        for (Index i = 0; i < rows; ++i) {
-          res[i * resIncr]
-            += var(new gevv_vvv_vari(&alpha, &lhs[i], lhsStride,
-                                     rhs, rhsIncr, cols));
-        }
+        stan::math::gemm_vvv_vari::run(rows, 1, cols,
+                                       lhs, 1, lhsStride,
+                                       rhs, rhsIncr, 0,
+                                       res, resIncr, 0, alpha);
       }
     };
 
@@ -183,20 +181,24 @@ namespace Eigen {
           const RhsScalar* rhs, Index rhsIncr,
           ResScalar* res, Index resIncr,
           const RhsScalar &alpha) {
-        for (Index i = 0; i < rows; i++) {
-          res[i*resIncr]
-            += stan::math::var
-            (new stan::math::gevv_vvv_vari
-             (&alpha,
-              (static_cast<int>(LhsStorageOrder) == static_cast<int>(ColMajor))
-              ? (&lhs[i]) : (&lhs[i*lhsStride]),
-              (static_cast<int>(LhsStorageOrder) == static_cast<int>(ColMajor))
-              ? (lhsStride) : (1),
-              rhs, rhsIncr, cols));
-        }
+        stan::math::gemm_vvv_vari::run(rows, 1, cols,
+                                       lhs, lhsStride, 1,
+                                       rhs, rhsIncr, 0,
+                                       res, resIncr, 0, alpha);
       }
     };
 
+    /**
+     * Specialization of matrix-matrix products for reverse-mode
+     * autodiff variables. The whole product is a single vari, whose
+     * forward and reverse passes are matrix products of doubles.
+     *
+     * @tparam Index index type
+     * @tparam LhsStorageOrder left-hand side storage order
+     * @tparam ConjugateLhs left-hand side conjugacy flag
+     * @tparam RhsStorageOrder right-hand side storage order
+     * @tparam ConjugateRhs right-hand side conjugacy flag
+     */
     template <typename Index, int LhsStorageOrder, bool ConjugateLhs,
               int RhsStorageOrder, bool ConjugateRhs>
     struct general_matrix_matrix_product<Index, stan::math::var,
@@ -222,20 +224,16 @@ namespace Eigen {
                       const ResScalar &alpha,
                       level3_blocking<LhsScalar, RhsScalar>& /* blocking */,
                       GemmParallelInfo<Index>* /* info = 0 */) {
-        for (Index i = 0; i < cols; i++) {
-          general_matrix_vector_product<Index, LhsScalar, LhsMapper,
-                                        LhsStorageOrder,
-                                        ConjugateLhs, RhsScalar, RhsMapper,
-                                        ConjugateRhs>
-            ::run(rows, depth, lhs, lhsStride,
-                  &rhs[static_cast<int>(RhsStorageOrder)
-                       == static_cast<int>(ColMajor)
-                       ? i * rhsStride : i],
-                  static_cast<int>(RhsStorageOrder)
-                  == static_cast<int>(ColMajor)
-                  ? 1 : rhsStride,
-                  &res[i * resStride], 1, alpha);
-        }
+        bool lhs_col_major = static_cast<int>(LhsStorageOrder)
+          == static_cast<int>(ColMajor);
+        bool rhs_col_major = static_cast<int>(RhsStorageOrder)
+          == static_cast<int>(ColMajor);
+        stan::math::gemm_vvv_vari::run(rows, cols, depth,
+                                       lhs, lhs_col_major ? 1 : lhsStride,
+                                       lhs_col_major ? lhsStride : 1,
+                                       rhs, rhs_col_major ? 1 : rhsStride,
+                                       rhs_col_major ? rhsStride : 1,
+                                       res, 1, resStride, alpha);
       }
 
       EIGEN_DONT_INLINE
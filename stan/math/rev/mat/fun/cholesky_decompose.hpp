@@ -49,8 +49,7 @@ namespace stan {
           variRefL_(ChainableStack::memalloc_.alloc_array<vari*>
                     (A.rows() * (A.rows() + 1) / 2)) {
             size_t pos = 0;
-            block_size_ = std::max((M_ / 8 / 16) * 16, 8);
-            block_size_ = std::min(block_size_, 128);
+            block_size_ = block_size(M_);
             for (size_type j = 0; j < M_; ++j) {
               for (size_type i = j; i < M_; ++i) {
                 variRefA_[pos] = A.coeffRef(i, j).vi_;
@@ -59,14 +58,24 @@ namespace stan {
             }
           }
 
+      /**
+       * Return the block size for the specified size of matrix.
+       *
+       * @param M number of rows of the matrix
+       * @return block size
+       */
+      static int block_size(int M) {
+        return std::min(std::max((M / 8 / 16) * 16, 8), 128);
+      }
+
       /**
        * Symbolic adjoint calculation for cholesky factor A
        *
        * @param L cholesky factor
        * @param Lbar matrix of adjoints of L
        */
-      inline void symbolic_rev(Block_& L,
-                               Block_& Lbar) {
+      static inline void symbolic_rev(Block_& L,
+                                      Block_& Lbar) {
         using Eigen::Lower;
         using Eigen::Upper;
         using Eigen::StrictlyUpper;
@@ -79,41 +88,32 @@ namespace stan {
       }
 
       /**
-       * Reverse mode differentiation algorithm refernce:
+       * Replace the adjoints of the lower triangle of a cholesky
+       * factor by the adjoints of the lower triangle of the
+       * factored matrix, using the blocked algorithm from
        *
        * Iain Murray: Differentiation of the Cholesky decomposition, 2016.
        *
+       * @param[in, out] L cholesky factor, whose upper triangle is zero
+       * @param[in, out] Lbar adjoints of L, whose upper triangle is zero
+       * @param block_size block size
        */
-      virtual void chain() {
-        using Eigen::MatrixXd;
+      static void adjoint(Eigen::MatrixXd& L, Eigen::MatrixXd& Lbar,
+                          int block_size) {
         using Eigen::Lower;
-        using Eigen::Block;
-        using Eigen::Upper;
         using Eigen::StrictlyUpper;
-        MatrixXd Lbar(M_, M_);
-        MatrixXd L(M_, M_);
-
-        Lbar.setZero();
-        L.setZero();
-        size_t pos = 0;
-        for (size_type j = 0; j < M_; ++j) {
-          for (size_type i = j; i < M_; ++i) {
-            Lbar.coeffRef(i, j) = variRefL_[pos]->adj_;
-            L.coeffRef(i, j) = variRefL_[pos]->val_;
-            ++pos;
-          }
-        }
-
-        for (int k = M_; k > 0; k -= block_size_) {
-          int j = std::max(0, k - block_size_);
+        using Eigen::Upper;
+        int M = L.rows();
+        for (int k = M; k > 0; k -= block_size) {
+          int j = std::max(0, k - block_size);
           Block_ R = L.block(j, 0, k - j, j);
           Block_ D = L.block(j, j, k - j, k - j);
-          Block_ B = L.block(k, 0, M_ - k, j);
-          Block_ C = L.block(k, j, M_ - k, k - j);
+          Block_ B = L.block(k, 0, M - k, j);
+          Block_ C = L.block(k, j, M - k, k - j);
           Block_ Rbar = Lbar.block(j, 0, k - j, j);
           Block_ Dbar = Lbar.block(j, j, k - j, k - j);
-          Block_ Bbar = Lbar.block(k, 0, M_ - k, j);
-          Block_ Cbar = Lbar.block(k, j, M_ - k, k - j);
+          Block_ Bbar = Lbar.block(k, 0, M - k, j);
+          Block_ Cbar = Lbar.block(k, j, M - k, k - j);
           if (Cbar.size() > 0) {
             Cbar
               = D.transpose().triangularView<Upper>()
@@ -127,6 +127,31 @@ namespace stan {
           Dbar.diagonal() *= 0.5;
           Dbar.triangularView<StrictlyUpper>().setZero();
         }
+      }
+
+      /**
+       * Reverse mode differentiation algorithm refernce:
+       *
+       * Iain Murray: Differentiation of the Cholesky decomposition, 2016.
+       *
+       */
+      virtual void chain() {
+        using Eigen::MatrixXd;
+        MatrixXd Lbar(M_, M_);
+        MatrixXd L(M_, M_);
+
+        Lbar.setZero();
+        L.setZero();
+        size_t pos = 0;
+        for (size_type j = 0; j < M_; ++j) {
+          for (size_type i = j; i < M_; ++i) {
+            Lbar.coeffRef(i, j) = variRefL_[pos]->adj_;
+            L.coeffRef(i, j) = variRefL_[pos]->val_;
+            ++pos;
+          }
+        }
+
+        adjoint(L, Lbar, block_size_);
         pos = 0;
         for (size_type j = 0; j < M_; ++j)
           for (size_type i = j; i < M_; ++i)
@@ -282,6 +307,53 @@ namespace stan {
       }
       return L;
     }
+
+    /**
+     * The vari for the cholesky factor of a matrix variable. The
+     * reverse pass runs the blocked algorithm of
+     * <code>cholesky_block</code> on the values and adjoints of the
+     * factor and adds the result to the adjoints of the lower
+     * triangle of the matrix.
+     */
+    class cholesky_var_matrix_vari : public vari_matrix {
+    public:
+      vari_matrix* A_;
+
+      /**
+       * Constructor for the cholesky factor of a matrix variable.
+       *
+       * @param A implementation of the matrix
+       * @param L_A cholesky factor of the values of the matrix
+       */
+      cholesky_var_matrix_vari(vari_matrix* A, const Eigen::MatrixXd& L_A)
+        : vari_matrix(L_A.rows(), L_A.cols()), A_(A) {
+        val() = L_A;
+      }
+
+      virtual void chain() {
+        Eigen::MatrixXd L = val();
+        Eigen::MatrixXd Lbar = adj().triangularView<Eigen::Lower>();
+        cholesky_block::adjoint(L, Lbar, cholesky_block::block_size(rows_));
+        A_->adj().triangularView<Eigen::Lower>() += Lbar;
+      }
+    };
+
+    /**
+     * Reverse mode specialization of cholesky decomposition for
+     * matrix variables.
+     *
+     * @param A matrix variable
+     * @return L cholesky factor of A
+     */
+    inline var_matrix cholesky_decompose(const var_matrix& A) {
+      Eigen::MatrixXd L_A = A.val();
+      check_square("cholesky_decompose", "A", L_A);
+      check_symmetric("cholesky_decompose", "A", L_A);
+      Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>, Eigen::Lower> L_factor(L_A);
+      check_pos_definite("cholesky_decompose", "m", L_factor);
+      L_A.triangularView<Eigen::StrictlyUpper>().setZero();
+      return var_matrix(new cholesky_var_matrix_vari(A.vi_, L_A));
+    }
   }
 }
 #endif
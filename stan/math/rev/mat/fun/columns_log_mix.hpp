@@ -0,0 +1,89 @@
+#ifndef STAN_MATH_REV_MAT_FUN_COLUMNS_LOG_MIX_HPP
+#define STAN_MATH_REV_MAT_FUN_COLUMNS_LOG_MIX_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/log_mix_slices.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/meta/is_vector_like.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/scal/err/check_bounded.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      template <typename T_theta, typename T_lambda, int R, int C>
+      inline Eigen::Matrix<var, 1, C>
+      columns_log_mix(const Eigen::Matrix<T_theta, Eigen::Dynamic, 1>& theta,
+                      const Eigen::Matrix<T_lambda, R, C>& lambda) {
+        check_bounded("columns_log_mix", "theta", theta, 0, 1);
+        check_not_nan("columns_log_mix", "lambda", lambda);
+        check_size_match("columns_log_mix", "size of theta", theta.size(),
+                         "rows of lambda", lambda.rows());
+        Eigen::Matrix<var, 1, C> ret(lambda.cols());
+        log_mix_slices(&theta, lambda, false, ret.data());
+        return ret;
+      }
+
+    }
+
+    /**
+     * Return the log mixture density of each column of the specified
+     * matrix of log densities, with the specified mixing proportions.
+     *
+     * <p>All of the results share a single vari, which keeps the
+     * weights of the log densities for the reverse pass.
+     *
+     * @param[in] theta mixing proportions in [0, 1].
+     * @param[in] lambda log densities.
+     * @return Row vector of the log mixture densities of the columns.
+     */
+    template <int R, int C>
+    inline Eigen::Matrix<var, 1, C>
+    columns_log_mix(const Eigen::Matrix<var, Eigen::Dynamic, 1>& theta,
+                    const Eigen::Matrix<var, R, C>& lambda) {
+      return internal::columns_log_mix(theta, lambda);
+    }
+
+    /**
+     * Return the log mixture density of each column of the specified
+     * matrix of log densities, with the specified mixing proportions.
+     *
+     * <p>All of the results share a single vari, which keeps the
+     * weights of the log densities for the reverse pass.
+     *
+     * @param[in] theta mixing proportions in [0, 1].
+     * @param[in] lambda log densities.
+     * @return Row vector of the log mixture densities of the columns.
+     */
+    template <int R, int C>
+    inline Eigen::Matrix<var, 1, C>
+    columns_log_mix(const Eigen::Matrix<var, Eigen::Dynamic, 1>& theta,
+                    const Eigen::Matrix<double, R, C>& lambda) {
+      return internal::columns_log_mix(theta, lambda);
+    }
+
+    /**
+     * Return the log mixture density of each column of the specified
+     * matrix of log densities, with the specified mixing proportions.
+     *
+     * <p>All of the results share a single vari, which keeps the
+     * weights of the log densities for the reverse pass.
+     *
+     * @param[in] theta mixing proportions in [0, 1].
+     * @param[in] lambda log densities.
+     * @return Row vector of the log mixture densities of the columns.
+     */
+    template <int R, int C>
+    inline Eigen::Matrix<var, 1, C>
+    columns_log_mix(const Eigen::Matrix<double, Eigen::Dynamic, 1>& theta,
+                    const Eigen::Matrix<var, R, C>& lambda) {
+      return internal::columns_log_mix(theta, lambda);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,223 @@
+#ifndef STAN_MATH_REV_MAT_FUN_LOG_MIX_SLICES_HPP
+#define STAN_MATH_REV_MAT_FUN_LOG_MIX_SLICES_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/fun/value_of.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      /**
+       * The vari for the log mixture densities, or the log sums of
+       * exponentials, of the rows or the columns of a matrix.
+       *
+       * <p>The first result is this vari and the others are varis
+       * that are not chained, so the whole operation is a single vari
+       * on the stack. The weight of each entry, <code>exp(lambda -
+       * y)</code> for the result <code>y</code> of its row or column,
+       * is stored in column-major order like the matrix, and the
+       * reverse pass scales the weights by the adjoints of the results
+       * in one sweep over the matrix.
+       */
+      class log_mix_slices_vari : public vari {
+      public:
+        size_t rows_;
+        size_t cols_;
+        bool by_rows_;
+        double* theta_;
+        vari** theta_vis_;
+        vari** lambda_vis_;
+        double* weights_;
+        vari** y_;
+
+        /**
+         * Construct the vari for the specified results and weights.
+         * The first result is the value of this vari.
+         *
+         * @param[in] rows number of rows of the matrix
+         * @param[in] cols number of columns of the matrix
+         * @param[in] by_rows whether the results are of the rows or
+         * of the columns
+         * @param[in] theta mixing proportions, or 0 if there are none
+         * @param[in] theta_vis varis of the mixing proportions, or 0
+         * if they are constants
+         * @param[in] lambda_vis varis of the entries, or 0 if they are
+         * constants
+         * @param[in] weights weights of the entries
+         * @param[in] y results
+         */
+        log_mix_slices_vari(size_t rows, size_t cols, bool by_rows,
+                            double* theta, vari** theta_vis,
+                            vari** lambda_vis, double* weights,
+                            const std::vector<double>& y)
+          : vari(y[0]), rows_(rows), cols_(cols), by_rows_(by_rows),
+            theta_(theta), theta_vis_(theta_vis), lambda_vis_(lambda_vis),
+            weights_(weights),
+            y_(ChainableStack::memalloc_.alloc_array<vari*>(y.size())) {
+          y_[0] = this;
+          for (size_t n = 1; n < y.size(); ++n)
+            y_[n] = new vari(y[n], false);
+        }
+
+        void chain() {
+          size_t N = by_rows_ ? rows_ : cols_;
+          size_t K = by_rows_ ? cols_ : rows_;
+          std::vector<double> adj(N);
+          for (size_t n = 0; n < N; ++n)
+            adj[n] = y_[n]->adj_;
+          std::vector<double> theta_adj(theta_vis_ ? K : 0, 0.0);
+          for (size_t j = 0; j < cols_; ++j) {
+            for (size_t i = 0; i < rows_; ++i) {
+              size_t n = by_rows_ ? i : j;
+              size_t k = by_rows_ ? j : i;
+              double a = adj[n] * weights_[i + j * rows_];
+              if (lambda_vis_)
+                lambda_vis_[i + j * rows_]->adj_ += theta_ ? theta_[k] * a
+                                                           : a;
+              if (theta_vis_)
+                theta_adj[k] += a;
+            }
+          }
+          for (size_t k = 0; k < theta_adj.size(); ++k)
+            theta_vis_[k]->adj_ += theta_adj[k];
+        }
+      };
+
+      template <int R, int C>
+      inline vari** entry_varis(const Eigen::Matrix<var, R, C>& x) {
+        vari** vis
+          = ChainableStack::memalloc_.alloc_array<vari*>(x.size());
+        for (int i = 0; i < x.size(); ++i)
+          vis[i] = x(i).vi_;
+        return vis;
+      }
+
+      template <int R, int C>
+      inline vari** entry_varis(const Eigen::Matrix<double, R, C>& x) {
+        return 0;
+      }
+
+      /**
+       * Return the log mixture densities of the rows or the columns
+       * of the specified matrix of log densities, with the specified
+       * mixing proportions, as a single vari.
+       *
+       * @tparam T_theta type of mixing proportions
+       * @tparam T_lambda type of log densities
+       * @param[in] theta mixing proportions, or 0 for the log sums of
+       * exponentials
+       * @param[in] lambda log densities
+       * @param[in] by_rows whether to reduce each row or each column
+       * @param[out] y results, one per row or column
+       */
+      template <typename T_theta, typename T_lambda, int R, int C>
+      void log_mix_slices(
+          const Eigen::Matrix<T_theta, Eigen::Dynamic, 1>* theta,
+          const Eigen::Matrix<T_lambda, R, C>& lambda, bool by_rows,
+          var* y) {
+        using std::exp;
+        using std::log;
+        const double neg_inf = -std::numeric_limits<double>::infinity();
+        size_t rows = lambda.rows();
+        size_t cols = lambda.cols();
+        size_t N = by_rows ? rows : cols;
+        size_t K = by_rows ? cols : rows;
+        if (N == 0)
+          return;
+        if (K == 0) {
+          for (size_t n = 0; n < N; ++n)
+            y[n] = neg_inf;
+          return;
+        }
+
+        double* theta_val = 0;
+        vari** theta_vis = 0;
+        std::vector<double> log_theta(K, 0.0);
+        if (theta) {
+          theta_val = ChainableStack::memalloc_.alloc_array<double>(K);
+          for (size_t k = 0; k < K; ++k) {
+            theta_val[k] = value_of((*theta)(k));
+            log_theta[k] = log(theta_val[k]);
+          }
+          theta_vis = entry_varis(*theta);
+        }
+
+        // the sweeps follow the storage order of the matrix
+        double* w = ChainableStack::memalloc_.alloc_array<double>(N * K);
+        std::vector<double> max_entry(N, neg_inf);
+        for (size_t j = 0; j < cols; ++j) {
+          for (size_t i = 0; i < rows; ++i) {
+            size_t n = by_rows ? i : j;
+            double a = log_theta[by_rows ? j : i] + value_of(lambda(i, j));
+            w[i + j * rows] = a;
+            if (a > max_entry[n])
+              max_entry[n] = a;
+          }
+        }
+        std::vector<double> sum(N, 0.0);
+        for (size_t j = 0; j < cols; ++j) {
+          for (size_t i = 0; i < rows; ++i) {
+            size_t n = by_rows ? i : j;
+            double& a = w[i + j * rows];
+            a = a == neg_inf ? 0 : exp(a - max_entry[n]);
+            sum[n] += a;
+          }
+        }
+        std::vector<double> y_val(N);
+        for (size_t n = 0; n < N; ++n) {
+          y_val[n] = max_entry[n] + log(sum[n]);
+          sum[n] = 1 / sum[n];
+        }
+
+        // the weight of an entry leaves out its mixing proportion
+        for (size_t j = 0; j < cols; ++j) {
+          for (size_t i = 0; i < rows; ++i) {
+            size_t n = by_rows ? i : j;
+            size_t k = by_rows ? j : i;
+            double& a = w[i + j * rows];
+            if (!theta_val)
+              a *= sum[n];
+            else if (theta_val[k] > 0)
+              a *= sum[n] / theta_val[k];
+            else
+              a = exp(value_of(lambda(i, j)) - y_val[n]);
+          }
+        }
+
+        log_mix_slices_vari* vi
+          = new log_mix_slices_vari(rows, cols, by_rows, theta_val,
+                                    theta_vis, entry_varis(lambda), w,
+                                    y_val);
+        for (size_t n = 0; n < N; ++n)
+          y[n] = var(vi->y_[n]);
+      }
+
+      /**
+       * Return the log sums of exponentials of the rows or the
+       * columns of the specified matrix as a single vari.
+       *
+       * @param[in] x matrix
+       * @param[in] by_rows whether to reduce each row or each column
+       * @param[out] y results, one per row or column
+       */
+      template <int R, int C>
+      inline void log_sum_exp_slices(const Eigen::Matrix<var, R, C>& x,
+                                     bool by_rows, var* y) {
+        log_mix_slices(
+            static_cast<const Eigen::Matrix<double, Eigen::Dynamic, 1>*>(0),
+            x, by_rows, y);
+      }
+
+    }
+
+  }
+}
+#endif
@@ -638,6 +638,140 @@ namespace stan {
       AB_v.vi_ = baseVari->variRefAB_;
       return AB_v;
     }
+
+    namespace internal {
+
+      /**
+       * Check that no value of the specified matrix variable is NaN.
+       *
+       * @param function name of the calling function
+       * @param name name of the matrix variable
+       * @param x matrix variable
+       * @throw std::domain_error if a value is NaN
+       */
+      inline void check_not_nan_entries(const char* function,
+                                        const char* name,
+                                        const var_matrix& x) {
+        for (int i = 0; i < x.size(); ++i)
+          check_not_nan(function, name, x.vi_->vals_[i]);
+      }
+
+    }
+
+    /**
+     * This is a subclass of the vari_matrix class for matrix
+     * multiplication A * B of matrix variables, or of a matrix
+     * variable and a matrix of doubles.
+     *
+     * The values of a matrix variable operand are read from its
+     * arena storage and the values of a constant operand are copied
+     * to the arena, so the reverse pass adds to the adjoints of the
+     * operands with two matrix products and no gather or scatter.
+     */
+    class multiply_var_matrix_vari : public vari_matrix {
+    public:
+      int A_cols_;
+      vari_matrix* A_;
+      vari_matrix* B_;
+      const double* Ad_;
+      const double* Bd_;
+
+      /**
+       * Constructor for multiply_var_matrix_vari.
+       *
+       * @param A_rows rows of A
+       * @param A_cols columns of A, rows of B
+       * @param B_cols columns of B
+       * @param A implementation of A, or 0 if A is constant
+       * @param Ad values of A
+       * @param B implementation of B, or 0 if B is constant
+       * @param Bd values of B
+       */
+      multiply_var_matrix_vari(int A_rows, int A_cols, int B_cols,
+                               vari_matrix* A, const double* Ad,
+                               vari_matrix* B, const double* Bd)
+        : vari_matrix(A_rows, B_cols), A_cols_(A_cols), A_(A), B_(B),
+          Ad_(Ad), Bd_(Bd) {
+        using Eigen::Map;
+        using Eigen::MatrixXd;
+        val().noalias()
+          = Map<const MatrixXd>(Ad_, rows_, A_cols_)
+          * Map<const MatrixXd>(Bd_, A_cols_, cols_);
+      }
+
+      virtual void chain() {
+        using Eigen::Map;
+        using Eigen::MatrixXd;
+        if (A_)
+          A_->adj().noalias()
+            += adj() * Map<const MatrixXd>(Bd_, A_cols_, cols_).transpose();
+        if (B_)
+          B_->adj().noalias()
+            += Map<const MatrixXd>(Ad_, rows_, A_cols_).transpose() * adj();
+      }
+    };
+
+    /**
+     * Return the product of the specified matrix variables.
+     *
+     * @param[in] A matrix variable
+     * @param[in] B matrix variable
+     * @return product of the matrix variables
+     */
+    inline var_matrix multiply(const var_matrix& A, const var_matrix& B) {
+      check_multiplicable("multiply", "A", A, "B", B);
+      internal::check_not_nan_entries("multiply", "A", A);
+      internal::check_not_nan_entries("multiply", "B", B);
+      return var_matrix(new multiply_var_matrix_vari(A.rows(), A.cols(),
+                                                     B.cols(), A.vi_,
+                                                     A.vi_->vals_, B.vi_,
+                                                     B.vi_->vals_));
+    }
+
+    /**
+     * Return the product of the specified matrix variable and matrix.
+     *
+     * @tparam R2 rows of B
+     * @tparam C2 columns of B
+     * @param[in] A matrix variable
+     * @param[in] B matrix
+     * @return product of the matrix variable and the matrix
+     */
+    template <int R2, int C2>
+    inline var_matrix multiply(const var_matrix& A,
+                               const Eigen::Matrix<double, R2, C2>& B) {
+      check_multiplicable("multiply", "A", A, "B", B);
+      internal::check_not_nan_entries("multiply", "A", A);
+      check_not_nan("multiply", "B", B);
+      double* Bd = ChainableStack::memalloc_.alloc_array<double>(B.size());
+      Eigen::Map<Eigen::MatrixXd>(Bd, B.rows(), B.cols()) = B;
+      return var_matrix(new multiply_var_matrix_vari(A.rows(), A.cols(),
+                                                     B.cols(), A.vi_,
+                                                     A.vi_->vals_, 0, Bd));
+    }
+
+    /**
+     * Return the product of the specified matrix and matrix variable.
+     *
+     * @tparam R1 rows of A
+     * @tparam C1 columns of A
+     * @param[in] A matrix
+     * @param[in] B matrix variable
+     * @return product of the matrix and the matrix variable
+     */
+    template <int R1, int C1>
+    inline var_matrix multiply(const Eigen::Matrix<double, R1, C1>& A,
+                               const var_matrix& B) {
+      check_multiplicable("multiply", "A", A, "B", B);
+      check_not_nan("multiply", "A", A);
+      internal::check_not_nan_entries("multiply", "B", B);
+      double* Ad = ChainableStack::memalloc_.alloc_array<double>(A.size());
+      Eigen::Map<Eigen::MatrixXd>(Ad, A.rows(), A.cols()) = A;
+      return var_matrix(new multiply_var_matrix_vari(A.rows(), A.cols(),
+                                                     B.cols(), 0, Ad,
+                                                     B.vi_, B.vi_->vals_));
+    }
+
   }
 }
 #endif
@@ -0,0 +1,89 @@
+#ifndef STAN_MATH_REV_MAT_FUN_ROWS_LOG_MIX_HPP
+#define STAN_MATH_REV_MAT_FUN_ROWS_LOG_MIX_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/log_mix_slices.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/meta/is_vector_like.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/scal/err/check_bounded.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      template <typename T_theta, typename T_lambda, int R, int C>
+      inline Eigen::Matrix<var, R, 1>
+      rows_log_mix(const Eigen::Matrix<T_theta, Eigen::Dynamic, 1>& theta,
+                   const Eigen::Matrix<T_lambda, R, C>& lambda) {
+        check_bounded("rows_log_mix", "theta", theta, 0, 1);
+        check_not_nan("rows_log_mix", "lambda", lambda);
+        check_size_match("rows_log_mix", "size of theta", theta.size(),
+                         "columns of lambda", lambda.cols());
+        Eigen::Matrix<var, R, 1> ret(lambda.rows());
+        log_mix_slices(&theta, lambda, true, ret.data());
+        return ret;
+      }
+
+    }
+
+    /**
+     * Return the log mixture density of each row of the specified
+     * matrix of log densities, with the specified mixing proportions.
+     *
+     * <p>All of the results share a single vari, which keeps the
+     * weights of the log densities for the reverse pass.
+     *
+     * @param[in] theta mixing proportions in [0, 1].
+     * @param[in] lambda log densities.
+     * @return Vector of the log mixture densities of the rows.
+     */
+    template <int R, int C>
+    inline Eigen::Matrix<var, R, 1>
+    rows_log_mix(const Eigen::Matrix<var, Eigen::Dynamic, 1>& theta,
+                 const Eigen::Matrix<var, R, C>& lambda) {
+      return internal::rows_log_mix(theta, lambda);
+    }
+
+    /**
+     * Return the log mixture density of each row of the specified
+     * matrix of log densities, with the specified mixing proportions.
+     *
+     * <p>All of the results share a single vari, which keeps the
+     * weights of the log densities for the reverse pass.
+     *
+     * @param[in] theta mixing proportions in [0, 1].
+     * @param[in] lambda log densities.
+     * @return Vector of the log mixture densities of the rows.
+     */
+    template <int R, int C>
+    inline Eigen::Matrix<var, R, 1>
+    rows_log_mix(const Eigen::Matrix<var, Eigen::Dynamic, 1>& theta,
+                 const Eigen::Matrix<double, R, C>& lambda) {
+      return internal::rows_log_mix(theta, lambda);
+    }
+
+    /**
+     * Return the log mixture density of each row of the specified
+     * matrix of log densities, with the specified mixing proportions.
+     *
+     * <p>All of the results share a single vari, which keeps the
+     * weights of the log densities for the reverse pass.
+     *
+     * @param[in] theta mixing proportions in [0, 1].
+     * @param[in] lambda log densities.
+     * @return Vector of the log mixture densities of the rows.
+     */
+    template <int R, int C>
+    inline Eigen::Matrix<var, R, 1>
+    rows_log_mix(const Eigen::Matrix<double, Eigen::Dynamic, 1>& theta,
+                 const Eigen::Matrix<var, R, C>& lambda) {
+      return internal::rows_log_mix(theta, lambda);
+    }
+
+  }
+}
+#endif
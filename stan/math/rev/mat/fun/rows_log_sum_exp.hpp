@@ -0,0 +1,31 @@
+#ifndef STAN_MATH_REV_MAT_FUN_ROWS_LOG_SUM_EXP_HPP
+#define STAN_MATH_REV_MAT_FUN_ROWS_LOG_SUM_EXP_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/log_mix_slices.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Return the log of the sum of the exponentiated values of each
+     * row of the specified matrix.
+     *
+     * <p>All of the results share a single vari, which keeps the
+     * softmax weights of the rows for the reverse pass.
+     *
+     * @param[in] x Matrix.
+     * @return Vector of the log sums of exponentials of the rows.
+     */
+    template <int R, int C>
+    inline Eigen::Matrix<var, R, 1>
+    rows_log_sum_exp(const Eigen::Matrix<var, R, C>& x) {
+      Eigen::Matrix<var, R, 1> ret(x.rows());
+      internal::log_sum_exp_slices(x, true, ret.data());
+      return ret;
+    }
+
+  }
+}
+#endif
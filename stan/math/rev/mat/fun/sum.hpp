@@ -53,6 +53,38 @@ namespace stan {
       return var(new sum_eigen_v_vari(m));
     }
 
+    /**
+     * Class for representing the sum of the entries of a matrix
+     * variable, whose <code>chain()</code> method adds its adjoint to
+     * the adjoints of the matrix.
+     */
+    class sum_var_matrix_vari : public vari {
+    protected:
+      vari_matrix* x_;
+
+    public:
+      explicit sum_var_matrix_vari(vari_matrix* x)
+        : vari(x->val().sum()), x_(x) {
+      }
+
+      virtual void chain() {
+        x_->adj().array() += adj_;
+      }
+    };
+
+    /**
+     * Returns the sum of the entries of the specified matrix
+     * variable.
+     *
+     * @param x Specified matrix variable.
+     * @return Sum of entries of the matrix variable.
+     */
+    inline var sum(const var_matrix& x) {
+      if (x.size() == 0)
+        return 0.0;
+      return var(new sum_var_matrix_vari(x.vi_));
+    }
+
   }
 }
 #endif
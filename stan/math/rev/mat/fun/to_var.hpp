@@ -91,6 +91,58 @@ namespace stan {
       return rv;
     }
 
+    namespace internal {
+
+      /**
+       * The vari for the entries of a matrix variable as separate
+       * variables. The first entry is this vari and the others are
+       * varis that are not chained; the reverse pass adds all of
+       * their adjoints to the adjoints of the matrix.
+       */
+      class var_matrix_entries_vari : public vari {
+      public:
+        vari_matrix* x_;
+        vari** entries_;
+
+        explicit var_matrix_entries_vari(vari_matrix* x)
+          : vari(x->vals_[0]), x_(x),
+            entries_(ChainableStack::memalloc_
+                     .alloc_array<vari*>(x->rows_ * x->cols_)) {
+          entries_[0] = this;
+          for (int i = 1; i < x->rows_ * x->cols_; ++i)
+            entries_[i] = new vari(x->vals_[i], false);
+        }
+
+        void chain() {
+          for (int i = 0; i < x_->rows_ * x_->cols_; ++i)
+            x_->adjs_[i] += entries_[i]->adj_;
+        }
+      };
+
+    }
+
+    /**
+     * Converts a matrix variable to a matrix of automatic
+     * differentiation variables.
+     *
+     * <p>The entries share one vari, which passes their adjoints on
+     * to the adjoints of the matrix variable.
+     *
+     * @param[in] x A matrix variable
+     * @return A Matrix with automatic differentiation variables
+     *    with values of x.
+     */
+    inline matrix_v to_var(const var_matrix& x) {
+      matrix_v m_v(x.rows(), x.cols());
+      if (x.size() == 0)
+        return m_v;
+      internal::var_matrix_entries_vari* vi
+        = new internal::var_matrix_entries_vari(x.vi_);
+      for (int i = 0; i < m_v.size(); ++i)
+        m_v(i).vi_ = vi->entries_[i];
+      return m_v;
+    }
+
   }
 }
 #endif
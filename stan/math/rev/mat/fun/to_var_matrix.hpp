@@ -0,0 +1,75 @@
+#ifndef STAN_MATH_REV_MAT_FUN_TO_VAR_MATRIX_HPP
+#define STAN_MATH_REV_MAT_FUN_TO_VAR_MATRIX_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      /**
+       * The vari for a matrix variable holding the values of a matrix
+       * of separate variables. The reverse pass adds the adjoints of
+       * the matrix variable to the adjoints of the entries.
+       */
+      class var_entries_matrix_vari : public vari_matrix {
+      public:
+        vari** entries_;
+
+        template <int R, int C>
+        explicit var_entries_matrix_vari(const Eigen::Matrix<var, R, C>& x)
+          : vari_matrix(x.rows(), x.cols()),
+            entries_(ChainableStack::memalloc_
+                     .alloc_array<vari*>(x.size())) {
+          for (int i = 0; i < x.size(); ++i) {
+            entries_[i] = x(i).vi_;
+            vals_[i] = entries_[i]->val_;
+          }
+        }
+
+        void chain() {
+          for (int i = 0; i < rows_ * cols_; ++i)
+            entries_[i]->adj_ += adjs_[i];
+        }
+      };
+
+    }
+
+    /**
+     * Return a matrix variable with the values of the specified
+     * matrix of variables.
+     *
+     * <p>The values are gathered once, and the adjoints of the
+     * matrix variable are added to the adjoints of the entries in
+     * the reverse pass, so a chain of operations on matrix variables
+     * only converts at its ends.
+     *
+     * @tparam R number of rows, can be Eigen::Dynamic
+     * @tparam C number of columns, can be Eigen::Dynamic
+     * @param[in] x matrix of variables
+     * @return matrix variable
+     */
+    template <int R, int C>
+    inline var_matrix to_var_matrix(const Eigen::Matrix<var, R, C>& x) {
+      return var_matrix(new internal::var_entries_matrix_vari(x));
+    }
+
+    /**
+     * Return an independent matrix variable with the specified
+     * values.
+     *
+     * @tparam R number of rows, can be Eigen::Dynamic
+     * @tparam C number of columns, can be Eigen::Dynamic
+     * @param[in] x values
+     * @return matrix variable
+     */
+    template <int R, int C>
+    inline var_matrix to_var_matrix(const Eigen::Matrix<double, R, C>& x) {
+      return var_matrix(x);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,145 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_CHECKPOINT_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_CHECKPOINT_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/arr/err/check_nonzero_size.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/fun/value_of.hpp>
+#include <stdexcept>
+
+namespace stan {
+  namespace math {
+
+    namespace internal {
+
+      /**
+       * Holds a copy of the functor of a checkpointed region for as
+       * long as the region's vari is on the stack.
+       */
+      template <typename F>
+      class checkpoint_alloc : public chainable_alloc {
+      public:
+        const F f_;
+        explicit checkpoint_alloc(const F& f) : f_(f) { }
+      };
+
+      /**
+       * The vari for a checkpointed region. Only the inputs and the
+       * outputs of the region are stored. The first output is this
+       * vari and the rest are allocated without being put on the
+       * chain stack, as in <code>algebra_solver_vari</code>.
+       *
+       * <p>The chain() method recomputes the region on a nested
+       * stack, propagates the adjoints of the outputs back through
+       * it to the inputs and then recovers the nested memory.
+       */
+      template <typename F>
+      class checkpoint_vari : public vari {
+      public:
+        const checkpoint_alloc<F>* f_;
+        int x_size_;
+        vari** x_;
+        int y_size_;
+        vari** y_;
+
+        checkpoint_vari(const F& f,
+                        const Eigen::Matrix<var, Eigen::Dynamic, 1>& x,
+                        const Eigen::VectorXd& y)
+          : vari(y(0)),
+            f_(new checkpoint_alloc<F>(f)),
+            x_size_(x.size()),
+            x_(ChainableStack::memalloc_.alloc_array<vari*>(x.size())),
+            y_size_(y.size()),
+            y_(ChainableStack::memalloc_.alloc_array<vari*>(y.size())) {
+          for (int i = 0; i < x_size_; ++i)
+            x_[i] = x(i).vi_;
+          y_[0] = this;
+          for (int j = 1; j < y_size_; ++j)
+            y_[j] = new vari(y(j), false);
+        }
+
+        void chain() {
+          start_nested();
+          try {
+            Eigen::Matrix<var, Eigen::Dynamic, 1> x_local(x_size_);
+            for (int i = 0; i < x_size_; ++i)
+              x_local(i) = x_[i]->val_;
+            Eigen::Matrix<var, Eigen::Dynamic, 1> y_local = f_->f_(x_local);
+            if (y_local.size() != y_size_)
+              throw std::logic_error("checkpoint: the region returned a "
+                                     "different number of outputs when "
+                                     "it was recomputed");
+            for (int j = 0; j < y_size_; ++j)
+              y_local(j).vi_->adj_ += y_[j]->adj_;
+
+            size_t end = ChainableStack::var_stack_.size();
+            size_t begin = end - nested_size();
+            for (size_t n = end; n-- > begin; )
+              ChainableStack::var_stack_[n]->chain();
+
+            for (int i = 0; i < x_size_; ++i)
+              x_[i]->adj_ += x_local(i).adj();
+          } catch (const std::exception& /*e*/) {
+            recover_memory_nested();
+            throw;
+          }
+          recover_memory_nested();
+        }
+      };
+
+    }
+
+    /**
+     * Return the result of applying the specified function to the
+     * specified argument without keeping the function's expression
+     * graph on the stack.
+     *
+     * <p>The function is evaluated on the values of the argument, so
+     * the forward pass records only the inputs and outputs of the
+     * region. When gradients are computed the region is evaluated
+     * again on a nested stack, its adjoints are propagated to the
+     * inputs and its memory is recovered before the reverse pass
+     * continues. Splitting a long computation, such as the steps of
+     * a state-space recursion, into checkpointed regions therefore
+     * bounds the memory used by reverse mode by the size of the
+     * largest region, at the cost of evaluating every region twice.
+     *
+     * <p>The functor must implement
+     *
+     * <code>
+     * template <typename T>
+     * Eigen::Matrix<T, Eigen::Dynamic, 1>
+     * operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>&) const
+     * </code>
+     *
+     * for <code>T</code> equal to <code>double</code> and
+     * <code>var</code>, and must return the same number of outputs
+     * for both. The functor is copied and the copy is kept until the
+     * memory is recovered, so any data it refers to must also stay
+     * alive until then.
+     *
+     * @tparam F Type of function
+     * @param[in] f Function
+     * @param[in] x Argument to function
+     * @return Function applied to argument
+     * @throw std::invalid_argument if the function returns no
+     * outputs
+     */
+    template <typename F>
+    inline Eigen::Matrix<var, Eigen::Dynamic, 1>
+    checkpoint(const F& f, const Eigen::Matrix<var, Eigen::Dynamic, 1>& x) {
+      Eigen::VectorXd y = f(Eigen::VectorXd(value_of(x)));
+      check_nonzero_size("checkpoint", "Region outputs", y);
+
+      internal::checkpoint_vari<F>* vi
+        = new internal::checkpoint_vari<F>(f, x, y);
+      Eigen::Matrix<var, Eigen::Dynamic, 1> y_var(y.size());
+      for (int j = 0; j < y.size(); ++j)
+        y_var(j) = var(vi->y_[j]);
+      return y_var;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,91 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_GRADIENT_BATCH_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_GRADIENT_BATCH_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/functor/gradient.hpp>
+#include <stan/math/rev/mat/functor/record_compact_program.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Calculate the values and the gradients of the specified
+     * function at each of the specified arguments, which are the
+     * columns of a matrix.
+     *
+     * <p>The function is recorded once, at the first argument, with
+     * the compact tape enabled. The recorded program is then
+     * evaluated on blocks of the remaining arguments, with each
+     * instruction applied to all arguments in the block before the
+     * next one (see <code>compact_program::forward()</code>), and
+     * the gradients of a block are a single reverse sweep. The
+     * graph is built once instead of once per argument.
+     *
+     * <p>An argument at which a comparison of variables made by the
+     * function has a different outcome than at the first argument,
+     * or at which a value is NaN, is evaluated on its own by
+     * <code>gradient()</code>. So is every argument if the function
+     * uses an operation without a compact form (see
+     * <code>compact_op</code>). As for <code>taped_gradient</code>,
+     * the control flow of the function must not depend on
+     * <code>value_of()</code> or <code>val()</code> of its argument.
+     *
+     * @tparam F Type of function
+     * @param[in] f Function
+     * @param[in] x Arguments to function, one per column
+     * @param[out] fx Function applied to each argument
+     * @param[out] grad_fx Gradient of function at each argument, one
+     * per column
+     */
+    template <typename F>
+    void
+    gradient_batch(const F& f,
+                   const Eigen::Matrix<double, Eigen::Dynamic,
+                                       Eigen::Dynamic>& x,
+                   Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+                   Eigen::Matrix<double, Eigen::Dynamic,
+                                 Eigen::Dynamic>& grad_fx) {
+      // points evaluated together, keeping the lanes of the
+      // program in cache
+      static const int block_size = 32;
+      const int N = x.rows();
+      const int K = x.cols();
+      fx.resize(K);
+      grad_fx.resize(N, K);
+      if (K == 0)
+        return;
+
+      compact_program program;
+      Eigen::Matrix<double, Eigen::Dynamic, 1> x_k = x.col(0);
+      Eigen::Matrix<double, Eigen::Dynamic, 1> grad_k;
+      bool recorded = record_compact_program(f, x_k, fx(0), grad_k,
+                                             program);
+      grad_fx.col(0) = grad_k;
+
+      std::vector<char> ok(block_size);
+      for (int begin = 1; begin < K; begin += block_size) {
+        int size = std::min(block_size, K - begin);
+        if (recorded) {
+          program.forward(x.data() + begin * N, size, &ok[0]);
+          program.gradient(0, grad_fx.data() + begin * N);
+        } else {
+          std::fill(ok.begin(), ok.end(), 0);
+        }
+        for (int k = 0; k < size; ++k) {
+          if (ok[k]) {
+            fx(begin + k) = program.value(0, k);
+          } else {
+            x_k = x.col(begin + k);
+            gradient(f, x_k, fx(begin + k), grad_k);
+            grad_fx.col(begin + k) = grad_k;
+          }
+        }
+      }
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,66 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_RECORD_COMPACT_PROGRAM_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_RECORD_COMPACT_PROGRAM_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Evaluate the specified function and its gradient at the
+     * specified argument with the compact tape enabled, and record
+     * the evaluation as a <code>compact_program</code>.
+     *
+     * <p>The function is evaluated in a nested region, which is
+     * recovered before returning.
+     *
+     * @tparam F Type of function
+     * @param[in] f Function
+     * @param[in] x Argument to function
+     * @param[out] fx Function applied to argument
+     * @param[out] grad_fx Gradient of function at argument
+     * @param[out] program recorded program
+     * @return true if the program can be replayed
+     */
+    template <typename F>
+    bool
+    record_compact_program(const F& f,
+                           const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                           double& fx,
+                           Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx,
+                           compact_program& program) {
+      bool recorded;
+      start_nested();
+      bool enabled = start_compact_recording();
+      try {
+        Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x.size());
+        for (int i = 0; i < x.size(); ++i)
+          x_var(i) = x(i);
+        var fx_var = f(x_var);
+        stop_compact_recording(enabled);
+        fx = fx_var.val();
+        grad_fx.resize(x.size());
+        grad(fx_var.vi_);
+        for (int i = 0; i < x.size(); ++i)
+          grad_fx(i) = x_var(i).adj();
+
+        std::vector<vari*> inputs(x.size());
+        for (int i = 0; i < x.size(); ++i)
+          inputs[i] = x_var(i).vi_;
+        std::vector<vari*> outputs(1, fx_var.vi_);
+        recorded = program.record(inputs, outputs);
+      } catch (const std::exception& /*e*/) {
+        stop_compact_recording(enabled);
+        recover_memory_nested();
+        throw;
+      }
+      recover_memory_nested();
+      return recorded;
+    }
+
+  }
+}
+#endif
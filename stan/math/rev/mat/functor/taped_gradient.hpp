@@ -0,0 +1,109 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_TAPED_GRADIENT_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_TAPED_GRADIENT_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/functor/gradient.hpp>
+#include <stan/math/rev/mat/functor/record_compact_program.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Calculates the value and the gradient of a function like
+     * <code>gradient()</code>, recording the function once and
+     * replaying the recording on later arguments.
+     *
+     * <p>The first call evaluates the function with the compact tape
+     * enabled and keeps the tape as a <code>compact_program</code>.
+     * Later calls evaluate the program on the new argument, which
+     * runs only the value and partial computations and the adjoint
+     * sweep, with no allocation of varis and no virtual calls. If a
+     * comparison of variables made by the function has a different
+     * outcome for the new argument, or a value is NaN, the function
+     * is recorded again at that argument.
+     *
+     * <p>A function can only be replayed if all of its operations
+     * have a compact form (see <code>compact_op</code>) and its
+     * control flow depends on its argument only through comparisons
+     * of variables. Branching on <code>value_of()</code> or
+     * <code>val()</code> is not detected, so such functions must not
+     * be used; the built-in functions that branch on the value of
+     * their argument, such as <code>fabs()</code>, record their
+     * comparisons like the comparison operators do. If the first recording cannot be replayed, every call
+     * evaluates the function as <code>gradient()</code> does.
+     *
+     * @tparam F Type of function
+     */
+    template <typename F>
+    class taped_gradient {
+    private:
+      const F f_;
+      compact_program program_;
+      bool replayable_;
+      bool recorded_;
+      int recordings_;
+
+      void record(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                  double& fx,
+                  Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+        recorded_ = record_compact_program(f_, x, fx, grad_fx, program_);
+        if (recordings_ == 0)
+          replayable_ = recorded_;
+        ++recordings_;
+      }
+
+    public:
+      /**
+       * Construct from the specified function, which is copied.
+       *
+       * @param[in] f Function
+       */
+      explicit taped_gradient(const F& f)
+        : f_(f), replayable_(true), recorded_(false), recordings_(0) { }
+
+      /**
+       * Calculate the value and the gradient of the function at the
+       * specified argument.
+       *
+       * @param[in] x Argument to function
+       * @param[out] fx Function applied to argument
+       * @param[out] grad_fx Gradient of function at argument
+       */
+      void operator()(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                      double& fx,
+                      Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+        if (!replayable_) {
+          gradient(f_, x, fx, grad_fx);
+          return;
+        }
+        if (recorded_
+            && program_.num_inputs() == static_cast<size_t>(x.size())
+            && program_.forward(x.data())) {
+          fx = program_.value(0);
+          grad_fx.resize(x.size());
+          program_.gradient(0, grad_fx.data());
+          return;
+        }
+        record(x, fx, grad_fx);
+      }
+
+      /**
+       * Return the number of times the function has been recorded.
+       *
+       * @return number of recordings
+       */
+      int recordings() const { return recordings_; }
+
+      /**
+       * Return true unless the first recording of the function could
+       * not be replayed.
+       *
+       * @return whether calls replay a recording
+       */
+      bool replayable() const { return replayable_; }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,157 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_TAPED_JACOBIAN_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_TAPED_JACOBIAN_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/functor/jacobian.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Calculates the value and the Jacobian of a function like
+     * <code>jacobian()</code>, recording the function once and
+     * replaying the recording on later arguments.
+     *
+     * <p>Recording, replay and the conditions under which a function
+     * can be replayed are as for <code>taped_gradient</code>. Each
+     * block of eight rows of the Jacobian is one reverse sweep over
+     * the recording, with one adjoint lane per row.
+     *
+     * @tparam F Type of function
+     */
+    template <typename F>
+    class taped_jacobian {
+    private:
+      const F f_;
+      compact_program program_;
+      std::vector<double> row_;
+      bool replayable_;
+      bool recorded_;
+      int recordings_;
+
+      // fills J from the last evaluation of the program, with one
+      // reverse sweep per block of rows
+      void rows(int n, Eigen::Matrix<double, Eigen::Dynamic,
+                                     Eigen::Dynamic>& J) {
+        const int block = 8;
+        int m = program_.num_outputs();
+        J.resize(m, n);
+        row_.resize(n * block);
+        for (int i = 0; i < m; i += block) {
+          int K = std::min(block, m - i);
+          program_.output_gradients(i, K, row_.data());
+          for (int k = 0; k < K; ++k)
+            for (int j = 0; j < n; ++j)
+              J(i + k, j) = row_[j + k * n];
+        }
+      }
+
+      void record(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                  Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+                  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& J) {
+        using Eigen::Matrix;
+        using Eigen::Dynamic;
+        start_nested();
+        bool enabled = start_compact_recording();
+        try {
+          Matrix<var, Dynamic, 1> x_var(x.size());
+          for (int k = 0; k < x.size(); ++k)
+            x_var(k) = x(k);
+          Matrix<var, Dynamic, 1> fx_var = f_(x_var);
+          stop_compact_recording(enabled);
+          fx.resize(fx_var.size());
+          for (int i = 0; i < fx_var.size(); ++i)
+            fx(i) = fx_var(i).val();
+
+          std::vector<vari*> inputs(x.size());
+          for (int k = 0; k < x.size(); ++k)
+            inputs[k] = x_var(k).vi_;
+          std::vector<vari*> outputs(fx_var.size());
+          for (int i = 0; i < fx_var.size(); ++i)
+            outputs[i] = fx_var(i).vi_;
+          recorded_ = program_.record(inputs, outputs);
+
+          if (recorded_ && program_.forward(x.data())) {
+            rows(x.size(), J);
+          } else {
+            J.resize(fx_var.size(), x.size());
+            for (int i = 0; i < fx_var.size(); ++i) {
+              if (i > 0)
+                set_zero_all_adjoints_nested();
+              grad(fx_var(i).vi_);
+              for (int k = 0; k < x.size(); ++k)
+                J(i, k) = x_var(k).adj();
+            }
+          }
+          if (recordings_ == 0)
+            replayable_ = recorded_;
+          ++recordings_;
+        } catch (const std::exception& /*e*/) {
+          stop_compact_recording(enabled);
+          recover_memory_nested();
+          throw;
+        }
+        recover_memory_nested();
+      }
+
+    public:
+      /**
+       * Construct from the specified function, which is copied.
+       *
+       * @param[in] f Function
+       */
+      explicit taped_jacobian(const F& f)
+        : f_(f), replayable_(true), recorded_(false), recordings_(0) { }
+
+      /**
+       * Calculate the value and the Jacobian of the function at the
+       * specified argument.
+       *
+       * @param[in] x Argument to function
+       * @param[out] fx Function applied to argument
+       * @param[out] J Jacobian of function at argument
+       */
+      void operator()(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                      Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+                      Eigen::Matrix<double, Eigen::Dynamic,
+                                    Eigen::Dynamic>& J) {
+        if (!replayable_) {
+          jacobian(f_, x, fx, J);
+          return;
+        }
+        if (recorded_
+            && program_.num_inputs() == static_cast<size_t>(x.size())
+            && program_.forward(x.data())) {
+          int m = program_.num_outputs();
+          fx.resize(m);
+          for (int i = 0; i < m; ++i)
+            fx(i) = program_.value(i);
+          rows(x.size(), J);
+          return;
+        }
+        record(x, fx, J);
+      }
+
+      /**
+       * Return the number of times the function has been recorded.
+       *
+       * @return number of recordings
+       */
+      int recordings() const { return recordings_; }
+
+      /**
+       * Return true unless the first recording of the function could
+       * not be replayed.
+       *
+       * @return whether calls replay a recording
+       */
+      bool replayable() const { return replayable_; }
+    };
+
+  }
+}
+#endif
@@ -47,6 +47,9 @@ namespace stan {
      * @return Cosine of variable.
      */
     inline var cos(const var& a) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(COMPACT_COS, std::cos(a.vi_->val_),
+                                     a.vi_, 0, -std::sin(a.vi_->val_)));
       return var(new cos_vari(a.vi_));
     }
 
@@ -42,6 +42,9 @@ namespace stan {
      * @return Exponentiated variable.
      */
     inline var exp(const var& a) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(COMPACT_EXP, std::exp(a.vi_->val_),
+                                     a.vi_));
       return var(new exp_vari(a.vi_));
     }
 
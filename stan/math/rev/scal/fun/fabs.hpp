@@ -24,6 +24,9 @@ namespace stan {
      *
      * Returns std::numeric_limits<double>::quiet_NaN() for NaN inputs.
      *
+     * The sign tests are recorded as guards on the compact tape, so
+     * that a replay of a recording at an argument of the other sign
+     * is detected (see <code>compact_program</code>).
      *
        \f[		
        \mbox{fabs}(x) =
@@ -47,11 +50,11 @@ namespace stan {
      * @return Absolute value of variable.
      */
     inline var fabs(const var& a) {
-      if (a.val() > 0.0)
+      if (record_compact_guard(COMPACT_GT, a.val() > 0.0, a.vi_, 0, 0.0))
         return a;
-      else if (a.val() < 0.0)
-        return var(new neg_vari(a.vi_));
-      else if (a.val() == 0)
+      else if (record_compact_guard(COMPACT_LT, a.val() < 0.0, a.vi_, 0, 0.0))
+        return -a;
+      else if (record_compact_guard(COMPACT_EQ, a.val() == 0, a.vi_, 0, 0.0))
         return var(new vari(0));
       else
         return var(new precomp_v_vari(NOT_A_NUMBER, a.vi_, NOT_A_NUMBER));
@@ -86,6 +86,10 @@ namespace stan {
        \end{cases}
        \f]
      *
+     * The comparison is recorded as a guard on the compact tape, as
+     * the constant zero would otherwise be replayed unchanged at
+     * arguments with x > y.
+     *
      * @param a First variable.
      * @param b Second variable.
      * @return The positive difference between the first and second
@@ -93,7 +97,8 @@ namespace stan {
      */
     inline var fdim(const var& a, const var& b) {
       // reversed test to get NaN vals automatically in second case
-      return (a.vi_->val_ <= b.vi_->val_)
+      return record_compact_guard(COMPACT_LE, a.vi_->val_ <= b.vi_->val_,
+                                  a.vi_, b.vi_)
         ? var(new vari(0.0))
         : var(new fdim_vv_vari(a.vi_, b.vi_));
     }
@@ -112,7 +117,7 @@ namespace stan {
      */
     inline var fdim(double a, const var& b) {
       // reversed test to get NaN vals automatically in second case
-      return a <= b.vi_->val_
+      return record_compact_guard(COMPACT_GE, a <= b.vi_->val_, b.vi_, 0, a)
         ? var(new vari(0.0))
         : var(new fdim_dv_vari(a, b.vi_));
     }
@@ -130,7 +135,7 @@ namespace stan {
      */
     inline var fdim(const var& a, double b) {
       // reversed test to get NaN vals automatically in second case
-      return a.vi_->val_ <= b
+      return record_compact_guard(COMPACT_LE, a.vi_->val_ <= b, a.vi_, 0, b)
         ? var(new vari(0.0))
         : var(new fdim_vd_vari(a.vi_, b));
     }
@@ -32,6 +32,11 @@ namespace stan {
      * @return Inverse logit of argument.
      */
     inline var inv_logit(const var& a) {
+      if (compact_tape_enabled()) {
+        double val = inv_logit(a.vi_->val_);
+        return var(record_compact_op(COMPACT_INV_LOGIT, val, a.vi_, 0,
+                                     val * (1.0 - val)));
+      }
       return var(new inv_logit_vari(a.vi_));
     }
 
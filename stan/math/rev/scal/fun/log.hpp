@@ -48,6 +48,9 @@ namespace stan {
      * @return Natural log of variable.
      */
     inline var log(const var& a) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(COMPACT_LOG, std::log(a.vi_->val_),
+                                     a.vi_, 0, a.vi_->val_));
       return var(new log_vari(a.vi_));
     }
 
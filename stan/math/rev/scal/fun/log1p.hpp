@@ -30,6 +30,9 @@ namespace stan {
      * @return The log of 1 plus the variable.
      */
     inline var log1p(const var& a) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(COMPACT_LOG1P, log1p(a.vi_->val_),
+                                     a.vi_, 0, 1 + a.vi_->val_));
       return var(new log1p_vari(a.vi_));
     }
 
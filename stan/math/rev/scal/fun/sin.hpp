@@ -47,6 +47,9 @@ namespace stan {
      * @return Sine of variable.
      */
     inline var sin(const var& a) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(COMPACT_SIN, std::sin(a.vi_->val_),
+                                     a.vi_, 0, std::cos(a.vi_->val_)));
       return var(new sin_vari(a.vi_));
     }
 
@@ -48,6 +48,11 @@ namespace stan {
      * @return Square root of variable.
      */
     inline var sqrt(const var& a) {
+      if (compact_tape_enabled()) {
+        double val = std::sqrt(a.vi_->val_);
+        return var(record_compact_op(COMPACT_SQRT, val, a.vi_, 0,
+                                     2.0 * val));
+      }
       return var(new sqrt_vari(a.vi_));
     }
 
@@ -44,6 +44,10 @@ namespace stan {
      * @return Square of variable.
      */
     inline var square(const var& x) {
+      if (compact_tape_enabled())
+        return var(record_compact_op(COMPACT_SQUARE,
+                                     x.vi_->val_ * x.vi_->val_, x.vi_, 0,
+                                     2.0 * x.vi_->val_));
       return var(new square_vari(x.vi_));
     }
 
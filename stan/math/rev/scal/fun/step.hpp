@@ -18,12 +18,18 @@ namespace stan {
      *
      * \f$\mbox{step}(x) = 0\f$.
      *
+     * The sign test is recorded as a guard on the compact tape, as
+     * the constant result would otherwise be replayed unchanged at
+     * an argument of the other sign.
+     *
      * @param a Variable argument.
      * @return The constant variable with value 1.0 if the argument's
      * value is greater than or equal to 0.0, and value 0.0 otherwise.
      */
     inline var step(const var& a) {
-      return var(new vari(a.vi_->val_ < 0.0 ? 0.0 : 1.0));
+      bool negative = record_compact_guard(COMPACT_LT, a.vi_->val_ < 0.0,
+                                           a.vi_, 0, 0.0);
+      return var(new vari(negative ? 0.0 : 1.0));
     }
 
   }
@@ -48,6 +48,11 @@ namespace stan {
      * @return Hyperbolic tangent of variable.
      */
     inline var tanh(const var& a) {
+      if (compact_tape_enabled()) {
+        double cosh = std::cosh(a.vi_->val_);
+        return var(record_compact_op(COMPACT_TANH, std::tanh(a.vi_->val_),
+                                     a.vi_, 0, cosh * cosh));
+      }
       return var(new tanh_vari(a.vi_));
     }
 
@@ -55,3 +55,23 @@ TEST(AgradFwdMatrixLogDeterminant, ffd_exception) {
 
   EXPECT_THROW(log_determinant(matrix_ffd(2, 3)), std::invalid_argument);
 }
+
+TEST(AgradFwdMatrixLogDeterminant, fd_large) {
+  using stan::math::matrix_fd;
+  using stan::math::fvar;
+  using stan::math::log_determinant;
+
+  // the determinant, 1e400, overflows a double
+  int N = 100;
+  matrix_fd v(N, N);
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      v(i, j) = i == j ? 1e4 : 1.0 / (i + j + 1);
+      v(i, j).d_ = i == j ? 1e4 : 0.0;
+    }
+  }
+
+  fvar<double> det = log_determinant(v);
+  EXPECT_NEAR(400 * std::log(10.0), det.val_, 1e-3);
+  EXPECT_NEAR(N, det.d_, 1e-3);
+}
@@ -1134,3 +1134,64 @@ TEST(AgradFwdMatrixOperatorMultiplication, ffd_matrix_matrix_exception) {
   EXPECT_THROW(multiply(v1, d2), std::invalid_argument);
   EXPECT_THROW(multiply(d1, v2), std::invalid_argument);
 }
+TEST(AgradFwdMatrixOperatorMultiplication, fd_matrix_matrix_large) {
+  using stan::math::dot_product;
+  using stan::math::matrix_d;
+  using stan::math::matrix_fd;
+
+  matrix_fd v1(7, 5);
+  matrix_fd v2(5, 6);
+  for (int i = 0; i < v1.size(); ++i)
+    v1(i) = fvar<double>(std::sin(i + 1.0), std::cos(i + 1.0));
+  for (int i = 0; i < v2.size(); ++i)
+    v2(i) = fvar<double>(std::cos(2.0 * i), std::sin(3.0 * i));
+  matrix_d d1 = stan::math::value_of(v1);
+  matrix_d d2 = stan::math::value_of(v2);
+
+  matrix_fd output = multiply(v1, v2);
+  matrix_fd output_fd = multiply(v1, d2);
+  matrix_fd output_df = multiply(d1, v2);
+  ASSERT_EQ(7, output.rows());
+  ASSERT_EQ(6, output.cols());
+  for (int i = 0; i < 7; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      fvar<double> expected = 0;
+      fvar<double> expected_fd = 0;
+      fvar<double> expected_df = 0;
+      for (int k = 0; k < 5; ++k) {
+        expected += v1(i, k) * v2(k, j);
+        expected_fd += v1(i, k) * d2(k, j);
+        expected_df += d1(i, k) * v2(k, j);
+      }
+      EXPECT_FLOAT_EQ(expected.val_, output(i, j).val_);
+      EXPECT_FLOAT_EQ(expected.d_, output(i, j).d_);
+      EXPECT_FLOAT_EQ(expected_fd.val_, output_fd(i, j).val_);
+      EXPECT_FLOAT_EQ(expected_fd.d_, output_fd(i, j).d_);
+      EXPECT_FLOAT_EQ(expected_df.val_, output_df(i, j).val_);
+      EXPECT_FLOAT_EQ(expected_df.d_, output_df(i, j).d_);
+    }
+  }
+}
+
+/*
+#include <chrono>
+TEST(AgradFwdMatrixOperatorMultiplication, speed) {
+  using stan::math::matrix_fd;
+  int N = 256;
+  matrix_fd A(N, N);
+  matrix_fd B(N, N);
+  for (int i = 0; i < A.size(); ++i) {
+    A(i) = fvar<double>(std::sin(i), std::cos(i));
+    B(i) = fvar<double>(std::cos(i), std::sin(i));
+  }
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  matrix_fd AB = multiply(A, B);
+  std::chrono::steady_clock::time_point end
+    = std::chrono::steady_clock::now();
+  std::cout << "multiply: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                 end - start).count()
+            << " ms, " << AB(0, 0).d_ << std::endl;
+}
+*/
@@ -0,0 +1,86 @@
+#include <stan/math/fwd/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/prob/hmm_marginal_args.hpp>
+
+using stan::math::fvar;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+namespace {
+
+  template <typename T>
+  struct hmm_arg {
+    static T make(double x, double d) { return T(x, d); }
+    static double direction(double d) { return d; }
+  };
+
+  template <>
+  struct hmm_arg<double> {
+    static double make(double x, double d) { return x; }
+    static double direction(double d) { return 0; }
+  };
+
+  // the derivative along a direction that keeps the rows of Gamma and rho
+  // on the simplex, against a central finite difference, for the arguments
+  // that are fvars
+  template <typename T_omega, typename T_Gamma, typename T_rho>
+  void expect_directional_derivative(int K, int T) {
+    Matrix<double, Dynamic, Dynamic> log_omegas, Gamma;
+    Matrix<double, Dynamic, 1> rho;
+    hmm_args(K, T, log_omegas, Gamma, rho);
+    Matrix<double, Dynamic, Dynamic> d_log_omegas(K, T);
+    for (int i = 0; i < d_log_omegas.size(); ++i)
+      d_log_omegas(i) = std::sin(i + 1.0);
+    Matrix<double, Dynamic, Dynamic> d_Gamma
+      = Matrix<double, Dynamic, Dynamic>::Zero(K, K);
+    for (int i = 0; i < K; ++i) {
+      d_Gamma(i, i) = 0.5;
+      d_Gamma(i, (i + 1) % K) -= 0.5;
+    }
+    Matrix<double, Dynamic, 1> d_rho = Matrix<double, Dynamic, 1>::Zero(K);
+    d_rho(0) = 0.25;
+    d_rho(K - 1) -= 0.25;
+
+    Matrix<T_omega, Dynamic, Dynamic> log_omegas_f(K, T);
+    for (int i = 0; i < log_omegas.size(); ++i) {
+      log_omegas_f(i) = hmm_arg<T_omega>::make(log_omegas(i),
+                                               d_log_omegas(i));
+      d_log_omegas(i) = hmm_arg<T_omega>::direction(d_log_omegas(i));
+    }
+    Matrix<T_Gamma, Dynamic, Dynamic> Gamma_f(K, K);
+    for (int i = 0; i < Gamma.size(); ++i) {
+      Gamma_f(i) = hmm_arg<T_Gamma>::make(Gamma(i), d_Gamma(i));
+      d_Gamma(i) = hmm_arg<T_Gamma>::direction(d_Gamma(i));
+    }
+    Matrix<T_rho, Dynamic, 1> rho_f(K);
+    for (int i = 0; i < rho.size(); ++i) {
+      rho_f(i) = hmm_arg<T_rho>::make(rho(i), d_rho(i));
+      d_rho(i) = hmm_arg<T_rho>::direction(d_rho(i));
+    }
+
+    fvar<double> lp = stan::math::hmm_marginal(log_omegas_f, Gamma_f, rho_f);
+    const double h = 1e-6;
+    Matrix<double, Dynamic, Dynamic> log_omegas_h
+      = log_omegas + h * d_log_omegas;
+    Matrix<double, Dynamic, Dynamic> Gamma_h = Gamma + h * d_Gamma;
+    Matrix<double, Dynamic, 1> rho_h = rho + h * d_rho;
+    double lp_plus = stan::math::hmm_marginal(log_omegas_h, Gamma_h, rho_h);
+    log_omegas_h = log_omegas - h * d_log_omegas;
+    Gamma_h = Gamma - h * d_Gamma;
+    rho_h = rho - h * d_rho;
+    double lp_minus = stan::math::hmm_marginal(log_omegas_h, Gamma_h, rho_h);
+
+    EXPECT_FLOAT_EQ(stan::math::hmm_marginal(log_omegas, Gamma, rho),
+                    lp.val_);
+    EXPECT_NEAR((lp_plus - lp_minus) / (2 * h), lp.d_, 1e-6);
+  }
+
+}
+
+TEST(ProbDistributionsHmmMarginal, fvar_double) {
+  expect_directional_derivative<fvar<double>, fvar<double>,
+                                fvar<double> >(3, 6);
+  expect_directional_derivative<fvar<double>, double, double>(4, 5);
+  expect_directional_derivative<double, fvar<double>, double>(2, 7);
+  expect_directional_derivative<double, double, fvar<double> >(3, 3);
+}
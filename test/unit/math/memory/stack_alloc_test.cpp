@@ -118,3 +118,100 @@ TEST(stack_alloc, in_stack_second_block) {
   EXPECT_FALSE(allocator.in_stack(x));
   EXPECT_FALSE(allocator.in_stack(y));
 }
+
+TEST(stack_alloc, recover_all_coalesces) {
+  stan::math::stack_alloc allocator;
+  size_t n = 10 * stan::math::DEFAULT_INITIAL_NBYTES;
+  for (int i = 0; i < 10; ++i)
+    allocator.alloc_array<char>(n / 10);
+  EXPECT_LT(1U, allocator.num_blocks());
+  size_t retained = allocator.bytes_retained();
+
+  allocator.recover_all();
+  EXPECT_EQ(1U, allocator.num_blocks());
+  EXPECT_EQ(retained, allocator.bytes_retained());
+
+  // a sweep of the same size fits in the one block
+  for (int i = 0; i < 10; ++i) {
+    char* x = allocator.alloc_array<char>(n / 10);
+    x[0] = 1;
+    x[n / 10 - 1] = 1;
+  }
+  EXPECT_EQ(1U, allocator.num_blocks());
+  EXPECT_EQ(retained, allocator.bytes_allocated());
+
+  allocator.free_all();
+  EXPECT_EQ(1U, allocator.num_blocks());
+  EXPECT_EQ(stan::math::DEFAULT_INITIAL_NBYTES, allocator.bytes_retained());
+}
+
+TEST(stack_alloc, max_retained_bytes) {
+  stan::math::stack_alloc allocator;
+  size_t cap = 4 * stan::math::DEFAULT_INITIAL_NBYTES;
+  allocator.set_max_retained_bytes(cap);
+  allocator.alloc_array<char>(20 * stan::math::DEFAULT_INITIAL_NBYTES);
+  EXPECT_LT(cap, allocator.bytes_retained());
+
+  allocator.recover_all();
+  EXPECT_EQ(cap, allocator.bytes_retained());
+
+  // the initial block is always kept
+  allocator.set_max_retained_bytes(0);
+  allocator.recover_all();
+  EXPECT_EQ(stan::math::DEFAULT_INITIAL_NBYTES, allocator.bytes_retained());
+
+  // and is not reallocated by further recoveries
+  // (a freed block may be handed back at the same address, but its
+  // contents are clobbered by the system)
+  char* block = allocator.alloc_array<char>(1);
+  block[0] = 'x';
+  for (int i = 0; i < 2; ++i) {
+    allocator.recover_all();
+    EXPECT_EQ(block, allocator.alloc_array<char>(1));
+    EXPECT_EQ('x', block[0]);
+  }
+}
+
+TEST(stack_alloc, max_retained_bytes_huge_pages) {
+  stan::math::stack_alloc allocator;
+  allocator.set_huge_pages(true);
+  // a cap that is not a whole number of huge pages
+  allocator.set_max_retained_bytes(3 * stan::math::HUGE_PAGE_NBYTES / 2);
+  allocator.alloc_array<char>(4 * stan::math::HUGE_PAGE_NBYTES);
+  allocator.recover_all();
+  EXPECT_EQ(1U, allocator.num_blocks());
+
+  // (a freed block may be handed back at the same address, but its
+  // contents are clobbered by the system)
+  char* block = allocator.alloc_array<char>(1);
+  block[0] = 'x';
+  for (int i = 0; i < 2; ++i) {
+    allocator.recover_all();
+    EXPECT_EQ(block, allocator.alloc_array<char>(1));
+    EXPECT_EQ('x', block[0]);
+  }
+}
+
+TEST(stack_alloc, huge_pages_prefault) {
+  stan::math::stack_alloc allocator;
+  allocator.set_huge_pages(true);
+  allocator.set_prefault(true);
+  for (int k = 0; k < 3; ++k) {
+    std::vector<double*> xs;
+    for (int i = 0; i < 1000; ++i) {
+      xs.push_back(allocator.alloc_array<double>(1000));
+      for (int j = 0; j < 1000; ++j)
+        xs.back()[j] = i + j;
+    }
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_TRUE(allocator.in_stack(xs[i]));
+      EXPECT_FLOAT_EQ(i + 999, xs[i][999]);
+      EXPECT_TRUE(stan::math::is_aligned(xs[i], 8U));
+    }
+    allocator.recover_all();
+  }
+  EXPECT_EQ(1U, allocator.num_blocks());
+  EXPECT_LE(8000000U, allocator.bytes_retained());
+  allocator.free_all();
+  EXPECT_EQ(stan::math::DEFAULT_INITIAL_NBYTES, allocator.bytes_retained());
+}
@@ -0,0 +1,309 @@
+#include <stan/math/mix/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <test/unit/util.hpp>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using stan::math::var;
+
+namespace {
+
+  struct damped_decay_fun {
+    template <typename T0, typename T1, typename T2>
+    inline
+    std::vector<typename stan::return_type<T1, T2>::type>
+    operator()(const T0& t_in,
+               const std::vector<T1>& y_in,
+               const std::vector<T2>& theta,
+               const std::vector<double>& x,
+               const std::vector<int>& x_int,
+               std::ostream* msgs) const {
+      if (theta[0] < 0.0)
+        throw std::domain_error("negative rate");
+      if (msgs && t_in == 0)
+        *msgs << "subject " << x_int[0] << ";";
+      std::vector<typename stan::return_type<T1, T2>::type> res;
+      res.push_back(-theta[0] * y_in[0]);
+      return res;
+    }
+  };
+
+  struct decay_fun {
+    template <typename T0, typename T1, typename T2>
+    inline
+    std::vector<typename stan::return_type<T1, T2>::type>
+    operator()(const T0& t_in,
+               const std::vector<T1>& y_in,
+               const std::vector<T2>& theta,
+               const std::vector<double>& x,
+               const std::vector<int>& x_int,
+               std::ostream* msgs) const {
+      std::vector<typename stan::return_type<T1, T2>::type> res;
+      for (size_t n = 0; n < y_in.size(); ++n)
+        res.push_back(-theta[0] * y_in[n]);
+      return res;
+    }
+  };
+
+  struct batch_inputs {
+    std::vector<std::vector<double> > y0;
+    std::vector<std::vector<double> > ts;
+    std::vector<std::vector<double> > theta;
+    std::vector<std::vector<double> > x;
+    std::vector<std::vector<int> > x_int;
+
+    explicit batch_inputs(size_t K)
+      : y0(K), ts(K), theta(K), x(K), x_int(K) {
+      for (size_t i = 0; i < K; ++i) {
+        y0[i].push_back(1.0 + 0.1 * i);
+        y0[i].push_back(-0.5 + 0.05 * i);
+        for (size_t t = 0; t < 2 + i % 3; ++t)
+          ts[i].push_back(0.5 * (t + 1) + 0.01 * i);
+        theta[i].push_back(0.1 + 0.02 * i);
+      }
+    }
+  };
+
+  template <typename T1, typename T2>
+  void expect_matches_unbatched(int num_threads) {
+    const size_t K = 7;
+    batch_inputs in(K);
+    std::vector<std::vector<T1> > y0(K);
+    std::vector<std::vector<T2> > theta(K);
+    for (size_t i = 0; i < K; ++i) {
+      y0[i] = std::vector<T1>(in.y0[i].begin(), in.y0[i].end());
+      theta[i] = std::vector<T2>(in.theta[i].begin(), in.theta[i].end());
+    }
+
+    harm_osc_ode_fun f;
+    typedef typename stan::return_type<T1, T2>::type T;
+    std::vector<std::vector<std::vector<T> > > ys
+      = stan::math::integrate_ode_rk45_batch(f, y0, 0.0, in.ts, theta,
+                                             in.x, in.x_int, 0, 1e-8,
+                                             1e-8, 1E6, num_threads);
+    ASSERT_EQ(K, ys.size());
+
+    for (size_t i = 0; i < K; ++i) {
+      std::vector<std::vector<T> > ys_ref
+        = stan::math::integrate_ode_rk45(f, y0[i], 0.0, in.ts[i],
+                                         theta[i], in.x[i], in.x_int[i],
+                                         0, 1e-8, 1e-8);
+      ASSERT_EQ(ys_ref.size(), ys[i].size());
+      for (size_t t = 0; t < ys_ref.size(); ++t) {
+        for (size_t n = 0; n < 2; ++n) {
+          EXPECT_NEAR(stan::math::value_of(ys_ref[t][n]),
+                      stan::math::value_of(ys[i][t][n]), 1e-6);
+          if (!stan::is_var<T>::value)
+            continue;
+          std::vector<var> vars;
+          for (size_t k = 0; k < y0[i].size(); ++k)
+            vars.push_back(y0[i][k]);
+          for (size_t k = 0; k < theta[i].size(); ++k)
+            vars.push_back(theta[i][k]);
+          std::vector<double> g_ref;
+          std::vector<double> g;
+          stan::math::grad(stan::math::to_var(ys_ref[t][n]).vi_);
+          for (size_t k = 0; k < vars.size(); ++k)
+            g_ref.push_back(stan::math::to_var(vars[k]).adj());
+          stan::math::set_zero_all_adjoints();
+          stan::math::grad(stan::math::to_var(ys[i][t][n]).vi_);
+          for (size_t k = 0; k < vars.size(); ++k)
+            g.push_back(stan::math::to_var(vars[k]).adj());
+          stan::math::set_zero_all_adjoints();
+          for (size_t k = 0; k < vars.size(); ++k)
+            EXPECT_NEAR(g_ref[k], g[k], 1e-6);
+        }
+      }
+    }
+    stan::math::recover_memory();
+  }
+
+}
+
+TEST(StanMathOdeIntegrateOdeRk45Batch, dd) {
+  expect_matches_unbatched<double, double>(1);
+  expect_matches_unbatched<double, double>(3);
+}
+
+TEST(StanMathOdeIntegrateOdeRk45Batch, dv) {
+  expect_matches_unbatched<double, var>(1);
+  expect_matches_unbatched<double, var>(3);
+}
+
+TEST(StanMathOdeIntegrateOdeRk45Batch, vd) {
+  expect_matches_unbatched<var, double>(1);
+  expect_matches_unbatched<var, double>(3);
+}
+
+TEST(StanMathOdeIntegrateOdeRk45Batch, vv) {
+  expect_matches_unbatched<var, var>(1);
+  expect_matches_unbatched<var, var>(3);
+}
+
+TEST(StanMathOdeIntegrateOdeRk45Batch, one_node_per_subject) {
+  const size_t K = 5;
+  batch_inputs in(K);
+  std::vector<std::vector<var> > theta(K);
+  for (size_t i = 0; i < K; ++i)
+    theta[i] = std::vector<var>(in.theta[i].begin(), in.theta[i].end());
+  size_t stack_size = stan::math::ChainableStack::var_stack_.size();
+  harm_osc_ode_fun f;
+  stan::math::integrate_ode_rk45_batch(f, in.y0, 0.0, in.ts, theta, in.x,
+                                       in.x_int, 0, 1e-6, 1e-6, 1E6, 2);
+  EXPECT_EQ(stack_size + K, stan::math::ChainableStack::var_stack_.size());
+  stan::math::recover_memory();
+}
+
+//  The subjects of a worker share one stepper, whatever their sizes.
+TEST(StanMathOdeIntegrateOdeRk45Batch, subjects_of_different_sizes) {
+  const size_t K = 6;
+  std::vector<std::vector<double> > y0(K);
+  std::vector<std::vector<double> > ts(K, std::vector<double>(1, 1.0));
+  std::vector<std::vector<var> > theta(K, std::vector<var>(1, 0.5));
+  std::vector<std::vector<double> > x(K);
+  std::vector<std::vector<int> > x_int(K);
+  for (size_t i = 0; i < K; ++i)
+    y0[i] = std::vector<double>(1 + (5 * i) % K, 2.0);
+
+  decay_fun f;
+  std::vector<std::vector<std::vector<var> > > ys
+    = stan::math::integrate_ode_rk45_batch(f, y0, 0.0, ts, theta, x, x_int,
+                                           0, 1e-8, 1e-8, 1E6, 1);
+  for (size_t i = 0; i < K; ++i) {
+    ASSERT_EQ(y0[i].size(), ys[i][0].size());
+    for (size_t n = 0; n < y0[i].size(); ++n) {
+      EXPECT_NEAR(2.0 * std::exp(-0.5), ys[i][0][n].val(), 1e-6);
+      stan::math::set_zero_all_adjoints();
+      ys[i][0][n].grad();
+      EXPECT_NEAR(-2.0 * std::exp(-0.5), theta[i][0].adj(), 1e-6);
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeIntegrateOdeRk45Batch, messages_and_errors) {
+  const size_t K = 6;
+  std::vector<std::vector<double> > y0(K, std::vector<double>(1, 1.0));
+  std::vector<std::vector<double> > ts(K, std::vector<double>(1, 1.0));
+  std::vector<std::vector<var> > theta(K, std::vector<var>(1, 0.5));
+  std::vector<std::vector<double> > x(K);
+  std::vector<std::vector<int> > x_int(K);
+  for (size_t i = 0; i < K; ++i)
+    x_int[i].push_back(i);
+  damped_decay_fun f;
+
+  std::stringstream msgs;
+  std::vector<std::vector<std::vector<var> > > ys
+    = stan::math::integrate_ode_rk45_batch(f, y0, 0.0, ts, theta, x, x_int,
+                                           &msgs, 1e-6, 1e-6, 1E6, 4);
+  EXPECT_FLOAT_EQ(std::exp(-0.5), ys[5][0][0].val());
+  std::string out = msgs.str();
+  for (size_t i = 0; i < K; ++i) {
+    std::stringstream s;
+    s << "subject " << i << ";";
+    EXPECT_NE(std::string::npos, out.find(s.str()));
+  }
+  EXPECT_LT(out.find("subject 1;"), out.find("subject 4;"));
+
+  theta[3][0] = -1.0;
+  EXPECT_THROW_MSG(stan::math::integrate_ode_rk45_batch(f, y0, 0.0, ts,
+                                                        theta, x, x_int, 0,
+                                                        1e-6, 1e-6, 1E6,
+                                                        4),
+                   std::domain_error, "negative rate");
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeIntegrateOdeRk45Batch, error_conditions) {
+  using stan::math::integrate_ode_rk45_batch;
+  const size_t K = 3;
+  batch_inputs in(K);
+  harm_osc_ode_fun f;
+
+  std::vector<std::vector<double> > ts_short(in.ts.begin(),
+                                             in.ts.begin() + 2);
+  EXPECT_THROW(integrate_ode_rk45_batch(f, in.y0, 0.0, ts_short, in.theta,
+                                        in.x, in.x_int),
+               std::invalid_argument);
+
+  std::vector<std::vector<double> > ts_bad(in.ts);
+  ts_bad[2][0] = -1.0;
+  EXPECT_THROW(integrate_ode_rk45_batch(f, in.y0, 0.0, ts_bad, in.theta,
+                                        in.x, in.x_int),
+               std::domain_error);
+
+  std::vector<std::vector<double> > y0_empty(in.y0);
+  y0_empty[1].clear();
+  EXPECT_THROW(integrate_ode_rk45_batch(f, y0_empty, 0.0, in.ts, in.theta,
+                                        in.x, in.x_int),
+               std::invalid_argument);
+
+  EXPECT_THROW(integrate_ode_rk45_batch(f, in.y0, 0.0, in.ts, in.theta,
+                                        in.x, in.x_int, 0, 1e-6, 1e-6, 1E6,
+                                        0),
+               std::domain_error);
+}
+
+//  Here, we compare the speed of the batched solver to that of one
+//  call to integrate_ode_rk45 per subject, for 1000 subjects.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(StanMathOdeIntegrateOdeRk45Batch, batch_speed) {
+  const size_t K = 1000;
+  harm_osc_ode_fun f;
+  std::vector<std::vector<double> > y0(K, std::vector<double>(2, -0.5));
+  std::vector<std::vector<double> > ts(K);
+  std::vector<std::vector<double> > x(K);
+  std::vector<std::vector<int> > x_int(K);
+  for (size_t i = 0; i < K; ++i) {
+    y0[i][0] = 1.0 + 0.001 * i;
+    for (int t = 1; t <= 10; ++t)
+      ts[i].push_back(t);
+  }
+
+  for (int num_threads = 0; num_threads <= 4;
+       num_threads = num_threads == 0 ? 1 : 2 * num_threads) {
+    std::vector<std::vector<var> > theta(K);
+    for (size_t i = 0; i < K; ++i)
+      theta[i].push_back(0.15 + 0.0001 * i);
+
+    TimeVar t1 = timeNow();
+    var lp = 0;
+    if (num_threads == 0) {
+      for (size_t i = 0; i < K; ++i) {
+        std::vector<std::vector<var> > y
+          = stan::math::integrate_ode_rk45(f, y0[i], 0.0, ts[i], theta[i],
+                                           x[i], x_int[i]);
+        for (size_t t = 0; t < y.size(); ++t)
+          lp += y[t][0];
+      }
+    } else {
+      std::vector<std::vector<std::vector<var> > > ys
+        = stan::math::integrate_ode_rk45_batch(f, y0, 0.0, ts, theta, x,
+                                               x_int, 0, 1e-6, 1e-6, 1E6,
+                                               num_threads);
+      for (size_t i = 0; i < K; ++i)
+        for (size_t t = 0; t < ys[i].size(); ++t)
+          lp += ys[i][t][0];
+    }
+    lp.grad();
+    TimeVar t2 = timeNow();
+    stan::math::recover_memory();
+
+    std::cout << (num_threads == 0 ? "unbatched" : "batched")
+              << " threads: " << num_threads
+              << " time: " << duration(t2 - t1) << " us" << std::endl;
+  }
+}
+
+*/
@@ -0,0 +1,119 @@
+#include <stan/math/mix/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/functor/compact_tape_functors.hpp>
+#include <stdexcept>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using Eigen::VectorXd;
+
+namespace {
+
+  // a sum of local terms starting from a constant
+  struct chain_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      T s = 1.5;
+      for (int i = 0; i + 1 < x.size(); ++i)
+        s += stan::math::square(x(i + 1) - x(i)) / (s + 2.0) + x(i) * x(i);
+      return s;
+    }
+  };
+
+  template <typename F>
+  void expect_matches_hessian(const F& f, const VectorXd& x) {
+    double fx;
+    VectorXd grad;
+    Matrix<double, Dynamic, Dynamic> H;
+    stan::math::edge_pushing_hessian(f, x, fx, grad, H);
+
+    double fx_ref;
+    VectorXd grad_ref;
+    Matrix<double, Dynamic, Dynamic> H_ref;
+    stan::math::hessian(f, x, fx_ref, grad_ref, H_ref);
+
+    EXPECT_FLOAT_EQ(fx_ref, fx);
+    ASSERT_EQ(x.size(), grad.size());
+    ASSERT_EQ(x.size(), H.rows());
+    ASSERT_EQ(x.size(), H.cols());
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_FLOAT_EQ(grad_ref(i), grad(i));
+      for (int j = 0; j < x.size(); ++j)
+        EXPECT_NEAR(H_ref(i, j), H(i, j), 1e-10);
+    }
+    EXPECT_EQ(0U, stan::math::ChainableStack::var_stack_.size());
+  }
+
+}
+
+TEST(AgradAutoDiff, edgePushingHessian) {
+  compact_fun f;
+  VectorXd x(3);
+  x << 0.7, 1.9, -0.4;
+  expect_matches_hessian(f, x);
+  x << -1.3, 0.6, 2.1;
+  expect_matches_hessian(f, x);
+}
+
+TEST(AgradAutoDiff, edgePushingHessianChain) {
+  chain_fun f;
+  VectorXd x(8);
+  for (int i = 0; i < x.size(); ++i)
+    x(i) = 0.4 * i - 1.0;
+  expect_matches_hessian(f, x);
+}
+
+TEST(AgradAutoDiff, edgePushingHessianFallsBack) {
+  lgamma_fun f;
+  VectorXd x(3);
+  x << 1.5, 2.0, -0.5;
+  expect_matches_hessian(f, x);
+}
+
+//  Here, we compare the speed of edge pushing to that of the N
+//  forward-over-reverse passes of hessian().
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+struct quadratic_fun {
+  template <typename T>
+  inline
+  T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    T s = 0;
+    for (int i = 0; i < x.size(); ++i)
+      for (int j = i; j < x.size(); j += 7)
+        s += stan::math::exp(0.01 * x(i) * x(j));
+    return s;
+  }
+};
+
+TEST(AgradAutoDiff, edge_pushing_hessian_speed) {
+  quadratic_fun f;
+  for (int N = 50; N <= 500; N *= 10) {
+    VectorXd x(N);
+    for (int i = 0; i < N; ++i)
+      x(i) = 0.001 * i;
+    double fx;
+    VectorXd grad;
+    Matrix<double, Dynamic, Dynamic> H;
+
+    TimeVar t1 = timeNow();
+    stan::math::hessian(f, x, fx, grad, H);
+    TimeVar t2 = timeNow();
+    stan::math::edge_pushing_hessian(f, x, fx, grad, H);
+    TimeVar t3 = timeNow();
+
+    std::cout << "N: " << N
+              << " hessian: " << duration(t2 - t1) << " us"
+              << " edge_pushing_hessian: " << duration(t3 - t2) << " us"
+              << std::endl;
+  }
+}
+
+*/
@@ -0,0 +1,191 @@
+#include <stan/math/mix/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/functor/compact_tape_functors.hpp>
+#include <stdexcept>
+#include <vector>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using Eigen::VectorXd;
+
+namespace {
+
+  // tridiagonal Hessian
+  struct chain_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      T s = 0;
+      for (int i = 0; i + 1 < x.size(); ++i)
+        s += stan::math::square(x(i + 1) - x(i)) * x(i) + 0.1 * x(i);
+      return s;
+    }
+  };
+
+  // block diagonal Hessian with blocks of size 3
+  struct block_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      T s = 0;
+      for (int i = 0; i + 2 < x.size(); i += 3) {
+        s += x(i + 2) * stan::math::exp(x(i) / (2.0 + x(i + 1) * x(i + 1)))
+          - stan::math::log(1.5 + stan::math::sin(x(i + 2)));
+      }
+      return s;
+    }
+  };
+
+  // the first input interacts with all others
+  struct arrow_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      T s = 0;
+      for (int i = 1; i < x.size(); ++i)
+        s += x(0) * x(i) + stan::math::square(x(i)) * i;
+      return s;
+    }
+  };
+
+  struct linear_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      return 2.0 * x(0) - x(1) + 3.0;
+    }
+  };
+
+  template <typename F>
+  void expect_matches_hessian(const F& f, const VectorXd& x) {
+    double fx;
+    VectorXd grad;
+    Eigen::SparseMatrix<double> H;
+    stan::math::sparse_hessian(f, x, fx, grad, H);
+
+    double fx_ref;
+    VectorXd grad_ref;
+    Matrix<double, Dynamic, Dynamic> H_ref;
+    stan::math::hessian(f, x, fx_ref, grad_ref, H_ref);
+
+    EXPECT_FLOAT_EQ(fx_ref, fx);
+    ASSERT_EQ(x.size(), grad.size());
+    ASSERT_EQ(x.size(), H.rows());
+    ASSERT_EQ(x.size(), H.cols());
+    Matrix<double, Dynamic, Dynamic> H_dense(H);
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_FLOAT_EQ(grad_ref(i), grad(i));
+      for (int j = 0; j < x.size(); ++j)
+        EXPECT_NEAR(H_ref(i, j), H_dense(i, j), 1e-10);
+    }
+    EXPECT_EQ(0U, stan::math::ChainableStack::var_stack_.size());
+  }
+
+  template <typename F>
+  int num_colors(const F& f, const VectorXd& x) {
+    stan::math::start_nested();
+    bool enabled = stan::math::start_compact_recording();
+    std::vector<stan::math::vari*> inputs;
+    Matrix<stan::math::var, Dynamic, 1> x_var(x.size());
+    for (int i = 0; i < x.size(); ++i) {
+      x_var(i) = x(i);
+      inputs.push_back(x_var(i).vi_);
+    }
+    stan::math::var fx = f(x_var);
+    stan::math::stop_compact_recording(enabled);
+    stan::math::compact_program program;
+    EXPECT_TRUE(program.record(inputs,
+                               std::vector<stan::math::vari*>(1, fx.vi_)));
+    stan::math::recover_memory_nested();
+
+    std::vector<std::vector<size_t> > pattern;
+    stan::math::internal::hessian_sparsity(program, pattern);
+    std::vector<int> color;
+    return stan::math::internal::star_coloring(pattern, color);
+  }
+
+}
+
+TEST(AgradAutoDiff, sparseHessianBanded) {
+  chain_fun f;
+  VectorXd x(12);
+  for (int i = 0; i < x.size(); ++i)
+    x(i) = 0.3 * i - 1.0;
+  expect_matches_hessian(f, x);
+  EXPECT_EQ(3, num_colors(f, x));
+}
+
+TEST(AgradAutoDiff, sparseHessianBlockDiagonal) {
+  block_fun f;
+  VectorXd x(15);
+  for (int i = 0; i < x.size(); ++i)
+    x(i) = 0.2 * i - 0.5;
+  expect_matches_hessian(f, x);
+  EXPECT_EQ(3, num_colors(f, x));
+}
+
+TEST(AgradAutoDiff, sparseHessianArrow) {
+  arrow_fun f;
+  VectorXd x(10);
+  for (int i = 0; i < x.size(); ++i)
+    x(i) = 1.0 - 0.1 * i;
+  expect_matches_hessian(f, x);
+  EXPECT_EQ(2, num_colors(f, x));
+}
+
+TEST(AgradAutoDiff, sparseHessianLinear) {
+  linear_fun f;
+  VectorXd x(2);
+  x << 1.5, -2.0;
+  double fx;
+  VectorXd grad;
+  Eigen::SparseMatrix<double> H;
+  stan::math::sparse_hessian(f, x, fx, grad, H);
+  EXPECT_FLOAT_EQ(3.0 + 3.0 + 2.0, fx);
+  EXPECT_FLOAT_EQ(2.0, grad(0));
+  EXPECT_FLOAT_EQ(-1.0, grad(1));
+  EXPECT_EQ(0, H.nonZeros());
+}
+
+TEST(AgradAutoDiff, sparseHessianDenseFallback) {
+  lgamma_fun f;
+  VectorXd x(3);
+  x << 1.5, 2.0, -0.5;
+  expect_matches_hessian(f, x);
+}
+
+//  Here, we compare the speed of the sparse Hessian of a function
+//  with a tridiagonal Hessian to that of the dense Hessian.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(AgradAutoDiff, sparse_hessian_speed) {
+  chain_fun f;
+  for (int N = 10; N <= 1000; N *= 10) {
+    VectorXd x(N);
+    for (int i = 0; i < N; ++i)
+      x(i) = 0.001 * i;
+    double fx;
+    VectorXd grad;
+    Eigen::SparseMatrix<double> H;
+    Matrix<double, Dynamic, Dynamic> H_dense;
+
+    TimeVar t1 = timeNow();
+    stan::math::hessian(f, x, fx, grad, H_dense);
+    TimeVar t2 = timeNow();
+    stan::math::sparse_hessian(f, x, fx, grad, H);
+    TimeVar t3 = timeNow();
+
+    std::cout << "N: " << N
+              << " hessian: " << duration(t2 - t1) << " us"
+              << " sparse_hessian: " << duration(t3 - t2) << " us"
+              << std::endl;
+  }
+}
+
+*/
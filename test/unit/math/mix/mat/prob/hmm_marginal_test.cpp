@@ -0,0 +1,107 @@
+#include <stan/math/mix/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/prob/hmm_marginal_args.hpp>
+#include <vector>
+
+using stan::math::fvar;
+using stan::math::var;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+namespace {
+
+  // the gradient with respect to all of the arguments at the specified
+  // point
+  std::vector<double> hmm_gradient(
+      const Matrix<double, Dynamic, Dynamic>& log_omegas_d,
+      const Matrix<double, Dynamic, Dynamic>& Gamma_d,
+      const Matrix<double, Dynamic, 1>& rho_d) {
+    Matrix<var, Dynamic, Dynamic> log_omegas = log_omegas_d;
+    Matrix<var, Dynamic, Dynamic> Gamma = Gamma_d;
+    Matrix<var, Dynamic, 1> rho = rho_d;
+    std::vector<var> xs;
+    for (int i = 0; i < log_omegas.size(); ++i)
+      xs.push_back(log_omegas(i));
+    for (int i = 0; i < Gamma.size(); ++i)
+      xs.push_back(Gamma(i));
+    for (int i = 0; i < rho.size(); ++i)
+      xs.push_back(rho(i));
+    std::vector<double> g;
+    stan::math::hmm_marginal(log_omegas, Gamma, rho).grad(xs, g);
+    stan::math::recover_memory();
+    return g;
+  }
+
+}
+
+//  The gradient of the value is the reverse-mode gradient, and the
+//  gradient of the tangent is the Hessian times the direction, which is
+//  checked against a central finite difference of the gradient.
+TEST(ProbDistributionsHmmMarginal, fvar_var) {
+  const int K = 3;
+  const int T = 5;
+  Matrix<double, Dynamic, Dynamic> log_omegas_d, Gamma_d;
+  Matrix<double, Dynamic, 1> rho_d;
+  hmm_args(K, T, log_omegas_d, Gamma_d, rho_d);
+  Matrix<double, Dynamic, Dynamic> d_log_omegas(K, T);
+  for (int i = 0; i < d_log_omegas.size(); ++i)
+    d_log_omegas(i) = std::sin(i + 1.0);
+  Matrix<double, Dynamic, Dynamic> d_Gamma
+    = Matrix<double, Dynamic, Dynamic>::Zero(K, K);
+  for (int i = 0; i < K; ++i) {
+    d_Gamma(i, i) = 0.5;
+    d_Gamma(i, (i + 1) % K) = -0.5;
+  }
+  Matrix<double, Dynamic, 1> d_rho = Matrix<double, Dynamic, 1>::Zero(K);
+  d_rho(0) = 0.25;
+  d_rho(K - 1) = -0.25;
+
+  std::vector<double> g = hmm_gradient(log_omegas_d, Gamma_d, rho_d);
+  const double h = 1e-6;
+  std::vector<double> g_plus
+    = hmm_gradient(log_omegas_d + h * d_log_omegas, Gamma_d + h * d_Gamma,
+                   rho_d + h * d_rho);
+  std::vector<double> g_minus
+    = hmm_gradient(log_omegas_d - h * d_log_omegas, Gamma_d - h * d_Gamma,
+                   rho_d - h * d_rho);
+
+  Matrix<fvar<var>, Dynamic, Dynamic> log_omegas(K, T);
+  for (int i = 0; i < log_omegas.size(); ++i)
+    log_omegas(i) = fvar<var>(log_omegas_d(i), d_log_omegas(i));
+  Matrix<fvar<var>, Dynamic, Dynamic> Gamma(K, K);
+  for (int i = 0; i < Gamma.size(); ++i)
+    Gamma(i) = fvar<var>(Gamma_d(i), d_Gamma(i));
+  Matrix<fvar<var>, Dynamic, 1> rho(K);
+  for (int i = 0; i < rho.size(); ++i)
+    rho(i) = fvar<var>(rho_d(i), d_rho(i));
+  std::vector<var> xs;
+  for (int i = 0; i < log_omegas.size(); ++i)
+    xs.push_back(log_omegas(i).val_);
+  for (int i = 0; i < Gamma.size(); ++i)
+    xs.push_back(Gamma(i).val_);
+  for (int i = 0; i < rho.size(); ++i)
+    xs.push_back(rho(i).val_);
+
+  fvar<var> lp = stan::math::hmm_marginal(log_omegas, Gamma, rho);
+  EXPECT_FLOAT_EQ(stan::math::hmm_marginal(log_omegas_d, Gamma_d, rho_d),
+                  lp.val_.val());
+  double d = 0;
+  for (int i = 0; i < log_omegas.size(); ++i)
+    d += g[i] * d_log_omegas(i);
+  for (int i = 0; i < Gamma.size(); ++i)
+    d += g[log_omegas.size() + i] * d_Gamma(i);
+  for (int i = 0; i < rho.size(); ++i)
+    d += g[log_omegas.size() + Gamma.size() + i] * d_rho(i);
+  EXPECT_FLOAT_EQ(d, lp.d_.val());
+
+  std::vector<double> g_val;
+  lp.val_.grad(xs, g_val);
+  for (size_t i = 0; i < g.size(); ++i)
+    EXPECT_FLOAT_EQ(g[i], g_val[i]);
+  stan::math::set_zero_all_adjoints();
+  std::vector<double> g_d;
+  lp.d_.grad(xs, g_d);
+  for (size_t i = 0; i < g.size(); ++i)
+    EXPECT_NEAR((g_plus[i] - g_minus[i]) / (2 * h), g_d[i], 1e-5);
+  stan::math::recover_memory();
+}
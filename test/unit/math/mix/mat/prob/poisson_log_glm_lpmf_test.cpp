@@ -0,0 +1,48 @@
+#include <stan/math/mix/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+//  Arguments of nested autodiff types put varis on the autodiff stack, so
+//  they are swept on a single thread whatever the number of threads asked for.
+TEST(ProbDistributionsPoissonLogGLM, glm_fvar_var_threads) {
+  using stan::math::var;
+  using stan::math::fvar;
+  const int N = 40000;
+  const int M = 3;
+  std::vector<int> n(N);
+  Matrix<double, Dynamic, Dynamic> x(N, M);
+  for (int i = 0; i < N; ++i) {
+    n[i] = i % 4;
+    for (int j = 0; j < M; ++j)
+      x(i, j) = ((i + 3 * j) % 11) / 10.0 - 0.5;
+  }
+
+  double lp_val[2];
+  double lp_d[2];
+  double beta_adj[2][M];
+  double alpha_adj[2];
+  for (int k = 0; k < 2; ++k) {
+    Matrix<fvar<var>, Dynamic, 1> beta(M);
+    for (int j = 0; j < M; ++j)
+      beta[j] = fvar<var>(0.1 * (j + 1), 1.0);
+    fvar<var> alpha(0.2, 0.5);
+    fvar<var> lp = stan::math::poisson_log_glm_lpmf(n, x, beta, alpha,
+                                                    k == 0 ? 1 : 3);
+    lp.d_.grad();
+    lp_val[k] = lp.val_.val();
+    lp_d[k] = lp.d_.val();
+    for (int j = 0; j < M; ++j)
+      beta_adj[k][j] = beta[j].val_.adj();
+    alpha_adj[k] = alpha.val_.adj();
+    stan::math::recover_memory();
+  }
+
+  EXPECT_EQ(lp_val[0], lp_val[1]);
+  EXPECT_EQ(lp_d[0], lp_d[1]);
+  for (int j = 0; j < M; ++j)
+    EXPECT_EQ(beta_adj[0][j], beta_adj[1][j]);
+  EXPECT_EQ(alpha_adj[0], alpha_adj[1]);
+}
@@ -0,0 +1,60 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <vector>
+
+TEST(ProbAutocovarianceBatch, matches_autocovariance) {
+  // ar1.csv generated in R as described in autocovariance_test.cpp
+  std::fstream f("test/unit/math/prim/mat/fun/ar1.csv");
+  std::vector<double> ar1;
+  for (size_t i = 0; i < 1000; ++i) {
+    double temp;
+    f >> temp;
+    ar1.push_back(temp);
+  }
+
+  // columns of different lengths of the same series
+  const size_t lengths[] = {1000, 999, 97, 2};
+  Eigen::FFT<double> fft;
+  for (size_t n = 0; n < 4; ++n) {
+    const size_t N = lengths[n];
+    Eigen::MatrixXd y(N, 3);
+    for (size_t i = 0; i < N; ++i) {
+      y(i, 0) = ar1[i];
+      y(i, 1) = ar1[ar1.size() - 1 - i];
+      y(i, 2) = 2.0 * ar1[i] + 1.0;
+    }
+
+    Eigen::MatrixXd batch;
+    stan::math::autocovariance_batch(y, batch, fft);
+    ASSERT_EQ(static_cast<int>(N), batch.rows());
+    ASSERT_EQ(3, batch.cols());
+    EXPECT_FALSE(fft.HasFlag(Eigen::FFT<double>::HalfSpectrum));
+
+    for (int k = 0; k < 3; ++k) {
+      std::vector<double> y_k(y.col(k).data(), y.col(k).data() + N);
+      std::vector<double> ref;
+      stan::math::autocovariance(y_k, ref);
+      for (size_t i = 0; i < N; ++i)
+        EXPECT_NEAR(ref[i], batch(i, k), 1e-8);
+    }
+  }
+}
+
+TEST(ProbAutocovarianceBatch, map) {
+  std::vector<double> draws;
+  for (int i = 0; i < 40; ++i)
+    draws.push_back(std::sin(0.3 * i) + 0.01 * i);
+  Eigen::Map<const Eigen::MatrixXd> y(&draws[0], 20, 2);
+
+  Eigen::MatrixXd batch;
+  stan::math::autocovariance_batch(y, batch);
+  for (int k = 0; k < 2; ++k) {
+    std::vector<double> y_k(draws.begin() + 20 * k,
+                            draws.begin() + 20 * (k + 1));
+    std::vector<double> ref;
+    stan::math::autocovariance(y_k, ref);
+    for (size_t i = 0; i < 20; ++i)
+      EXPECT_NEAR(ref[i], batch(i, k), 1e-8);
+  }
+}
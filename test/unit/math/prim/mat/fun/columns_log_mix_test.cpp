@@ -0,0 +1,33 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+
+TEST(MathMatrix, columns_log_mix) {
+  using stan::math::columns_log_mix;
+  using stan::math::log_mix;
+
+  Eigen::VectorXd theta(2);
+  theta << 0.3, 0.7;
+  Eigen::MatrixXd lambda(2, 3);
+  lambda << 1.7, 197, -0.5, -3.9, -3000, 0.25;
+  Eigen::RowVectorXd y = columns_log_mix(theta, lambda);
+  ASSERT_EQ(3, y.size());
+  for (int n = 0; n < 3; ++n)
+    EXPECT_FLOAT_EQ(log_mix(0.3, lambda(0, n), lambda(1, n)), y(n));
+}
+
+TEST(MathMatrix, columns_log_mix_exceptions) {
+  using stan::math::columns_log_mix;
+  Eigen::VectorXd theta(2);
+  theta << 0.3, 0.7;
+  Eigen::MatrixXd lambda(2, 3);
+  lambda << 1.7, 197, -0.5, -3.9, -3000, 0.25;
+  Eigen::MatrixXd lambda3 = Eigen::MatrixXd::Zero(3, 3);
+  EXPECT_THROW(columns_log_mix(theta, lambda3), std::invalid_argument);
+  theta(1) = 1.5;
+  EXPECT_THROW(columns_log_mix(theta, lambda), std::domain_error);
+  theta(1) = 0.7;
+  lambda(1, 1) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(columns_log_mix(theta, lambda), std::domain_error);
+}
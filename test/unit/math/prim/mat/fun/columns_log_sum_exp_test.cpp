@@ -0,0 +1,19 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+TEST(MathMatrix, columns_log_sum_exp) {
+  using stan::math::columns_log_sum_exp;
+  using std::exp;
+  using std::log;
+
+  Eigen::MatrixXd m(2, 3);
+  m << 1.0, -3.0, 0.5, 2.0, 1000.0, -std::numeric_limits<double>::infinity();
+  Eigen::RowVectorXd y = columns_log_sum_exp(m);
+  ASSERT_EQ(3, y.size());
+  EXPECT_FLOAT_EQ(log(exp(1.0) + exp(2.0)), y(0));
+  EXPECT_FLOAT_EQ(1000.0, y(1));
+  EXPECT_FLOAT_EQ(0.5, y(2));
+  EXPECT_EQ(0, columns_log_sum_exp(Eigen::MatrixXd(3, 0)).size());
+}
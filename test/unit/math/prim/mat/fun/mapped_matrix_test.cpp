@@ -0,0 +1,124 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/fun/temp_file.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+TEST(MathMatrix, mapped_matrix_layouts) {
+  test::temp_file file;
+  const std::string& path = file.path;
+  Eigen::MatrixXd x(4, 3);
+  x << 1, 2, 3,
+      4, 5, 6,
+      7, 8, 9,
+      10, 11, 12;
+
+  for (int row_major = 0; row_major < 2; ++row_major) {
+    stan::math::write_mapped_matrix(path, x, row_major);
+    {
+      stan::math::mapped_matrix x_m(path);
+      EXPECT_EQ(4, x_m.rows());
+      EXPECT_EQ(3, x_m.cols());
+      EXPECT_EQ(12U, x_m.size());
+      EXPECT_EQ(12U, stan::length(x_m));
+      EXPECT_EQ(row_major == 1, x_m.row_major());
+      EXPECT_TRUE(x_m.finite());
+      EXPECT_TRUE(stan::is_constant_struct<stan::math::mapped_matrix>::value);
+      for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 3; ++j) {
+          EXPECT_FLOAT_EQ(x(i, j), x_m(i, j));
+          EXPECT_FLOAT_EQ(x(i, j), x_m.values()(i, j));
+        }
+      EXPECT_FLOAT_EQ(x.col(1).sum(), x_m.col(1).sum());
+      EXPECT_FLOAT_EQ(x.row(2).sum(), x_m.row(2).sum());
+
+      Eigen::MatrixXd buffer;
+      Eigen::MatrixXd tile = stan::math::value_of_rows(x_m, 1, 2, buffer);
+      EXPECT_EQ(2, tile.rows());
+      EXPECT_EQ(3, tile.cols());
+      for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 3; ++j)
+          EXPECT_FLOAT_EQ(x(i + 1, j), tile(i, j));
+    }
+  }
+}
+
+TEST(MathMatrix, mapped_matrix_errors) {
+  static const char* function = "mapped_matrix_errors";
+  test::temp_file file;
+  const std::string& path = file.path;
+  EXPECT_THROW(stan::math::mapped_matrix x_m(path + ".missing"),
+               std::runtime_error);
+
+  {
+    std::ofstream out(path.c_str(), std::ios::binary);
+    out << "not a matrix file, but long enough to hold a header";
+  }
+  EXPECT_THROW(stan::math::mapped_matrix x_m(path), std::invalid_argument);
+
+  Eigen::MatrixXd x = Eigen::MatrixXd::Ones(3, 2);
+  stan::math::write_mapped_matrix(path, x);
+  {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::app);
+    out << "trailing";
+  }
+  EXPECT_THROW(stan::math::mapped_matrix x_m(path), std::invalid_argument);
+
+  // dimensions over INT_MAX, or whose number of bytes overflows to the
+  // size of the file
+  boost::uint64_t dims[2][2] = { { 1ULL << 31, 1 },
+                                 { 1073807362, 2147352580 } };
+  for (int k = 0; k < 2; ++k) {
+    stan::math::write_mapped_matrix(path, Eigen::MatrixXd::Ones(4, 2));
+    {
+      std::fstream out(path.c_str(),
+                       std::ios::binary | std::ios::in | std::ios::out);
+      out.seekp(16);
+      out.write(reinterpret_cast<const char*>(dims[k]), sizeof(dims[k]));
+    }
+    EXPECT_THROW(stan::math::mapped_matrix x_m(path), std::invalid_argument);
+  }
+
+  stan::math::write_mapped_matrix(path, x);
+  {
+    stan::math::mapped_matrix x_m(path);
+    EXPECT_NO_THROW(stan::math::check_finite(function, "x", x_m));
+  }
+
+  x(2, 1) = std::numeric_limits<double>::infinity();
+  stan::math::write_mapped_matrix(path, x, true);
+  {
+    stan::math::mapped_matrix x_m(path);
+    EXPECT_FALSE(x_m.finite());
+    EXPECT_THROW(stan::math::check_finite(function, "x", x_m),
+                 std::domain_error);
+  }
+}
+
+TEST(MathMatrix, mapped_matrix_wide_tiles) {
+  test::temp_file file;
+  const int N = 1000;
+  const int M = 100;
+  Eigen::MatrixXd x(N, M);
+  for (int i = 0; i < N; ++i)
+    for (int j = 0; j < M; ++j)
+      x(i, j) = i - 0.5 * j;
+
+  for (int row_major = 0; row_major < 2; ++row_major) {
+    stan::math::write_mapped_matrix(file.path, x, row_major);
+    stan::math::mapped_matrix x_m(file.path);
+    Eigen::MatrixXd buffer;
+    for (int begin = 0; begin < N; begin += 300) {
+      int rows = std::min(300, N - begin);
+      Eigen::MatrixXd tile
+        = stan::math::value_of_rows(x_m, begin, rows, buffer);
+      EXPECT_EQ(0, (tile - x.middleRows(begin, rows)).norm());
+    }
+    // the values are read again after their pages have been released
+    EXPECT_EQ(0, (x_m.values() - x).norm());
+  }
+}
@@ -0,0 +1,33 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+
+TEST(MathMatrix, rows_log_mix) {
+  using stan::math::rows_log_mix;
+  using stan::math::log_mix;
+
+  Eigen::VectorXd theta(2);
+  theta << 0.3, 0.7;
+  Eigen::MatrixXd lambda(3, 2);
+  lambda << 1.7, -3.9, 197, -3000, -0.5, 0.25;
+  Eigen::VectorXd y = rows_log_mix(theta, lambda);
+  ASSERT_EQ(3, y.size());
+  for (int n = 0; n < 3; ++n)
+    EXPECT_FLOAT_EQ(log_mix(0.3, lambda(n, 0), lambda(n, 1)), y(n));
+}
+
+TEST(MathMatrix, rows_log_mix_exceptions) {
+  using stan::math::rows_log_mix;
+  Eigen::VectorXd theta(2);
+  theta << 0.3, 0.7;
+  Eigen::MatrixXd lambda(3, 2);
+  lambda << 1.7, -3.9, 197, -3000, -0.5, 0.25;
+  Eigen::MatrixXd lambda3 = Eigen::MatrixXd::Zero(3, 3);
+  EXPECT_THROW(rows_log_mix(theta, lambda3), std::invalid_argument);
+  theta(1) = 1.5;
+  EXPECT_THROW(rows_log_mix(theta, lambda), std::domain_error);
+  theta(1) = 0.7;
+  lambda(1, 1) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(rows_log_mix(theta, lambda), std::domain_error);
+}
@@ -0,0 +1,24 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+TEST(MathMatrix, rows_log_sum_exp) {
+  using stan::math::rows_log_sum_exp;
+  using std::exp;
+  using std::log;
+
+  Eigen::MatrixXd m(3, 2);
+  m << 1.0, 2.0, -3.0, 1000.0, 0.5, -std::numeric_limits<double>::infinity();
+  Eigen::VectorXd y = rows_log_sum_exp(m);
+  ASSERT_EQ(3, y.size());
+  EXPECT_FLOAT_EQ(log(exp(1.0) + exp(2.0)), y(0));
+  EXPECT_FLOAT_EQ(1000.0, y(1));
+  EXPECT_FLOAT_EQ(0.5, y(2));
+
+  Eigen::MatrixXd m0(2, 0);
+  y = rows_log_sum_exp(m0);
+  ASSERT_EQ(2, y.size());
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(), y(0));
+  EXPECT_EQ(0, rows_log_sum_exp(Eigen::MatrixXd(0, 3)).size());
+}
@@ -0,0 +1,79 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+TEST(MathMatrix, sufficient_stats_ungrouped) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(3);
+  y.push_back(1);
+  y.push_back(4);
+  stan::math::sufficient_stats s(y);
+
+  EXPECT_EQ(1, s.num_groups());
+  EXPECT_EQ(4, s.num_obs());
+  EXPECT_FLOAT_EQ(4, s.count()[0]);
+  EXPECT_FLOAT_EQ(8, s.sum()[0]);
+  EXPECT_FLOAT_EQ(2, s.mean()[0]);
+  EXPECT_FLOAT_EQ(4 + 1 + 1 + 4, s.sum_sq_dev()[0]);
+  EXPECT_FLOAT_EQ(stan::math::lgamma(4.0) + stan::math::lgamma(2.0)
+                  + stan::math::lgamma(5.0),
+                  s.sum_lgamma_p1()[0]);
+  EXPECT_FLOAT_EQ(0, s.min());
+  EXPECT_FLOAT_EQ(4, s.max());
+  EXPECT_TRUE(s.integer_valued());
+  EXPECT_TRUE(stan::math::is_nan(s.non_integer()));
+}
+
+TEST(MathMatrix, sufficient_stats_grouped) {
+  Eigen::VectorXd y(5);
+  y << 1.5, -2, 0.5, 3, 4;
+  std::vector<int> group;
+  group.push_back(2);
+  group.push_back(1);
+  group.push_back(2);
+  group.push_back(1);
+  group.push_back(2);
+  stan::math::sufficient_stats s(y, group, 3);
+
+  EXPECT_EQ(3, s.num_groups());
+  EXPECT_EQ(5, s.num_obs());
+  EXPECT_FLOAT_EQ(2, s.count()[0]);
+  EXPECT_FLOAT_EQ(3, s.count()[1]);
+  EXPECT_FLOAT_EQ(0, s.count()[2]);
+  EXPECT_FLOAT_EQ(1, s.sum()[0]);
+  EXPECT_FLOAT_EQ(6, s.sum()[1]);
+  EXPECT_FLOAT_EQ(0.5, s.mean()[0]);
+  EXPECT_FLOAT_EQ(2, s.mean()[1]);
+  EXPECT_FLOAT_EQ(0, s.mean()[2]);
+  EXPECT_FLOAT_EQ(6.25 + 6.25, s.sum_sq_dev()[0]);
+  EXPECT_FLOAT_EQ(0.25 + 2.25 + 4, s.sum_sq_dev()[1]);
+  EXPECT_FLOAT_EQ(0, s.sum_sq_dev()[2]);
+  EXPECT_FLOAT_EQ(-2, s.min());
+  EXPECT_FLOAT_EQ(4, s.max());
+  EXPECT_FALSE(s.integer_valued());
+  EXPECT_FLOAT_EQ(1.5, s.non_integer());
+}
+
+TEST(MathMatrix, sufficient_stats_exceptions) {
+  std::vector<double> y(3, 1.0);
+  std::vector<int> group(3, 1);
+  EXPECT_NO_THROW(stan::math::sufficient_stats(y, group, 1));
+
+  group[1] = 2;
+  EXPECT_THROW(stan::math::sufficient_stats(y, group, 1),
+               std::domain_error);
+  group[1] = 0;
+  EXPECT_THROW(stan::math::sufficient_stats(y, group, 1),
+               std::domain_error);
+  group[1] = 1;
+  EXPECT_THROW(stan::math::sufficient_stats(y, group, 0),
+               std::domain_error);
+  group.push_back(1);
+  EXPECT_THROW(stan::math::sufficient_stats(y, group, 1),
+               std::invalid_argument);
+
+  y[2] = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(stan::math::sufficient_stats s(y), std::domain_error);
+}
@@ -0,0 +1,38 @@
+#ifndef TEST_UNIT_MATH_PRIM_MAT_FUN_TEMP_FILE_HPP
+#define TEST_UNIT_MATH_PRIM_MAT_FUN_TEMP_FILE_HPP
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace test {
+
+  /**
+   * A temporary file with a unique path, so that tests run in
+   * parallel do not collide, which is removed when it goes out of
+   * scope.
+   */
+  struct temp_file {
+    std::string path;
+
+    temp_file() {
+      const char* dir = std::getenv("TMPDIR");
+      std::string pattern = std::string(dir ? dir : "/tmp")
+        + "/stan_math_test_XXXXXX";
+      std::vector<char> name(pattern.begin(), pattern.end());
+      name.push_back('\0');
+      int fd = mkstemp(&name[0]);
+      if (fd >= 0)
+        close(fd);
+      path = &name[0];
+    }
+
+    ~temp_file() {
+      std::remove(path.c_str());
+    }
+  };
+
+}
+#endif
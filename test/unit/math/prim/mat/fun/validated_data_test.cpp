@@ -0,0 +1,153 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+TEST(MathMatrix, validated_data_summary) {
+  std::vector<double> y;
+  y.push_back(1.5);
+  y.push_back(-2);
+  y.push_back(4);
+  stan::math::validated_data<std::vector<double> > y_v
+    = stan::math::validate_data(y);
+
+  EXPECT_EQ(3U, y_v.size());
+  EXPECT_EQ(3U, stan::length(y_v));
+  EXPECT_TRUE(y_v.not_nan());
+  EXPECT_TRUE(y_v.finite());
+  EXPECT_FLOAT_EQ(-2, y_v.min());
+  EXPECT_FLOAT_EQ(4, y_v.max());
+  EXPECT_TRUE(stan::is_vector<stan::math::validated_data<
+              std::vector<double> > >::value);
+  EXPECT_TRUE(stan::is_constant_struct<stan::math::validated_data<
+              std::vector<double> > >::value);
+
+  y.push_back(std::numeric_limits<double>::quiet_NaN());
+  y.push_back(std::numeric_limits<double>::infinity());
+  y_v = stan::math::validate_data(y);
+  EXPECT_FALSE(y_v.not_nan());
+  EXPECT_FALSE(y_v.finite());
+  EXPECT_FLOAT_EQ(-2, y_v.min());
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), y_v.max());
+}
+
+TEST(MathMatrix, validated_data_checks) {
+  using stan::math::validate_data;
+  static const char* function = "validated_data_checks";
+  Eigen::VectorXd y(3);
+  y << 0, 1, 2;
+
+  EXPECT_NO_THROW(stan::math::check_finite(function, "y", validate_data(y)));
+  EXPECT_NO_THROW(stan::math::check_not_nan(function, "y",
+                                            validate_data(y)));
+  EXPECT_NO_THROW(stan::math::check_nonnegative(function, "y",
+                                                validate_data(y)));
+  EXPECT_THROW(stan::math::check_positive(function, "y", validate_data(y)),
+               std::domain_error);
+  EXPECT_THROW(stan::math::check_positive_finite(function, "y",
+                                                 validate_data(y)),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::check_bounded(function, "y", validate_data(y),
+                                            0, 2));
+  EXPECT_THROW(stan::math::check_bounded(function, "y", validate_data(y),
+                                         0, 1),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::check_greater(function, "y", validate_data(y),
+                                            -1));
+  EXPECT_THROW(stan::math::check_greater(function, "y", validate_data(y), 0),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::check_greater_or_equal(function, "y",
+                                                     validate_data(y), 0));
+  EXPECT_NO_THROW(stan::math::check_less(function, "y", validate_data(y),
+                                         3));
+  EXPECT_THROW(stan::math::check_less(function, "y", validate_data(y), 2),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::check_less_or_equal(function, "y",
+                                                  validate_data(y), 2));
+
+  Eigen::VectorXd low(3);
+  low << -1, 0, 1;
+  EXPECT_NO_THROW(stan::math::check_greater_or_equal(function, "y",
+                                                     validate_data(y), low));
+  low(2) = 3;
+  EXPECT_THROW(stan::math::check_greater_or_equal(function, "y",
+                                                  validate_data(y), low),
+               std::domain_error);
+
+  y(1) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(stan::math::check_not_nan(function, "y", validate_data(y)),
+               std::domain_error);
+  EXPECT_THROW(stan::math::check_finite(function, "y", validate_data(y)),
+               std::domain_error);
+  EXPECT_THROW(stan::math::check_nonnegative(function, "y",
+                                             validate_data(y)),
+               std::domain_error);
+}
+
+TEST(MathMatrix, validated_data_normal_lpdf) {
+  Eigen::VectorXd y(4);
+  y << -1, 0.5, 2, 3;
+  stan::math::validated_data<Eigen::VectorXd> y_v
+    = stan::math::validate_data(y);
+
+  EXPECT_FLOAT_EQ(stan::math::normal_lpdf(y, 0.5, 2.0),
+                  stan::math::normal_lpdf(y_v, 0.5, 2.0));
+  EXPECT_FLOAT_EQ(stan::math::normal_lpdf<true>(y, 0.5, 2.0),
+                  stan::math::normal_lpdf<true>(y_v, 0.5, 2.0));
+
+  Eigen::VectorXd mu(4);
+  mu << 0, 1, 2, 3;
+  EXPECT_FLOAT_EQ(stan::math::normal_lpdf(y, mu, 2.0),
+                  stan::math::normal_lpdf(y_v, mu, 2.0));
+
+  Eigen::VectorXd mu_short(3);
+  mu_short << 0, 1, 2;
+  EXPECT_THROW(stan::math::normal_lpdf(y_v, mu_short, 2.0),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::normal_lpdf(y_v, 0.5, -2.0), std::domain_error);
+
+  y(2) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(stan::math::normal_lpdf(stan::math::validate_data(y), 0.5,
+                                       2.0),
+               std::domain_error);
+}
+
+TEST(MathMatrix, validated_data_poisson_lpmf) {
+  std::vector<int> n;
+  n.push_back(0);
+  n.push_back(3);
+  n.push_back(7);
+
+  EXPECT_FLOAT_EQ(stan::math::poisson_lpmf(n, 2.5),
+                  stan::math::poisson_lpmf(stan::math::validate_data(n),
+                                           2.5));
+
+  n[1] = -1;
+  EXPECT_THROW(stan::math::poisson_lpmf(stan::math::validate_data(n), 2.5),
+               std::domain_error);
+}
+
+TEST(MathMatrix, validated_data_bernoulli_logit_glm_lpmf) {
+  Eigen::Matrix<int, Eigen::Dynamic, 1> n(3);
+  n << 1, 0, 1;
+  Eigen::MatrixXd x(3, 2);
+  x << -12, 46, -42, 24, 25, 27;
+  Eigen::VectorXd beta(2);
+  beta << 0.3, 2;
+  double alpha = 0.3;
+
+  EXPECT_FLOAT_EQ(stan::math::bernoulli_logit_glm_lpmf(n, x, beta, alpha),
+                  stan::math::bernoulli_logit_glm_lpmf(
+                      stan::math::validate_data(n),
+                      stan::math::validate_data(x), beta, alpha));
+
+  x(1, 1) = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(stan::math::bernoulli_logit_glm_lpmf(
+                   n, stan::math::validate_data(x), beta, alpha),
+               std::domain_error);
+  x(1, 1) = 24;
+  n(2) = 2;
+  EXPECT_THROW(stan::math::bernoulli_logit_glm_lpmf(
+                   stan::math::validate_data(n), x, beta, alpha),
+               std::domain_error);
+}
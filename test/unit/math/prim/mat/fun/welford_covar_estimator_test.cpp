@@ -73,3 +73,74 @@ TEST(ProbWelfordCovarEstimator, sample_covariance) {
     for (int j = 0; j < n; ++j)
       EXPECT_EQ(55.0 / 6.0, covar(i, j));
 }
+
+TEST(ProbWelfordCovarEstimator, add_samples) {
+  const int n = 4;
+  const int n_learn = 25;
+  Eigen::MatrixXd q(n, n_learn);
+  for (int i = 0; i < n_learn; ++i)
+    for (int k = 0; k < n; ++k)
+      q(k, i) = std::sin(1.0 + i * (k + 1)) + 0.1 * k * i;
+
+  stan::math::welford_covar_estimator estimator(n);
+  for (int i = 0; i < n_learn; ++i)
+    estimator.add_sample(q.col(i));
+
+  stan::math::welford_covar_estimator batched(n);
+  batched.add_sample(q.col(0));
+  batched.add_samples(q.block(0, 1, n, 10));
+  batched.add_samples(q.block(0, 11, n, 0));
+  batched.add_samples(q.block(0, 11, n, 14));
+  EXPECT_EQ(n_learn, batched.num_samples());
+
+  Eigen::VectorXd mean(n);
+  Eigen::VectorXd batched_mean(n);
+  estimator.sample_mean(mean);
+  batched.sample_mean(batched_mean);
+  Eigen::MatrixXd covar(n, n);
+  Eigen::MatrixXd batched_covar(n, n);
+  estimator.sample_covariance(covar);
+  batched.sample_covariance(batched_covar);
+  for (int i = 0; i < n; ++i) {
+    EXPECT_FLOAT_EQ(mean(i), batched_mean(i));
+    for (int j = 0; j < n; ++j)
+      EXPECT_FLOAT_EQ(covar(i, j), batched_covar(i, j));
+  }
+}
+
+TEST(ProbWelfordCovarEstimator, merge) {
+  const int n = 3;
+  const int n_learn = 20;
+
+  stan::math::welford_covar_estimator estimator(n);
+  stan::math::welford_covar_estimator chain1(n);
+  stan::math::welford_covar_estimator chain2(n);
+  for (int i = 0; i < n_learn; ++i) {
+    Eigen::VectorXd q(n);
+    q << i, std::cos(i), i * i % 7;
+    estimator.add_sample(q);
+    if (i < 6)
+      chain1.add_sample(q);
+    else
+      chain2.add_sample(q);
+  }
+
+  stan::math::welford_covar_estimator merged(n);
+  merged.merge(chain1);
+  merged.merge(chain2);
+  EXPECT_EQ(n_learn, merged.num_samples());
+
+  Eigen::VectorXd mean(n);
+  Eigen::VectorXd merged_mean(n);
+  estimator.sample_mean(mean);
+  merged.sample_mean(merged_mean);
+  Eigen::MatrixXd covar(n, n);
+  Eigen::MatrixXd merged_covar(n, n);
+  estimator.sample_covariance(covar);
+  merged.sample_covariance(merged_covar);
+  for (int i = 0; i < n; ++i) {
+    EXPECT_FLOAT_EQ(mean(i), merged_mean(i));
+    for (int j = 0; j < n; ++j)
+      EXPECT_FLOAT_EQ(covar(i, j), merged_covar(i, j));
+  }
+}
@@ -70,3 +70,68 @@ TEST(ProbWelfordVarEstimator, sample_variance) {
   for (int i = 0; i < n; ++i)
     EXPECT_EQ(55.0 / 6.0, var(i));
 }
+
+TEST(ProbWelfordVarEstimator, add_samples) {
+  const int n = 4;
+  const int n_learn = 25;
+  Eigen::MatrixXd q(n, n_learn);
+  for (int i = 0; i < n_learn; ++i)
+    for (int k = 0; k < n; ++k)
+      q(k, i) = std::sin(1.0 + i * (k + 1)) + 0.1 * k * i;
+
+  stan::math::welford_var_estimator estimator(n);
+  for (int i = 0; i < n_learn; ++i)
+    estimator.add_sample(q.col(i));
+
+  stan::math::welford_var_estimator batched(n);
+  batched.add_samples(q.leftCols(10));
+  batched.add_samples(q.rightCols(15));
+  EXPECT_EQ(n_learn, batched.num_samples());
+
+  Eigen::VectorXd mean(n);
+  Eigen::VectorXd batched_mean(n);
+  estimator.sample_mean(mean);
+  batched.sample_mean(batched_mean);
+  Eigen::VectorXd var(n);
+  Eigen::VectorXd batched_var(n);
+  estimator.sample_variance(var);
+  batched.sample_variance(batched_var);
+  for (int i = 0; i < n; ++i) {
+    EXPECT_FLOAT_EQ(mean(i), batched_mean(i));
+    EXPECT_FLOAT_EQ(var(i), batched_var(i));
+  }
+}
+
+TEST(ProbWelfordVarEstimator, merge) {
+  const int n = 3;
+  const int n_learn = 20;
+
+  stan::math::welford_var_estimator estimator(n);
+  stan::math::welford_var_estimator chain1(n);
+  stan::math::welford_var_estimator chain2(n);
+  for (int i = 0; i < n_learn; ++i) {
+    Eigen::VectorXd q(n);
+    q << i, std::cos(i), i * i % 7;
+    estimator.add_sample(q);
+    if (i % 3 == 0)
+      chain1.add_sample(q);
+    else
+      chain2.add_sample(q);
+  }
+
+  chain1.merge(chain2);
+  EXPECT_EQ(n_learn, chain1.num_samples());
+
+  Eigen::VectorXd mean(n);
+  Eigen::VectorXd merged_mean(n);
+  estimator.sample_mean(mean);
+  chain1.sample_mean(merged_mean);
+  Eigen::VectorXd var(n);
+  Eigen::VectorXd merged_var(n);
+  estimator.sample_variance(var);
+  chain1.sample_variance(merged_var);
+  for (int i = 0; i < n; ++i) {
+    EXPECT_FLOAT_EQ(mean(i), merged_mean(i));
+    EXPECT_FLOAT_EQ(var(i), merged_var(i));
+  }
+}
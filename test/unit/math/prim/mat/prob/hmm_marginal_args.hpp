@@ -0,0 +1,29 @@
+#ifndef TEST_UNIT_MATH_PRIM_MAT_PROB_HMM_MARGINAL_ARGS_HPP
+#define TEST_UNIT_MATH_PRIM_MAT_PROB_HMM_MARGINAL_ARGS_HPP
+
+#include <Eigen/Dense>
+
+// log emission densities, transition matrix and initial distribution of
+// an HMM with K states and T steps
+void hmm_args(int K, int T,
+              Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>&
+              log_omegas,
+              Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& Gamma,
+              Eigen::Matrix<double, Eigen::Dynamic, 1>& rho) {
+  log_omegas.resize(K, T);
+  for (int t = 0; t < T; ++t)
+    for (int k = 0; k < K; ++k)
+      log_omegas(k, t) = -0.5 * ((t * 7 + k * 3) % 11) - 2.0 * k;
+  Gamma.resize(K, K);
+  for (int i = 0; i < K; ++i) {
+    for (int j = 0; j < K; ++j)
+      Gamma(i, j) = 1.0 + (i == j ? 4.0 : 0.0) + 0.1 * j;
+    Gamma.row(i) /= Gamma.row(i).sum();
+  }
+  rho.resize(K);
+  for (int k = 0; k < K; ++k)
+    rho(k) = k + 1.0;
+  rho /= rho.sum();
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/prob/hmm_marginal_args.hpp>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+TEST(ProbDistributionsHmmMarginal, matches_enumeration) {
+  Matrix<double, Dynamic, Dynamic> log_omegas, Gamma;
+  Matrix<double, Dynamic, 1> rho;
+  hmm_args(3, 4, log_omegas, Gamma, rho);
+
+  // sum over all 3^4 paths of the hidden states
+  double p = 0;
+  for (int path = 0; path < 81; ++path) {
+    int z[4] = { path % 3, path / 3 % 3, path / 9 % 3, path / 27 };
+    double q = rho(z[0]) * std::exp(log_omegas(z[0], 0));
+    for (int t = 1; t < 4; ++t)
+      q *= Gamma(z[t - 1], z[t]) * std::exp(log_omegas(z[t], t));
+    p += q;
+  }
+  EXPECT_FLOAT_EQ(std::log(p),
+                  stan::math::hmm_marginal(log_omegas, Gamma, rho));
+}
+
+TEST(ProbDistributionsHmmMarginal, large_emissions) {
+  Matrix<double, Dynamic, Dynamic> log_omegas, Gamma;
+  Matrix<double, Dynamic, 1> rho;
+  hmm_args(3, 50, log_omegas, Gamma, rho);
+  double lp = stan::math::hmm_marginal(log_omegas, Gamma, rho);
+  log_omegas.array() -= 1000;
+  EXPECT_FLOAT_EQ(lp - 50 * 1000,
+                  stan::math::hmm_marginal(log_omegas, Gamma, rho));
+  log_omegas(1, 10) = -std::numeric_limits<double>::infinity();
+  EXPECT_FALSE(stan::math::is_inf(
+      stan::math::hmm_marginal(log_omegas, Gamma, rho)));
+  log_omegas.col(10).setConstant(-std::numeric_limits<double>::infinity());
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(),
+            stan::math::hmm_marginal(log_omegas, Gamma, rho));
+}
+
+TEST(ProbDistributionsHmmMarginal, exceptions) {
+  Matrix<double, Dynamic, Dynamic> log_omegas, Gamma;
+  Matrix<double, Dynamic, 1> rho;
+  hmm_args(3, 5, log_omegas, Gamma, rho);
+  using stan::math::hmm_marginal;
+
+  Matrix<double, Dynamic, Dynamic> Gamma_rect(3, 2);
+  Gamma_rect.setConstant(0.5);
+  EXPECT_THROW(hmm_marginal(log_omegas, Gamma_rect, rho),
+               std::invalid_argument);
+  Matrix<double, Dynamic, 1> rho2(2);
+  rho2 << 0.5, 0.5;
+  EXPECT_THROW(hmm_marginal(log_omegas, Gamma, rho2),
+               std::invalid_argument);
+
+  Matrix<double, Dynamic, Dynamic> Gamma_bad = Gamma;
+  Gamma_bad(1, 1) += 0.1;
+  EXPECT_THROW(hmm_marginal(log_omegas, Gamma_bad, rho), std::domain_error);
+  Matrix<double, Dynamic, 1> rho_bad = rho;
+  rho_bad(0) = -rho_bad(0);
+  EXPECT_THROW(hmm_marginal(log_omegas, Gamma, rho_bad), std::domain_error);
+  log_omegas(2, 3) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(hmm_marginal(log_omegas, Gamma, rho), std::domain_error);
+}
+
+TEST(ProbDistributionsHmmMarginal, no_steps) {
+  Matrix<double, Dynamic, Dynamic> log_omegas, Gamma;
+  Matrix<double, Dynamic, 1> rho;
+  hmm_args(3, 0, log_omegas, Gamma, rho);
+  EXPECT_FLOAT_EQ(0, stan::math::hmm_marginal(log_omegas, Gamma, rho));
+}
@@ -251,3 +251,40 @@ TEST(ProbDistributionsMultiNormalCholesky,
 
   EXPECT_TRUE(chi < quantile(complement(mydist, 1e-6)));
 }
+
+TEST(ProbDistributionsMultiNormalCholesky, batchRng) {
+  Matrix<double, Dynamic, Dynamic> sigma(3, 3);
+  sigma << 9.0, -3.0, 0.0,
+          -3.0,  4.0, 1.0,
+           0.0, 1.0, 3.0;
+  Matrix<double, Dynamic, Dynamic> L = sigma.llt().matrixL();
+  Matrix<double, Dynamic, 1> mu(3);
+  mu << 2.0, -2.0, 11.0;
+
+  int N = 20000;
+  stan::math::philox_engine rng1(3);
+  stan::math::philox_engine rng4(3);
+  Matrix<double, Dynamic, Dynamic> y
+    = stan::math::multi_normal_cholesky_rng(mu, L, N, rng1);
+  Matrix<double, Dynamic, Dynamic> y4
+    = stan::math::multi_normal_cholesky_rng(mu, L, N, rng4, 4);
+  ASSERT_EQ(3, y.rows());
+  ASSERT_EQ(N, y.cols());
+  EXPECT_TRUE(y == y4);
+
+  Matrix<double, Dynamic, 1> mean = y.rowwise().mean();
+  Matrix<double, Dynamic, Dynamic> centered = y.colwise() - mean;
+  Matrix<double, Dynamic, Dynamic> cov
+    = centered * centered.transpose() / (N - 1);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_NEAR(mu(i), mean(i), 0.1);
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(sigma(i, j), cov(i, j), 0.3);
+  }
+
+  EXPECT_THROW(stan::math::multi_normal_cholesky_rng(mu, L, -1, rng1),
+               std::domain_error);
+  Matrix<double, Dynamic, 1> mu_short = mu.head(2);
+  EXPECT_THROW(stan::math::multi_normal_cholesky_rng(mu_short, L, 2, rng1),
+               std::invalid_argument);
+}
@@ -339,3 +339,29 @@ TEST(multiNormalRng, nonPosDefErrorTest) {
   boost::random::mt19937 rng;
   EXPECT_THROW(multi_normal_rng(mu, S, rng), std::domain_error);
 }
+
+TEST(ProbDistributionsMultiNormal, batchRng) {
+  Matrix<double, Dynamic, Dynamic> sigma(3, 3);
+  sigma << 9.0, -3.0, 0.0,
+          -3.0,  4.0, 1.0,
+           0.0, 1.0, 3.0;
+  Matrix<double, Dynamic, 1> mu(3);
+  mu << 2.0, -2.0, 11.0;
+
+  stan::math::philox_engine rng(3);
+  stan::math::philox_engine rng_chol(3);
+  Matrix<double, Dynamic, Dynamic> y
+    = stan::math::multi_normal_rng(mu, sigma, 100, rng, 2);
+  Matrix<double, Dynamic, Dynamic> L = sigma.llt().matrixL();
+  Matrix<double, Dynamic, Dynamic> y_chol
+    = stan::math::multi_normal_cholesky_rng(mu, L, 100, rng_chol);
+  ASSERT_EQ(3, y.rows());
+  ASSERT_EQ(100, y.cols());
+  for (int j = 0; j < 100; ++j)
+    for (int i = 0; i < 3; ++i)
+      EXPECT_FLOAT_EQ(y_chol(i, j), y(i, j));
+
+  sigma(0, 1) = -10;
+  EXPECT_THROW(stan::math::multi_normal_rng(mu, sigma, 10, rng),
+               std::domain_error);
+}
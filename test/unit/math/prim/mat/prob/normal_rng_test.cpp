@@ -0,0 +1,108 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <boost/math/distributions.hpp>
+#include <test/unit/math/prim/scal/prob/util.hpp>
+#include <limits>
+#include <vector>
+
+using stan::math::philox_engine;
+
+TEST(ProbDistributionsNormal, batchThreadInvariance) {
+  // spans several chunks and ends with an odd partial chunk
+  int N = 3 * stan::math::RNG_CHUNK_SIZE + 101;
+  philox_engine rng1(20171113);
+  philox_engine rng4(20171113);
+  Eigen::VectorXd y1 = stan::math::normal_rng(1.5, 2.0, N, rng1);
+  Eigen::VectorXd y4 = stan::math::normal_rng(1.5, 2.0, N, rng4, 4);
+  ASSERT_EQ(N, y1.size());
+  for (int n = 0; n < N; ++n)
+    EXPECT_EQ(y1(n), y4(n));
+  EXPECT_TRUE(rng1 == rng4);
+
+  Eigen::VectorXd z1 = stan::math::normal_rng(1.5, 2.0, N, rng1);
+  Eigen::VectorXd z4 = stan::math::normal_rng(1.5, 2.0, N, rng4, 3);
+  for (int n = 0; n < N; ++n) {
+    EXPECT_EQ(z1(n), z4(n));
+    EXPECT_NE(y1(n), z1(n));
+  }
+}
+
+TEST(ProbDistributionsNormal, batchVectorized) {
+  int N = 5000;
+  std::vector<double> mu(N);
+  Eigen::VectorXd sigma(N);
+  for (int n = 0; n < N; ++n) {
+    mu[n] = (n % 2 == 0) ? -100 : 100;
+    sigma[n] = 0.5;
+  }
+  philox_engine rng(1);
+  philox_engine rng_std(1);
+  Eigen::VectorXd y = stan::math::normal_rng(mu, sigma, N, rng, 2);
+  Eigen::VectorXd z = stan::math::normal_rng(0, 1, N, rng_std);
+  for (int n = 0; n < N; ++n)
+    EXPECT_FLOAT_EQ(mu[n] + 0.5 * z(n), y(n));
+}
+
+TEST(ProbDistributionsNormal, batchErrorCheck) {
+  philox_engine rng;
+  std::vector<double> mu(3, 0.0);
+  double inf = std::numeric_limits<double>::infinity();
+  EXPECT_EQ(0, stan::math::normal_rng(0, 1, 0, rng).size());
+  EXPECT_THROW(stan::math::normal_rng(inf, 1, 3, rng), std::domain_error);
+  EXPECT_THROW(stan::math::normal_rng(0, -1, 3, rng), std::domain_error);
+  EXPECT_THROW(stan::math::normal_rng(0, 1, -1, rng), std::domain_error);
+  EXPECT_THROW(stan::math::normal_rng(0, 1, 3, rng, 0), std::domain_error);
+  EXPECT_NO_THROW(stan::math::normal_rng(mu, 1, 3, rng));
+  EXPECT_THROW(stan::math::normal_rng(mu, 1, 4, rng),
+               std::invalid_argument);
+}
+
+TEST(ProbDistributionsNormal, batchChiSquareGoodnessFitTest) {
+  philox_engine rng(17);
+  int N = 100000;
+  int K = 100;
+  Eigen::VectorXd y = stan::math::normal_rng(2.0, 3.0, N, rng, 4);
+  std::vector<double> samples(y.data(), y.data() + N);
+
+  boost::math::normal_distribution<> dist(2.0, 3.0);
+  std::vector<double> quantiles;
+  for (int k = 1; k < K; ++k)
+    quantiles.push_back(quantile(dist, k / static_cast<double>(K)));
+  quantiles.push_back(std::numeric_limits<double>::max());
+  assert_matches_quantiles(samples, quantiles, 1e-6);
+}
+
+//  Here, we compare the speed of the batched generator to that of
+//  repeated scalar calls on a serial engine.
+/*
+
+#include <boost/random/mersenne_twister.hpp>
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(ProbDistributionsNormal, batch_speed) {
+  const int N = 10000000;
+  boost::random::mt19937 mt;
+  philox_engine rng(1);
+  Eigen::VectorXd y(N);
+
+  TimeVar t1 = timeNow();
+  for (int n = 0; n < N; ++n)
+    y(n) = stan::math::normal_rng(1.0, 2.0, mt);
+  TimeVar t2 = timeNow();
+  y = stan::math::normal_rng(1.0, 2.0, N, rng);
+  TimeVar t3 = timeNow();
+  y = stan::math::normal_rng(1.0, 2.0, N, rng, 8);
+  TimeVar t4 = timeNow();
+
+  std::cout << "scalar calls: " << duration(t2 - t1) << " us" << std::endl
+            << "batched, 1 thread: " << duration(t3 - t2) << " us"
+            << std::endl
+            << "batched, 8 threads: " << duration(t4 - t3) << " us"
+            << std::endl;
+}
+
+*/
@@ -0,0 +1,59 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <boost/math/distributions.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using stan::math::philox_engine;
+
+TEST(ProbDistributionsPoisson, batchThreadInvariance) {
+  int N = 2 * stan::math::RNG_CHUNK_SIZE + 7;
+  std::vector<double> lambda(N);
+  for (int n = 0; n < N; ++n)
+    lambda[n] = (n % 3 == 0) ? 0.5 : 250.0;
+  philox_engine rng1(99);
+  philox_engine rng3(99);
+  std::vector<int> y1 = stan::math::poisson_rng(lambda, N, rng1);
+  std::vector<int> y3 = stan::math::poisson_rng(lambda, N, rng3, 3);
+  ASSERT_EQ(static_cast<size_t>(N), y1.size());
+  for (int n = 0; n < N; ++n)
+    EXPECT_EQ(y1[n], y3[n]);
+  EXPECT_TRUE(rng1 == rng3);
+}
+
+TEST(ProbDistributionsPoisson, batchErrorCheck) {
+  philox_engine rng;
+  EXPECT_EQ(0U, stan::math::poisson_rng(2.0, 0, rng).size());
+  EXPECT_THROW(stan::math::poisson_rng(-1.0, 3, rng), std::domain_error);
+  EXPECT_THROW(stan::math::poisson_rng(std::pow(2.0, 31), 3, rng),
+               std::domain_error);
+  EXPECT_THROW(stan::math::poisson_rng(2.0, -1, rng), std::domain_error);
+  EXPECT_THROW(stan::math::poisson_rng(2.0, 3, rng, 0), std::domain_error);
+  EXPECT_THROW(stan::math::poisson_rng(std::vector<double>(2, 1.0), 3, rng),
+               std::invalid_argument);
+}
+
+TEST(ProbDistributionsPoisson, batchChiSquareGoodnessFitTest) {
+  philox_engine rng(5);
+  int N = 10000;
+  int K = 15;
+  boost::math::poisson_distribution<> dist(5);
+  boost::math::chi_squared mydist(K - 1);
+
+  std::vector<double> bin(K, 0);
+  std::vector<double> expect(K);
+  for (int i = 0; i < K; i++)
+    expect[i] = N * pdf(dist, i);
+  expect[K - 1] = N * (1 - cdf(dist, K - 2));
+
+  std::vector<int> y = stan::math::poisson_rng(5.0, N, rng, 2);
+  for (int n = 0; n < N; ++n)
+    ++bin[std::min(y[n], K - 1)];
+
+  double chi = 0;
+  for (int j = 0; j < K; j++)
+    chi += ((bin[j] - expect[j]) * (bin[j] - expect[j]) / expect[j]);
+
+  EXPECT_TRUE(chi < quantile(complement(mydist, 1e-6)));
+}
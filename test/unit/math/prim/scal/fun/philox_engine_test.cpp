@@ -0,0 +1,101 @@
+#include <stan/math/prim/scal.hpp>
+#include <gtest/gtest.h>
+#include <boost/random/uniform_01.hpp>
+#include <vector>
+
+using stan::math::philox_engine;
+
+TEST(MathFunctions, philox4x32_10_known_answers) {
+  // known-answer vectors published with the Random123 library
+  boost::uint32_t ctr1[4] = {0, 0, 0, 0};
+  boost::uint32_t key1[2] = {0, 0};
+  philox_engine::philox4x32_10(ctr1, key1);
+  EXPECT_EQ(0x6627e8d5U, ctr1[0]);
+  EXPECT_EQ(0xe169c58dU, ctr1[1]);
+  EXPECT_EQ(0xbc57ac4cU, ctr1[2]);
+  EXPECT_EQ(0x9b00dbd8U, ctr1[3]);
+
+  boost::uint32_t ctr2[4] = {0x243f6a88U, 0x85a308d3U,
+                             0x13198a2eU, 0x03707344U};
+  boost::uint32_t key2[2] = {0xa4093822U, 0x299f31d0U};
+  philox_engine::philox4x32_10(ctr2, key2);
+  EXPECT_EQ(0xd16cfe09U, ctr2[0]);
+  EXPECT_EQ(0x94fdccebU, ctr2[1]);
+  EXPECT_EQ(0x5001e420U, ctr2[2]);
+  EXPECT_EQ(0x24126ea1U, ctr2[3]);
+}
+
+TEST(MathFunctions, philox_engine_outputs) {
+  philox_engine rng(0x0123456789abcdefULL, 7);
+  for (boost::uint32_t block = 0; block < 3; ++block) {
+    boost::uint32_t ctr[4] = {block, 0, 7, 0};
+    boost::uint32_t key[2] = {0x89abcdefU, 0x01234567U};
+    philox_engine::philox4x32_10(ctr, key);
+    for (int i = 0; i < 4; ++i)
+      EXPECT_EQ(ctr[i], rng());
+  }
+}
+
+TEST(MathFunctions, philox_engine_discard) {
+  philox_engine rng(42);
+  std::vector<boost::uint32_t> draws(50);
+  for (size_t i = 0; i < draws.size(); ++i)
+    draws[i] = rng();
+
+  for (size_t skip = 0; skip < 20; ++skip) {
+    for (size_t start = 0; start < 9; ++start) {
+      philox_engine jumped(42);
+      for (size_t i = 0; i < start; ++i)
+        jumped();
+      jumped.discard(skip);
+      EXPECT_EQ(draws[start + skip], jumped());
+    }
+  }
+
+  philox_engine a(42);
+  philox_engine b(42);
+  a.discard(1000003);
+  for (int i = 0; i < 1000003; ++i)
+    b();
+  EXPECT_TRUE(a == b);
+  EXPECT_EQ(a(), b());
+}
+
+TEST(MathFunctions, philox_engine_split) {
+  philox_engine rng(42);
+  rng.discard(5);
+  philox_engine s1 = rng.split(1);
+  philox_engine s2 = rng.split(2);
+  EXPECT_EQ(1U, s1.stream());
+  EXPECT_EQ(2U, s2.stream());
+  EXPECT_TRUE(s1 == philox_engine(42, 1));
+  EXPECT_TRUE(s1 != s2);
+
+  int same = 0;
+  for (int i = 0; i < 1000; ++i)
+    same += (s1() == s2());
+  EXPECT_LT(same, 3);
+}
+
+TEST(MathFunctions, philox_engine_seed) {
+  philox_engine a(3, 4);
+  a();
+  a.seed(3, 4);
+  EXPECT_TRUE(a == philox_engine(3, 4));
+  EXPECT_TRUE(philox_engine(3) != philox_engine(4));
+}
+
+TEST(MathFunctions, philox_engine_with_rng_functions) {
+  philox_engine rng(123);
+  boost::uniform_01<philox_engine&> unif(rng);
+  double sum = 0;
+  for (int i = 0; i < 10000; ++i) {
+    double u = unif();
+    EXPECT_GE(u, 0.0);
+    EXPECT_LT(u, 1.0);
+    sum += u;
+  }
+  EXPECT_NEAR(0.5, sum / 10000, 0.02);
+  EXPECT_NO_THROW(stan::math::normal_rng(0, 1, rng));
+  EXPECT_NO_THROW(stan::math::poisson_rng(3.5, rng));
+}
@@ -126,3 +126,58 @@ TEST(StanMathRevDecoupleOdeStates, decouple_ode_states_vv) {
                       ys[t][n].val());
 }
 
+
+TEST(StanMathRevDecoupleOdeStates, decouple_ode_states_gradients) {
+  using stan::math::decouple_ode_states;
+  using stan::math::var;
+  using stan::math::ChainableStack;
+
+  std::vector<double> y0_d(2);
+  y0_d[0] = 1.0;
+  y0_d[1] = 0.5;
+  std::vector<double> theta_d(1, 0.15);
+
+  std::vector<var> y0_v(y0_d.begin(), y0_d.end());
+  std::vector<var> theta_v(theta_d.begin(), theta_d.end());
+
+  size_t N = 2;
+  size_t S = N + 1;
+  size_t size = N * (1 + S);
+  size_t T = 10;
+  size_t k = 0;
+  std::vector<std::vector<double> > ys_coupled(T);
+  for (size_t t = 0; t < T; t++) {
+    std::vector<double> coupled_state(size, 0.0);
+    for (size_t n = 0; n < size; n++)
+      coupled_state[n] = ++k;
+    ys_coupled[t] = coupled_state;
+  }
+
+  // all outputs share a single vari on the chain stack
+  size_t stack_size = ChainableStack::var_stack_.size();
+  std::vector<std::vector<var> > ys
+    = decouple_ode_states(ys_coupled, y0_v, theta_v);
+  EXPECT_EQ(stack_size + 1, ChainableStack::var_stack_.size());
+
+  std::vector<var> vars(y0_v);
+  vars.push_back(theta_v[0]);
+  for (size_t t = 0; t < T; t++) {
+    for (size_t n = 0; n < N; n++) {
+      std::vector<double> g;
+      ys[t][n].grad(vars, g);
+      ASSERT_EQ(S, g.size());
+      for (size_t s = 0; s < S; s++)
+        EXPECT_FLOAT_EQ(ys_coupled[t][N + N * s + n], g[s]);
+      stan::math::set_zero_all_adjoints();
+    }
+  }
+
+  // gradient of a sum of outputs at different times
+  var f = ys[2][0] + 3.0 * ys[7][1];
+  std::vector<double> g;
+  f.grad(vars, g);
+  for (size_t s = 0; s < S; s++)
+    EXPECT_FLOAT_EQ(ys_coupled[2][N + N * s]
+                    + 3.0 * ys_coupled[7][N + N * s + 1], g[s]);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,182 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+using stan::math::var;
+using stan::math::ChainableStack;
+
+namespace {
+
+  // uses hooked operators, unhooked functions (pow, lgamma, fma) and
+  // a matrix operation with its own vari, interleaved
+  template <typename T>
+  T mixed_function(const std::vector<T>& x) {
+    using std::pow;
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::sqrt;
+    using stan::math::square;
+    using stan::math::sin;
+    using stan::math::cos;
+    using stan::math::tanh;
+    using stan::math::log1p;
+    using stan::math::inv_logit;
+    using stan::math::lgamma;
+    using stan::math::pow;
+    using stan::math::fma;
+    T a = x[0] * x[1] + 2.0 * x[2] - x[0] / x[1];
+    T b = exp(-a / 3.0) + log(x[1]) - sqrt(square(x[2]) + 1.0);
+    T c = pow(b, 2.0) + lgamma(x[1] + 1.5) + sin(a) * cos(b);
+    Eigen::Matrix<T, Eigen::Dynamic, 1> v(3);
+    v << a, b, c;
+    T d = stan::math::dot_self(v);
+    T e = fma(d, 1e-3, tanh(c)) + log1p(inv_logit(d / 100.0));
+    return (1.0 - e) / (2.0 + a * a) + 5.0 / x[2] - 1.0 + (-x[0]);
+  }
+
+  void gradient_in_mode(bool compact, const std::vector<double>& x,
+                        double& f, std::vector<double>& g) {
+    stan::math::set_compact_tape(compact);
+    std::vector<var> x_var(x.begin(), x.end());
+    var f_var = mixed_function(x_var);
+    f = f_var.val();
+    f_var.grad(x_var, g);
+    stan::math::set_compact_tape(false);
+    stan::math::recover_memory();
+  }
+
+}
+
+TEST(AgradRevCompactTape, matchesVirtualDispatch) {
+  std::vector<double> x;
+  x.push_back(0.7);
+  x.push_back(1.9);
+  x.push_back(-0.4);
+  double f_virtual;
+  double f_compact;
+  std::vector<double> g_virtual;
+  std::vector<double> g_compact;
+  gradient_in_mode(false, x, f_virtual, g_virtual);
+  gradient_in_mode(true, x, f_compact, g_compact);
+  EXPECT_FLOAT_EQ(f_virtual, f_compact);
+  ASSERT_EQ(g_virtual.size(), g_compact.size());
+  for (size_t i = 0; i < g_virtual.size(); ++i)
+    EXPECT_FLOAT_EQ(g_virtual[i], g_compact[i]);
+}
+
+TEST(AgradRevCompactTape, recordsOnlyCompactEntries) {
+  stan::math::set_compact_tape(true);
+  var x = 1.5;
+  var y = 2.5;
+  size_t stack_size = ChainableStack::var_stack_.size();
+  var z = x;
+  for (int i = 0; i < 100; ++i)
+    z = z * y + 1.0;
+  // one segment vari for all 200 operations
+  EXPECT_EQ(stack_size + 1, ChainableStack::var_stack_.size());
+  EXPECT_EQ(200U, ChainableStack::compact_tape_.size());
+
+  var w = stan::math::lgamma(z) * y;
+  EXPECT_EQ(stack_size + 3, ChainableStack::var_stack_.size());
+  EXPECT_EQ(201U, ChainableStack::compact_tape_.size());
+  stan::math::set_compact_tape(false);
+
+  w.grad();
+  double x_adj = x.adj();
+  double y_adj = y.adj();
+  stan::math::recover_memory();
+  EXPECT_EQ(0U, ChainableStack::compact_tape_.size());
+
+  var x2 = 1.5;
+  var y2 = 2.5;
+  var z2 = x2;
+  for (int i = 0; i < 100; ++i)
+    z2 = z2 * y2 + 1.0;
+  var w2 = stan::math::lgamma(z2) * y2;
+  w2.grad();
+  EXPECT_FLOAT_EQ(x2.adj(), x_adj);
+  EXPECT_FLOAT_EQ(y2.adj(), y_adj);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevCompactTape, nested) {
+  stan::math::set_compact_tape(true);
+  var x = 2.0;
+  var y = x * x;
+
+  stan::math::start_nested();
+  var a = 3.0;
+  var b = a * a * a;
+  b.grad();
+  EXPECT_FLOAT_EQ(27.0, a.adj());
+  EXPECT_FLOAT_EQ(0.0, x.adj());
+  stan::math::set_zero_all_adjoints_nested();
+  b.grad();
+  EXPECT_FLOAT_EQ(27.0, a.adj());
+  stan::math::recover_memory_nested();
+
+  var z = y * x;
+  z.grad();
+  EXPECT_FLOAT_EQ(12.0, x.adj());
+
+  stan::math::set_zero_all_adjoints();
+  z.grad();
+  EXPECT_FLOAT_EQ(12.0, x.adj());
+  stan::math::set_compact_tape(false);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevCompactTape, nan) {
+  stan::math::set_compact_tape(true);
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  var x = 1.0;
+  var y = nan;
+  var z = x * y + x - 2.0;
+  z.grad();
+  EXPECT_TRUE(std::isnan(z.val()));
+  EXPECT_TRUE(std::isnan(x.adj()));
+  EXPECT_TRUE(std::isnan(y.adj()));
+  stan::math::set_compact_tape(false);
+  stan::math::recover_memory();
+}
+
+//  Here, we compare the speed of the compact tape to that of the
+//  virtual dispatch through the var stack.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(AgradRevCompactTape, compact_tape_speed) {
+  const int N = 1000000;
+  for (int compact = 0; compact < 2; ++compact) {
+    stan::math::set_compact_tape(compact);
+    int T_forward = 0;
+    int T_reverse = 0;
+    for (int rep = 0; rep < 10; ++rep) {
+      TimeVar t1 = timeNow();
+      var x = 0.3;
+      var y = 0.7;
+      var z = 0;
+      for (int n = 0; n < N; ++n)
+        z = z + 0.01 * stan::math::exp(-x * y) - y / (10.0 + x * x)
+          + y * x;
+      TimeVar t2 = timeNow();
+      z.grad();
+      TimeVar t3 = timeNow();
+      stan::math::recover_memory();
+      T_forward += duration(t2 - t1);
+      T_reverse += duration(t3 - t2);
+    }
+    std::cout << (compact ? "compact" : "virtual")
+              << " forward: " << T_forward
+              << " us, reverse: " << T_reverse << " us" << std::endl;
+  }
+  stan::math::set_compact_tape(false);
+}
+
+*/
@@ -0,0 +1,35 @@
+#include <stan/math/rev/core.hpp>
+#include <gtest/gtest.h>
+
+TEST(AgradRevVarMatrix, independent) {
+  using stan::math::var_matrix;
+  Eigen::MatrixXd x(2, 3);
+  x << 1, 2, 3, 4, 5, 6;
+  var_matrix a(x);
+  EXPECT_EQ(2, a.rows());
+  EXPECT_EQ(3, a.cols());
+  EXPECT_EQ(6, a.size());
+  for (int i = 0; i < x.size(); ++i) {
+    EXPECT_FLOAT_EQ(x(i), a.val()(i));
+    EXPECT_FLOAT_EQ(0, a.adj()(i));
+  }
+
+  var_matrix b = a;
+  EXPECT_EQ(a.vi_, b.vi_);
+  b.adj()(1, 2) = 2.5;
+  EXPECT_FLOAT_EQ(2.5, a.adj()(1, 2));
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevVarMatrix, set_zero_all_adjoints) {
+  using stan::math::var_matrix;
+  Eigen::MatrixXd x = Eigen::MatrixXd::Ones(3, 2);
+  var_matrix a(x);
+  a.adj().setConstant(4);
+  a.vi_->adj_ = 1;
+  stan::math::set_zero_all_adjoints();
+  EXPECT_FLOAT_EQ(0, a.vi_->adj_);
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_FLOAT_EQ(0, a.adj()(i));
+  stan::math::recover_memory();
+}
@@ -1,3 +1,157 @@
 #include <stan/math/rev/mat.hpp>
 #include <gtest/gtest.h>
 #include <test/unit/math/rev/mat/fun/util.hpp>
+#include <vector>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using stan::math::var;
+
+namespace {
+
+  template <typename MA, typename MB>
+  void expect_product_gradients(const MA& A, const MB& B,
+                                const Matrix<var, Dynamic, Dynamic>& AB,
+                                int i, int j) {
+    std::vector<var> xs;
+    for (int n = 0; n < A.size(); ++n)
+      xs.push_back(A(n));
+    for (int n = 0; n < B.size(); ++n)
+      xs.push_back(B(n));
+    std::vector<double> g;
+    var y = AB(i, j);
+    y.grad(xs, g);
+    for (int r = 0; r < A.rows(); ++r) {
+      for (int k = 0; k < A.cols(); ++k) {
+        int n = &A(r, k) - A.data();
+        EXPECT_FLOAT_EQ(r == i ? B(k, j).val() : 0.0, g[n]);
+      }
+    }
+    for (int k = 0; k < B.rows(); ++k) {
+      for (int c = 0; c < B.cols(); ++c) {
+        int n = A.size() + (&B(k, c) - B.data());
+        EXPECT_FLOAT_EQ(c == j ? A(i, k).val() : 0.0, g[n]);
+      }
+    }
+    stan::math::set_zero_all_adjoints();
+  }
+
+}
+
+TEST(AgradRevMatrix, var_matrix_product) {
+  Matrix<var, Dynamic, Dynamic> A(12, 15);
+  Matrix<var, Dynamic, Dynamic> B(15, 10);
+  for (int n = 0; n < A.size(); ++n)
+    A(n) = 0.1 * n - 3.0;
+  for (int n = 0; n < B.size(); ++n)
+    B(n) = 2.0 - 0.05 * n;
+  size_t stack_size = stan::math::ChainableStack::var_stack_.size();
+  size_t nochain_size
+    = stan::math::ChainableStack::var_nochain_stack_.size();
+  Matrix<var, Dynamic, Dynamic> AB = A * B;
+  // one vari for the product and a few for Eigen's scalars rather
+  // than one per entry
+  EXPECT_GT(stack_size + 10, stan::math::ChainableStack::var_stack_.size());
+  EXPECT_EQ(nochain_size + AB.size() - 1,
+            stan::math::ChainableStack::var_nochain_stack_.size());
+
+  Matrix<double, Dynamic, Dynamic> AB_d
+    = stan::math::value_of(A) * stan::math::value_of(B);
+  for (int n = 0; n < AB.size(); ++n)
+    EXPECT_FLOAT_EQ(AB_d(n), AB(n).val());
+  expect_product_gradients(A, B, AB, 0, 0);
+  expect_product_gradients(A, B, AB, 7, 4);
+  expect_product_gradients(A, B, AB, 11, 9);
+}
+
+TEST(AgradRevMatrix, var_matrix_product_row_major) {
+  Matrix<var, Dynamic, Dynamic, Eigen::RowMajor> A(13, 11);
+  Matrix<var, Dynamic, Dynamic> B(11, 14);
+  for (int n = 0; n < A.size(); ++n)
+    A(n) = 0.1 * n - 3.0;
+  for (int n = 0; n < B.size(); ++n)
+    B(n) = 2.0 - 0.05 * n;
+  Matrix<var, Dynamic, Dynamic> AB = A * B;
+  Matrix<double, Dynamic, Dynamic> A_d(A.rows(), A.cols());
+  for (int i = 0; i < A.rows(); ++i)
+    for (int k = 0; k < A.cols(); ++k)
+      A_d(i, k) = A(i, k).val();
+  Matrix<double, Dynamic, Dynamic> AB_d = A_d * stan::math::value_of(B);
+  for (int n = 0; n < AB.size(); ++n)
+    EXPECT_FLOAT_EQ(AB_d(n), AB(n).val());
+  expect_product_gradients(A, B, AB, 3, 5);
+  expect_product_gradients(A, B, AB, 12, 13);
+
+  // the transpose is read as a row-major operand
+  Matrix<var, Dynamic, Dynamic> BtAt = B.transpose() * A.transpose();
+  for (int i = 0; i < BtAt.rows(); ++i)
+    for (int j = 0; j < BtAt.cols(); ++j)
+      EXPECT_FLOAT_EQ(AB_d(j, i), BtAt(i, j).val());
+}
+
+TEST(AgradRevMatrix, var_matrix_product_accumulates) {
+  Matrix<var, Dynamic, Dynamic> A(10, 20);
+  Matrix<var, Dynamic, 1> x(20);
+  Matrix<var, Dynamic, 1> y(10);
+  for (int n = 0; n < A.size(); ++n)
+    A(n) = 0.01 * n;
+  for (int n = 0; n < x.size(); ++n)
+    x(n) = 1.0 - 0.1 * n;
+  for (int n = 0; n < y.size(); ++n)
+    y(n) = n;
+  std::vector<var> ys(y.data(), y.data() + y.size());
+  var a = 2.5;
+
+  y.noalias() += a * (A * x);
+  Matrix<double, Dynamic, 1> y_d
+    = 2.5 * stan::math::value_of(A) * stan::math::value_of(x);
+  for (int n = 0; n < y.size(); ++n)
+    EXPECT_FLOAT_EQ(n + y_d(n), y(n).val());
+
+  std::vector<var> xs(ys);
+  xs.push_back(a);
+  std::vector<double> g;
+  y(3).grad(xs, g);
+  for (int n = 0; n < y.size(); ++n)
+    EXPECT_FLOAT_EQ(n == 3 ? 1.0 : 0.0, g[n]);
+  EXPECT_FLOAT_EQ(y_d(3) / 2.5, g[y.size()]);
+}
+
+//  Here, we compare the speed of a product of matrices of variables to
+//  that of the explicit multiply() overload.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(AgradRevMatrix, var_matrix_product_speed) {
+  for (int N = 16; N <= 256; N *= 2) {
+    Matrix<var, Dynamic, Dynamic> A(N, N);
+    Matrix<var, Dynamic, Dynamic> B(N, N);
+    for (int n = 0; n < A.size(); ++n) {
+      A(n) = 0.001 * n;
+      B(n) = 1.0 - 0.001 * n;
+    }
+
+    TimeVar t1 = timeNow();
+    Matrix<var, Dynamic, Dynamic> AB = A * B;
+    stan::math::sum(AB).grad();
+    TimeVar t2 = timeNow();
+    stan::math::set_zero_all_adjoints();
+    TimeVar t3 = timeNow();
+    Matrix<var, Dynamic, Dynamic> AB2 = stan::math::multiply(A, B);
+    stan::math::sum(AB2).grad();
+    TimeVar t4 = timeNow();
+
+    std::cout << "N: " << N
+              << " A * B: " << duration(t2 - t1) << " us"
+              << " multiply: " << duration(t4 - t3) << " us"
+              << std::endl;
+    stan::math::recover_memory();
+  }
+}
+
+*/
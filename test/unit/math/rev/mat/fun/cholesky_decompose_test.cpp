@@ -447,3 +447,43 @@ TEST(AgradRevMatrix, check_varis_on_stack_large) {
   X = stan::math::multiply(X, stan::math::transpose(X));
   test::check_varis_on_stack(stan::math::cholesky_decompose(X));
 }
+
+TEST(AgradRevMatrix, mat_cholesky_var_matrix) {
+  using Eigen::MatrixXd;
+  using stan::math::cholesky_decompose;
+  using stan::math::matrix_v;
+  using stan::math::var_matrix;
+
+  for (int N = 5; N < 100; N += 45) {
+    MatrixXd B = MatrixXd::Random(N, N);
+    MatrixXd A_d = B * B.transpose() + N * MatrixXd::Identity(N, N);
+    MatrixXd W = MatrixXd::Random(N, N);
+
+    matrix_v A = A_d;
+    stan::math::var f
+      = stan::math::sum(stan::math::elt_multiply(W, cholesky_decompose(A)));
+    f.grad();
+    MatrixXd A_adj(N, N);
+    for (int i = 0; i < A.size(); ++i)
+      A_adj(i) = A(i).adj();
+    stan::math::recover_memory();
+
+    var_matrix a(A_d);
+    var_matrix L = cholesky_decompose(a);
+    MatrixXd L_d = A_d.llt().matrixL();
+    for (int i = 0; i < L_d.size(); ++i)
+      EXPECT_FLOAT_EQ(L_d(i), L.val()(i));
+    f = stan::math::sum(stan::math::elt_multiply(W, stan::math::to_var(L)));
+    f.grad();
+    for (int i = 0; i < A_adj.size(); ++i)
+      EXPECT_NEAR(A_adj(i), a.adj()(i), 1e-10);
+    stan::math::recover_memory();
+  }
+
+  MatrixXd m(2, 2);
+  m << 1.0, 2.0, 2.0, 3.0;
+  EXPECT_THROW(cholesky_decompose(var_matrix(m)), std::domain_error);
+  MatrixXd n = MatrixXd::Ones(2, 3);
+  EXPECT_THROW(cholesky_decompose(var_matrix(n)), std::invalid_argument);
+  stan::math::recover_memory();
+}
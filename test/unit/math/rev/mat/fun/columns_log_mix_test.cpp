@@ -0,0 +1,138 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/fun/util.hpp>
+#include <vector>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using stan::math::var;
+
+namespace {
+
+  template <typename T_theta, typename T_lambda>
+  void test_columns_log_mix(const Eigen::VectorXd& theta_d,
+                         const Eigen::MatrixXd& lambda_d) {
+    for (int i = 0; i < lambda_d.cols(); ++i) {
+      Matrix<T_theta, Dynamic, 1> theta(theta_d.size());
+      Matrix<T_lambda, Dynamic, Dynamic> lambda(lambda_d.rows(),
+                                                lambda_d.cols());
+      std::vector<var> xs;
+      for (int k = 0; k < theta.size(); ++k) {
+        theta(k) = theta_d(k);
+        if (stan::is_var<T_theta>::value)
+          xs.push_back(theta(k));
+      }
+      for (int n = 0; n < lambda.size(); ++n) {
+        lambda(n) = lambda_d(n);
+        if (stan::is_var<T_lambda>::value)
+          xs.push_back(lambda(n));
+      }
+      Matrix<var, 1, Dynamic> y = stan::math::columns_log_mix(theta, lambda);
+      ASSERT_EQ(lambda.cols(), y.size());
+
+      Matrix<var, Dynamic, 1> a(lambda.rows());
+      for (int k = 0; k < lambda.rows(); ++k)
+        a(k) = stan::math::log(theta(k)) + lambda(k, i);
+      var y_ref = stan::math::log_sum_exp(a);
+      EXPECT_FLOAT_EQ(y_ref.val(), y(i).val());
+      std::vector<double> g_ref;
+      y_ref.grad(xs, g_ref);
+      stan::math::set_zero_all_adjoints();
+      std::vector<double> g;
+      y(i).grad(xs, g);
+      for (size_t n = 0; n < g.size(); ++n)
+        EXPECT_FLOAT_EQ(g_ref[n], g[n]);
+      stan::math::recover_memory();
+    }
+  }
+
+}
+
+TEST(AgradRevMatrix, columns_log_mix) {
+  Eigen::VectorXd theta(3);
+  theta << 0.2, 0.5, 0.3;
+  Eigen::MatrixXd lambda(3, 4);
+  lambda << -1.0, 1.7, -20.0, 0.0,
+    -2.0, -3.9, -1.0, 0.0,
+    -3.0, 0.5, -1.5, 0.0;
+  test_columns_log_mix<var, var>(theta, lambda);
+  test_columns_log_mix<var, double>(theta, lambda);
+  test_columns_log_mix<double, var>(theta, lambda);
+}
+
+TEST(AgradRevMatrix, columns_log_mix_zero_proportion) {
+  Eigen::VectorXd theta(2);
+  theta << 0.0, 1.0;
+  Eigen::MatrixXd lambda(2, 2);
+  lambda << -1.0, 1.7,
+    -2.0, -3.9;
+  Matrix<var, Dynamic, 1> theta_v(2);
+  theta_v << 0.0, 1.0;
+  Matrix<var, 1, Dynamic> y = stan::math::columns_log_mix(theta_v, lambda);
+  EXPECT_FLOAT_EQ(-2.0, y(0).val());
+  EXPECT_FLOAT_EQ(-3.9, y(1).val());
+
+  // d/dtheta_k is exp(lambda_k - y), also at theta_k = 0
+  std::vector<var> xs(theta_v.data(), theta_v.data() + 2);
+  std::vector<double> g;
+  y(0).grad(xs, g);
+  EXPECT_FLOAT_EQ(std::exp(-1.0 + 2.0), g[0]);
+  EXPECT_FLOAT_EQ(1.0, g[1]);
+}
+
+TEST(AgradRevMatrix, columns_log_mix_exceptions) {
+  Matrix<var, Dynamic, 1> theta(2);
+  theta << 0.3, 1.2;
+  Matrix<var, Dynamic, Dynamic> lambda(2, 3);
+  lambda << 1, 2, 3, 4, 5, 6;
+  EXPECT_THROW(stan::math::columns_log_mix(theta, lambda),
+               std::domain_error);
+  theta(1) = 0.7;
+  Matrix<var, Dynamic, Dynamic> lambda3(3, 2);
+  lambda3 << 1, 2, 3, 4, 5, 6;
+  EXPECT_THROW(stan::math::columns_log_mix(theta, lambda3),
+               std::invalid_argument);
+}
+
+//  Here, we compare the speed of the mixture log density of a large
+//  data set to that of one log_sum_exp per observation.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(AgradRevMatrix, columns_log_mix_speed) {
+  const int N = 1000000;
+  const int K = 10;
+  Matrix<var, Dynamic, 1> theta(K);
+  for (int k = 0; k < K; ++k)
+    theta(k) = 1.0 / K;
+  Matrix<var, Dynamic, Dynamic> lambda(K, N);
+  for (int n = 0; n < lambda.size(); ++n)
+    lambda(n) = -0.5 * (n % 17);
+
+  TimeVar t1 = timeNow();
+  var lp = 0;
+  Matrix<var, Dynamic, 1> log_theta = stan::math::log(theta);
+  for (int n = 0; n < N; ++n) {
+    Matrix<var, Dynamic, 1> a = log_theta + lambda.col(n);
+    lp += stan::math::log_sum_exp(a);
+  }
+  lp.grad();
+  TimeVar t2 = timeNow();
+  stan::math::set_zero_all_adjoints();
+  TimeVar t3 = timeNow();
+  var lp2 = stan::math::sum(stan::math::columns_log_mix(theta, lambda));
+  lp2.grad();
+  TimeVar t4 = timeNow();
+
+  std::cout << "log_sum_exp per column: " << duration(t2 - t1) << " us"
+            << std::endl
+            << "columns_log_mix: " << duration(t4 - t3) << " us"
+            << std::endl;
+}
+
+*/
@@ -0,0 +1,57 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/fun/util.hpp>
+#include <vector>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using stan::math::var;
+
+TEST(AgradRevMatrix, columns_log_sum_exp) {
+  Matrix<double, Dynamic, Dynamic> m(3, 4);
+  m << 1.0, 2.0, -3.0, 0.5,
+    -10.0, 20.0, 3.5, 4.0,
+    0.0, 0.0, 0.0, -2.5;
+
+  for (int i = 0; i < m.cols(); ++i) {
+    Matrix<var, Dynamic, Dynamic> x(m.rows(), m.cols());
+    for (int n = 0; n < m.size(); ++n)
+      x(n) = m(n);
+    std::vector<var> xs(x.data(), x.data() + x.size());
+    Matrix<var, 1, Dynamic> y = stan::math::columns_log_sum_exp(x);
+    ASSERT_EQ(m.cols(), y.size());
+
+    Matrix<var, Dynamic, 1> col = x.col(i);
+    var y_ref = stan::math::log_sum_exp(col);
+    EXPECT_FLOAT_EQ(y_ref.val(), y(i).val());
+    std::vector<double> g_ref;
+    y_ref.grad(xs, g_ref);
+    stan::math::set_zero_all_adjoints();
+    std::vector<double> g;
+    y(i).grad(xs, g);
+    for (size_t n = 0; n < g.size(); ++n)
+      EXPECT_FLOAT_EQ(g_ref[n], g[n]);
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevMatrix, columns_log_sum_exp_single_vari) {
+  Matrix<var, Dynamic, Dynamic> x(5, 100);
+  for (int n = 0; n < x.size(); ++n)
+    x(n) = 0.01 * n;
+  size_t stack_size = stan::math::ChainableStack::var_stack_.size();
+  Matrix<var, 1, Dynamic> y = stan::math::columns_log_sum_exp(x);
+  EXPECT_EQ(stack_size + 1, stan::math::ChainableStack::var_stack_.size());
+
+  var lp = stan::math::sum(y);
+  std::vector<var> xs(x.data(), x.data() + x.size());
+  std::vector<double> g;
+  lp.grad(xs, g);
+  // the weights of each column sum to one
+  for (int j = 0; j < x.cols(); ++j) {
+    double s = 0;
+    for (int k = 0; k < x.rows(); ++k)
+      s += g[k + j * x.rows()];
+    EXPECT_FLOAT_EQ(1.0, s);
+  }
+}
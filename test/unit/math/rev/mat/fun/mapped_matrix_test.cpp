@@ -0,0 +1,58 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/fun/temp_file.hpp>
+#include <string>
+#include <vector>
+
+using stan::math::var;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+//  We check that the GLMs give the same values and gradients for a design
+//  matrix streamed from a file as for the same matrix held in memory.
+TEST(AgradRevMatrix, mapped_matrix_glms) {
+  test::temp_file file;
+  const std::string& path = file.path;
+  const int N = 20000;
+  const int M = 3;
+  srand(1);
+  Matrix<double, Dynamic, Dynamic> x
+    = Matrix<double, Dynamic, Dynamic>::Random(N, M);
+  std::vector<int> n(N);
+  for (int i = 0; i < N; ++i)
+    n[i] = (i / 3 + i / 7) % 2;
+  Matrix<double, Dynamic, 1> beta_dbl(M);
+  beta_dbl << 0.3, -1.2, 0.5;
+
+  for (int row_major = 0; row_major < 2; ++row_major) {
+    stan::math::write_mapped_matrix(path, x, row_major);
+    stan::math::mapped_matrix x_m(path);
+    for (int num_threads = 1; num_threads <= 3; num_threads += 2) {
+      Matrix<var, Dynamic, 1> beta = beta_dbl;
+      var alpha = 0.4;
+      var lp = stan::math::bernoulli_logit_glm_lpmf(n, x, beta, alpha,
+                                                    num_threads)
+        + stan::math::poisson_log_glm_lpmf(n, x, beta, alpha, num_threads);
+      lp.grad();
+      double lp_val = lp.val();
+      std::vector<double> adj(M + 1);
+      for (int m = 0; m < M; ++m)
+        adj[m] = beta[m].adj();
+      adj[M] = alpha.adj();
+      stan::math::recover_memory();
+
+      Matrix<var, Dynamic, 1> beta2 = beta_dbl;
+      var alpha2 = 0.4;
+      var lp2 = stan::math::bernoulli_logit_glm_lpmf(n, x_m, beta2, alpha2,
+                                                     num_threads)
+        + stan::math::poisson_log_glm_lpmf(n, x_m, beta2, alpha2,
+                                           num_threads);
+      lp2.grad();
+      EXPECT_FLOAT_EQ(lp_val, lp2.val());
+      for (int m = 0; m < M; ++m)
+        EXPECT_FLOAT_EQ(adj[m], beta2[m].adj());
+      EXPECT_FLOAT_EQ(adj[M], alpha2.adj());
+      stan::math::recover_memory();
+    }
+  }
+}
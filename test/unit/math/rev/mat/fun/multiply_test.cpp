@@ -1723,3 +1723,129 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::multiply(s, value_of(s)));
   test::check_varis_on_stack(stan::math::multiply(value_of(s), s));
 }
+
+TEST(AgradRevMatrix, multiply_var_matrix) {
+  using Eigen::MatrixXd;
+  using stan::math::matrix_v;
+  using stan::math::multiply;
+  using stan::math::sum;
+  using stan::math::to_var_matrix;
+  using stan::math::var;
+  using stan::math::var_matrix;
+
+  MatrixXd A_d = MatrixXd::Random(5, 4);
+  MatrixXd B_d = MatrixXd::Random(4, 3);
+  MatrixXd W = MatrixXd::Random(5, 3);
+  matrix_v A = A_d;
+  matrix_v B = B_d;
+  var f = sum(stan::math::elt_multiply(W, multiply(A, B)));
+  f.grad();
+  MatrixXd A_adj(5, 4);
+  for (int i = 0; i < A.size(); ++i)
+    A_adj(i) = A(i).adj();
+  MatrixXd B_adj(4, 3);
+  for (int i = 0; i < B.size(); ++i)
+    B_adj(i) = B(i).adj();
+  stan::math::recover_memory();
+
+  // the product feeds a second product, which reads its values and
+  // adds to its adjoints directly
+  var_matrix a(A_d);
+  var_matrix b(B_d);
+  var_matrix ab = multiply(a, b);
+  MatrixXd I3 = MatrixXd::Identity(3, 3);
+  MatrixXd ones = MatrixXd::Ones(3, 1);
+  var g = sum(multiply(multiply(ab, I3), var_matrix(ones)));
+  EXPECT_FLOAT_EQ((A_d * B_d).sum(), g.val());
+  stan::math::recover_memory();
+
+  a = var_matrix(A_d);
+  b = var_matrix(B_d);
+  ab = multiply(a, b);
+  for (int i = 0; i < ab.size(); ++i)
+    EXPECT_FLOAT_EQ((A_d * B_d)(i), ab.val()(i));
+  MatrixXd I5 = MatrixXd::Identity(5, 5);
+  var h = sum(multiply(I5, ab)) * 0.0;
+  matrix_v ab_v = stan::math::to_var(ab);
+  h += sum(stan::math::elt_multiply(W, ab_v));
+  h.grad();
+  for (int i = 0; i < A_adj.size(); ++i)
+    EXPECT_FLOAT_EQ(A_adj(i), a.adj()(i));
+  for (int i = 0; i < B_adj.size(); ++i)
+    EXPECT_FLOAT_EQ(B_adj(i), b.adj()(i));
+  stan::math::recover_memory();
+
+  A = A_d;
+  a = to_var_matrix(A);
+  f = sum(stan::math::to_var(multiply(a, B_d)));
+  f.grad();
+  MatrixXd expected_adj = MatrixXd::Ones(5, 3) * B_d.transpose();
+  for (int i = 0; i < A.size(); ++i)
+    EXPECT_FLOAT_EQ(expected_adj(i), A(i).adj());
+  stan::math::recover_memory();
+
+  b = var_matrix(B_d);
+  f = sum(multiply(A_d, b));
+  f.grad();
+  expected_adj = A_d.transpose() * MatrixXd::Ones(5, 3);
+  for (int i = 0; i < B_d.size(); ++i)
+    EXPECT_FLOAT_EQ(expected_adj(i), b.adj()(i));
+  stan::math::recover_memory();
+
+  EXPECT_THROW(multiply(var_matrix(A_d), var_matrix(A_d)),
+               std::invalid_argument);
+}
+
+TEST(AgradRevMatrix, multiply_var_matrix_stack) {
+  using Eigen::MatrixXd;
+  using stan::math::var_matrix;
+  size_t stack_size = stan::math::ChainableStack::var_stack_.size();
+  MatrixXd x = MatrixXd::Random(20, 20);
+  var_matrix a(x);
+  var_matrix ab = stan::math::multiply(a, a);
+  ab = stan::math::multiply(ab, a);
+  EXPECT_EQ(stack_size + 2, stan::math::ChainableStack::var_stack_.size());
+  stan::math::recover_memory();
+}
+
+/*
+#include <chrono>
+TEST(AgradRevMatrix, multiply_var_matrix_speed) {
+  using Eigen::MatrixXd;
+  using stan::math::matrix_v;
+  using stan::math::var_matrix;
+  int N = 128;
+  int K = 10;
+  MatrixXd A_d = MatrixXd::Random(N, N) / N;
+
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  matrix_v A = A_d;
+  matrix_v P = A;
+  for (int k = 0; k < K; ++k)
+    P = stan::math::multiply(P, A);
+  stan::math::var f = stan::math::sum(P);
+  f.grad();
+  std::chrono::steady_clock::time_point end
+    = std::chrono::steady_clock::now();
+  std::cout << "matrix of var: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                 end - start).count()
+            << " ms" << std::endl;
+  stan::math::recover_memory();
+
+  start = std::chrono::steady_clock::now();
+  var_matrix a(A_d);
+  var_matrix p = a;
+  for (int k = 0; k < K; ++k)
+    p = stan::math::multiply(p, a);
+  f = stan::math::sum(p);
+  f.grad();
+  end = std::chrono::steady_clock::now();
+  std::cout << "var_matrix: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                 end - start).count()
+            << " ms" << std::endl;
+  stan::math::recover_memory();
+}
+*/
@@ -0,0 +1,138 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/fun/util.hpp>
+#include <vector>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using stan::math::var;
+
+namespace {
+
+  template <typename T_theta, typename T_lambda>
+  void test_rows_log_mix(const Eigen::VectorXd& theta_d,
+                         const Eigen::MatrixXd& lambda_d) {
+    for (int i = 0; i < lambda_d.rows(); ++i) {
+      Matrix<T_theta, Dynamic, 1> theta(theta_d.size());
+      Matrix<T_lambda, Dynamic, Dynamic> lambda(lambda_d.rows(),
+                                                lambda_d.cols());
+      std::vector<var> xs;
+      for (int k = 0; k < theta.size(); ++k) {
+        theta(k) = theta_d(k);
+        if (stan::is_var<T_theta>::value)
+          xs.push_back(theta(k));
+      }
+      for (int n = 0; n < lambda.size(); ++n) {
+        lambda(n) = lambda_d(n);
+        if (stan::is_var<T_lambda>::value)
+          xs.push_back(lambda(n));
+      }
+      Matrix<var, Dynamic, 1> y = stan::math::rows_log_mix(theta, lambda);
+      ASSERT_EQ(lambda.rows(), y.size());
+
+      Matrix<var, 1, Dynamic> a(lambda.cols());
+      for (int k = 0; k < lambda.cols(); ++k)
+        a(k) = stan::math::log(theta(k)) + lambda(i, k);
+      var y_ref = stan::math::log_sum_exp(a);
+      EXPECT_FLOAT_EQ(y_ref.val(), y(i).val());
+      std::vector<double> g_ref;
+      y_ref.grad(xs, g_ref);
+      stan::math::set_zero_all_adjoints();
+      std::vector<double> g;
+      y(i).grad(xs, g);
+      for (size_t n = 0; n < g.size(); ++n)
+        EXPECT_FLOAT_EQ(g_ref[n], g[n]);
+      stan::math::recover_memory();
+    }
+  }
+
+}
+
+TEST(AgradRevMatrix, rows_log_mix) {
+  Eigen::VectorXd theta(3);
+  theta << 0.2, 0.5, 0.3;
+  Eigen::MatrixXd lambda(4, 3);
+  lambda << -1.0, -2.0, -3.0,
+    1.7, -3.9, 0.5,
+    -20.0, -1.0, -1.5,
+    0.0, 0.0, 0.0;
+  test_rows_log_mix<var, var>(theta, lambda);
+  test_rows_log_mix<var, double>(theta, lambda);
+  test_rows_log_mix<double, var>(theta, lambda);
+}
+
+TEST(AgradRevMatrix, rows_log_mix_zero_proportion) {
+  Eigen::VectorXd theta(2);
+  theta << 0.0, 1.0;
+  Eigen::MatrixXd lambda(2, 2);
+  lambda << -1.0, -2.0,
+    1.7, -3.9;
+  Matrix<var, Dynamic, 1> theta_v(2);
+  theta_v << 0.0, 1.0;
+  Matrix<var, Dynamic, 1> y = stan::math::rows_log_mix(theta_v, lambda);
+  EXPECT_FLOAT_EQ(-2.0, y(0).val());
+  EXPECT_FLOAT_EQ(-3.9, y(1).val());
+
+  // d/dtheta_k is exp(lambda_k - y), also at theta_k = 0
+  std::vector<var> xs(theta_v.data(), theta_v.data() + 2);
+  std::vector<double> g;
+  y(0).grad(xs, g);
+  EXPECT_FLOAT_EQ(std::exp(-1.0 + 2.0), g[0]);
+  EXPECT_FLOAT_EQ(1.0, g[1]);
+}
+
+TEST(AgradRevMatrix, rows_log_mix_exceptions) {
+  Matrix<var, Dynamic, 1> theta(2);
+  theta << 0.3, 1.2;
+  Matrix<var, Dynamic, Dynamic> lambda(3, 2);
+  lambda << 1, 2, 3, 4, 5, 6;
+  EXPECT_THROW(stan::math::rows_log_mix(theta, lambda), std::domain_error);
+  theta(1) = 0.7;
+  Matrix<var, Dynamic, Dynamic> lambda3(2, 3);
+  lambda3 << 1, 2, 3, 4, 5, 6;
+  EXPECT_THROW(stan::math::rows_log_mix(theta, lambda3),
+               std::invalid_argument);
+}
+
+//  Here, we compare the speed of the mixture log density of a large
+//  data set to that of one log_sum_exp per observation.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(AgradRevMatrix, rows_log_mix_speed) {
+  const int N = 1000000;
+  const int K = 10;
+  Matrix<var, Dynamic, 1> theta(K);
+  for (int k = 0; k < K; ++k)
+    theta(k) = 1.0 / K;
+  Matrix<var, Dynamic, Dynamic> lambda(N, K);
+  for (int n = 0; n < lambda.size(); ++n)
+    lambda(n) = -0.5 * (n % 17);
+
+  TimeVar t1 = timeNow();
+  var lp = 0;
+  Matrix<var, 1, Dynamic> log_theta = stan::math::log(theta).transpose();
+  for (int n = 0; n < N; ++n) {
+    Matrix<var, 1, Dynamic> a = log_theta + lambda.row(n);
+    lp += stan::math::log_sum_exp(a);
+  }
+  lp.grad();
+  TimeVar t2 = timeNow();
+  stan::math::set_zero_all_adjoints();
+  TimeVar t3 = timeNow();
+  var lp2 = stan::math::sum(stan::math::rows_log_mix(theta, lambda));
+  lp2.grad();
+  TimeVar t4 = timeNow();
+
+  std::cout << "log_sum_exp per row: " << duration(t2 - t1) << " us"
+            << std::endl
+            << "rows_log_mix: " << duration(t4 - t3) << " us"
+            << std::endl;
+}
+
+*/
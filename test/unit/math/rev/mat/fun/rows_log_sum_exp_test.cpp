@@ -0,0 +1,57 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/fun/util.hpp>
+#include <vector>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using stan::math::var;
+
+TEST(AgradRevMatrix, rows_log_sum_exp) {
+  Matrix<double, Dynamic, Dynamic> m(3, 4);
+  m << 1.0, 2.0, -3.0, 0.5,
+    -10.0, 20.0, 3.5, 4.0,
+    0.0, 0.0, 0.0, -2.5;
+
+  for (int i = 0; i < m.rows(); ++i) {
+    Matrix<var, Dynamic, Dynamic> x(m.rows(), m.cols());
+    for (int n = 0; n < m.size(); ++n)
+      x(n) = m(n);
+    std::vector<var> xs(x.data(), x.data() + x.size());
+    Matrix<var, Dynamic, 1> y = stan::math::rows_log_sum_exp(x);
+    ASSERT_EQ(m.rows(), y.size());
+
+    Matrix<var, 1, Dynamic> row = x.row(i);
+    var y_ref = stan::math::log_sum_exp(row);
+    EXPECT_FLOAT_EQ(y_ref.val(), y(i).val());
+    std::vector<double> g_ref;
+    y_ref.grad(xs, g_ref);
+    stan::math::set_zero_all_adjoints();
+    std::vector<double> g;
+    y(i).grad(xs, g);
+    for (size_t n = 0; n < g.size(); ++n)
+      EXPECT_FLOAT_EQ(g_ref[n], g[n]);
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevMatrix, rows_log_sum_exp_single_vari) {
+  Matrix<var, Dynamic, Dynamic> x(100, 5);
+  for (int n = 0; n < x.size(); ++n)
+    x(n) = 0.01 * n;
+  size_t stack_size = stan::math::ChainableStack::var_stack_.size();
+  Matrix<var, Dynamic, 1> y = stan::math::rows_log_sum_exp(x);
+  EXPECT_EQ(stack_size + 1, stan::math::ChainableStack::var_stack_.size());
+
+  var lp = stan::math::sum(y);
+  std::vector<var> xs(x.data(), x.data() + x.size());
+  std::vector<double> g;
+  lp.grad(xs, g);
+  // the weights of each row sum to one
+  for (int i = 0; i < x.rows(); ++i) {
+    double s = 0;
+    for (int k = 0; k < x.cols(); ++k)
+      s += g[i + k * x.rows()];
+    EXPECT_FLOAT_EQ(1.0, s);
+  }
+}
@@ -97,3 +97,18 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::sum(v));
   test::check_varis_on_stack(stan::math::sum(rv));
 }
+
+TEST(AgradRevMatrix, sum_var_matrix) {
+  using stan::math::var_matrix;
+  Eigen::MatrixXd x(2, 3);
+  x << 1, 2, 3, 4, 5, 6;
+  var_matrix a(x);
+  stan::math::var f = stan::math::sum(a);
+  EXPECT_FLOAT_EQ(21, f.val());
+  f.grad();
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_FLOAT_EQ(1, a.adj()(i));
+  Eigen::MatrixXd empty(0, 2);
+  EXPECT_FLOAT_EQ(0, stan::math::sum(var_matrix(empty)).val());
+  stan::math::recover_memory();
+}
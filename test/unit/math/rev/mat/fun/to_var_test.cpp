@@ -89,3 +89,35 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::to_var(v));
   test::check_varis_on_stack(stan::math::to_var(rv));
 }
+
+TEST(AgradRevMatrix, to_var_var_matrix) {
+  using stan::math::matrix_v;
+  using stan::math::to_var;
+  using stan::math::to_var_matrix;
+  using stan::math::var;
+  using stan::math::var_matrix;
+
+  matrix_v x(2, 2);
+  x << 1, 2, 3, 4;
+  var_matrix a = to_var_matrix(x);
+  EXPECT_EQ(2, a.rows());
+  EXPECT_EQ(2, a.cols());
+  for (int i = 0; i < 4; ++i)
+    EXPECT_FLOAT_EQ(x(i).val(), a.val()(i));
+
+  matrix_v y = to_var(a);
+  EXPECT_EQ(2, y.rows());
+  EXPECT_EQ(2, y.cols());
+  var f = y(0, 0) * y(1, 1) - 3 * y(1, 0);
+  EXPECT_FLOAT_EQ(-5, f.val());
+  f.grad();
+  EXPECT_FLOAT_EQ(4, x(0, 0).adj());
+  EXPECT_FLOAT_EQ(-3, x(1, 0).adj());
+  EXPECT_FLOAT_EQ(0, x(0, 1).adj());
+  EXPECT_FLOAT_EQ(1, x(1, 1).adj());
+  EXPECT_FLOAT_EQ(4, a.adj()(0, 0));
+
+  Eigen::MatrixXd empty(0, 3);
+  EXPECT_EQ(0, to_var(var_matrix(empty)).rows());
+  stan::math::recover_memory();
+}
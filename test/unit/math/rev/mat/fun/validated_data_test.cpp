@@ -0,0 +1,125 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+// For speed comparisons
+// #include <chrono>
+
+using stan::math::var;
+using stan::math::validate_data;
+
+TEST(AgradRevMatrix, validated_data_normal_lpdf) {
+  Eigen::VectorXd y(4);
+  y << -1, 0.5, 2, 3;
+  stan::math::validated_data<Eigen::VectorXd> y_v = validate_data(y);
+
+  var mu1 = 0.5;
+  var sigma1 = 2.0;
+  var lp1 = stan::math::normal_lpdf(y, mu1, sigma1);
+  std::vector<var> theta1;
+  theta1.push_back(mu1);
+  theta1.push_back(sigma1);
+  std::vector<double> grad1;
+  lp1.grad(theta1, grad1);
+
+  var mu2 = 0.5;
+  var sigma2 = 2.0;
+  var lp2 = stan::math::normal_lpdf(y_v, mu2, sigma2);
+  std::vector<var> theta2;
+  theta2.push_back(mu2);
+  theta2.push_back(sigma2);
+  std::vector<double> grad2;
+  lp2.grad(theta2, grad2);
+
+  EXPECT_FLOAT_EQ(lp1.val(), lp2.val());
+  EXPECT_FLOAT_EQ(grad1[0], grad2[0]);
+  EXPECT_FLOAT_EQ(grad1[1], grad2[1]);
+
+  EXPECT_THROW(stan::math::normal_lpdf(y_v, mu2, -sigma2),
+               std::domain_error);
+}
+
+TEST(AgradRevMatrix, validated_data_bernoulli_logit_glm_lpmf) {
+  Eigen::Matrix<int, Eigen::Dynamic, 1> n(3);
+  n << 1, 0, 1;
+  Eigen::MatrixXd x(3, 2);
+  x << -12, 46, -42, 24, 25, 27;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> beta1(2);
+  beta1 << 0.3, 2;
+  var alpha1 = 0.3;
+  var lp1 = stan::math::bernoulli_logit_glm_lpmf(n, x, beta1, alpha1);
+  lp1.grad();
+  double alpha1_adj = alpha1.adj();
+  Eigen::VectorXd beta1_adj(2);
+  beta1_adj << beta1[0].adj(), beta1[1].adj();
+  stan::math::set_zero_all_adjoints();
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> beta2(2);
+  beta2 << 0.3, 2;
+  var alpha2 = 0.3;
+  var lp2 = stan::math::bernoulli_logit_glm_lpmf(validate_data(n),
+                                                 validate_data(x),
+                                                 beta2, alpha2);
+  lp2.grad();
+
+  EXPECT_FLOAT_EQ(lp1.val(), lp2.val());
+  EXPECT_FLOAT_EQ(alpha1_adj, alpha2.adj());
+  for (int i = 0; i < 2; ++i)
+    EXPECT_FLOAT_EQ(beta1_adj[i], beta2[i].adj());
+}
+
+//  Here, we compare the speed of the density with validated data to
+//  that of the same density checking its data on every call.
+
+/*
+TEST(AgradRevMatrix, validated_data_speed) {
+  typedef std::chrono::high_resolution_clock::time_point TimeVar;
+  #define duration(a) std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+  #define timeNow() std::chrono::high_resolution_clock::now()
+
+  const int R = 100000;
+  const int C = 10;
+
+  Eigen::Matrix<int, Eigen::Dynamic, 1> n(R);
+  for (int i = 0; i < R; i++)
+    n[i] = rand() % 2;
+  Eigen::MatrixXd x = Eigen::MatrixXd::Random(R, C);
+  Eigen::VectorXd y = Eigen::VectorXd::Random(R);
+  stan::math::validated_data<Eigen::Matrix<int, Eigen::Dynamic, 1> >
+    n_v = validate_data(n);
+  stan::math::validated_data<Eigen::MatrixXd> x_v = validate_data(x);
+  stan::math::validated_data<Eigen::VectorXd> y_v = validate_data(y);
+
+  int T1 = 0;
+  int T2 = 0;
+  for (int testnumber = 0; testnumber < 30; testnumber++) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> beta
+      = Eigen::VectorXd::Random(C);
+    var alpha = 0.3;
+    var sigma = 1.5;
+
+    TimeVar t1 = timeNow();
+    var lp1 = stan::math::bernoulli_logit_glm_lpmf(n, x, beta, alpha)
+      + stan::math::normal_lpdf(y, alpha, sigma);
+    lp1.grad();
+    TimeVar t2 = timeNow();
+    stan::math::recover_memory();
+
+    beta = Eigen::VectorXd::Random(C);
+    alpha = 0.3;
+    sigma = 1.5;
+    TimeVar t3 = timeNow();
+    var lp2 = stan::math::bernoulli_logit_glm_lpmf(n_v, x_v, beta, alpha)
+      + stan::math::normal_lpdf(y_v, alpha, sigma);
+    lp2.grad();
+    TimeVar t4 = timeNow();
+    stan::math::recover_memory();
+
+    T1 += duration(t2 - t1);
+    T2 += duration(t4 - t3);
+  }
+
+  std::cout << "Checked data: " << T1 << std::endl
+            << "Validated data: " << T2 << std::endl;
+}
+*/
@@ -0,0 +1,148 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using stan::math::var;
+
+// K steps of a nonlinear state-space recursion with parameter theta
+// stored as the last element of the state
+struct state_steps {
+  int K_;
+  explicit state_steps(int K) : K_(K) { }
+
+  template <typename T>
+  inline Matrix<T, Dynamic, 1>
+  operator()(const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::sin;
+    using stan::math::exp;
+    Matrix<T, Dynamic, 1> z = x;
+    for (int k = 0; k < K_; ++k) {
+      T z0 = z(0);
+      z(0) = 0.9 * z(0) + 0.1 * sin(z(1)) * z(2);
+      z(1) = 0.5 * z(1) + 0.01 * exp(-z0 * z0);
+    }
+    return z;
+  }
+};
+
+// number of outputs differs between double and var
+struct bad_region {
+  inline Matrix<double, Dynamic, 1>
+  operator()(const Matrix<double, Dynamic, 1>& x) const {
+    return x;
+  }
+  inline Matrix<var, Dynamic, 1>
+  operator()(const Matrix<var, Dynamic, 1>& x) const {
+    return x.head(1);
+  }
+};
+
+struct empty_region {
+  template <typename T>
+  inline Matrix<T, Dynamic, 1>
+  operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return Matrix<T, Dynamic, 1>(0);
+  }
+};
+
+var run_steps(const Matrix<var, Dynamic, 1>& x0, int num_regions,
+              int steps_per_region, bool use_checkpoint) {
+  state_steps f(steps_per_region);
+  Matrix<var, Dynamic, 1> z = x0;
+  for (int r = 0; r < num_regions; ++r)
+    z = use_checkpoint ? stan::math::checkpoint(f, z) : f(z);
+  return z(0) * z(0) + z(1);
+}
+
+TEST(AgradRevCheckpoint, matchesDirectGradient) {
+  std::vector<double> g_direct(3);
+  std::vector<double> g_checkpoint(3);
+  double val_direct;
+  double val_checkpoint;
+
+  for (int use_checkpoint = 0; use_checkpoint < 2; ++use_checkpoint) {
+    Matrix<var, Dynamic, 1> x0(3);
+    x0 << 1.5, -0.3, 0.7;
+    var lp = run_steps(x0, 20, 50, use_checkpoint);
+    lp.grad();
+    std::vector<double>& g = use_checkpoint ? g_checkpoint : g_direct;
+    for (int i = 0; i < 3; ++i)
+      g[i] = x0(i).adj();
+    (use_checkpoint ? val_checkpoint : val_direct) = lp.val();
+    stan::math::recover_memory();
+  }
+
+  EXPECT_FLOAT_EQ(val_direct, val_checkpoint);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(g_direct[i], g_checkpoint[i]);
+}
+
+TEST(AgradRevCheckpoint, boundsStackSize) {
+  using stan::math::ChainableStack;
+  Matrix<var, Dynamic, 1> x0(3);
+  x0 << 1.5, -0.3, 0.7;
+  size_t start = ChainableStack::var_stack_.size();
+  var lp_direct = run_steps(x0, 20, 50, false);
+  size_t direct_size = ChainableStack::var_stack_.size() - start;
+
+  start = ChainableStack::var_stack_.size();
+  var lp = run_steps(x0, 20, 50, true);
+  size_t checkpoint_size = ChainableStack::var_stack_.size() - start;
+  EXPECT_LT(20 * checkpoint_size, direct_size);
+  EXPECT_FLOAT_EQ(lp_direct.val(), lp.val());
+
+  lp.grad();
+  EXPECT_EQ(start + checkpoint_size, ChainableStack::var_stack_.size());
+  EXPECT_TRUE(stan::math::empty_nested());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevCheckpoint, sharedInputsAndNesting) {
+  // the same input feeds two regions, and the whole computation is
+  // differentiated inside a nested gradient() call
+  struct outer {
+    double operator()(const Matrix<double, Dynamic, 1>& x) const {
+      state_steps f(10);
+      return f(x)(0) * f(x)(1);
+    }
+    var operator()(const Matrix<var, Dynamic, 1>& x) const {
+      state_steps f(10);
+      Matrix<var, Dynamic, 1> a = stan::math::checkpoint(f, x);
+      Matrix<var, Dynamic, 1> b = stan::math::checkpoint(f, x);
+      return a(0) * b(1);
+    }
+  };
+  Matrix<double, Dynamic, 1> x(3);
+  x << 0.2, 1.1, -0.4;
+  double fx;
+  Matrix<double, Dynamic, 1> grad_fx;
+  stan::math::gradient(outer(), x, fx, grad_fx);
+
+  Matrix<var, Dynamic, 1> x_var(3);
+  for (int i = 0; i < 3; ++i)
+    x_var(i) = x(i);
+  state_steps f(10);
+  Matrix<var, Dynamic, 1> y = f(x_var);
+  var fx_var = y(0) * y(1);
+  fx_var.grad();
+  EXPECT_FLOAT_EQ(fx_var.val(), fx);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(x_var(i).adj(), grad_fx(i));
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevCheckpoint, exceptions) {
+  Matrix<var, Dynamic, 1> x(2);
+  x << 1, 2;
+  EXPECT_THROW(stan::math::checkpoint(empty_region(), x),
+               std::invalid_argument);
+
+  Matrix<var, Dynamic, 1> y = stan::math::checkpoint(bad_region(), x);
+  var lp = y(0) + y(1);
+  EXPECT_THROW(lp.grad(), std::logic_error);
+  EXPECT_TRUE(stan::math::empty_nested());
+  stan::math::recover_memory();
+}
@@ -0,0 +1,56 @@
+#ifndef TEST_UNIT_MATH_REV_MAT_FUNCTOR_COMPACT_TAPE_FUNCTORS_HPP
+#define TEST_UNIT_MATH_REV_MAT_FUNCTOR_COMPACT_TAPE_FUNCTORS_HPP
+
+#include <stan/math/rev/mat.hpp>
+
+// uses every operation with a compact form
+struct compact_fun {
+  template <typename T>
+  inline
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::sqrt;
+    using stan::math::square;
+    using stan::math::sin;
+    using stan::math::cos;
+    using stan::math::tanh;
+    using stan::math::log1p;
+    using stan::math::inv_logit;
+    T a = x(0) * x(1) + 2.0 * x(2) - x(0) / x(1) + (x(1) - 0.5);
+    T b = exp(-a / 3.0) + log(x(1)) - sqrt(square(x(2)) + 1.0);
+    T c = sin(a) * cos(b) + tanh(x(2)) + log1p(inv_logit(x(0)));
+    return (1.0 - c) / (2.0 + a * a) + 5.0 / x(2) - 1.0 + (-x(0)) + b;
+  }
+};
+
+// fabs and step branch on the signs of their arguments
+struct sign_fun {
+  template <typename T>
+  inline
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::fabs;
+    using stan::math::step;
+    return fabs(x(0)) * x(1) + step(x(1)) * x(0);
+  }
+};
+
+// lgamma has no compact form
+struct lgamma_fun {
+  template <typename T>
+  inline
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    return stan::math::lgamma(x(0)) * x(1);
+  }
+};
+
+// log1p throws outside of its domain
+struct log1p_fun {
+  template <typename T>
+  inline
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    return stan::math::log1p(x(0)) * x(1);
+  }
+};
+
+#endif
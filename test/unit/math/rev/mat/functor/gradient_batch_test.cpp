@@ -0,0 +1,138 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/functor/compact_tape_functors.hpp>
+#include <stdexcept>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using Eigen::VectorXd;
+using Eigen::MatrixXd;
+
+namespace {
+
+  // the branch taken depends on the argument
+  struct branch_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      T y = x(0) * x(1);
+      if (y > 1.0)
+        return y * y;
+      return 3.0 * x(1) - y;
+    }
+  };
+
+  template <typename F>
+  void expect_matches_gradient(const F& f, const MatrixXd& x) {
+    VectorXd fx;
+    MatrixXd grad_fx;
+    stan::math::gradient_batch(f, x, fx, grad_fx);
+    ASSERT_EQ(x.cols(), fx.size());
+    ASSERT_EQ(x.rows(), grad_fx.rows());
+    ASSERT_EQ(x.cols(), grad_fx.cols());
+    for (int k = 0; k < x.cols(); ++k) {
+      double fx_ref;
+      VectorXd grad_fx_ref;
+      stan::math::gradient(f, VectorXd(x.col(k)), fx_ref, grad_fx_ref);
+      EXPECT_FLOAT_EQ(fx_ref, fx(k));
+      for (int i = 0; i < x.rows(); ++i)
+        EXPECT_FLOAT_EQ(grad_fx_ref(i), grad_fx(i, k));
+    }
+    EXPECT_FALSE(stan::math::compact_tape_enabled());
+    EXPECT_EQ(0U, stan::math::ChainableStack::var_stack_.size());
+  }
+
+}
+
+TEST(AgradAutoDiff, gradientBatch) {
+  compact_fun f;
+  MatrixXd x(3, 70);
+  for (int k = 0; k < x.cols(); ++k)
+    x.col(k) << 0.7 + 0.01 * k, 1.9 - 0.01 * k, -0.4 + 0.005 * k;
+  expect_matches_gradient(f, x);
+}
+
+TEST(AgradAutoDiff, gradientBatchBranches) {
+  branch_fun f;
+  MatrixXd x(2, 40);
+  for (int k = 0; k < x.cols(); ++k)
+    x.col(k) << 0.1 * k, 0.5;
+  expect_matches_gradient(f, x);
+}
+
+TEST(AgradAutoDiff, gradientBatchSignChanges) {
+  sign_fun f;
+  MatrixXd x(2, 70);
+  for (int k = 0; k < x.cols(); ++k)
+    x.col(k) << 1.0 - 0.03 * k, 0.7 - 0.02 * k;
+  x(0, 40) = 0;
+  expect_matches_gradient(f, x);
+}
+
+TEST(AgradAutoDiff, gradientBatchFallsBack) {
+  lgamma_fun f;
+  MatrixXd x(2, 5);
+  for (int k = 0; k < x.cols(); ++k)
+    x.col(k) << 1.5 + k, 0.5 * k;
+  expect_matches_gradient(f, x);
+}
+
+TEST(AgradAutoDiff, gradientBatchEmpty) {
+  compact_fun f;
+  MatrixXd x(3, 0);
+  VectorXd fx;
+  MatrixXd grad_fx;
+  stan::math::gradient_batch(f, x, fx, grad_fx);
+  EXPECT_EQ(0, fx.size());
+  EXPECT_EQ(3, grad_fx.rows());
+  EXPECT_EQ(0, grad_fx.cols());
+}
+
+TEST(AgradAutoDiff, gradientBatchThrows) {
+  log1p_fun f;
+  MatrixXd x(2, 4);
+  x << 0.5, 0.2, -2.0, 0.1,
+       1.5, 1.5, 1.5, 1.5;
+  VectorXd fx;
+  MatrixXd grad_fx;
+  EXPECT_THROW(stan::math::gradient_batch(f, x, fx, grad_fx),
+               std::domain_error);
+  EXPECT_FALSE(stan::math::compact_tape_enabled());
+  EXPECT_EQ(0U, stan::math::ChainableStack::var_stack_.size());
+}
+
+//  Here, we compare the speed of evaluating the gradient at many
+//  points in a batch to that of one call to gradient() per point.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(AgradAutoDiff, gradient_batch_speed) {
+  compact_fun f;
+  const int K = 100000;
+  MatrixXd x(3, K);
+  for (int k = 0; k < K; ++k)
+    x.col(k) << 0.7 + 1e-6 * k, 1.9, -0.4;
+  VectorXd fx(K);
+  MatrixXd grad_fx(3, K);
+
+  TimeVar t1 = timeNow();
+  for (int k = 0; k < K; ++k) {
+    double fx_k;
+    VectorXd grad_k;
+    stan::math::gradient(f, VectorXd(x.col(k)), fx_k, grad_k);
+  }
+  TimeVar t2 = timeNow();
+  stan::math::gradient_batch(f, x, fx, grad_fx);
+  TimeVar t3 = timeNow();
+
+  std::cout << "gradient: " << duration(t2 - t1) << " us" << std::endl
+            << "gradient_batch: " << duration(t3 - t2) << " us"
+            << std::endl;
+}
+
+*/
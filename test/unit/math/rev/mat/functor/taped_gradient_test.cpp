@@ -0,0 +1,332 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/functor/compact_tape_functors.hpp>
+#include <stdexcept>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using Eigen::VectorXd;
+
+namespace {
+
+  // the branch taken depends on the argument
+  struct branch_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      T y = x(0) * x(1);
+      if (y > 1.0 && x(0) < x(1))
+        return y * y;
+      return 3.0 * x(1) - y;
+    }
+  };
+
+  // the sum starts from a constant promoted to a var
+  struct sum_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      T s = 0.5;
+      for (int i = 0; i < x.size(); ++i)
+        s += x(i) * x(i) * (i + 1);
+      return s;
+    }
+  };
+
+  // fdim is a constant zero unless x(0) > x(1)
+  struct fdim_fun {
+    template <typename T>
+    inline
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      return stan::math::fdim(x(0), x(1)) + x(0) * x(1);
+    }
+  };
+
+  struct compact_vector_fun {
+    template <typename T>
+    inline
+    Matrix<T, Dynamic, 1> operator()(const Matrix<T, Dynamic, 1>& x) const {
+      Matrix<T, Dynamic, 1> y(3);
+      y(0) = x(0) * x(1);
+      y(1) = stan::math::exp(x(1)) - x(0);
+      y(2) = x(1) > 0 ? x(0) / x(1) : x(0) * x(1);
+      return y;
+    }
+  };
+
+  // each output depends on a few neighboring inputs
+  struct coupled_vector_fun {
+    template <typename T>
+    inline
+    Matrix<T, Dynamic, 1> operator()(const Matrix<T, Dynamic, 1>& x) const {
+      int N = x.size();
+      Matrix<T, Dynamic, 1> y(N);
+      for (int i = 0; i < N; ++i) {
+        T u = x((i + 1) % N);
+        T v = x((i + 3) % N);
+        y(i) = x(i) * u + stan::math::sin(x(i))
+          - stan::math::exp(v) / (1.0 + x(i) * x(i));
+      }
+      return y;
+    }
+  };
+
+  template <typename F>
+  void expect_matches_gradient(stan::math::taped_gradient<F>& taped,
+                               const F& f, const VectorXd& x) {
+    double fx;
+    VectorXd grad_fx;
+    taped(x, fx, grad_fx);
+    double fx_ref;
+    VectorXd grad_fx_ref;
+    stan::math::gradient(f, x, fx_ref, grad_fx_ref);
+    EXPECT_FLOAT_EQ(fx_ref, fx);
+    ASSERT_EQ(grad_fx_ref.size(), grad_fx.size());
+    for (int i = 0; i < grad_fx.size(); ++i)
+      EXPECT_FLOAT_EQ(grad_fx_ref(i), grad_fx(i));
+  }
+
+}
+
+TEST(AgradAutoDiff, tapedGradientReplays) {
+  compact_fun f;
+  stan::math::taped_gradient<compact_fun> taped(f);
+  VectorXd x(3);
+  for (int n = 0; n < 5; ++n) {
+    x << 0.7 + 0.1 * n, 1.9 - 0.2 * n, -0.4 + 0.05 * n;
+    expect_matches_gradient(taped, f, x);
+  }
+  EXPECT_TRUE(taped.replayable());
+  EXPECT_EQ(1, taped.recordings());
+  EXPECT_FALSE(stan::math::compact_tape_enabled());
+  EXPECT_EQ(0U, stan::math::ChainableStack::var_stack_.size());
+}
+
+TEST(AgradAutoDiff, tapedGradientConstants) {
+  sum_fun f;
+  stan::math::taped_gradient<sum_fun> taped(f);
+  VectorXd x(4);
+  for (int n = 0; n < 3; ++n) {
+    x << 0.3 * n, -1.0, 2.0 + n, 0.5;
+    expect_matches_gradient(taped, f, x);
+  }
+  EXPECT_TRUE(taped.replayable());
+  EXPECT_EQ(1, taped.recordings());
+}
+
+TEST(AgradAutoDiff, tapedGradientRecordsAgainOnBranchChange) {
+  branch_fun f;
+  stan::math::taped_gradient<branch_fun> taped(f);
+  VectorXd x(2);
+  x << 1.5, 2.0;
+  expect_matches_gradient(taped, f, x);
+  x << 1.2, 2.5;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(1, taped.recordings());
+
+  // x(0) < x(1) no longer holds
+  x << 3.0, 2.0;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(2, taped.recordings());
+
+  // y > 1 no longer holds
+  x << 3.0, 0.1;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(3, taped.recordings());
+  x << 4.0, 0.2;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(3, taped.recordings());
+}
+
+TEST(AgradAutoDiff, tapedGradientRecordsAgainOnSignChange) {
+  sign_fun f;
+  stan::math::taped_gradient<sign_fun> taped(f);
+  VectorXd x(2);
+  x << 1.5, 2.0;
+  expect_matches_gradient(taped, f, x);
+  x << 0.5, 1.0;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(1, taped.recordings());
+
+  // fabs(x(0)) negates instead of returning its argument
+  x << -1.5, 2.0;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(2, taped.recordings());
+  x << -0.5, 1.0;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(2, taped.recordings());
+
+  // step(x(1)) is zero instead of one
+  x << -0.5, -1.0;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(3, taped.recordings());
+
+  // fabs(x(0)) is a constant zero
+  x << 0.0, -1.0;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(4, taped.recordings());
+  x << 2.0, -1.0;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(5, taped.recordings());
+  EXPECT_TRUE(taped.replayable());
+}
+
+TEST(AgradAutoDiff, tapedGradientRecordsAgainOnFdim) {
+  fdim_fun f;
+  stan::math::taped_gradient<fdim_fun> taped(f);
+  VectorXd x(2);
+  x << 1.0, 2.0;
+  expect_matches_gradient(taped, f, x);
+  x << 0.5, 2.5;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(1, taped.recordings());
+
+  // the positive difference is no longer a constant zero
+  x << 3.0, 2.0;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(2, taped.recordings());
+}
+
+TEST(AgradAutoDiff, tapedGradientFallsBack) {
+  lgamma_fun f;
+  stan::math::taped_gradient<lgamma_fun> taped(f);
+  VectorXd x(2);
+  x << 2.5, 1.5;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_FALSE(taped.replayable());
+  x << 3.5, 0.5;
+  expect_matches_gradient(taped, f, x);
+  EXPECT_EQ(1, taped.recordings());
+}
+
+TEST(AgradAutoDiff, tapedGradientThrows) {
+  log1p_fun f;
+  stan::math::taped_gradient<log1p_fun> taped(f);
+  VectorXd x(2);
+  x << 0.5, 1.5;
+  expect_matches_gradient(taped, f, x);
+
+  // the replay fails outside the domain and recording again throws
+  x << -2.0, 1.5;
+  double fx;
+  VectorXd grad_fx;
+  EXPECT_THROW(taped(x, fx, grad_fx), std::domain_error);
+  EXPECT_FALSE(stan::math::compact_tape_enabled());
+  EXPECT_EQ(0U, stan::math::ChainableStack::var_stack_.size());
+
+  x << 0.25, 1.5;
+  expect_matches_gradient(taped, f, x);
+}
+
+TEST(AgradAutoDiff, tapedJacobian) {
+  compact_vector_fun f;
+  stan::math::taped_jacobian<compact_vector_fun> taped(f);
+  VectorXd x(2);
+  for (int n = 0; n < 4; ++n) {
+    x << 1.5 - n, 0.7 - 0.4 * n;
+    VectorXd fx;
+    Matrix<double, Dynamic, Dynamic> J;
+    taped(x, fx, J);
+    VectorXd fx_ref;
+    Matrix<double, Dynamic, Dynamic> J_ref;
+    stan::math::jacobian(f, x, fx_ref, J_ref);
+    ASSERT_EQ(fx_ref.size(), fx.size());
+    ASSERT_EQ(J_ref.rows(), J.rows());
+    ASSERT_EQ(J_ref.cols(), J.cols());
+    for (int i = 0; i < fx.size(); ++i) {
+      EXPECT_FLOAT_EQ(fx_ref(i), fx(i));
+      for (int k = 0; k < x.size(); ++k)
+        EXPECT_FLOAT_EQ(J_ref(i, k), J(i, k));
+    }
+  }
+  // x(1) changes sign between the second and third arguments
+  EXPECT_TRUE(taped.replayable());
+  EXPECT_EQ(2, taped.recordings());
+}
+
+TEST(AgradAutoDiff, tapedJacobianBlocksOfRows) {
+  // 20 outputs are two blocks of eight rows and one of four
+  coupled_vector_fun f;
+  stan::math::taped_jacobian<coupled_vector_fun> taped(f);
+  VectorXd x(20);
+  for (int n = 0; n < 2; ++n) {
+    for (int i = 0; i < x.size(); ++i)
+      x(i) = std::cos(i + n);
+    VectorXd fx;
+    Matrix<double, Dynamic, Dynamic> J;
+    taped(x, fx, J);
+    VectorXd fx_ref;
+    Matrix<double, Dynamic, Dynamic> J_ref;
+    stan::math::jacobian(f, x, fx_ref, J_ref);
+    ASSERT_EQ(J_ref.rows(), J.rows());
+    ASSERT_EQ(J_ref.cols(), J.cols());
+    for (int i = 0; i < fx.size(); ++i) {
+      EXPECT_FLOAT_EQ(fx_ref(i), fx(i));
+      for (int k = 0; k < x.size(); ++k)
+        EXPECT_FLOAT_EQ(J_ref(i, k), J(i, k));
+    }
+  }
+  EXPECT_EQ(1, taped.recordings());
+}
+
+//  Here, we compare the speed of replaying a recording to that of
+//  building the expression graph on every call.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(AgradAutoDiff, taped_gradient_speed) {
+  compact_fun f;
+  stan::math::taped_gradient<compact_fun> taped(f);
+  const int R = 100000;
+  VectorXd x(3);
+  double fx;
+  VectorXd grad_fx;
+
+  TimeVar t1 = timeNow();
+  for (int r = 0; r < R; ++r) {
+    x << 0.7 + 1e-6 * r, 1.9, -0.4;
+    stan::math::gradient(f, x, fx, grad_fx);
+  }
+  TimeVar t2 = timeNow();
+  for (int r = 0; r < R; ++r) {
+    x << 0.7 + 1e-6 * r, 1.9, -0.4;
+    taped(x, fx, grad_fx);
+  }
+  TimeVar t3 = timeNow();
+
+  std::cout << "gradient: " << duration(t2 - t1) << " us" << std::endl
+            << "taped_gradient: " << duration(t3 - t2) << " us"
+            << std::endl;
+}
+
+TEST(AgradAutoDiff, taped_jacobian_speed) {
+  coupled_vector_fun f;
+  stan::math::taped_jacobian<coupled_vector_fun> taped(f);
+  const int R = 100;
+  VectorXd x(100);
+  VectorXd fx;
+  Matrix<double, Dynamic, Dynamic> J;
+
+  TimeVar t1 = timeNow();
+  for (int r = 0; r < R; ++r) {
+    x.setConstant(0.3 + 1e-6 * r);
+    stan::math::jacobian(f, x, fx, J);
+  }
+  TimeVar t2 = timeNow();
+  for (int r = 0; r < R; ++r) {
+    x.setConstant(0.3 + 1e-6 * r);
+    taped(x, fx, J);
+  }
+  TimeVar t3 = timeNow();
+
+  std::cout << "jacobian: " << duration(t2 - t1) << " us" << std::endl
+            << "taped_jacobian: " << duration(t3 - t2) << " us"
+            << std::endl;
+}
+
+*/
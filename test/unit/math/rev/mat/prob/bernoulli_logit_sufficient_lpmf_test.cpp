@@ -0,0 +1,97 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+using stan::math::var;
+using stan::math::bernoulli_logit_lpmf;
+using stan::math::bernoulli_logit_sufficient_lpmf;
+using stan::math::sufficient_stats;
+
+TEST(ProbDistributionsBernoulliLogitSufficient, matches_per_observation) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(1);
+  y.push_back(1);
+  y.push_back(0);
+  y.push_back(1);
+  std::vector<int> group;
+  group.push_back(1);
+  group.push_back(2);
+  group.push_back(2);
+  group.push_back(1);
+  group.push_back(2);
+  sufficient_stats s(y, group, 2);
+
+  std::vector<var> theta1;
+  theta1.push_back(1.3);
+  theta1.push_back(-0.6);
+  var lp1 = 0;
+  for (size_t n = 0; n < y.size(); ++n)
+    lp1 += bernoulli_logit_lpmf(y[n], theta1[group[n] - 1]);
+  std::vector<double> grad1;
+  lp1.grad(theta1, grad1);
+
+  std::vector<var> theta2;
+  theta2.push_back(1.3);
+  theta2.push_back(-0.6);
+  var lp2 = bernoulli_logit_sufficient_lpmf(s, theta2);
+  std::vector<double> grad2;
+  lp2.grad(theta2, grad2);
+
+  EXPECT_FLOAT_EQ(lp1.val(), lp2.val());
+  EXPECT_FLOAT_EQ(grad1[0], grad2[0]);
+  EXPECT_FLOAT_EQ(grad1[1], grad2[1]);
+}
+
+TEST(ProbDistributionsBernoulliLogitSufficient, propto) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(1);
+  y.push_back(1);
+  y.push_back(0);
+  y.push_back(1);
+  sufficient_stats s(y);
+
+  EXPECT_FLOAT_EQ(0.0, bernoulli_logit_sufficient_lpmf<true>(s, 1.3));
+  EXPECT_FLOAT_EQ(bernoulli_logit_lpmf<false>(y, 1.3),
+                  bernoulli_logit_sufficient_lpmf<false>(s, 1.3));
+
+  var theta1 = 1.3;
+  var theta2 = -0.6;
+  EXPECT_FLOAT_EQ(bernoulli_logit_lpmf<true>(y, theta1).val()
+                  - bernoulli_logit_lpmf<true>(y, theta2).val(),
+                  bernoulli_logit_sufficient_lpmf<true>(s, theta1).val()
+                  - bernoulli_logit_sufficient_lpmf<true>(s, theta2).val());
+}
+
+TEST(ProbDistributionsBernoulliLogitSufficient, exceptions) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(1);
+  y.push_back(1);
+  y.push_back(0);
+  y.push_back(1);
+  std::vector<int> group(y.size(), 1);
+  group[0] = 2;
+  sufficient_stats s(y, group, 2);
+
+  std::vector<double> theta(3, 1.3);
+  EXPECT_THROW(bernoulli_logit_sufficient_lpmf(s, theta),
+               std::invalid_argument);
+  theta.pop_back();
+  EXPECT_NO_THROW(bernoulli_logit_sufficient_lpmf(s, theta));
+  theta[1] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(bernoulli_logit_sufficient_lpmf(s, theta), std::domain_error);
+
+  y[3] = 2;
+  EXPECT_THROW(bernoulli_logit_sufficient_lpmf(
+                   sufficient_stats(y), 1.3),
+               std::domain_error);
+
+  std::vector<double> y_real(y.begin(), y.end());
+  y_real[3] = 0.5;
+  EXPECT_THROW(bernoulli_logit_sufficient_lpmf(
+                   sufficient_stats(y_real), 1.3),
+               std::domain_error);
+}
@@ -0,0 +1,124 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <vector>
+
+using stan::math::var;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+//  We check that the values of the new regression match those of one built
+//  from existing primitives.
+TEST(ProbDistributionsCategoricalLogitGLM, glm_matches_categorical_logit_doubles) {
+  std::vector<int> y(3);
+  y[0] = 1;
+  y[1] = 3;
+  y[2] = 2;
+  Matrix<double, Dynamic, Dynamic> x(3, 2);
+  x << -12, 46, -42,
+      24, 25, 27;
+  Matrix<double, Dynamic, Dynamic> beta(2, 3);
+  beta << 0.3, 2, -0.5,
+      -0.1, 0.2, 0.05;
+  Matrix<double, Dynamic, 1> alpha(3);
+  alpha << 0.3, -1, 2;
+  Matrix<double, Dynamic, Dynamic> theta = x * beta;
+  theta.rowwise() += alpha.transpose();
+
+  double lp = 0;
+  for (int i = 0; i < 3; ++i) {
+    Matrix<double, Dynamic, 1> theta_i = theta.row(i).transpose();
+    lp += stan::math::categorical_logit_lpmf(y[i], theta_i);
+  }
+  EXPECT_FLOAT_EQ(lp,
+                  stan::math::categorical_logit_glm_lpmf(y, x, beta, alpha));
+  EXPECT_FLOAT_EQ(0, (stan::math::categorical_logit_glm_lpmf<true>(
+                         y, x, beta, alpha)));
+  EXPECT_FLOAT_EQ(lp, (stan::math::categorical_logit_glm_lpmf<false>(
+                          y, x, beta, alpha)));
+
+  double lp_single = 0;
+  for (int i = 0; i < 3; ++i) {
+    Matrix<double, Dynamic, 1> theta_i = theta.row(i).transpose();
+    lp_single += stan::math::categorical_logit_lpmf(2, theta_i);
+  }
+  EXPECT_FLOAT_EQ(lp_single,
+                  stan::math::categorical_logit_glm_lpmf(2, x, beta, alpha));
+}
+
+//  We check that the gradients of the new regression match those of one built
+//  from existing primitives.
+TEST(ProbDistributionsCategoricalLogitGLM, glm_matches_categorical_logit_vars) {
+  std::vector<int> y(3);
+  y[0] = 1;
+  y[1] = 3;
+  y[2] = 2;
+  Matrix<double, Dynamic, Dynamic> x_dbl(3, 2);
+  x_dbl << -1.2, 4.6, -4.2,
+      2.4, 2.5, 2.7;
+  Matrix<double, Dynamic, Dynamic> beta_dbl(2, 3);
+  beta_dbl << 0.3, 2, -0.5,
+      -0.1, 0.2, 0.05;
+  Matrix<double, Dynamic, 1> alpha_dbl(3);
+  alpha_dbl << 0.3, -1, 2;
+
+  Matrix<var, Dynamic, Dynamic> x = x_dbl;
+  Matrix<var, Dynamic, Dynamic> beta = beta_dbl;
+  Matrix<var, Dynamic, 1> alpha = alpha_dbl;
+  Matrix<var, Dynamic, Dynamic> theta = x * beta;
+  var lp = 0;
+  for (int i = 0; i < 3; ++i) {
+    Matrix<var, Dynamic, 1> theta_i = theta.row(i).transpose() + alpha;
+    lp += stan::math::categorical_logit_lpmf(y[i], theta_i);
+  }
+  lp.grad();
+  double lp_val = lp.val();
+  Matrix<double, Dynamic, Dynamic> x_adj(3, 2);
+  for (int i = 0; i < x.size(); ++i)
+    x_adj(i) = x(i).adj();
+  Matrix<double, Dynamic, Dynamic> beta_adj(2, 3);
+  for (int i = 0; i < beta.size(); ++i)
+    beta_adj(i) = beta(i).adj();
+  Matrix<double, Dynamic, 1> alpha_adj(3);
+  for (int i = 0; i < alpha.size(); ++i)
+    alpha_adj(i) = alpha(i).adj();
+
+  stan::math::recover_memory();
+
+  Matrix<var, Dynamic, Dynamic> x2 = x_dbl;
+  Matrix<var, Dynamic, Dynamic> beta2 = beta_dbl;
+  Matrix<var, Dynamic, 1> alpha2 = alpha_dbl;
+  var lp2 = stan::math::categorical_logit_glm_lpmf(y, x2, beta2, alpha2);
+  lp2.grad();
+
+  EXPECT_FLOAT_EQ(lp_val, lp2.val());
+  for (int i = 0; i < x2.size(); ++i)
+    EXPECT_FLOAT_EQ(x_adj(i), x2(i).adj());
+  for (int i = 0; i < beta2.size(); ++i)
+    EXPECT_FLOAT_EQ(beta_adj(i), beta2(i).adj());
+  for (int i = 0; i < alpha2.size(); ++i)
+    EXPECT_FLOAT_EQ(alpha_adj(i), alpha2(i).adj());
+
+  stan::math::recover_memory();
+}
+
+TEST(ProbDistributionsCategoricalLogitGLM, glm_errors) {
+  std::vector<int> y(2, 1);
+  Matrix<double, Dynamic, Dynamic> x = Matrix<double, Dynamic, Dynamic>::Ones(2, 2);
+  Matrix<double, Dynamic, Dynamic> beta = Matrix<double, Dynamic, Dynamic>::Ones(2, 3);
+  Matrix<double, Dynamic, 1> alpha = Matrix<double, Dynamic, 1>::Ones(3);
+  EXPECT_NO_THROW(stan::math::categorical_logit_glm_lpmf(y, x, beta, alpha));
+
+  std::vector<int> y_bad(2, 4);
+  EXPECT_THROW(stan::math::categorical_logit_glm_lpmf(y_bad, x, beta, alpha),
+               std::domain_error);
+  std::vector<int> y_short(1, 1);
+  EXPECT_THROW(stan::math::categorical_logit_glm_lpmf(y_short, x, beta, alpha),
+               std::invalid_argument);
+  Matrix<double, Dynamic, 1> alpha_short = Matrix<double, Dynamic, 1>::Ones(2);
+  EXPECT_THROW(stan::math::categorical_logit_glm_lpmf(y, x, beta, alpha_short),
+               std::invalid_argument);
+  x(0, 1) = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(stan::math::categorical_logit_glm_lpmf(y, x, beta, alpha),
+               std::domain_error);
+}
@@ -0,0 +1,157 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using stan::math::var;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+namespace {
+
+  void categorical_logit_args(int N, int K, std::vector<int>& ns,
+                              Matrix<double, Dynamic, Dynamic>& beta) {
+    ns.resize(N);
+    beta.resize(N, K);
+    for (int i = 0; i < N; ++i) {
+      ns[i] = 1 + (i * 7 + i / 3) % K;
+      for (int k = 0; k < K; ++k)
+        beta(i, k) = std::sin(1.3 * i + 0.7 * k * k) * 3;
+    }
+  }
+
+}
+
+TEST(ProbDistributionsCategoricalLogit, vector_gradients) {
+  std::vector<int> ns;
+  Matrix<double, Dynamic, Dynamic> beta_mat;
+  categorical_logit_args(20, 4, ns, beta_mat);
+  Matrix<double, Dynamic, 1> beta_d = beta_mat.row(0).transpose();
+
+  Matrix<var, Dynamic, 1> beta = beta_d;
+  var lp = stan::math::categorical_logit_lpmf(ns, beta);
+  std::vector<var> x(beta.data(), beta.data() + beta.size());
+  std::vector<double> grad;
+  lp.grad(x, grad);
+  double lp_val = lp.val();
+  stan::math::recover_memory();
+
+  Matrix<var, Dynamic, 1> beta_ref = beta_d;
+  var lp_ref = 0;
+  for (size_t i = 0; i < ns.size(); ++i)
+    lp_ref += stan::math::categorical_logit_lpmf(ns[i], beta_ref);
+  std::vector<var> x_ref(beta_ref.data(), beta_ref.data() + beta_ref.size());
+  std::vector<double> grad_ref;
+  lp_ref.grad(x_ref, grad_ref);
+  double lp_ref_val = lp_ref.val();
+  stan::math::recover_memory();
+
+  EXPECT_FLOAT_EQ(lp_ref_val, lp_val);
+  for (size_t k = 0; k < grad.size(); ++k)
+    EXPECT_FLOAT_EQ(grad_ref[k], grad[k]);
+}
+
+TEST(ProbDistributionsCategoricalLogit, matrix_gradients) {
+  std::vector<int> ns;
+  Matrix<double, Dynamic, Dynamic> beta_d;
+  categorical_logit_args(20, 4, ns, beta_d);
+
+  Matrix<var, Dynamic, Dynamic> beta = beta_d;
+  var lp = stan::math::categorical_logit_lpmf(ns, beta);
+  std::vector<var> x(beta.data(), beta.data() + beta.size());
+  std::vector<double> grad;
+  lp.grad(x, grad);
+  double lp_val = lp.val();
+  stan::math::recover_memory();
+
+  Matrix<var, Dynamic, Dynamic> beta_ref = beta_d;
+  var lp_ref = 0;
+  for (size_t i = 0; i < ns.size(); ++i) {
+    Matrix<var, Dynamic, 1> row = beta_ref.row(i).transpose();
+    lp_ref += stan::math::categorical_logit_lpmf(ns[i], row);
+  }
+  std::vector<var> x_ref(beta_ref.data(), beta_ref.data() + beta_ref.size());
+  std::vector<double> grad_ref;
+  lp_ref.grad(x_ref, grad_ref);
+  double lp_ref_val = lp_ref.val();
+  stan::math::recover_memory();
+
+  EXPECT_FLOAT_EQ(lp_ref_val, lp_val);
+  for (size_t k = 0; k < grad.size(); ++k)
+    EXPECT_FLOAT_EQ(grad_ref[k], grad[k]);
+
+  EXPECT_FLOAT_EQ(lp_val,
+                  stan::math::categorical_logit_lpmf(ns, beta_d));
+  EXPECT_FLOAT_EQ(0.0,
+                  stan::math::categorical_logit_lpmf<true>(ns, beta_d));
+}
+
+TEST(ProbDistributionsCategoricalLogit, matrix_large_logits) {
+  std::vector<int> ns(2, 2);
+  Matrix<double, Dynamic, Dynamic> beta(2, 3);
+  beta << 1000, 1001, 999,
+    -1000, -999, -1001;
+  double lp = stan::math::categorical_logit_lpmf(ns, beta);
+  Matrix<double, Dynamic, 1> row(3);
+  row << 1, 2, 0;
+  EXPECT_FLOAT_EQ(2 * stan::math::categorical_logit_lpmf(2, row), lp);
+}
+
+TEST(ProbDistributionsCategoricalLogit, matrix_exceptions) {
+  std::vector<int> ns(3, 1);
+  Matrix<double, Dynamic, Dynamic> beta(2, 3);
+  beta.setZero();
+  EXPECT_THROW(stan::math::categorical_logit_lpmf(ns, beta),
+               std::invalid_argument);
+  ns.resize(2);
+  ns[1] = 4;
+  EXPECT_THROW(stan::math::categorical_logit_lpmf(ns, beta),
+               std::domain_error);
+  ns[1] = 3;
+  beta(1, 1) = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(stan::math::categorical_logit_lpmf(ns, beta),
+               std::domain_error);
+}
+
+//  Here, we compare the speed of the matrix categorical logit density to
+//  that of one call per observation.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(ProbDistributionsCategoricalLogit, categorical_logit_speed) {
+  const int N = 100000;
+  const int K = 5;
+  std::vector<int> ns;
+  Matrix<double, Dynamic, Dynamic> beta_d;
+  categorical_logit_args(N, K, ns, beta_d);
+
+  Matrix<var, Dynamic, Dynamic> beta = beta_d;
+  TimeVar t1 = timeNow();
+  var lp_ref = 0;
+  for (int i = 0; i < N; ++i) {
+    Matrix<var, Dynamic, 1> row = beta.row(i).transpose();
+    lp_ref += stan::math::categorical_logit_lpmf(ns[i], row);
+  }
+  lp_ref.grad();
+  TimeVar t2 = timeNow();
+  stan::math::recover_memory();
+  beta = beta_d;
+  TimeVar t3 = timeNow();
+  var lp = stan::math::categorical_logit_lpmf(ns, beta);
+  lp.grad();
+  TimeVar t4 = timeNow();
+  stan::math::recover_memory();
+
+  std::cout << "per observation: " << duration(t2 - t1) << " us"
+            << std::endl
+            << "categorical_logit_lpmf: " << duration(t4 - t3) << " us"
+            << std::endl;
+}
+
+*/
@@ -0,0 +1,123 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/prob/hmm_marginal_args.hpp>
+#include <cmath>
+#include <vector>
+
+using stan::math::var;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+namespace {
+
+  // the forward algorithm built from existing primitives
+  template <typename T_omega, typename T_Gamma, typename T_rho>
+  typename stan::return_type<T_omega, T_Gamma, T_rho>::type
+  hmm_marginal_ref(const Matrix<T_omega, Dynamic, Dynamic>& log_omegas,
+                   const Matrix<T_Gamma, Dynamic, Dynamic>& Gamma,
+                   const Matrix<T_rho, Dynamic, 1>& rho) {
+    typedef typename stan::return_type<T_omega, T_Gamma, T_rho>::type T;
+    int K = log_omegas.rows();
+    Matrix<T, Dynamic, 1> log_alpha(K);
+    for (int k = 0; k < K; ++k)
+      log_alpha(k) = stan::math::log(rho(k)) + log_omegas(k, 0);
+    for (int t = 1; t < log_omegas.cols(); ++t) {
+      Matrix<T, Dynamic, 1> next(K);
+      for (int j = 0; j < K; ++j) {
+        Matrix<T, Dynamic, 1> terms(K);
+        for (int i = 0; i < K; ++i)
+          terms(i) = log_alpha(i) + stan::math::log(Gamma(i, j));
+        next(j) = stan::math::log_sum_exp(terms) + log_omegas(j, t);
+      }
+      log_alpha = next;
+    }
+    return stan::math::log_sum_exp(log_alpha);
+  }
+
+  template <typename T_omega, typename T_Gamma, typename T_rho>
+  void expect_matches_ref(int K, int T) {
+    Matrix<double, Dynamic, Dynamic> log_omegas_d, Gamma_d;
+    Matrix<double, Dynamic, 1> rho_d;
+    hmm_args(K, T, log_omegas_d, Gamma_d, rho_d);
+
+    std::vector<double> grads[2];
+    double vals[2];
+    for (int r = 0; r < 2; ++r) {
+      Matrix<T_omega, Dynamic, Dynamic> log_omegas = log_omegas_d;
+      Matrix<T_Gamma, Dynamic, Dynamic> Gamma = Gamma_d;
+      Matrix<T_rho, Dynamic, 1> rho = rho_d;
+      std::vector<var> xs;
+      if (stan::is_var<T_omega>::value) {
+        for (int i = 0; i < log_omegas.size(); ++i)
+          xs.push_back(log_omegas(i));
+      }
+      if (stan::is_var<T_Gamma>::value) {
+        for (int i = 0; i < Gamma.size(); ++i)
+          xs.push_back(Gamma(i));
+      }
+      if (stan::is_var<T_rho>::value) {
+        for (int i = 0; i < rho.size(); ++i)
+          xs.push_back(rho(i));
+      }
+      var lp = r == 0 ? stan::math::hmm_marginal(log_omegas, Gamma, rho)
+        : hmm_marginal_ref(log_omegas, Gamma, rho);
+      vals[r] = lp.val();
+      lp.grad(xs, grads[r]);
+      stan::math::recover_memory();
+    }
+    EXPECT_FLOAT_EQ(vals[1], vals[0]);
+    ASSERT_EQ(grads[1].size(), grads[0].size());
+    for (size_t i = 0; i < grads[0].size(); ++i)
+      EXPECT_NEAR(grads[1][i], grads[0][i], 1e-10);
+  }
+
+}
+
+TEST(ProbDistributionsHmmMarginal, matches_forward_algorithm_vars) {
+  expect_matches_ref<var, var, var>(3, 6);
+  expect_matches_ref<var, double, double>(4, 5);
+  expect_matches_ref<double, var, double>(2, 7);
+  expect_matches_ref<double, double, var>(3, 3);
+  expect_matches_ref<var, var, var>(5, 1);
+}
+
+//  Here, we compare the speed of the HMM marginal density to that of the
+//  forward algorithm built from existing primitives.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(ProbDistributionsHmmMarginal, hmm_marginal_speed) {
+  const int K = 8;
+  const int T = 100000;
+  Matrix<double, Dynamic, Dynamic> log_omegas_d, Gamma_d;
+  Matrix<double, Dynamic, 1> rho_d;
+  hmm_args(K, T, log_omegas_d, Gamma_d, rho_d);
+  Matrix<var, Dynamic, Dynamic> log_omegas = log_omegas_d;
+  Matrix<var, Dynamic, Dynamic> Gamma = Gamma_d;
+  Matrix<var, Dynamic, 1> rho = rho_d;
+
+  TimeVar t1 = timeNow();
+  var lp_ref = hmm_marginal_ref(log_omegas, Gamma, rho);
+  lp_ref.grad();
+  TimeVar t2 = timeNow();
+  stan::math::recover_memory();
+  log_omegas = log_omegas_d;
+  Gamma = Gamma_d;
+  rho = rho_d;
+  TimeVar t3 = timeNow();
+  var lp = stan::math::hmm_marginal(log_omegas, Gamma, rho);
+  lp.grad();
+  TimeVar t4 = timeNow();
+
+  std::cout << "forward algorithm: " << duration(t2 - t1) << " us"
+            << std::endl
+            << "hmm_marginal: " << duration(t4 - t3) << " us"
+            << std::endl;
+}
+
+*/
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <test/unit/math/rev/mat/prob/expect_eq_diffs.hpp>
 #include <test/unit/math/rev/mat/util.hpp>
+#include <stan/math/prim/mat/functor/finite_diff_gradient.hpp>
+#include <cmath>
 #include <string>
 
 template <typename T_y, typename T_dof, typename T_scale>
@@ -130,3 +132,60 @@ TEST(InvWishart, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::inv_wishart_log<true>(W, nu,
                                                                to_var(S)));
 }
+
+namespace {
+
+  Eigen::MatrixXd spd_matrix(int K, double seed) {
+    Eigen::MatrixXd A(K, K);
+    for (int j = 0; j < K; ++j)
+      for (int i = 0; i < K; ++i)
+        A(i, j) = std::sin(seed + 0.7 * i + 0.31 * j * j + i * j);
+    return A * A.transpose() + K * Eigen::MatrixXd::Identity(K, K);
+  }
+
+  // the inverse Wishart density of symmetric W and S given by their
+  // lower triangles, with nu in between
+  struct inv_wishart_fun {
+    int K_;
+    explicit inv_wishart_fun(int K) : K_(K) { }
+
+    template <typename T>
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      Matrix<T, Dynamic, Dynamic> W(K_, K_), S(K_, K_);
+      int pos = 0;
+      for (int j = 0; j < K_; ++j)
+        for (int i = j; i < K_; ++i)
+          W(i, j) = W(j, i) = x(pos++);
+      T nu = x(pos++);
+      for (int j = 0; j < K_; ++j)
+        for (int i = j; i < K_; ++i)
+          S(i, j) = S(j, i) = x(pos++);
+      return stan::math::inv_wishart_log(W, nu, S);
+    }
+  };
+
+}
+
+TEST(InvWishart, gradients) {
+  const int K = 4;
+  Eigen::MatrixXd W = spd_matrix(K, 1.0);
+  Eigen::MatrixXd S = spd_matrix(K, 2.0);
+  Matrix<double, Dynamic, 1> x(K * (K + 1) + 1);
+  int pos = 0;
+  for (int j = 0; j < K; ++j)
+    for (int i = j; i < K; ++i)
+      x(pos++) = W(i, j);
+  x(pos++) = K + 1.5;
+  for (int j = 0; j < K; ++j)
+    for (int i = j; i < K; ++i)
+      x(pos++) = S(i, j);
+
+  inv_wishart_fun f(K);
+  double fx, fx_fd;
+  Matrix<double, Dynamic, 1> grad, grad_fd;
+  stan::math::gradient(f, x, fx, grad);
+  stan::math::finite_diff_gradient(f, x, fx_fd, grad_fd);
+  EXPECT_FLOAT_EQ(fx_fd, fx);
+  for (int n = 0; n < x.size(); ++n)
+    EXPECT_NEAR(grad_fd(n), grad(n), 1e-6 * (1 + std::fabs(grad(n))));
+}
@@ -109,3 +109,17 @@ TEST(ProbDistributionsLkjCorrCholesky, gradients) {
   EXPECT_FLOAT_EQ(fx, fx_ad);
 }
 
+
+TEST(ProbDistributionsLkjCorrCholesky, gradient_eta_one) {
+  // the normalizing constant has a closed form at eta = 1, but its
+  // derivative in eta does not vanish there
+  stan::math::lkj_corr_cholesky_cd f(4);
+  Eigen::Matrix<double, Eigen::Dynamic, 1> x(1);
+  x(0) = 0.0;
+  Eigen::Matrix<double, Eigen::Dynamic, 1> grad_fd, grad;
+  double fx_fd, fx;
+  stan::math::finite_diff_gradient(f, x, fx_fd, grad_fd);
+  stan::math::gradient(f, x, fx, grad);
+  EXPECT_FLOAT_EQ(fx_fd, fx);
+  EXPECT_NEAR(grad_fd(0), grad(0), 1e-6);
+}
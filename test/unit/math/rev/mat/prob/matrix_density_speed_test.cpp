@@ -0,0 +1,165 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using stan::math::var;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+//  Here, we compare the speed of the gradients of the Wishart, inverse
+//  Wishart and LKJ Cholesky densities to those of the same densities built
+//  from existing primitives, at K = 50 (averaged over 10 runs) and K = 200.
+
+namespace {
+
+  typedef std::chrono::high_resolution_clock clock_t;
+
+  double elapsed_ms(const clock_t::time_point& start) {
+    return std::chrono::duration<double, std::milli>(clock_t::now() - start)
+      .count();
+  }
+
+  Eigen::MatrixXd spd_matrix(int K, double seed) {
+    Eigen::MatrixXd A(K, K);
+    for (int j = 0; j < K; ++j)
+      for (int i = 0; i < K; ++i)
+        A(i, j) = std::sin(seed + 0.7 * i + 0.31 * j * j + i * j);
+    return A * A.transpose() + K * Eigen::MatrixXd::Identity(K, K);
+  }
+
+  var wishart_ref(const Matrix<var, Dynamic, Dynamic>& W, const var& nu,
+                  const Matrix<var, Dynamic, Dynamic>& S) {
+    using stan::math::log_determinant;
+    int k = W.rows();
+    return nu * k * stan::math::NEG_LOG_TWO_OVER_TWO
+      - stan::math::lmgamma(k, 0.5 * nu) - 0.5 * nu * log_determinant(S)
+      - 0.5 * stan::math::trace(stan::math::mdivide_left(S, W))
+      + 0.5 * (nu - k - 1.0) * log_determinant(W);
+  }
+
+  var inv_wishart_ref(const Matrix<var, Dynamic, Dynamic>& W, const var& nu,
+                      const Matrix<var, Dynamic, Dynamic>& S) {
+    using stan::math::log_determinant;
+    int k = W.rows();
+    return -stan::math::lmgamma(k, 0.5 * nu) + 0.5 * nu * log_determinant(S)
+      - 0.5 * (nu + k + 1.0) * log_determinant(W)
+      - 0.5 * stan::math::trace(stan::math::mdivide_left(W, S))
+      + nu * k * stan::math::NEG_LOG_TWO_OVER_TWO;
+  }
+
+  var lkj_corr_cholesky_ref(const Matrix<var, Dynamic, Dynamic>& L,
+                            const var& eta) {
+    stan::math::check_lower_triangular("lkj_corr_cholesky_ref", "L", L);
+    int K = L.rows();
+    var lp = stan::math::do_lkj_constant(eta, K);
+    for (int k = 1; k < K; ++k)
+      lp += (K - k - 1 + 2 * eta - 2) * log(L(k, k));
+    return lp;
+  }
+
+  // Returns the time in ms of the last of R evaluations of the gradient,
+  // after a first one that warms up the autodiff arena, and the value and
+  // the derivative with respect to the second argument.
+  template <class F>
+  double time_gradient(const F& f, const Eigen::MatrixXd& A_d, double b_d,
+                       const Eigen::MatrixXd& C_d, int R, double& lp_val,
+                       double& b_adj) {
+    double t = 0;
+    for (int r = 0; r <= R; ++r) {
+      Matrix<var, Dynamic, Dynamic> A = stan::math::to_var(A_d);
+      Matrix<var, Dynamic, Dynamic> C = stan::math::to_var(C_d);
+      var b = b_d;
+      clock_t::time_point start = clock_t::now();
+      var lp = f(A, b, C);
+      lp.grad();
+      if (r > 0)
+        t += elapsed_ms(start);
+      lp_val = lp.val();
+      b_adj = b.adj();
+      stan::math::recover_memory();
+    }
+    return t / R;
+  }
+
+  template <class F_ref, class F>
+  void compare_speed(const char* name, const F_ref& f_ref, const F& f,
+                     const Eigen::MatrixXd& A_d, double b_d,
+                     const Eigen::MatrixXd& C_d) {
+    const int R = A_d.rows() > 50 ? 1 : 10;
+    double lp_ref, b_adj_ref, lp, b_adj;
+    double t_ref = time_gradient(f_ref, A_d, b_d, C_d, R, lp_ref, b_adj_ref);
+    double t = time_gradient(f, A_d, b_d, C_d, R, lp, b_adj);
+    EXPECT_NEAR(lp_ref, lp, 1e-8 * std::fabs(lp_ref));
+    EXPECT_NEAR(b_adj_ref, b_adj, 1e-8 * std::fabs(b_adj_ref));
+    std::cout << name << ", K = " << A_d.rows() << ": primitives "
+              << t_ref << " ms, density " << t << " ms" << std::endl;
+  }
+
+  struct wishart_ref_fun {
+    var operator()(const Matrix<var, Dynamic, Dynamic>& W, const var& nu,
+                   const Matrix<var, Dynamic, Dynamic>& S) const {
+      return wishart_ref(W, nu, S);
+    }
+  };
+
+  struct wishart_fun {
+    var operator()(const Matrix<var, Dynamic, Dynamic>& W, const var& nu,
+                   const Matrix<var, Dynamic, Dynamic>& S) const {
+      return stan::math::wishart_lpdf(W, nu, S);
+    }
+  };
+
+  struct inv_wishart_ref_fun {
+    var operator()(const Matrix<var, Dynamic, Dynamic>& W, const var& nu,
+                   const Matrix<var, Dynamic, Dynamic>& S) const {
+      return inv_wishart_ref(W, nu, S);
+    }
+  };
+
+  struct inv_wishart_fun {
+    var operator()(const Matrix<var, Dynamic, Dynamic>& W, const var& nu,
+                   const Matrix<var, Dynamic, Dynamic>& S) const {
+      return stan::math::inv_wishart_lpdf(W, nu, S);
+    }
+  };
+
+  // the third argument is not used
+  struct lkj_corr_cholesky_ref_fun {
+    var operator()(const Matrix<var, Dynamic, Dynamic>& L, const var& eta,
+                   const Matrix<var, Dynamic, Dynamic>& unused) const {
+      return lkj_corr_cholesky_ref(L, eta);
+    }
+  };
+
+  struct lkj_corr_cholesky_fun {
+    var operator()(const Matrix<var, Dynamic, Dynamic>& L, const var& eta,
+                   const Matrix<var, Dynamic, Dynamic>& unused) const {
+      return stan::math::lkj_corr_cholesky_lpdf(L, eta);
+    }
+  };
+
+}
+
+TEST(ProbDistributionsMatrixVariate, wishart_speed) {
+  for (int K = 50; K <= 200; K += 150)
+    compare_speed("wishart", wishart_ref_fun(), wishart_fun(),
+                  spd_matrix(K, 1.0), K + 2.5, spd_matrix(K, 2.0));
+}
+
+TEST(ProbDistributionsMatrixVariate, inv_wishart_speed) {
+  for (int K = 50; K <= 200; K += 150)
+    compare_speed("inv_wishart", inv_wishart_ref_fun(), inv_wishart_fun(),
+                  spd_matrix(K, 1.0), K + 2.5, spd_matrix(K, 2.0));
+}
+
+TEST(ProbDistributionsMatrixVariate, lkj_corr_cholesky_speed) {
+  for (int K = 50; K <= 200; K += 150) {
+    Eigen::MatrixXd L = spd_matrix(K, 1.0).llt().matrixL();
+    for (int i = 0; i < K; ++i)
+      L.row(i) /= L.row(i).norm();
+    compare_speed("lkj_corr_cholesky", lkj_corr_cholesky_ref_fun(),
+                  lkj_corr_cholesky_fun(), L, 1.5, Eigen::MatrixXd(0, 0));
+  }
+}
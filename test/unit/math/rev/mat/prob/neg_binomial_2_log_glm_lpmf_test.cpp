@@ -103,6 +103,85 @@ TEST(ProbDistributionsNegBinomial2LogGLM, glm_matches_neg_binomial_2_log_vars) {
   }
 }
 
+//  We check that the regression swept in several tiles, on one or more
+//  threads, matches one built from existing primitives, and that it gives
+//  the same result for a given number of threads.
+TEST(ProbDistributionsNegBinomial2LogGLM, glm_matches_neg_binomial_2_log_threads) {
+  const int N = 40000;
+  const int M = 3;
+  srand(1);
+  Matrix<int, Dynamic, 1> n(N, 1);
+  Matrix<double, Dynamic, 1> phi_dbl(N, 1);
+  for (int i = 0; i < N; i++) {
+    n[i] = rand() % 10;
+    phi_dbl[i] = 0.5 + (rand() % 100) / 20.0;
+  }
+  Matrix<double, Dynamic, Dynamic> x_dbl
+    = Matrix<double, Dynamic, Dynamic>::Random(N, M);
+  Matrix<double, Dynamic, 1> beta_dbl(M, 1);
+  beta_dbl << 0.3, -0.2, 0.5;
+  double alpha_dbl = 0.3;
+
+  Matrix<var, Dynamic, Dynamic> x = x_dbl;
+  Matrix<var, Dynamic, 1> beta = beta_dbl;
+  var alpha = alpha_dbl;
+  Matrix<var, Dynamic, 1> phi = phi_dbl;
+  Matrix<var, Dynamic, 1> theta = stan::math::multiply(x, beta);
+  for (int i = 0; i < N; i++)
+    theta[i] += alpha;
+  var lp = stan::math::neg_binomial_2_log_lpmf(n, theta, phi);
+  lp.grad();
+  double lp_val = lp.val();
+  Matrix<double, Dynamic, 1> beta_adj(M, 1);
+  for (int m = 0; m < M; m++)
+    beta_adj[m] = beta[m].adj();
+  double alpha_adj = alpha.adj();
+  Matrix<double, Dynamic, Dynamic> x_adj(N, M);
+  for (int i = 0; i < x.size(); i++)
+    x_adj(i) = x(i).adj();
+  Matrix<double, Dynamic, 1> phi_adj(N, 1);
+  for (int i = 0; i < N; i++)
+    phi_adj[i] = phi[i].adj();
+  stan::math::recover_memory();
+
+  double lp_threads = 0;
+  Matrix<double, Dynamic, 1> beta_adj_threads(M, 1);
+  for (int num_threads = 1; num_threads <= 4; num_threads++) {
+    Matrix<var, Dynamic, Dynamic> x2 = x_dbl;
+    Matrix<var, Dynamic, 1> beta2 = beta_dbl;
+    var alpha2 = alpha_dbl;
+    Matrix<var, Dynamic, 1> phi2 = phi_dbl;
+    var lp2 = stan::math::neg_binomial_2_log_glm_lpmf(n, x2, beta2, alpha2, phi2,
+                                                      num_threads);
+    lp2.grad();
+
+    EXPECT_FLOAT_EQ(lp_val, lp2.val());
+    for (int m = 0; m < M; m++)
+      EXPECT_FLOAT_EQ(beta_adj[m], beta2[m].adj());
+    EXPECT_FLOAT_EQ(alpha_adj, alpha2.adj());
+    for (int i = 0; i < x2.size(); i++)
+      EXPECT_NEAR(x_adj(i), x2(i).adj(), 1e-8);
+    for (int i = 0; i < N; i++)
+      EXPECT_NEAR(phi_adj[i], phi2[i].adj(), 1e-8);
+    if (num_threads == 3) {
+      lp_threads = lp2.val();
+      for (int m = 0; m < M; m++)
+        beta_adj_threads[m] = beta2[m].adj();
+    }
+    stan::math::recover_memory();
+  }
+
+  Matrix<var, Dynamic, 1> beta3 = beta_dbl;
+  var alpha3 = alpha_dbl;
+  var lp3 = stan::math::neg_binomial_2_log_glm_lpmf(n, x_dbl, beta3, alpha3,
+                                                    phi_dbl, 3);
+  lp3.grad();
+  EXPECT_EQ(lp_threads, lp3.val());
+  for (int m = 0; m < M; m++)
+    EXPECT_EQ(beta_adj_threads[m], beta3[m].adj());
+  stan::math::recover_memory();
+}
+
 //  Here, we compare the speed of the new regression to that of one built from
 //  existing primitives.
 
@@ -0,0 +1,80 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+using stan::math::var;
+using stan::math::sufficient_stats;
+using stan::math::normal_lpdf;
+using stan::math::normal_sufficient_lpdf;
+
+TEST(ProbDistributionsNormalSufficient, stats_match_per_observation) {
+  std::vector<double> y;
+  y.push_back(-1.2);
+  y.push_back(0.4);
+  y.push_back(2.5);
+  y.push_back(0.1);
+  y.push_back(1.7);
+  std::vector<int> group;
+  group.push_back(1);
+  group.push_back(2);
+  group.push_back(2);
+  group.push_back(1);
+  group.push_back(2);
+  sufficient_stats s(y, group, 2);
+
+  std::vector<var> theta1;
+  theta1.push_back(0.3);
+  theta1.push_back(1.1);
+  theta1.push_back(0.8);
+  theta1.push_back(1.9);
+  var lp1 = 0;
+  for (size_t n = 0; n < y.size(); ++n)
+    lp1 += normal_lpdf(y[n], theta1[group[n] - 1], theta1[group[n] + 1]);
+  std::vector<double> grad1;
+  lp1.grad(theta1, grad1);
+
+  std::vector<var> theta2;
+  theta2.push_back(0.3);
+  theta2.push_back(1.1);
+  theta2.push_back(0.8);
+  theta2.push_back(1.9);
+  std::vector<var> mu(theta2.begin(), theta2.begin() + 2);
+  std::vector<var> sigma(theta2.begin() + 2, theta2.end());
+  var lp2 = normal_sufficient_lpdf(s, mu, sigma);
+  std::vector<double> grad2;
+  lp2.grad(theta2, grad2);
+
+  EXPECT_FLOAT_EQ(lp1.val(), lp2.val());
+  for (size_t i = 0; i < grad1.size(); ++i)
+    EXPECT_FLOAT_EQ(grad1[i], grad2[i]);
+}
+
+TEST(ProbDistributionsNormalSufficient, stats_propto) {
+  std::vector<double> y;
+  y.push_back(-1.2);
+  y.push_back(0.4);
+  y.push_back(2.5);
+  sufficient_stats s(y);
+
+  EXPECT_FLOAT_EQ(0.0, normal_sufficient_lpdf<true>(s, 0.3, 1.5));
+  EXPECT_FLOAT_EQ(normal_lpdf(y, 0.3, 1.5),
+                  normal_sufficient_lpdf(s, 0.3, 1.5));
+
+  var mu = 0.3;
+  var sigma = 1.5;
+  EXPECT_FLOAT_EQ(normal_lpdf<true>(y, mu, sigma).val(),
+                  normal_sufficient_lpdf<true>(s, mu, sigma).val());
+}
+
+TEST(ProbDistributionsNormalSufficient, stats_exceptions) {
+  std::vector<double> y(3, 1.0);
+  std::vector<int> group(3, 1);
+  sufficient_stats s(y, group, 2);
+
+  EXPECT_THROW(normal_sufficient_lpdf(s, 0.0, 1.0), std::domain_error);
+  EXPECT_THROW(normal_sufficient_lpdf(sufficient_stats(y), 0.0, -1.0),
+               std::domain_error);
+  std::vector<double> mu(2, 0.0);
+  EXPECT_THROW(normal_sufficient_lpdf(sufficient_stats(y), mu, 1.0),
+               std::invalid_argument);
+}
@@ -0,0 +1,108 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using stan::math::var;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+namespace {
+
+  void ordered_logistic_args(int N, std::vector<int>& y,
+                         Matrix<double, Dynamic, 1>& lambda,
+                         Matrix<double, Dynamic, 1>& c) {
+    c.resize(4);
+    c << -1.5, -0.2, 0.4, 2.0;
+    y.resize(N);
+    lambda.resize(N);
+    for (int i = 0; i < N; ++i) {
+      y[i] = 1 + (i * 3 + i / 2) % 5;
+      lambda(i) = 2 * std::sin(0.9 * i);
+    }
+  }
+
+}
+
+TEST(ProbDistributionsOrderedLogistic, vector_gradients) {
+  std::vector<int> y;
+  Matrix<double, Dynamic, 1> lambda_d, c_d;
+  ordered_logistic_args(30, y, lambda_d, c_d);
+
+  Matrix<var, Dynamic, 1> lambda = lambda_d;
+  Matrix<var, Dynamic, 1> c = c_d;
+  var lp = stan::math::ordered_logistic_lpmf(y, lambda, c);
+  std::vector<var> x(lambda.data(), lambda.data() + lambda.size());
+  x.insert(x.end(), c.data(), c.data() + c.size());
+  std::vector<double> grad;
+  lp.grad(x, grad);
+  double lp_val = lp.val();
+  stan::math::recover_memory();
+
+  Matrix<var, Dynamic, 1> lambda_ref = lambda_d;
+  Matrix<var, Dynamic, 1> c_ref = c_d;
+  var lp_ref = 0;
+  for (size_t i = 0; i < y.size(); ++i)
+    lp_ref += stan::math::ordered_logistic_lpmf(y[i], lambda_ref(i), c_ref);
+  std::vector<var> x_ref(lambda_ref.data(),
+                         lambda_ref.data() + lambda_ref.size());
+  x_ref.insert(x_ref.end(), c_ref.data(), c_ref.data() + c_ref.size());
+  std::vector<double> grad_ref;
+  lp_ref.grad(x_ref, grad_ref);
+  double lp_ref_val = lp_ref.val();
+  stan::math::recover_memory();
+
+  EXPECT_FLOAT_EQ(lp_ref_val, lp_val);
+  ASSERT_EQ(grad_ref.size(), grad.size());
+  for (size_t k = 0; k < grad.size(); ++k)
+    EXPECT_NEAR(grad_ref[k], grad[k], 1e-8);
+
+  lambda = lambda_d;
+  c = c_d;
+  EXPECT_FLOAT_EQ(lp_val,
+                  stan::math::ordered_logistic_lpmf(y, lambda_d, c).val());
+  EXPECT_FLOAT_EQ(lp_val,
+                  stan::math::ordered_logistic_lpmf(y, lambda, c_d).val());
+  stan::math::recover_memory();
+}
+
+//  Here, we compare the speed of the vectorized ordered logistic density to
+//  that of one call per observation.
+/*
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+#define duration(a) \
+  std::chrono::duration_cast<std::chrono::microseconds>(a).count()
+#define timeNow() std::chrono::high_resolution_clock::now()
+
+TEST(ProbDistributionsOrderedLogistic, ordered_logistic_speed) {
+  const int N = 100000;
+  std::vector<int> y;
+  Matrix<double, Dynamic, 1> lambda_d, c_d;
+  ordered_logistic_args(N, y, lambda_d, c_d);
+
+  Matrix<var, Dynamic, 1> lambda = lambda_d;
+  Matrix<var, Dynamic, 1> c = c_d;
+  TimeVar t1 = timeNow();
+  var lp_ref = 0;
+  for (int i = 0; i < N; ++i)
+    lp_ref += stan::math::ordered_logistic_lpmf(y[i], lambda(i), c);
+  lp_ref.grad();
+  TimeVar t2 = timeNow();
+  stan::math::recover_memory();
+  lambda = lambda_d;
+  c = c_d;
+  TimeVar t3 = timeNow();
+  var lp = stan::math::ordered_logistic_lpmf(y, lambda, c);
+  lp.grad();
+  TimeVar t4 = timeNow();
+  stan::math::recover_memory();
+
+  std::cout << "per observation: " << duration(t2 - t1) << " us"
+            << std::endl
+            << "ordered_logistic_lpmf: " << duration(t4 - t3) << " us"
+            << std::endl;
+}
+
+*/
@@ -0,0 +1,94 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+using stan::math::var;
+using stan::math::poisson_log_lpmf;
+using stan::math::poisson_log_sufficient_lpmf;
+using stan::math::sufficient_stats;
+
+TEST(ProbDistributionsPoissonLogSufficient, matches_per_observation) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(3);
+  y.push_back(1);
+  y.push_back(4);
+  y.push_back(2);
+  std::vector<int> group;
+  group.push_back(1);
+  group.push_back(2);
+  group.push_back(2);
+  group.push_back(1);
+  group.push_back(2);
+  sufficient_stats s(y, group, 2);
+
+  std::vector<var> alpha1;
+  alpha1.push_back(0.9);
+  alpha1.push_back(-0.4);
+  var lp1 = 0;
+  for (size_t n = 0; n < y.size(); ++n)
+    lp1 += poisson_log_lpmf(y[n], alpha1[group[n] - 1]);
+  std::vector<double> grad1;
+  lp1.grad(alpha1, grad1);
+
+  std::vector<var> alpha2;
+  alpha2.push_back(0.9);
+  alpha2.push_back(-0.4);
+  var lp2 = poisson_log_sufficient_lpmf(s, alpha2);
+  std::vector<double> grad2;
+  lp2.grad(alpha2, grad2);
+
+  EXPECT_FLOAT_EQ(lp1.val(), lp2.val());
+  EXPECT_FLOAT_EQ(grad1[0], grad2[0]);
+  EXPECT_FLOAT_EQ(grad1[1], grad2[1]);
+}
+
+TEST(ProbDistributionsPoissonLogSufficient, propto) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(3);
+  y.push_back(1);
+  y.push_back(4);
+  y.push_back(2);
+  sufficient_stats s(y);
+
+  EXPECT_FLOAT_EQ(0.0, poisson_log_sufficient_lpmf<true>(s, 0.9));
+  EXPECT_FLOAT_EQ(poisson_log_lpmf<false>(y, 0.9),
+                  poisson_log_sufficient_lpmf<false>(s, 0.9));
+
+  var alpha1 = 0.9;
+  var alpha2 = -0.4;
+  EXPECT_FLOAT_EQ(poisson_log_lpmf<true>(y, alpha1).val()
+                  - poisson_log_lpmf<true>(y, alpha2).val(),
+                  poisson_log_sufficient_lpmf<true>(s, alpha1).val()
+                  - poisson_log_sufficient_lpmf<true>(s, alpha2).val());
+}
+
+TEST(ProbDistributionsPoissonLogSufficient, exceptions) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(3);
+  y.push_back(1);
+  y.push_back(4);
+  y.push_back(2);
+  std::vector<int> group(y.size(), 1);
+  group[0] = 2;
+  sufficient_stats s(y, group, 2);
+
+  std::vector<double> alpha(3, 0.9);
+  EXPECT_THROW(poisson_log_sufficient_lpmf(s, alpha), std::invalid_argument);
+  alpha.pop_back();
+  EXPECT_NO_THROW(poisson_log_sufficient_lpmf(s, alpha));
+  alpha[1] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(poisson_log_sufficient_lpmf(s, alpha), std::domain_error);
+
+  y[3] = -1;
+  EXPECT_THROW(poisson_log_sufficient_lpmf(sufficient_stats(y), 0.9),
+               std::domain_error);
+
+  std::vector<double> y_real(y.begin(), y.end());
+  y_real[3] = 1.5;
+  EXPECT_THROW(poisson_log_sufficient_lpmf(sufficient_stats(y_real), 0.9),
+               std::domain_error);
+}
@@ -0,0 +1,96 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+using stan::math::var;
+using stan::math::poisson_lpmf;
+using stan::math::poisson_sufficient_lpmf;
+using stan::math::sufficient_stats;
+
+TEST(ProbDistributionsPoissonSufficient, matches_per_observation) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(3);
+  y.push_back(1);
+  y.push_back(4);
+  y.push_back(2);
+  std::vector<int> group;
+  group.push_back(1);
+  group.push_back(2);
+  group.push_back(2);
+  group.push_back(1);
+  group.push_back(2);
+  sufficient_stats s(y, group, 2);
+
+  std::vector<var> lambda1;
+  lambda1.push_back(2.5);
+  lambda1.push_back(0.7);
+  var lp1 = 0;
+  for (size_t n = 0; n < y.size(); ++n)
+    lp1 += poisson_lpmf(y[n], lambda1[group[n] - 1]);
+  std::vector<double> grad1;
+  lp1.grad(lambda1, grad1);
+
+  std::vector<var> lambda2;
+  lambda2.push_back(2.5);
+  lambda2.push_back(0.7);
+  var lp2 = poisson_sufficient_lpmf(s, lambda2);
+  std::vector<double> grad2;
+  lp2.grad(lambda2, grad2);
+
+  EXPECT_FLOAT_EQ(lp1.val(), lp2.val());
+  EXPECT_FLOAT_EQ(grad1[0], grad2[0]);
+  EXPECT_FLOAT_EQ(grad1[1], grad2[1]);
+}
+
+TEST(ProbDistributionsPoissonSufficient, propto) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(3);
+  y.push_back(1);
+  y.push_back(4);
+  y.push_back(2);
+  sufficient_stats s(y);
+
+  EXPECT_FLOAT_EQ(0.0, poisson_sufficient_lpmf<true>(s, 2.5));
+  EXPECT_FLOAT_EQ(poisson_lpmf<false>(y, 2.5),
+                  poisson_sufficient_lpmf<false>(s, 2.5));
+
+  var lambda1 = 2.5;
+  var lambda2 = 0.7;
+  EXPECT_FLOAT_EQ(poisson_lpmf<true>(y, lambda1).val()
+                  - poisson_lpmf<true>(y, lambda2).val(),
+                  poisson_sufficient_lpmf<true>(s, lambda1).val()
+                  - poisson_sufficient_lpmf<true>(s, lambda2).val());
+}
+
+TEST(ProbDistributionsPoissonSufficient, exceptions) {
+  std::vector<int> y;
+  y.push_back(0);
+  y.push_back(3);
+  y.push_back(1);
+  y.push_back(4);
+  y.push_back(2);
+  std::vector<int> group(y.size(), 1);
+  group[0] = 2;
+  sufficient_stats s(y, group, 2);
+
+  std::vector<double> lambda(3, 2.5);
+  EXPECT_THROW(poisson_sufficient_lpmf(s, lambda), std::invalid_argument);
+  lambda.pop_back();
+  EXPECT_NO_THROW(poisson_sufficient_lpmf(s, lambda));
+  lambda[1] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(poisson_sufficient_lpmf(s, lambda), std::domain_error);
+
+  y[3] = -1;
+  EXPECT_THROW(poisson_sufficient_lpmf(sufficient_stats(y), 2.5),
+               std::domain_error);
+  EXPECT_THROW(poisson_sufficient_lpmf(s, -1.0),
+               std::domain_error);
+
+  std::vector<double> y_real(y.begin(), y.end());
+  y_real[3] = 1.5;
+  EXPECT_THROW(poisson_sufficient_lpmf(sufficient_stats(y_real), 2.5),
+               std::domain_error);
+}
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <test/unit/math/rev/mat/prob/expect_eq_diffs.hpp>
 #include <test/unit/math/rev/mat/util.hpp>
+#include <stan/math/prim/mat/functor/finite_diff_gradient.hpp>
+#include <cmath>
 #include <string>
 
 template <typename T_y, typename T_dof, typename T_scale>
@@ -122,3 +124,82 @@ TEST(Wishart, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::wishart_log<true>(W, to_var(nu), S));
   test::check_varis_on_stack(stan::math::wishart_log<true>(W, nu, to_var(S)));
 }
+
+namespace {
+
+  Eigen::MatrixXd spd_matrix(int K, double seed) {
+    Eigen::MatrixXd A(K, K);
+    for (int j = 0; j < K; ++j)
+      for (int i = 0; i < K; ++i)
+        A(i, j) = std::sin(seed + 0.7 * i + 0.31 * j * j + i * j);
+    return A * A.transpose() + K * Eigen::MatrixXd::Identity(K, K);
+  }
+
+  // the Wishart density of symmetric W and S given by their lower
+  // triangles, with nu in between
+  struct wishart_fun {
+    int K_;
+    explicit wishart_fun(int K) : K_(K) { }
+
+    template <typename T>
+    T operator()(const Matrix<T, Dynamic, 1>& x) const {
+      Matrix<T, Dynamic, Dynamic> W(K_, K_), S(K_, K_);
+      int pos = 0;
+      for (int j = 0; j < K_; ++j)
+        for (int i = j; i < K_; ++i)
+          W(i, j) = W(j, i) = x(pos++);
+      T nu = x(pos++);
+      for (int j = 0; j < K_; ++j)
+        for (int i = j; i < K_; ++i)
+          S(i, j) = S(j, i) = x(pos++);
+      return stan::math::wishart_log(W, nu, S);
+    }
+  };
+
+}
+
+TEST(Wishart, gradients) {
+  const int K = 4;
+  Eigen::MatrixXd W = spd_matrix(K, 1.0);
+  Eigen::MatrixXd S = spd_matrix(K, 2.0);
+  Matrix<double, Dynamic, 1> x(K * (K + 1) + 1);
+  int pos = 0;
+  for (int j = 0; j < K; ++j)
+    for (int i = j; i < K; ++i)
+      x(pos++) = W(i, j);
+  x(pos++) = K + 1.5;
+  for (int j = 0; j < K; ++j)
+    for (int i = j; i < K; ++i)
+      x(pos++) = S(i, j);
+
+  wishart_fun f(K);
+  double fx, fx_fd;
+  Matrix<double, Dynamic, 1> grad, grad_fd;
+  stan::math::gradient(f, x, fx, grad);
+  stan::math::finite_diff_gradient(f, x, fx_fd, grad_fd);
+  EXPECT_FLOAT_EQ(fx_fd, fx);
+  for (int n = 0; n < x.size(); ++n)
+    EXPECT_NEAR(grad_fd(n), grad(n), 1e-6 * (1 + std::fabs(grad(n))));
+
+  // nu at k + 1 drops log det(W) from the value but not the gradient
+  x(K * (K + 1) / 2) = K + 1;
+  stan::math::gradient(f, x, fx, grad);
+  stan::math::finite_diff_gradient(f, x, fx_fd, grad_fd);
+  EXPECT_NEAR(grad_fd(K * (K + 1) / 2), grad(K * (K + 1) / 2), 1e-6);
+}
+
+TEST(Wishart, gradients_lower_triangles) {
+  Eigen::MatrixXd W_d = spd_matrix(3, 1.0);
+  Eigen::MatrixXd S_d = spd_matrix(3, 2.0);
+  Matrix<var, Dynamic, Dynamic> W = to_var(W_d);
+  Matrix<var, Dynamic, Dynamic> S = to_var(S_d);
+  var lp = stan::math::wishart_log(W, 5.0, S);
+  lp.grad();
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < j; ++i) {
+      EXPECT_FLOAT_EQ(0, W(i, j).adj());
+      EXPECT_FLOAT_EQ(0, S(i, j).adj());
+    }
+  }
+  stan::math::recover_memory();
+}